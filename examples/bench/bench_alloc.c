@@ -0,0 +1,182 @@
+/*
+ *  bench_alloc: Benchmark of small object allocator against malloc
+ *  Copyright (C) 2008-2011  Christian Rau
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  If you modify this software, you should include a notice giving the
+ *  name of the person performing the modification, the date of modification,
+ *  and the reason for such modification.
+ *
+ *  Contact: Christian Rau
+ *
+ *     rauy@users.sourceforge.net
+ */
+
+/*
+ * Every thread repeatedly allocates a set of objects with the sizes of the
+ * mesh elements and frees them in random order, once with malloc/free and
+ * once with the small object allocator (and its per-thread caches). The
+ * throughput is printed for doubling numbers of threads.
+ *
+ * usage: bench_alloc [max_threads] [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gi_memory.h"
+#include "gi_thread.h"
+#include "gi_mesh.h"
+
+#define NUM_OBJECTS     65536
+#define NUM_SIZES       5
+#define MAX_THREADS     64
+
+typedef struct _BenchData
+{
+    GIboolean   use_malloc;     // allocate with malloc instead of allocator
+    GIuint      rounds;         // number of allocation rounds
+    GIuint      *order;         // random order of deallocations
+    GIvoid      **objects;      // allocated objects
+} BenchData;
+
+static GISmallObjectAllocator g_Alloc;
+static GIusize g_Sizes[NUM_SIZES];
+
+static void run(BenchData *data)
+{
+    GIuint r, i, n;
+
+    for(r=0; r<data->rounds; ++r)
+    {
+        // allocate in order and touch objects
+        for(i=0; i<NUM_OBJECTS; ++i)
+        {
+            GIusize size = g_Sizes[i%NUM_SIZES];
+            data->objects[i] = data->use_malloc ? malloc(size) :
+                GISmallObjectAllocator_allocate(&g_Alloc, size);
+            *(GIuint*)data->objects[i] = i;
+        }
+
+        // free in random order
+        for(i=0; i<NUM_OBJECTS; ++i)
+        {
+            n = data->order[i];
+            if(data->use_malloc)
+                free(data->objects[n]);
+            else
+                GISmallObjectAllocator_deallocate(&g_Alloc, data->objects[n], g_Sizes[n%NUM_SIZES]);
+        }
+    }
+}
+
+#if OPENGI_NUM_THREADS > 1
+static GIthreadret GITHREADENTRY worker(GIvoid *arg)
+{
+    run((BenchData*)arg);
+    GIMemory_release_caches();
+    return 0;
+}
+#endif
+
+static double measure(BenchData *data, GIuint threads)
+{
+    double dTime = GITimer_seconds();
+#if OPENGI_NUM_THREADS > 1
+    GIthread hThreads[MAX_THREADS];
+    GIuint t;
+
+    for(t=0; t<threads; ++t)
+        hThreads[t] = GIthread_create(worker, data+t);
+    for(t=0; t<threads; ++t)
+        GIthread_join(hThreads[t]);
+#else
+    (void)threads;
+    run(data);
+#endif
+    return GITimer_seconds() - dTime;
+}
+
+int main(int argc, char *argv[])
+{
+    static BenchData data[MAX_THREADS];
+    GIuint uiMaxThreads = (argc > 1) ? atoi(argv[1]) : 4;
+    GIuint uiRounds = (argc > 2) ? atoi(argv[2]) : 50;
+    GIuint t, i, j, threads = 1;
+    GIusize uiMin = ~(GIusize)0, uiMax = 0;
+
+    if(uiMaxThreads < 1 || uiMaxThreads > MAX_THREADS)
+        uiMaxThreads = 4;
+#if OPENGI_NUM_THREADS <= 1
+    printf("library built without multithreading, using 1 thread\n");
+    uiMaxThreads = 1;
+#endif
+    g_Sizes[0] = sizeof(GIVertex);
+    g_Sizes[1] = sizeof(GIHalfEdge);
+    g_Sizes[2] = sizeof(GIEdge);
+    g_Sizes[3] = sizeof(GIFace);
+    g_Sizes[4] = sizeof(GIParam);
+    for(i=0; i<NUM_SIZES; ++i)
+    {
+        uiMin = (g_Sizes[i] < uiMin) ? g_Sizes[i] : uiMin;
+        uiMax = (g_Sizes[i] > uiMax) ? g_Sizes[i] : uiMax;
+    }
+    GISmallObjectAllocator_construct(&g_Alloc);
+
+    // create random deallocation orders
+    srand(1);
+    for(t=0; t<uiMaxThreads; ++t)
+    {
+        data[t].rounds = uiRounds;
+        data[t].order = (GIuint*)malloc(NUM_OBJECTS*sizeof(GIuint));
+        data[t].objects = (GIvoid**)malloc(NUM_OBJECTS*sizeof(GIvoid*));
+        for(i=0; i<NUM_OBJECTS; ++i)
+            data[t].order[i] = i;
+        for(i=NUM_OBJECTS-1; i>0; --i)
+        {
+            GIuint uiTemp = data[t].order[i];
+            j = (GIuint)rand() % (i+1);
+            data[t].order[i] = data[t].order[j];
+            data[t].order[j] = uiTemp;
+        }
+    }
+
+    printf("%d objects of %d-%d bytes, %d rounds per thread\n", NUM_OBJECTS,
+        (int)uiMin, (int)uiMax, uiRounds);
+    printf("threads    malloc [Mop/s]    allocator [Mop/s]\n");
+    for(;;)
+    {
+        double dOps = 2.0 * NUM_OBJECTS * uiRounds * threads * 1e-6, dMalloc, dAlloc;
+        for(t=0; t<threads; ++t)
+            data[t].use_malloc = GI_TRUE;
+        dMalloc = measure(data, threads);
+        for(t=0; t<threads; ++t)
+            data[t].use_malloc = GI_FALSE;
+        dAlloc = measure(data, threads);
+        printf("%7d    %14.1f    %17.1f\n", threads, dOps/dMalloc, dOps/dAlloc);
+        if(threads == uiMaxThreads)
+            break;
+        threads = ((threads<<1) < uiMaxThreads) ? (threads<<1) : uiMaxThreads;
+    }
+
+    // clean up
+    for(t=0; t<uiMaxThreads; ++t)
+    {
+        free(data[t].order);
+        free(data[t].objects);
+    }
+    GISmallObjectAllocator_destruct(&g_Alloc);
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ *  bench_amg: Benchmark of algebraic multigrid preconditioner
+ *  Copyright (C) 2008-2011  Christian Rau
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  If you modify this software, you should include a notice giving the
+ *  name of the person performing the modification, the date of modification,
+ *  and the reason for such modification.
+ *
+ *  Contact: Christian Rau
+ *
+ *     rauy@users.sourceforge.net
+ */
+
+/*
+ * Two right hand sides are solved by CG2 to the parameterizer's threshold
+ * on weighted Laplacians of regularly triangulated grids of growing size,
+ * preconditioned by Jacobi, IC and AMG. The edge weights vary like the ones
+ * of stretch-minimizing iterations, which change the values of a system but
+ * not its structure. The last two rows solve a system with new weights,
+ * once with a hierarchy built from scratch and once with the values of the
+ * previous hierarchy recomputed. Times are milliseconds.
+ *
+ * usage: bench_amg [max_grid_size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gi_memory.h"
+#include "gi_numerics.h"
+#include "gi_thread.h"
+
+#define NUM_NEIGHBOURS      6
+#define EPSILON             1e-6
+#define MAX_ITERATIONS      10000
+
+static const int g_Neighbours[NUM_NEIGHBOURS][2] = {
+    { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, -1 } };
+
+// edge weight in [0.5,1.5] for both directions of an edge
+static GIdouble weight(GIuint i, GIuint j, GIuint seed)
+{
+    GIuint h = ((i<j ? i : j)*2654435761u) ^ ((i<j ? j : i)*40503u) ^ (seed*2246822519u);
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return 0.5 + (GIdouble)(h&0xFFFF) / 65535.0;
+}
+
+// build lower triangle of weighted grid Laplacian
+static void create_matrix(GISparseMatrixCSR *mat, GIuint size, GIuint seed)
+{
+    GISparseMatrixLIL lil;
+    GIuint x, y, k, i, j, N = size * size;
+
+    GISparseMatrixLIL_construct(&lil, N, GI_TRUE);
+    for(y=0,i=0; y<size; ++y)
+    {
+        for(x=0; x<size; ++x,++i)
+        {
+            GIdouble dSum = 0.0;
+            for(k=0; k<NUM_NEIGHBOURS; ++k)
+            {
+                GIint nx = (GIint)x + g_Neighbours[k][0], ny = (GIint)y + g_Neighbours[k][1];
+                GIdouble dWeight;
+                if(nx < 0 || ny < 0 || nx >= (GIint)size || ny >= (GIint)size)
+                    continue;
+                j = ny*size + nx;
+                dWeight = weight(i, j, seed);
+                if(i > j)
+                    GISparseMatrixLIL_set(&lil, i, j, -dWeight);
+                dSum += dWeight;
+            }
+            GISparseMatrixLIL_set(&lil, i, i, dSum+1e-2);
+        }
+    }
+    GISparseMatrixCSR_construct(mat, &lil);
+    GISparseMatrixLIL_destruct(&lil);
+}
+
+// solve from zero and print iterations and times
+static void solve(GISparseMatrixCSR *mat, const char *name, double setup,
+                  GImvfunc pc, const GIdouble *b, GIdouble *x)
+{
+    GIuint iterations[2], uiSteps;
+    double dTime;
+
+    memset(x, 0, 2*mat->n*sizeof(GIdouble));
+    dTime = GITimer_seconds();
+    uiSteps = GISolver_cg2((GISparseMatrix*)mat, b, x, GISparseMatrixCSR_ax2,
+        pc, EPSILON, MAX_ITERATIONS, iterations, NULL);
+    dTime = 1e3 * (GITimer_seconds()-dTime);
+    printf("%10d  %-10s %10.2f %6d %10.2f %10.2f\n", mat->n, name,
+        setup, uiSteps, dTime, setup+dTime);
+}
+
+int main(int argc, char *argv[])
+{
+    GIuint uiMaxSize = (argc > 1) ? atoi(argv[1]) : 512;
+    GIuint i, size, N;
+    GIdouble *pB, *pX;
+
+    // library internals allocate from the global allocator
+    GISmallObjectAllocator_construct(&g_SmallObjAlloc);
+    printf("CG2 to %g, times in ms\n", EPSILON);
+    printf("      rows  pc              setup   iter      solve      total\n");
+    srand(1);
+    for(size=128; size<=uiMaxSize; size<<=1)
+    {
+        GISparseMatrixCSR mat, next;
+        double dTime;
+
+        N = size * size;
+        pB = (GIdouble*)GI_MALLOC_ALIGNED(GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+        pX = (GIdouble*)GI_MALLOC_ALIGNED(GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+        for(i=0; i<2*N; ++i)
+            pB[i] = (GIdouble)rand() / (GIdouble)RAND_MAX;
+
+        // single-level preconditioners share the data of the matrix
+        create_matrix(&mat, size, 0);
+        dTime = GITimer_seconds();
+        GISparseMatrixCSR_prepare_jacobi(&mat);
+        solve(&mat, "Jacobi", 1e3*(GITimer_seconds()-dTime),
+            GISparseMatrix_pc_jacobi2, pB, pX);
+        GISparseMatrixCSR_destruct(&mat);
+        create_matrix(&mat, size, 0);
+        dTime = GITimer_seconds();
+        GISparseMatrixCSR_prepare_ilu(&mat);
+        solve(&mat, "IC", 1e3*(GITimer_seconds()-dTime),
+            GISparseMatrixCSR_pc_ilu2, pB, pX);
+        GISparseMatrixCSR_destruct(&mat);
+
+        // hierarchy for first weights
+        create_matrix(&mat, size, 0);
+        dTime = GITimer_seconds();
+        GISparseMatrixCSR_prepare_amg(&mat);
+        solve(&mat, "AMG", 1e3*(GITimer_seconds()-dTime),
+            GISparseMatrixCSR_pc_amg2, pB, pX);
+
+        // new weights with new hierarchy and with previous one
+        create_matrix(&next, size, 1);
+        dTime = GITimer_seconds();
+        GISparseMatrixCSR_prepare_amg(&next);
+        solve(&next, "AMG new", 1e3*(GITimer_seconds()-dTime),
+            GISparseMatrixCSR_pc_amg2, pB, pX);
+        memcpy(mat.values, next.values, mat.nnz*sizeof(GIdouble));
+        dTime = GITimer_seconds();
+        GISparseMatrixCSR_prepare_amg(&mat);
+        solve(&mat, "AMG again", 1e3*(GITimer_seconds()-dTime),
+            GISparseMatrixCSR_pc_amg2, pB, pX);
+        GISparseMatrixCSR_destruct(&next);
+        GISparseMatrixCSR_destruct(&mat);
+
+        GI_FREE_ALIGNED(pB);
+        GI_FREE_ALIGNED(pX);
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ *  bench_blas: Benchmark of vector kernels of BLAS routines
+ *  Copyright (C) 2008-2011  Christian Rau
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  If you modify this software, you should include a notice giving the
+ *  name of the person performing the modification, the date of modification,
+ *  and the reason for such modification.
+ *
+ *  Contact: Christian Rau
+ *
+ *     rauy@users.sourceforge.net
+ */
+
+/*
+ * Prints the vector kernels selected at runtime and times the unit stride
+ * BLAS routines used by the Krylov solvers against plain loops compiled
+ * with the flags of this program, for vectors fitting into L1 cache, into
+ * L2 cache and into main memory. dgemv multiplies the transpose of a matrix
+ * of 32 columns like the orthogonalization of GMRES. Results are GFlop/s.
+ *
+ * usage: bench_blas [min_seconds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gi_blas.h"
+#include "gi_thread.h"
+
+#define NUM_COLUMNS     32
+
+static double g_Sink = 0.0;
+
+// reference dot product
+static double ref_ddot(int n, const double *x, const double *y)
+{
+    double temp = 0.0;
+    int i;
+    for(i=0; i<n; ++i)
+        temp += x[i] * y[i];
+    return temp;
+}
+
+// reference scaled vector addition
+static void ref_daxpy(int n, double a, const double *x, double *y)
+{
+    int i;
+    for(i=0; i<n; ++i)
+        y[i] += a * x[i];
+}
+
+// reference transposed matrix-vector product
+static void ref_dgemv(int m, int n, const double *A, const double *x, double *y)
+{
+    int j;
+    for(j=0; j<n; ++j)
+        y[j] = ref_ddot(m, A+j*m, x);
+}
+
+// run kernel until time is up, return GFlop/s
+static double measure(int kernel, int n, double *x, double *y, double *A,
+                      double seconds)
+{
+    double dStart = GITimer_seconds(), dTime, dFlops = 0.0;
+    do
+    {
+        int r;
+        for(r=0; r<16; ++r)
+        {
+            switch(kernel)
+            {
+            case 0: g_Sink += ddot(n, x, 1, y, 1); break;
+            case 1: g_Sink += ref_ddot(n, x, y); break;
+            case 2: daxpy(n, 1e-9, x, 1, y, 1); break;
+            case 3: ref_daxpy(n, 1e-9, x, y); break;
+            case 4: dgemv('T', n, NUM_COLUMNS, 1.0, A, n, x, 1, 0.0, y, 1); break;
+            default: ref_dgemv(n, NUM_COLUMNS, A, x, y);
+            }
+        }
+        dFlops += 16.0 * 2.0 * n * ((kernel < 4) ? 1 : NUM_COLUMNS);
+        dTime = GITimer_seconds() - dStart;
+    } while(dTime < seconds);
+    return 1e-9 * dFlops / dTime;
+}
+
+int main(int argc, char *argv[])
+{
+    static const int sizes[] = { 1024, 16384, 1048576 };
+    static const char *names[] = { "ddot", "daxpy", "dgemv('T')" };
+    double dSeconds = (argc > 1) ? atof(argv[1]) : 0.5;
+    double *pX, *pY, *pA;
+    int i, k, s, n;
+
+    printf("kernels: %s, %d columns for dgemv, results in GFlop/s\n",
+        blas_kernels(), NUM_COLUMNS);
+    printf("routine        elements      library        loop\n");
+    for(s=0; s<3; ++s)
+    {
+        n = sizes[s];
+        pX = (double*)malloc(n*sizeof(double));
+        pY = (double*)malloc(n*sizeof(double));
+        pA = (double*)malloc(n*sizeof(double));
+        for(i=0; i<n; ++i)
+            pX[i] = pY[i] = pA[i] = 1.0 / (i+1);
+        for(k=0; k<3; ++k)
+        {
+            // dgemv moves the matrix, so use fewer elements per column
+            int m = (k == 2) ? n/NUM_COLUMNS : n;
+            printf("%-12s %10d %12.2f %11.2f\n", names[k], (k == 2) ? m*NUM_COLUMNS : m,
+                measure(2*k, m, pX, pY, pA, dSeconds),
+                measure(2*k+1, m, pX, pY, pA, dSeconds));
+        }
+        free(pX);
+        free(pY);
+        free(pA);
+    }
+    if(g_Sink == 0.0)
+        printf("\n");
+    return 0;
+}
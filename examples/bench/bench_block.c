@@ -0,0 +1,157 @@
+/*
+ *  bench_block: Benchmark of block solvers for two right hand sides
+ *  Copyright (C) 2008-2011  Christian Rau
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  If you modify this software, you should include a notice giving the
+ *  name of the person performing the modification, the date of modification,
+ *  and the reason for such modification.
+ *
+ *  Contact: Christian Rau
+ *
+ *     rauy@users.sourceforge.net
+ */
+
+/*
+ * Two right hand sides are solved with IC/ILU preconditioning on Laplacians
+ * of regularly triangulated grids (symmetric weights for CG, unsymmetric
+ * ones otherwise), once by two calls of the single vector solvers and once
+ * by one call of the block solvers on interleaved vectors, which stream the
+ * matrix and the factors once for both. Both run on the calling thread.
+ * Iterations are given for both systems, times are milliseconds.
+ *
+ * usage: bench_block [max_grid_size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gi_memory.h"
+#include "gi_numerics.h"
+#include "gi_thread.h"
+
+#define NUM_NEIGHBOURS      6
+#define EPSILON             1e-6
+#define MAX_ITERATIONS      10000
+#define GMRES_RESTART       30
+
+static const int g_Neighbours[NUM_NEIGHBOURS][2] = {
+    { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, -1 } };
+
+// build grid Laplacian
+static void create_matrix(GISparseMatrixCSR *mat, GIuint size, GIboolean symmetric)
+{
+    GISparseMatrixLIL lil;
+    GIuint x, y, k, i, j;
+
+    GISparseMatrixLIL_construct(&lil, size*size, symmetric);
+    for(y=0,i=0; y<size; ++y)
+    {
+        for(x=0; x<size; ++x,++i)
+        {
+            GIdouble dSum = 0.0;
+            for(k=0; k<NUM_NEIGHBOURS; ++k)
+            {
+                GIint nx = (GIint)x + g_Neighbours[k][0], ny = (GIint)y + g_Neighbours[k][1];
+                GIdouble dWeight = 1.0;
+                if(nx < 0 || ny < 0 || nx >= (GIint)size || ny >= (GIint)size)
+                    continue;
+                j = ny*size + nx;
+                if(!symmetric)
+                    dWeight = 0.5 + (GIdouble)rand() / (GIdouble)RAND_MAX;
+                if(!symmetric || i > j)
+                    GISparseMatrixLIL_set(&lil, i, j, -dWeight);
+                dSum += dWeight;
+            }
+            GISparseMatrixLIL_set(&lil, i, i, dSum+1e-2);
+        }
+    }
+    GISparseMatrixCSR_construct(mat, &lil);
+    GISparseMatrixLIL_destruct(&lil);
+    GISparseMatrixCSR_prepare_ilu(mat);
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *names[] = { "CG", "BiCGStab", "GMRES" };
+    static const GIsolverfunc solvers[] = {
+        GISolver_cg, GISolver_bicgstab, GISolver_gmres };
+    GIuint uiMaxSize = (argc > 1) ? atoi(argv[1]) : 512;
+    GIuint i, s, c, size, N, iterations[2], uiMaxIter;
+    GIdouble *pB, *pX, *pBC, *pXC;
+
+    GISmallObjectAllocator_construct(&g_SmallObjAlloc);
+    printf("IC/ILU preconditioner, %g threshold, GMRES restart %d, times in ms\n",
+        EPSILON, GMRES_RESTART);
+    printf("solver          rows      two iter      two ms    block iter    block ms\n");
+    srand(1);
+    for(size=128; size<=uiMaxSize; size<<=1)
+    {
+        N = size * size;
+        pB = (GIdouble*)GI_MALLOC_ALIGNED(GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+        pX = (GIdouble*)GI_MALLOC_ALIGNED(GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+        pBC = (GIdouble*)GI_MALLOC_ALIGNED(GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+        pXC = (GIdouble*)GI_MALLOC_ALIGNED(GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+        for(i=0; i<2*N; ++i)
+            pB[i] = (GIdouble)rand() / (GIdouble)RAND_MAX;
+        for(s=0; s<3; ++s)
+        {
+            GISparseMatrixCSR mat;
+            GIuint uiSingle[2];
+            double dSingle, dBlock;
+
+            // GMRES takes restart length and number of cycles
+            create_matrix(&mat, size, !s);
+            uiMaxIter = (s == 2) ? ((((MAX_ITERATIONS+GMRES_RESTART-1) /
+                GMRES_RESTART)<<8) | GMRES_RESTART) : MAX_ITERATIONS;
+
+            // one column after the other
+            dSingle = GITimer_seconds();
+            for(c=0; c<2; ++c)
+            {
+                for(i=0; i<N; ++i)
+                    pBC[i] = pB[(i<<1)+c];
+                memset(pXC, 0, N*sizeof(GIdouble));
+                uiSingle[c] = solvers[s]((GISparseMatrix*)&mat, pBC, pXC,
+                    GISparseMatrixCSR_ax, GISparseMatrixCSR_pc_ilu, EPSILON, uiMaxIter);
+            }
+            dSingle = 1e3 * (GITimer_seconds()-dSingle);
+
+            // both columns at once
+            memset(pX, 0, 2*N*sizeof(GIdouble));
+            dBlock = GITimer_seconds();
+            if(s == 0)
+                GISolver_cg2((GISparseMatrix*)&mat, pB, pX, GISparseMatrixCSR_ax2,
+                    GISparseMatrixCSR_pc_ilu2, EPSILON, uiMaxIter, iterations, NULL);
+            else if(s == 1)
+                GISolver_bicgstab2((GISparseMatrix*)&mat, pB, pX, GISparseMatrixCSR_ax2,
+                    GISparseMatrixCSR_pc_ilu2, EPSILON, uiMaxIter, iterations, NULL);
+            else
+                GISolver_gmres2((GISparseMatrix*)&mat, pB, pX, GISparseMatrixCSR_ax2,
+                    GISparseMatrixCSR_pc_ilu2, EPSILON, uiMaxIter, iterations, NULL);
+            dBlock = 1e3 * (GITimer_seconds()-dBlock);
+
+            printf("%-10s %9d %6d/%-6d %10.2f %6d/%-6d %10.2f\n", names[s], N,
+                uiSingle[0], uiSingle[1], dSingle, iterations[0], iterations[1], dBlock);
+            GISparseMatrixCSR_destruct(&mat);
+        }
+        GI_FREE_ALIGNED(pB);
+        GI_FREE_ALIGNED(pX);
+        GI_FREE_ALIGNED(pBC);
+        GI_FREE_ALIGNED(pXC);
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ *  bench_free: Benchmark of scattered deallocation from fixed allocators
+ *  Copyright (C) 2008-2011  Christian Rau
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  If you modify this software, you should include a notice giving the
+ *  name of the person performing the modification, the date of modification,
+ *  and the reason for such modification.
+ *
+ *  Contact: Christian Rau
+ *
+ *     rauy@users.sourceforge.net
+ */
+
+/*
+ * Half edges are allocated from a fixed allocator for growing heap sizes and
+ * freed in random order, like during cut reverts and patch destruction. For
+ * every size the owning chunks of the blocks are looked up with the former
+ * bidirectional search through the chunk array and with the constant time
+ * lookup of GIFixedAllocator_find, followed by the actual deallocations in
+ * random and in allocation order. Times are nanoseconds per block.
+ *
+ * usage: bench_free [max_objects]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gi_memory.h"
+#include "gi_thread.h"
+#include "gi_mesh.h"
+
+// chunk search used before constant time lookup
+static GIChunk* find_search(GIFixedAllocator *alloc, GIChunk *hint, GIvoid *address)
+{
+    GIChunk *pLo = hint, *pHi = hint+1, *pLoBound = alloc->chunks,
+        *pHiBound = alloc->chunks+alloc->num_chunks;
+    GIuint uiChunkSize = alloc->block_size * alloc->num_blocks;
+
+    if(pHi == pHiBound)
+        pHi = NULL;
+    for(;;)
+    {
+        if(pLo)
+        {
+            if((GIubyte*)address >= pLo->data && (GIubyte*)address < pLo->data+uiChunkSize)
+                return pLo;
+            if(pLo == pLoBound)
+            {
+                pLo = NULL;
+                if(!pHi)
+                    break;
+            }
+            else
+                --pLo;
+        }
+        if(pHi)
+        {
+            if((GIubyte*)address >= pHi->data && (GIubyte*)address < pHi->data+uiChunkSize)
+                return pHi;
+            if(++pHi == pHiBound)
+            {
+                pHi = NULL;
+                if(!pLo)
+                    break;
+            }
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    GIuint uiMaxObjects = (argc > 1) ? atoi(argv[1]) : 262144;
+    GIuint i, j, n, *pOrder = (GIuint*)malloc(uiMaxObjects*sizeof(GIuint));
+    GIvoid **pObjects = (GIvoid**)malloc(uiMaxObjects*sizeof(GIvoid*));
+    GIFixedAllocator alloc;
+    GIChunk *pHint;
+    GIusize uiCheck = 0;
+    double dTime, dSearch, dFind, dRandom, dOrdered;
+
+    printf("%d byte blocks, times in ns per block\n", (int)sizeof(GIHalfEdge));
+    printf("  objects    chunks    search    lookup    free random    free ordered\n");
+    srand(1);
+    for(n=1024; n<=uiMaxObjects; n<<=2)
+    {
+        // random order of deallocations
+        for(i=0; i<n; ++i)
+            pOrder[i] = i;
+        for(i=n-1; i>0; --i)
+        {
+            GIuint uiTemp = pOrder[i];
+            j = (GIuint)rand() % (i+1);
+            pOrder[i] = pOrder[j];
+            pOrder[j] = uiTemp;
+        }
+        GIFixedAllocator_construct(&alloc, sizeof(GIHalfEdge));
+        for(i=0; i<n; ++i)
+            pObjects[i] = GIFixedAllocator_allocate(&alloc);
+
+        // find owning chunks by searching
+        pHint = alloc.chunks;
+        dTime = GITimer_seconds();
+        for(i=0; i<n; ++i)
+        {
+            pHint = find_search(&alloc, pHint, pObjects[pOrder[i]]);
+            uiCheck += (GIusize)(pHint-alloc.chunks);
+        }
+        dSearch = GITimer_seconds() - dTime;
+
+        // find owning chunks directly
+        dTime = GITimer_seconds();
+        for(i=0; i<n; ++i)
+            uiCheck -= (GIusize)(GIFixedAllocator_find(&alloc, pObjects[pOrder[i]])-alloc.chunks);
+        dFind = GITimer_seconds() - dTime;
+
+        // free in random order
+        printf("%9d %9d", n, (int)alloc.num_chunks);
+        dTime = GITimer_seconds();
+        for(i=0; i<n; ++i)
+            GIFixedAllocator_deallocate(&alloc, pObjects[pOrder[i]]);
+        dRandom = GITimer_seconds() - dTime;
+
+        // free in allocation order
+        for(i=0; i<n; ++i)
+            pObjects[i] = GIFixedAllocator_allocate(&alloc);
+        dTime = GITimer_seconds();
+        for(i=0; i<n; ++i)
+            GIFixedAllocator_deallocate(&alloc, pObjects[i]);
+        dOrdered = GITimer_seconds() - dTime;
+        GIFixedAllocator_destruct(&alloc);
+
+        printf(" %9.1f %9.1f %14.1f %15.1f\n", 1e9*dSearch/n,
+            1e9*dFind/n, 1e9*dRandom/n, 1e9*dOrdered/n);
+    }
+    if(uiCheck)
+        printf("lookup mismatch\n");
+
+    free(pOrder);
+    free(pObjects);
+    return 0;
+}
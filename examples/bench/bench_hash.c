@@ -0,0 +1,188 @@
+/*
+ *  bench_hash: Benchmark of specialized against generic hash methods
+ *  Copyright (C) 2008-2011  Christian Rau
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  If you modify this software, you should include a notice giving the
+ *  name of the person performing the modification, the date of modification,
+ *  and the reason for such modification.
+ *
+ *  Contact: Christian Rau
+ *
+ *     rauy@users.sourceforge.net
+ */
+
+/*
+ * For every key type with specialized methods a hash is filled the way
+ * giIndexedMesh does it (find, insert if missing, with every key occurring
+ * six times) and then queried with random existing keys. This is done once
+ * with GIHash_find/GIHash_insert, which call the hash, compare and copy
+ * functions through pointers, and once with the specialized methods. Both
+ * variants run alternately for several rounds, starting with a different
+ * one every round, and the fastest round of every variant is reported.
+ * Times are nanoseconds per operation.
+ *
+ * usage: bench_hash [keys] [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gi_container.h"
+#include "gi_thread.h"
+
+#define NUM_OCCURRENCES     6
+#define BLOB_FLOATS         8
+
+typedef GIboolean (*insertfunc)(GIHash*, const GIvoid*, GIvoid*);
+typedef GIvoid* (*findfunc)(const GIHash*, const GIvoid*);
+
+typedef struct _KeyType
+{
+    const char      *name;          // name of key type
+    GIuint          key_size;       // size of key
+    GIhashfunc      hash;           // generic hash function
+    GIcompfunc      comp;           // generic compare function
+    GIcopyfunc      copy;           // generic copy function
+    insertfunc      insert;         // specialized insert
+    findfunc        find;           // specialized find
+} KeyType;
+
+static const KeyType g_KeyTypes[] = {
+    { "pointer", sizeof(GIvoid*), hash_pointer, compare_pointer, copy_pointer,
+        GIHash_insert_pointer, GIHash_find_pointer },
+    { "uintpair", sizeof(GIUIntPair), hash_uintpair, compare_uintpair, copy_uintpair,
+        GIHash_insert_uintpair, GIHash_find_uintpair },
+    { "blob", sizeof(GIuint)+BLOB_FLOATS*sizeof(GIfloat), hash_blob, compare_blob, copy_blob,
+        GIHash_insert_blob, GIHash_find_blob } };
+
+// random coordinate like those of mesh attributes
+static GIfloat random_float()
+{
+    return 2.0f * (GIfloat)rand() / (GIfloat)RAND_MAX - 1.0f;
+}
+
+// create distinct keys of given type
+static void create_keys(GIuint type, GIubyte *keys, GIuint count)
+{
+    GIuint i, j, uiStride = g_KeyTypes[type].key_size;
+
+    for(i=0; i<count; ++i)
+    {
+        GIubyte *pKey = keys + i*uiStride;
+        switch(type)
+        {
+        case 0:
+            *(GIvoid**)pKey = (GIvoid*)(keys + i*64);
+            break;
+        case 1:
+            ((GIUIntPair*)pKey)->first = i >> 2;
+            ((GIUIntPair*)pKey)->second = i*7 + 1;
+            break;
+        default:
+            *(GIuint*)pKey = BLOB_FLOATS * sizeof(GIfloat);
+            for(j=0; j<BLOB_FLOATS; ++j)
+                ((GIfloat*)((GIuint*)pKey+1))[j] = random_float();
+        }
+    }
+}
+
+// fill hash and query it, return seconds for fill and queries
+static void run(const KeyType *type, GIboolean specialized, const GIubyte *keys,
+                GIuint count, const GIuint *order, double *times)
+{
+    GIHash hash;
+    GIuint i, uiMisses = 0, uiOps = NUM_OCCURRENCES * count;
+    double dTime;
+
+    GIHash_construct(&hash, count, 0.0f, type->key_size, type->hash, type->comp, type->copy);
+
+    // find or insert like indexed mesh construction
+    dTime = GITimer_seconds();
+    for(i=0; i<uiOps; ++i)
+    {
+        const GIubyte *pKey = keys + (order[i]%count)*type->key_size;
+        if(specialized)
+        {
+            if(!type->find(&hash, pKey))
+                type->insert(&hash, pKey, (GIvoid*)(pKey+1));
+        }
+        else if(!GIHash_find(&hash, pKey))
+            GIHash_insert(&hash, pKey, (GIvoid*)(pKey+1));
+    }
+    times[0] = GITimer_seconds() - dTime;
+
+    // query existing keys
+    dTime = GITimer_seconds();
+    for(i=0; i<uiOps; ++i)
+    {
+        const GIubyte *pKey = keys + (order[uiOps-1-i]%count)*type->key_size;
+        GIvoid *pValue = specialized ? type->find(&hash, pKey) : GIHash_find(&hash, pKey);
+        if(pValue != (GIvoid*)(pKey+1))
+            ++uiMisses;
+    }
+    times[1] = GITimer_seconds() - dTime;
+    if(uiMisses)
+        printf("%d lookups failed\n", uiMisses);
+    GIHash_destruct(&hash, 0);
+}
+
+int main(int argc, char *argv[])
+{
+    GIuint uiCount = (argc > 1) ? atoi(argv[1]) : 100000;
+    GIuint uiRounds = (argc > 2) ? atoi(argv[2]) : 7;
+    GIuint i, j, t, r, v, uiOps = NUM_OCCURRENCES * uiCount;
+    GIuint *pOrder = (GIuint*)malloc(uiOps*sizeof(GIuint));
+    GIubyte *pKeys = (GIubyte*)malloc(uiCount*64);
+    double dBest[2][2], dTimes[2];
+
+    // every key occurs several times in random order
+    srand(1);
+    for(i=0; i<uiOps; ++i)
+        pOrder[i] = i;
+    for(i=uiOps-1; i>0; --i)
+    {
+        GIuint uiTemp = pOrder[i];
+        j = (GIuint)rand() % (i+1);
+        pOrder[i] = pOrder[j];
+        pOrder[j] = uiTemp;
+    }
+
+    printf("%d keys, %d operations per pass, best of %d rounds, times in ns per operation\n",
+        uiCount, uiOps, uiRounds);
+    printf("key type    fill generic    fill specialized    find generic    find specialized\n");
+    for(t=0; t<sizeof(g_KeyTypes)/sizeof(KeyType); ++t)
+    {
+        create_keys(t, pKeys, uiCount);
+        dBest[0][0] = dBest[0][1] = dBest[1][0] = dBest[1][1] = 1e30;
+        for(r=0; r<2*uiRounds; ++r)
+        {
+            // variants alternate, every other round starts with the specialized one
+            v = (r & 1) ^ ((r >> 1) & 1);
+            run(g_KeyTypes+t, (GIboolean)v, pKeys, uiCount, pOrder, dTimes);
+            for(i=0; i<2; ++i)
+                if(dTimes[i] < dBest[v][i])
+                    dBest[v][i] = dTimes[i];
+        }
+        printf("%-8s %15.1f %19.1f %15.1f %19.1f\n", g_KeyTypes[t].name,
+            1e9*dBest[0][0]/uiOps, 1e9*dBest[1][0]/uiOps,
+            1e9*dBest[0][1]/uiOps, 1e9*dBest[1][1]/uiOps);
+    }
+
+    free(pOrder);
+    free(pKeys);
+    return 0;
+}
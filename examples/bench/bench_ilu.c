@@ -0,0 +1,182 @@
+/*
+ *  bench_ilu: Benchmark of level-scheduled IC/ILU preconditioner
+ *  Copyright (C) 2008-2011  Christian Rau
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  If you modify this software, you should include a notice giving the
+ *  name of the person performing the modification, the date of modification,
+ *  and the reason for such modification.
+ *
+ *  Contact: Christian Rau
+ *
+ *     rauy@users.sourceforge.net
+ */
+
+/*
+ * Laplacians of regularly triangulated grids of growing size (every vertex
+ * has six neighbours, like inner vertices of the meshes parameterized) are
+ * factorized with the IC (symmetric weights) and ILU (unsymmetric weights)
+ * preconditioner, once with vertices in grid order and once in random order.
+ * The preconditioner is then applied with the sequential triangular solves
+ * and with the level schedule on the thread pool. Times are milliseconds
+ * per application, the schedule has to reproduce the sequential result.
+ *
+ * usage: bench_ilu [threads] [max_grid_size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "gi_memory.h"
+#include "gi_numerics.h"
+#include "gi_thread.h"
+
+#define NUM_NEIGHBOURS      6
+
+static const int g_Neighbours[NUM_NEIGHBOURS][2] = {
+    { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, -1 } };
+
+// build factorized grid Laplacian with optionally permuted vertices
+static void create_matrix(GISparseMatrixCSR *mat, GIuint size, GIboolean symmetric,
+                          const GIuint *perm)
+{
+    GISparseMatrixLIL lil;
+    GIuint x, y, k, i, j, N = size * size;
+
+    GISparseMatrixLIL_construct(&lil, N, symmetric);
+    for(y=0; y<size; ++y)
+    {
+        for(x=0; x<size; ++x)
+        {
+            GIdouble dSum = 0.0;
+            i = perm[y*size+x];
+            for(k=0; k<NUM_NEIGHBOURS; ++k)
+            {
+                GIint nx = (GIint)x + g_Neighbours[k][0], ny = (GIint)y + g_Neighbours[k][1];
+                GIdouble dWeight = 1.0;
+                if(nx < 0 || ny < 0 || nx >= (GIint)size || ny >= (GIint)size)
+                    continue;
+                j = perm[ny*size+nx];
+                if(!symmetric)
+                    dWeight = 0.5 + (GIdouble)rand() / (GIdouble)RAND_MAX;
+                if(!symmetric || i > j)
+                    GISparseMatrixLIL_set(&lil, i, j, -dWeight);
+                dSum += dWeight;
+            }
+            GISparseMatrixLIL_set(&lil, i, i, dSum+1e-2);
+        }
+    }
+    GISparseMatrixCSR_construct(mat, &lil);
+    GISparseMatrixLIL_destruct(&lil);
+    GISparseMatrixCSR_prepare_ilu(mat);
+}
+
+// apply preconditioner repeatedly, return milliseconds per application
+static double measure(GISparseMatrixCSR *mat, const GIdouble *x, GIdouble *y, GIuint runs)
+{
+    GIuint r;
+    double dTime = GITimer_seconds();
+    for(r=0; r<runs; ++r)
+        GISparseMatrixCSR_pc_ilu((GISparseMatrix*)mat, x, y);
+    return 1e3 * (GITimer_seconds()-dTime) / runs;
+}
+
+int main(int argc, char *argv[])
+{
+    GIuint uiThreads = (argc > 1) ? atoi(argv[1]) : OPENGI_MAX_THREADS;
+    GIuint uiMaxSize = (argc > 2) ? atoi(argv[2]) : 1024;
+    GIuint i, j, s, o, size, N, *pPerm;
+    GIdouble *pX, *pY, *pZ;
+
+    // library internals allocate from the global allocator
+    GISmallObjectAllocator_construct(&g_SmallObjAlloc);
+    if(uiThreads < 1)
+        uiThreads = 1;
+#if OPENGI_NUM_THREADS > 1
+    GIThreadPool_construct(&g_ThreadPool, uiThreads);
+#else
+    printf("library built without multithreading, no level schedule\n");
+    uiThreads = 1;
+#endif
+    printf("%d threads, times in ms per application\n", uiThreads);
+    printf("      rows  matrix  order     levels  sequential   scheduled  speedup\n");
+    srand(1);
+    for(size=128; size<=uiMaxSize; size<<=1)
+    {
+        N = size * size;
+        pPerm = (GIuint*)malloc(N*sizeof(GIuint));
+        pX = (GIdouble*)malloc(N*sizeof(GIdouble));
+        pY = (GIdouble*)malloc(N*sizeof(GIdouble));
+        pZ = (GIdouble*)malloc(N*sizeof(GIdouble));
+        for(i=0; i<N; ++i)
+            pX[i] = (GIdouble)rand() / (GIdouble)RAND_MAX;
+        for(s=0; s<2; ++s)
+        {
+            for(o=0; o<2; ++o)
+            {
+                GISparseMatrixCSR mat;
+                GIuint uiRuns = 1 + (1<<26) / (NUM_NEIGHBOURS*N);
+                double dSeq, dSched = 0.0, dError = 0.0;
+
+                // grid order or random order of vertices
+                for(i=0; i<N; ++i)
+                    pPerm[i] = i;
+                for(i=N-1; o && i>0; --i)
+                {
+                    GIuint uiTemp = pPerm[i];
+                    j = (GIuint)rand() % (i+1);
+                    pPerm[i] = pPerm[j];
+                    pPerm[j] = uiTemp;
+                }
+                create_matrix(&mat, size, !s, pPerm);
+                GISparseMatrixCSR_prepare_parallel(&mat, uiThreads);
+
+                // sequential triangular solves are used for single blocks
+                printf("%10d  %-6s  %-6s ", N, s ? "ILU" : "IC", o ? "random" : "grid");
+                if(mat.ilu_schedule)
+                    printf("%10d", mat.ilu_schedule->levels[0]+mat.ilu_schedule->levels[1]);
+                else
+                    printf("%10s", "-");
+                i = mat.blocks;
+                mat.blocks = 1;
+                dSeq = measure(&mat, pX, pY, uiRuns);
+                mat.blocks = i;
+                if(mat.blocks > 1 && mat.ilu_schedule)
+                {
+                    dSched = measure(&mat, pX, pZ, uiRuns);
+                    for(i=0; i<N; ++i)
+                        dError = (fabs(pZ[i]-pY[i]) > dError) ? fabs(pZ[i]-pY[i]) : dError;
+                    printf("%12.3f%12.3f%9.2f", dSeq, dSched, dSeq/dSched);
+                    if(dError > 0.0)
+                        printf("  (error %g)", dError);
+                    printf("\n");
+                }
+                else
+                    printf("%12.3f%12s%9s\n", dSeq, "-", "-");
+                GISparseMatrixCSR_destruct(&mat);
+            }
+        }
+        free(pPerm);
+        free(pX);
+        free(pY);
+        free(pZ);
+    }
+
+#if OPENGI_NUM_THREADS > 1
+    GIThreadPool_destruct(&g_ThreadPool);
+#endif
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ *  bench_krylov: Benchmark of memory traffic of two-column Krylov solvers
+ *  Copyright (C) 2008-2011  Christian Rau
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  If you modify this software, you should include a notice giving the
+ *  name of the person performing the modification, the date of modification,
+ *  and the reason for such modification.
+ *
+ *  Contact: Christian Rau
+ *
+ *     rauy@users.sourceforge.net
+ */
+
+/*
+ * The solvers for two right hand sides are run for a fixed number of
+ * iterations with Jacobi preconditioning on Laplacians of regularly
+ * triangulated grids (symmetric weights for CG, unsymmetric ones otherwise).
+ * Matrix and preconditioner applications are counted by wrappers, which add
+ * up the bytes of the matrix and vectors they stream. The bytes of the vector
+ * operations of the solvers are the passes over 2N-vectors listed below,
+ * reads and writes counted separately (one pass moves 16N bytes):
+ *
+ *   CG2        ddot2 2, daxpy2_nrm2 6, ddot2 2, dxpay2 3                 = 13
+ *   BiCGStab2  ddot2 2, daxpy2_nrm2 6, daxpy2 3, ddot2_nrm2 2,
+ *              daxpy2_nrm2 6, daxpy2 3, ddot2 2, dxpay2 4                = 28
+ *   GMRES2     per step j, counted in N-vectors for both systems:
+ *              dcopy into z 6, dcopy from w 6, dgemv('T') 4(j+1),
+ *              dorth 2(j+1)+4, dscal 4                       = 6(j+1)+20
+ *
+ * The GMRES figure assumes that q[j+1] does not stay in cache, so dgemv('T')
+ * reads it once per basis vector. It is averaged over a restart cycle and
+ * neglects the restarts. Times and bytes are per iteration as counted by the
+ * solvers (Krylov steps for GMRES), bandwidth is total bytes over time.
+ *
+ * usage: bench_krylov [max_grid_size] [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gi_memory.h"
+#include "gi_numerics.h"
+#include "gi_thread.h"
+
+#define NUM_NEIGHBOURS      6
+#define GMRES_RESTART       30
+
+static const int g_Neighbours[NUM_NEIGHBOURS][2] = {
+    { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, -1 } };
+
+static double g_MatrixBytes = 0.0;
+
+// build grid Laplacian
+static void create_matrix(GISparseMatrixCSR *mat, GIuint size, GIboolean symmetric)
+{
+    GISparseMatrixLIL lil;
+    GIuint x, y, k, i, j;
+
+    GISparseMatrixLIL_construct(&lil, size*size, symmetric);
+    for(y=0,i=0; y<size; ++y)
+    {
+        for(x=0; x<size; ++x,++i)
+        {
+            GIdouble dSum = 0.0;
+            for(k=0; k<NUM_NEIGHBOURS; ++k)
+            {
+                GIint nx = (GIint)x + g_Neighbours[k][0], ny = (GIint)y + g_Neighbours[k][1];
+                GIdouble dWeight = 1.0;
+                if(nx < 0 || ny < 0 || nx >= (GIint)size || ny >= (GIint)size)
+                    continue;
+                j = ny*size + nx;
+                if(!symmetric)
+                    dWeight = 0.5 + (GIdouble)rand() / (GIdouble)RAND_MAX;
+                if(!symmetric || i > j)
+                    GISparseMatrixLIL_set(&lil, i, j, -dWeight);
+                dSum += dWeight;
+            }
+            GISparseMatrixLIL_set(&lil, i, i, dSum+1e-2);
+        }
+    }
+    GISparseMatrixCSR_construct(mat, &lil);
+    GISparseMatrixLIL_destruct(&lil);
+    GISparseMatrixCSR_prepare_jacobi(mat);
+}
+
+// multiply and count values, indices, row starts and both vectors
+static void count_ax(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+    const GISparseMatrixCSR *mat = (const GISparseMatrixCSR*)A;
+    GISparseMatrixCSR_ax2(A, x, y);
+    g_MatrixBytes += 12.0*mat->nnz + 4.0*(mat->n+1) + 16.0*mat->n +
+        (mat->symmetric ? 32.0 : 16.0)*mat->n;
+}
+
+// precondition and count inverted diagonal and both vectors
+static void count_pc(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+    GISparseMatrix_pc_jacobi2(A, x, y);
+    g_MatrixBytes += 40.0 * A->n;
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *names[] = { "CG2", "BiCGStab2", "GMRES2" };
+    GIuint uiMaxSize = (argc > 1) ? atoi(argv[1]) : 512;
+    GIuint uiIterations = (argc > 2) ? atoi(argv[2]) : 60;
+    GIuint i, s, size, N, iterations[2];
+    GIdouble *pB, *pX;
+
+    GISmallObjectAllocator_construct(&g_SmallObjAlloc);
+    printf("%d iterations, Jacobi preconditioner, GMRES restart %d\n",
+        uiIterations, GMRES_RESTART);
+    printf("solver          rows    ms/iter  matrix MB/iter  vector MB/iter    GB/s\n");
+    srand(1);
+    for(size=256; size<=uiMaxSize; size<<=1)
+    {
+        N = size * size;
+        pB = (GIdouble*)GI_MALLOC_ALIGNED(GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+        pX = (GIdouble*)GI_MALLOC_ALIGNED(GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+        for(i=0; i<2*N; ++i)
+            pB[i] = (GIdouble)rand() / (GIdouble)RAND_MAX;
+        for(s=0; s<3; ++s)
+        {
+            GISparseMatrixCSR mat;
+            GIuint uiSteps;
+            double dTime, dPasses;
+
+            // zero threshold runs solvers for all iterations
+            create_matrix(&mat, size, !s);
+            memset(pX, 0, 2*N*sizeof(GIdouble));
+            g_MatrixBytes = 0.0;
+            dTime = GITimer_seconds();
+            if(s == 0)
+            {
+                uiSteps = GISolver_cg2((GISparseMatrix*)&mat, pB, pX, count_ax,
+                    count_pc, 0.0, uiIterations, iterations, NULL);
+                dPasses = 13.0;
+            }
+            else if(s == 1)
+            {
+                uiSteps = GISolver_bicgstab2((GISparseMatrix*)&mat, pB, pX, count_ax,
+                    count_pc, 0.0, uiIterations, iterations, NULL);
+                dPasses = 28.0;
+            }
+            else
+            {
+                GIuint uiCycles = (uiIterations+GMRES_RESTART-1) / GMRES_RESTART;
+                uiSteps = GISolver_gmres2((GISparseMatrix*)&mat, pB, pX, count_ax,
+                    count_pc, 0.0, (uiCycles<<8)|GMRES_RESTART, iterations, NULL);
+                dPasses = 0.5 * (3.0*(GMRES_RESTART+1) + 20.0);
+            }
+            dTime = GITimer_seconds() - dTime;
+            printf("%-10s %9d %10.2f %15.1f %15.1f %7.2f\n", names[s], N,
+                1e3*dTime/uiSteps, 1e-6*g_MatrixBytes/uiSteps, 1e-6*dPasses*16.0*N,
+                1e-9*(g_MatrixBytes+dPasses*16.0*N*uiSteps)/dTime);
+            GISparseMatrixCSR_destruct(&mat);
+        }
+        GI_FREE_ALIGNED(pB);
+        GI_FREE_ALIGNED(pX);
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ *  bench_tune: Benchmark of autotuned solver selection
+ *  Copyright (C) 2008-2011  Christian Rau
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  If you modify this software, you should include a notice giving the
+ *  name of the person performing the modification, the date of modification,
+ *  and the reason for such modification.
+ *
+ *  Contact: Christian Rau
+ *
+ *     rauy@users.sourceforge.net
+ */
+
+/*
+ * An octahedron is cut into 24 patches by Catmull-Clark subdivision, which
+ * are parameterized by stretch minimization several times in a row, each
+ * time like a new job on a similar mesh. This is done once with the default
+ * solvers and once with autotuning, in a new context each, so the first job
+ * of the latter includes the timing of all candidates and the later ones
+ * use the configurations cached in the context. Patches are parameterized
+ * one after another to not disturb the measurements. Times are seconds.
+ *
+ * usage: bench_tune [subdivisions] [jobs]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <GI/gi.h>
+
+#include "gi_thread.h"
+
+static GIfloat g_Vertices[] = {
+    1.0f, 0.0f, 0.0f,  -1.0f, 0.0f, 0.0f,  0.0f, 1.0f, 0.0f,
+    0.0f, -1.0f, 0.0f,  0.0f, 0.0f, 1.0f,  0.0f, 0.0f, -1.0f };
+
+static const GIuint g_Indices[] = {
+    0, 2, 4,  2, 1, 4,  1, 3, 4,  3, 0, 4,
+    2, 0, 5,  1, 2, 5,  3, 1, 5,  0, 3, 5 };
+
+int main(int argc, char *argv[])
+{
+    static const char *names[] = { "default", "autotune" };
+    GIuint uiSubdivisions = (argc > 1) ? atoi(argv[1]) : 7;
+    GIuint uiJobs = (argc > 2) ? atoi(argv[2]) : 4;
+    GIuint t, j;
+
+    printf("%d subdivisions, stretch minimizing, times in s\n", uiSubdivisions);
+    printf("solvers   job  patches   rows     total    setup    solve   iter  stretch\n");
+    for(t=0; t<2; ++t)
+    {
+        GIcontext pContext = giCreateContext();
+        GIuint uiMesh;
+        GIint iPatches, iRows, iIterations;
+
+        // cut mesh into patches
+        giMakeCurrent(pContext);
+        giDisable(GI_MULTITHREADING);
+        giBindAttrib(GI_POSITION_ATTRIB, 0);
+        giAttribPointer(0, 3, GI_FALSE, 0, g_Vertices);
+        giEnableAttribArray(0);
+        uiMesh = giGenMesh();
+        giBindMesh(uiMesh);
+        giIndexedMesh(0, 5, 24, g_Indices);
+        giCutterParameteri(GI_CUTTER, GI_CATMULL_CLARK_SUBDIVISION);
+        giCutterParameteri(GI_SUBDIVISION_ITERATIONS, uiSubdivisions);
+        giCut();
+        giGetMeshiv(GI_PATCH_COUNT, &iPatches);
+        giParameterizerParameteri(GI_PARAMETERIZER, GI_STRETCH_MINIMIZING);
+        giParameterizerParameterb(GI_AUTOTUNE_SOLVER, t ? GI_TRUE : GI_FALSE);
+
+        // statistics of mesh sum up those of its patches
+        for(j=0; j<uiJobs; ++j)
+        {
+            GIfloat fSetup, fSolve, fStretch;
+            double dTime = GITimer_seconds();
+            giParameterize();
+            dTime = GITimer_seconds() - dTime;
+            giGetMeshiv(GI_SOLVER_ROWS, &iRows);
+            giGetMeshiv(GI_SOLVER_ITERATIONS, &iIterations);
+            giGetMeshfv(GI_PRECONDITIONER_TIME, &fSetup);
+            giGetMeshfv(GI_SOLVER_TIME, &fSolve);
+            giComputeParamStretch(GI_RMS_GEOMETRIC_STRETCH);
+            giGetMeshfv(GI_RMS_GEOMETRIC_STRETCH, &fStretch);
+            printf("%-8s %4d %8d %6d %9.3f %8.3f %8.3f %6d %8.5f\n", names[t], j+1,
+                iPatches, iRows, dTime, fSetup, fSolve, iIterations, fStretch);
+        }
+        giDeleteMesh(uiMesh);
+        giDestroyContext(pContext);
+    }
+    return 0;
+}
@@ -89,6 +89,9 @@ typedef void (GICALLBACK *GIsamplercb)(GIdouble*, const GIdouble*, GIvoid*);
 /** Error callback. */
 typedef void (GICALLBACK *GIerrorcb)(GIenum, GIvoid*);
 
+/** Solver residual callback. */
+typedef void (GICALLBACK *GIresidualcb)(GIint, GIuint, const GIdouble*, GIvoid*);
+
 
 /*************************************************************************/
 /* Constants */
@@ -134,6 +137,7 @@ typedef void (GICALLBACK *GIerrorcb)(GIenum, GIvoid*);
 #define GI_IMAGE_BINDING                 0x0203		/**< Current bound image for active texture unit. */
 #define GI_SAMPLED_ATTRIB_COUNT          0x0204		/**< Number of sampled attributes. */
 #define GI_SAMPLED_ATTRIBS               0x0205		/**< Flags indicating sampled attributes. */
+#define GI_THREAD_COUNT                  0x0206		/**< Number of threads used for multithreading. */
 #define GI_EXACT_MAPPING_SUBSET_COUNT    0x0210		/**< Number of elements in exact mapping subset. */
 #define GI_PARAM_CORNER_SUBSET_COUNT     0x0211		/**< Number of elements in corner subset. */
 #define GI_EXACT_MAPPING_SUBSET_SORTED   0x0220		/**< Sorted flag for exact mapping subset. */
@@ -178,6 +182,13 @@ typedef void (GICALLBACK *GIerrorcb)(GIenum, GIvoid*);
 #define GI_PARAM_STRETCH_METRIC          0x050D		/**< Metric of param stretch values. */
 #define GI_TOPOLOGICAL_SIDEBAND_LENGTH   0x050E		/**< Length of topological sideband. */
 #define GI_TOPOLOGICAL_SIDEBAND          0x050F		/**< Topological sideband (cut path information). */
+#define GI_SOLVER_ROWS                   0x0510		/**< Number of unknowns of last linear system. */
+#define GI_SOLVER_NONZEROS               0x0511		/**< Number of stored coefficients of last linear system. */
+#define GI_SOLVER_ITERATIONS             0x0512		/**< Solver iterations of last parameterization. */
+#define GI_SOLVER_RESIDUAL               0x0513		/**< Relative residual of last linear system (see giParameterizerResidualCallback). */
+#define GI_ASSEMBLY_TIME                 0x0514		/**< Seconds spent constructing linear systems. */
+#define GI_PRECONDITIONER_TIME           0x0515		/**< Seconds spent setting up preconditioners/factorizations. */
+#define GI_SOLVER_TIME                   0x0516		/**< Seconds spent solving linear systems. */
 /** \} */
 
 /** \name Per-mesh attribute state
@@ -215,6 +226,12 @@ typedef void (GICALLBACK *GIerrorcb)(GIenum, GIvoid*);
 #define GI_UNSYMMETRIC_SOLVER            0x0807		/**< Solver for unsymmetric systems. */
 #define GI_AREA_WEIGHT                   0x0808		/**< Theta parameter for combined energy. */
 #define GI_PARAM_SOURCE_ATTRIB           0x0809		/**< Attribute to use as parameter coords. */
+#define GI_SYMMETRIC_SOLVER              0x080A		/**< Solver for symmetric systems. */
+#define GI_PRECONDITIONER                0x080B		/**< Preconditioner for iterative solvers. */
+#define GI_PARAM_ORDERING                0x080C		/**< Ordering of interior params in linear systems. */
+#define GI_SOLVER_PRECISION              0x080D		/**< Precision of iterative solvers (GI_FLOAT for large systems). */
+#define GI_WARM_START                    0x080E		/**< Start solvers from previous parameterization. */
+#define GI_AUTOTUNE_SOLVER               0x080F		/**< Select solvers by measured convergence. */
 #define GI_FROM_ATTRIB                   0x0810		/**< Set attrib as parameter coordinates. */
 #define GI_TUTTE_BARYCENTRIC             0x0811		/**< Tutte's Barycentric parameterization. */
 #define GI_SHAPE_PRESERVING              0x0812		/**< Floater's Shape Preserving parameterization. */
@@ -226,8 +243,15 @@ typedef void (GICALLBACK *GIerrorcb)(GIenum, GIvoid*);
 #define GI_GIM                           0x0818		/**< Gu's original Geometry Image parameterization. */
 #define GI_SOLVER_BICGSTAB               0x0820		/**< BiCGStab solver. */
 #define GI_SOLVER_GMRES                  0x0821		/**< GMRES(m) solver. */
+#define GI_SOLVER_CG                     0x0822		/**< Conjugate gradient solver. */
+#define GI_SOLVER_LDLT                   0x0823		/**< Sparse direct LDL^T solver. */
+#define GI_PRECONDITIONER_ILU            0x0824		/**< Incomplete Cholesky/LU preconditioner. */
+#define GI_PRECONDITIONER_AMG            0x0825		/**< Algebraic multigrid preconditioner (symmetric systems). */
+#define GI_ORDERING_RCM                  0x0826		/**< Reverse Cuthill-McKee ordering. */
+#define GI_PRECONDITIONER_JACOBI         0x0827		/**< Jacobi (diagonal) preconditioner. */
+#define GI_PRECONDITIONER_SSOR           0x0828		/**< Symmetric successive overrelaxation preconditioner. */
 #define GI_PARAM_STARTED                 0x0830		/**< Callback for parameterization start. */
-#define GI_PARAM_CHANGED                 0x0831		/**< Callback for parameterization change. */
+#define GI_PARAM_CHANGED                 0x0831		/**< Callback for parameterization change (only once per patch when multithreaded, see giParameterizerCallback). */
 #define GI_PARAM_FINISHED                0x0832		/**< Callback for parameterization end. */
 /** \} */
 
@@ -349,6 +373,7 @@ GIAPI void          GIAPIENTRY giGetFloatv(GIenum pname, GIfloat *params);
 GIAPI void          GIAPIENTRY giEnable(GIenum pname);
 GIAPI void          GIAPIENTRY giDisable(GIenum pname);
 GIAPI GIboolean     GIAPIENTRY giIsEnabled(GIenum pname);
+GIAPI void          GIAPIENTRY giThreadCount(GIuint count);
 GIAPI void          GIAPIENTRY giVertexSubset(GIenum subset, GIsizei count, GIboolean sorted, const GIuint *indices);
 GIAPI void          GIAPIENTRY giGetPointerv(GIenum pname, GIvoid **params);
 GIAPI void          GIAPIENTRY giAttribImage(GIuint attrib, GIuint image);
@@ -400,6 +425,7 @@ GIAPI void          GIAPIENTRY giParameterizerParameterb(GIenum pname, GIboolean
 GIAPI void          GIAPIENTRY giParameterizerParameteri(GIenum pname, GIint param);
 GIAPI void          GIAPIENTRY giParameterizerParameterf(GIenum pname, GIfloat param);
 GIAPI void          GIAPIENTRY giParameterizerCallback(GIenum which, GIparamcb fn, GIvoid *data);
+GIAPI void          GIAPIENTRY giParameterizerResidualCallback(GIresidualcb fn, GIvoid *data);
 GIAPI void          GIAPIENTRY giParameterize();
 /** \} */
 
@@ -46,6 +46,337 @@
 	#endif
 #endif
 
+#ifndef OPENGI_AVX
+	#if (defined(__x86_64__) && defined(__GNUC__)) || (defined(_M_X64) && _MSC_VER >= 1910)
+		#define OPENGI_AVX			1
+	#else
+		#define OPENGI_AVX			0
+	#endif
+#endif
+#if OPENGI_AVX
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#include <immintrin.h>
+		#define GI_TARGET_AVX2
+		#define GI_TARGET_AVX512
+	#else
+		#include <immintrin.h>
+		#include <cpuid.h>
+		#define GI_TARGET_AVX2		__attribute__((target("avx2,fma")))
+		#define GI_TARGET_AVX512	__attribute__((target("avx512f")))
+	#endif
+#endif
+
+/** \internal
+ *  \brief Vector kernels for SSE or generic code.
+ *  \ingroup numerics
+ */
+#define GI_ISA_DEFAULT				0
+
+/** \internal
+ *  \brief Vector kernels for AVX2 and FMA.
+ *  \ingroup numerics
+ */
+#define GI_ISA_AVX2					1
+
+/** \internal
+ *  \brief Vector kernels for AVX-512.
+ *  \ingroup numerics
+ */
+#define GI_ISA_AVX512				2
+
+
+#if OPENGI_AVX
+/** \internal
+ *  \brief Instruction set of vector kernels (negative if not yet detected).
+ *  \ingroup numerics
+ */
+static volatile int g_iISA = -1;
+
+/** \internal
+ *  \brief Detect best instruction set supported by processor and OS.
+ *  \details The result is computed on first use and cached.
+ *  \return GI_ISA_DEFAULT, GI_ISA_AVX2 or GI_ISA_AVX512
+ *  \ingroup numerics
+ */
+static int cpu_isa(void)
+{
+	if(g_iISA < 0)
+	{
+		unsigned int regs1[4] = { 0, 0, 0, 0 }, regs7[4] = { 0, 0, 0, 0 };
+		unsigned int uiXCR0 = 0;
+		int iISA = GI_ISA_DEFAULT;
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if(info[0] >= 7)
+		{
+			__cpuid((int*)regs1, 1);
+			__cpuidex((int*)regs7, 7, 0);
+		}
+		if(regs1[2] & (1<<27))
+			uiXCR0 = (unsigned int)_xgetbv(0);
+#else
+		if(__get_cpuid_max(0, NULL) >= 7)
+		{
+			__cpuid(1, regs1[0], regs1[1], regs1[2], regs1[3]);
+			__cpuid_count(7, 0, regs7[0], regs7[1], regs7[2], regs7[3]);
+		}
+		if(regs1[2] & (1<<27))
+		{
+			unsigned int uiHigh;
+			__asm__ __volatile__("xgetbv" : "=a"(uiXCR0), "=d"(uiHigh) : "c"(0));
+		}
+#endif
+
+		/* need FMA, AVX and AVX2 with YMM state enabled by OS */
+		if((regs1[2] & (1<<12)) && (regs1[2] & (1<<28)) && 
+		   (regs7[1] & (1<<5)) && (uiXCR0 & 0x06) == 0x06)
+		{
+			iISA = GI_ISA_AVX2;
+
+			/* need AVX-512F with opmask and ZMM state enabled by OS */
+			if((regs7[1] & (1<<16)) && (uiXCR0 & 0xE6) == 0xE6)
+				iISA = GI_ISA_AVX512;
+		}
+		g_iISA = iISA;
+	}
+	return g_iISA;
+}
+
+/** \internal
+ *  \brief Mask of remaining elements for AVX-512 kernels.
+ *  \param n number of remaining elements
+ *  \return mask of min(n,8) lowest elements
+ *  \ingroup numerics
+ */
+#define GI_TAIL_MASK(n)			((__mmask8)((n)>=8 ? 0xFF : ((1<<(n))-1)))
+
+/** \internal
+ *  \brief Dot product of contiguous vectors with AVX2.
+ *  \param n number of elements
+ *  \param x first vector
+ *  \param y second vector
+ *  \return dot product <\a x,\a y>
+ *  \ingroup numerics
+ */
+static GI_TARGET_AVX2 double ddot_avx2(int n, const double *x, const double *y)
+{
+	__m256d YMM0 = _mm256_setzero_pd(), YMM1 = _mm256_setzero_pd();
+	__m128d XMM0;
+	double temp;
+	int i = 0, m = n & ~7;
+	for(; i<m; i+=8)
+	{
+		YMM0 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i), _mm256_loadu_pd(y+i), YMM0);
+		YMM1 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i+4), _mm256_loadu_pd(y+i+4), YMM1);
+	}
+	YMM0 = _mm256_add_pd(YMM0, YMM1);
+	XMM0 = _mm_add_pd(_mm256_castpd256_pd128(YMM0), _mm256_extractf128_pd(YMM0, 1));
+	XMM0 = _mm_add_sd(XMM0, _mm_unpackhi_pd(XMM0, XMM0));
+	temp = _mm_cvtsd_f64(XMM0);
+	for(; i<n; ++i)
+		temp += x[i] * y[i];
+	return temp;
+}
+
+/** \internal
+ *  \brief Add scaled contiguous vector with AVX2 (y = a*x + y).
+ *  \param n number of elements
+ *  \param a scale factor
+ *  \param x first vector
+ *  \param y second vector
+ *  \ingroup numerics
+ */
+static GI_TARGET_AVX2 void daxpy_avx2(int n, double a, const double *x, double *y)
+{
+	__m256d YMM7 = _mm256_set1_pd(a);
+	int i = 0, m = n & ~7;
+	for(; i<m; i+=8)
+	{
+		_mm256_storeu_pd(y+i, _mm256_fmadd_pd(YMM7, 
+			_mm256_loadu_pd(x+i), _mm256_loadu_pd(y+i)));
+		_mm256_storeu_pd(y+i+4, _mm256_fmadd_pd(YMM7, 
+			_mm256_loadu_pd(x+i+4), _mm256_loadu_pd(y+i+4)));
+	}
+	for(; i<n; ++i)
+		y[i] += a * x[i];
+}
+
+/** \internal
+ *  \brief Scale contiguous vector with AVX2.
+ *  \param n number of elements
+ *  \param a scale factor
+ *  \param x vector to scale
+ *  \ingroup numerics
+ */
+static GI_TARGET_AVX2 void dscal_avx2(int n, double a, double *x)
+{
+	__m256d YMM7 = _mm256_set1_pd(a);
+	int i = 0, m = n & ~7;
+	for(; i<m; i+=8)
+	{
+		_mm256_storeu_pd(x+i, _mm256_mul_pd(_mm256_loadu_pd(x+i), YMM7));
+		_mm256_storeu_pd(x+i+4, _mm256_mul_pd(_mm256_loadu_pd(x+i+4), YMM7));
+	}
+	for(; i<n; ++i)
+		x[i] *= a;
+}
+
+/** \internal
+ *  \brief Copy contiguous vector with AVX2.
+ *  \param n number of elements
+ *  \param x source vector
+ *  \param y destination vector
+ *  \ingroup numerics
+ */
+static GI_TARGET_AVX2 void dcopy_avx2(int n, const double *x, double *y)
+{
+	int i = 0, m = n & ~15;
+	for(; i<m; i+=16)
+	{
+		__m256d YMM0 = _mm256_loadu_pd(x+i);
+		__m256d YMM1 = _mm256_loadu_pd(x+i+4);
+		__m256d YMM2 = _mm256_loadu_pd(x+i+8);
+		__m256d YMM3 = _mm256_loadu_pd(x+i+12);
+		_mm256_storeu_pd(y+i, YMM0);
+		_mm256_storeu_pd(y+i+4, YMM1);
+		_mm256_storeu_pd(y+i+8, YMM2);
+		_mm256_storeu_pd(y+i+12, YMM3);
+	}
+	for(; i<n; ++i)
+		y[i] = x[i];
+}
+
+/** \internal
+ *  \brief Dot product of contiguous vectors with AVX-512.
+ *  \param n number of elements
+ *  \param x first vector
+ *  \param y second vector
+ *  \return dot product <\a x,\a y>
+ *  \ingroup numerics
+ */
+static GI_TARGET_AVX512 double ddot_avx512(int n, const double *x, const double *y)
+{
+	__m512d ZMM0 = _mm512_setzero_pd(), ZMM1 = _mm512_setzero_pd();
+	int i = 0, m = n & ~15;
+	for(; i<m; i+=16)
+	{
+		ZMM0 = _mm512_fmadd_pd(_mm512_loadu_pd(x+i), _mm512_loadu_pd(y+i), ZMM0);
+		ZMM1 = _mm512_fmadd_pd(_mm512_loadu_pd(x+i+8), _mm512_loadu_pd(y+i+8), ZMM1);
+	}
+	for(; i<n; i+=8)
+	{
+		__mmask8 mask = GI_TAIL_MASK(n-i);
+		ZMM0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, x+i), 
+			_mm512_maskz_loadu_pd(mask, y+i), ZMM0);
+	}
+	return _mm512_reduce_add_pd(_mm512_add_pd(ZMM0, ZMM1));
+}
+
+/** \internal
+ *  \brief Add scaled contiguous vector with AVX-512 (y = a*x + y).
+ *  \param n number of elements
+ *  \param a scale factor
+ *  \param x first vector
+ *  \param y second vector
+ *  \ingroup numerics
+ */
+static GI_TARGET_AVX512 void daxpy_avx512(int n, double a, const double *x, double *y)
+{
+	__m512d ZMM7 = _mm512_set1_pd(a);
+	int i = 0, m = n & ~15;
+	for(; i<m; i+=16)
+	{
+		_mm512_storeu_pd(y+i, _mm512_fmadd_pd(ZMM7, 
+			_mm512_loadu_pd(x+i), _mm512_loadu_pd(y+i)));
+		_mm512_storeu_pd(y+i+8, _mm512_fmadd_pd(ZMM7, 
+			_mm512_loadu_pd(x+i+8), _mm512_loadu_pd(y+i+8)));
+	}
+	for(; i<n; i+=8)
+	{
+		__mmask8 mask = GI_TAIL_MASK(n-i);
+		_mm512_mask_storeu_pd(y+i, mask, _mm512_fmadd_pd(ZMM7, 
+			_mm512_maskz_loadu_pd(mask, x+i), _mm512_maskz_loadu_pd(mask, y+i)));
+	}
+}
+
+/** \internal
+ *  \brief Scale contiguous vector with AVX-512.
+ *  \param n number of elements
+ *  \param a scale factor
+ *  \param x vector to scale
+ *  \ingroup numerics
+ */
+static GI_TARGET_AVX512 void dscal_avx512(int n, double a, double *x)
+{
+	__m512d ZMM7 = _mm512_set1_pd(a);
+	int i = 0, m = n & ~15;
+	for(; i<m; i+=16)
+	{
+		_mm512_storeu_pd(x+i, _mm512_mul_pd(_mm512_loadu_pd(x+i), ZMM7));
+		_mm512_storeu_pd(x+i+8, _mm512_mul_pd(_mm512_loadu_pd(x+i+8), ZMM7));
+	}
+	for(; i<n; i+=8)
+	{
+		__mmask8 mask = GI_TAIL_MASK(n-i);
+		_mm512_mask_storeu_pd(x+i, mask, 
+			_mm512_mul_pd(_mm512_maskz_loadu_pd(mask, x+i), ZMM7));
+	}
+}
+
+/** \internal
+ *  \brief Copy contiguous vector with AVX-512.
+ *  \param n number of elements
+ *  \param x source vector
+ *  \param y destination vector
+ *  \ingroup numerics
+ */
+static GI_TARGET_AVX512 void dcopy_avx512(int n, const double *x, double *y)
+{
+	int i = 0, m = n & ~31;
+	for(; i<m; i+=32)
+	{
+		__m512d ZMM0 = _mm512_loadu_pd(x+i);
+		__m512d ZMM1 = _mm512_loadu_pd(x+i+8);
+		__m512d ZMM2 = _mm512_loadu_pd(x+i+16);
+		__m512d ZMM3 = _mm512_loadu_pd(x+i+24);
+		_mm512_storeu_pd(y+i, ZMM0);
+		_mm512_storeu_pd(y+i+8, ZMM1);
+		_mm512_storeu_pd(y+i+16, ZMM2);
+		_mm512_storeu_pd(y+i+24, ZMM3);
+	}
+	for(; i<n; i+=8)
+	{
+		__mmask8 mask = GI_TAIL_MASK(n-i);
+		_mm512_mask_storeu_pd(y+i, mask, _mm512_maskz_loadu_pd(mask, x+i));
+	}
+}
+#endif
+
+
+/** \internal
+ *  \brief Vector kernels used by unit stride routines.
+ *  \return name of instruction set of kernels
+ *  \ingroup numerics
+ */
+const char* blas_kernels(void)
+{
+#if OPENGI_AVX
+	switch(cpu_isa())
+	{
+	case GI_ISA_AVX512:
+		return "AVX-512";
+	case GI_ISA_AVX2:
+		return "AVX2/FMA";
+	}
+#endif
+#if OPENGI_SSE >= 2
+	return "SSE2";
+#else
+	return "generic";
+#endif
+}
 
 /** \internal
  *  \brief Compute Givens rotation.
@@ -252,6 +583,17 @@ void dscal(int n, double a, double *x, int incx)
 	else if(incx == 1)
 	{
 		int m = n & ~7;
+#if OPENGI_AVX
+		switch(cpu_isa())
+		{
+		case GI_ISA_AVX512:
+			dscal_avx512(n, a, x);
+			return;
+		case GI_ISA_AVX2:
+			dscal_avx2(n, a, x);
+			return;
+		}
+#endif
 #if OPENGI_SSE >= 2
 		__m128d XMM7 = _mm_set1_pd(a);
 		for(; i<m; i+=8)
@@ -315,6 +657,17 @@ void dcopy(int n, const double *x, int incx, double *y, int incy)
 		return;
 	else if(incx == 1 && incy == 1)
 	{
+#if OPENGI_AVX
+		switch(cpu_isa())
+		{
+		case GI_ISA_AVX512:
+			dcopy_avx512(n, x, y);
+			return;
+		case GI_ISA_AVX2:
+			dcopy_avx2(n, x, y);
+			return;
+		}
+#endif
 #if OPENGI_SSE >= 2
 		int m = n & ~15;
 		for(; i<m; i+=16)
@@ -386,6 +739,17 @@ void daxpy(int n, double a, const double *x, int incx, double *y, int incy)
 	else if(incx == 1 && incy == 1)
 	{
 		int m = n & ~3;
+#if OPENGI_AVX
+		switch(cpu_isa())
+		{
+		case GI_ISA_AVX512:
+			daxpy_avx512(n, a, x, y);
+			return;
+		case GI_ISA_AVX2:
+			daxpy_avx2(n, a, x, y);
+			return;
+		}
+#endif
 #if OPENGI_SSE >= 2
 		__m128d XMM7 = _mm_set1_pd(a);
 		for(; i<m; i+=4)
@@ -448,6 +812,15 @@ double ddot(int n, const double *x, int incx, const double *y, int incy)
 	else if(incx == 1 && incy == 1)
 	{
 		int m = n & ~3;
+#if OPENGI_AVX
+		switch(cpu_isa())
+		{
+		case GI_ISA_AVX512:
+			return ddot_avx512(n, x, y);
+		case GI_ISA_AVX2:
+			return ddot_avx2(n, x, y);
+		}
+#endif
 #if OPENGI_SSE >= 2
 		double temp;
 		__m128d XMM0 = _mm_setzero_pd();
@@ -516,6 +889,15 @@ double dnrm2(int n, const double *x, int incx)
 	else if(incx == 1)
 	{
 		int m = n & ~7;
+#if OPENGI_AVX
+		switch(cpu_isa())
+		{
+		case GI_ISA_AVX512:
+			return sqrt(ddot_avx512(n, x, x));
+		case GI_ISA_AVX2:
+			return sqrt(ddot_avx2(n, x, x));
+		}
+#endif
 #if OPENGI_SSE >= 2
 		double temp;
 		__m128d XMM0 = _mm_setzero_pd();
@@ -732,6 +1114,9 @@ void dgemv(char trans, int m, int n, double alpha, const double *A, int lda,
 		   const double *x, int incx, double beta, double *y, int incy)
 {
 	int i, ix, iy, j, jx, jy, ij, kx, ky, lenx, leny;
+#if OPENGI_AVX
+	int iISA = cpu_isa();
+#endif
 	if(m <= 0 || n <= 0 || lda < m || !incx || !incy || 
 	   (alpha == 0.0 && beta == 1.0) || 
 	   (trans != 'N' && trans != 'T' && trans != 'C'))
@@ -783,6 +1168,18 @@ void dgemv(char trans, int m, int n, double alpha, const double *A, int lda,
 				if(x[jx] != 0.0)
 				{
 					register double temp = alpha * x[jx];
+#if OPENGI_AVX
+					if(iISA == GI_ISA_AVX512)
+					{
+						daxpy_avx512(m, temp, A+lda*j, y);
+						continue;
+					}
+					else if(iISA == GI_ISA_AVX2)
+					{
+						daxpy_avx2(m, temp, A+lda*j, y);
+						continue;
+					}
+#endif
 					for(i=0,ij=lda*j; i<m; ++i,++ij)
 						y[i] += temp * A[ij];
 				}
@@ -808,6 +1205,13 @@ void dgemv(char trans, int m, int n, double alpha, const double *A, int lda,
 			for(j=0,jy=ky; j<n; ++j,jy+=incy)
 			{
 				register double temp = 0.0;
+#if OPENGI_AVX
+				if(iISA == GI_ISA_AVX512)
+					temp = ddot_avx512(m, A+lda*j, x);
+				else if(iISA == GI_ISA_AVX2)
+					temp = ddot_avx2(m, A+lda*j, x);
+				else
+#endif
 				for(i=0,ij=lda*j; i<m; ++i,++ij)
 					temp += A[ij] * x[i];
 				y[j] += alpha * temp;
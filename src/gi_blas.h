@@ -40,6 +40,8 @@
 /*************************************************************************/
 /* Functions */
 
+const char* blas_kernels(void);
+
 /** \name Level 1 BLAS routines
  *  \{
  */
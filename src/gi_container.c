@@ -36,6 +36,49 @@
 #include <stdlib.h>
 #include <string.h>
 #include <float.h>
+#include <limits.h>
+
+#define GI_HASH_MAX_LOAD			0.9f
+#define GI_HASH_SLOT_SIZE(k)		((sizeof(GIHashSlot)+(k)+sizeof(GIvoid*)-1)&~(sizeof(GIvoid*)-1))
+#define GI_HASH_SLOT(h,i)			((GIHashSlot*)((h)->data+(GIusize)(i)*(h)->slot_size))
+#define GI_INDEXED_HEAP_ARITY		4
+#define GI_QUEUE_MIN_CAPACITY		16
+
+/* key operations shared by generic and specialized hashes */
+#define GI_HASH_UINT(k)				(*(const GIuint*)(k))
+#define GI_EQUAL_UINT(k,l)			(*(const GIuint*)(k) == *(const GIuint*)(l))
+#define GI_COPY_UINT(d,s)			(*(GIuint*)(d) = *(const GIuint*)(s))
+#define GI_HASH_POINTER(k)			(*(const GIuint*)(k) >> 2)
+#define GI_EQUAL_POINTER(k,l)		(*(const GIvoid**)(k) == *(const GIvoid**)(l))
+#define GI_COPY_POINTER(d,s)		(*(GIvoid**)(d) = *(GIvoid**)(s))
+#define GI_HASH_VEC3F(k)			(((const GIuint*)(k))[0] ^ ((const GIuint*)(k))[1] ^ ((const GIuint*)(k))[2])
+#define GI_EQUAL_VEC3F(k,l)			GI_VEC3_EQUAL((const GIfloat*)(k), (const GIfloat*)(l))
+#define GI_COPY_VEC3F(d,s)			GI_VEC3_COPY((GIfloat*)(d), (const GIfloat*)(s))
+#define GI_HASH_UINTPAIR(k)			(((const GIUIntPair*)(k))->first + ((const GIUIntPair*)(k))->second)
+#define GI_EQUAL_UINTPAIR(k,l)		((((const GIUIntPair*)(k))->first == ((const GIUIntPair*)(l))->first && \
+										((const GIUIntPair*)(k))->second == ((const GIUIntPair*)(l))->second) || \
+										(((const GIUIntPair*)(k))->first == ((const GIUIntPair*)(l))->second && \
+										((const GIUIntPair*)(k))->second == ((const GIUIntPair*)(l))->first))
+#define GI_COPY_UINTPAIR(d,s)		(*(GIUIntPair*)(d) = *(const GIUIntPair*)(s))
+#define GI_HASH_BLOB(k)				blob_hash(k)
+#define GI_EQUAL_BLOB(k,l)			(!memcmp((const GIuint*)(k)+1, (const GIuint*)(l)+1, *(const GIuint*)(k)))
+#define GI_COPY_BLOB(d,s)			memcpy(d, s, *(const GIuint*)(s)+sizeof(GIuint))
+
+/** \internal
+ *  \brief Compute full hash value of packed blob.
+ *  \param b blob consisting of byte count followed by data
+ *  \return hash value
+ *  \ingroup container
+ */
+static GIuint blob_hash(const GIvoid *b)
+{
+    GIuint i = 0;
+    const GIuint *p = (const GIuint*)b;
+    p += *p / sizeof(GIuint);
+    for(; p!=b; --p)
+        i ^= *p;
+    return i;
+}
 
 /** \internal
  *  \brief nearest greater prime numbers for powers of two.
@@ -109,16 +152,20 @@ void GIHash_construct(GIHash *hash, GIuint size, GIfloat load, GIuint key_size,
                            GIhashfunc hash_func, GIcompfunc comp_func, 
                            GIcopyfunc copy_func)
 {
+    /* probe sequences need free slots */
     if(load <= 0.0f)
         load = 0.8f;
+    else if(load > GI_HASH_MAX_LOAD)
+        load = GI_HASH_MAX_LOAD;
 
     /* initialize hash */
     hash->key_size = key_size;
+    hash->slot_size = GI_HASH_SLOT_SIZE(key_size);
     hash->size = next_prime(size);
     hash->threshold = load * (GIfloat)hash->size;
     hash->count = 0;
     hash->load_factor = load;
-    hash->data = (GIHashNode**)GI_CALLOC_ARRAY(hash->size, sizeof(GIHashNode*));
+    hash->data = (GIubyte*)GI_CALLOC_ARRAY(hash->size, hash->slot_size);
     hash->hash = hash_func;
     hash->comp = comp_func;
     hash->copy = copy_func;
@@ -141,35 +188,98 @@ void GIHash_destruct(GIHash *hash, GIuint value_size)
 
 /** \internal
  *  \brief Resize hash.
+ *  \details Slots are moved using their stored hash values, 
+ *  so keys are neither rehashed nor copied with the copy function.
  *  \param hash hash to resize
  *  \param size new size
  *  \ingroup container
  */
 void GIHash_resize(GIHash *hash, GIuint size)
 {
-    GIHashNode **pData = hash->data, *pTemp;
-    GIuint i, uiOldSize = hash->size;
+    GIubyte *pData = hash->data;
+    GIHashSlot *pSlot, *pNew;
+    GIuint i, j, uiOldSize = hash->size;
 
     /* resize hash */
     hash->size = size;
     hash->threshold = hash->load_factor * (GIfloat)hash->size;
-    hash->count = 0;
-    hash->data = (GIHashNode**)GI_CALLOC_ARRAY(hash->size, sizeof(GIHashNode*));
+    hash->data = (GIubyte*)GI_CALLOC_ARRAY(hash->size, hash->slot_size);
 
-    /* copy and free data */
+    /* move slots to new positions */
     for(i=0; i<uiOldSize; ++i)
     {
-        while(pData[i])
-        {
-            pTemp = pData[i];
-            pData[i] = pTemp->next;
-            GIHash_insert(hash, pTemp+1, pTemp->value);
-            GI_FREE_SINGLE(pTemp, sizeof(GIHashNode)+hash->key_size);
-        }
+        pSlot = (GIHashSlot*)(pData+(GIusize)i*hash->slot_size);
+        if(!pSlot->used)
+            continue;
+        for(j=pSlot->hash%size; (pNew=GI_HASH_SLOT(hash, j))->used; j=(j+1==size) ? 0 : (j+1));
+        memcpy(pNew, pSlot, hash->slot_size);
     }
     GI_FREE_ARRAY(pData);
 }
 
+/** \internal
+ *  \brief Occupy free slot found by a probe.
+ *  \details Grows the hash if neccessary and searches the free slot again. 
+ *  The key has to be copied into the returned slot by the caller.
+ *  \param hash hash to insert into
+ *  \param slot free slot at end of probe sequence
+ *  \param key_hash full hash value of key
+ *  \param value item to insert
+ *  \return slot to copy key into
+ *  \ingroup container
+ */
+static GIHashSlot* GIHash_occupy(GIHash *hash, GIHashSlot *slot, 
+                                 GIuint key_hash, GIvoid *value)
+{
+    GIuint i;
+
+    /* grow if neccessary and find free slot again */
+    if(hash->count+1 >= hash->threshold)
+    {
+        GIHash_resize(hash, next_prime(hash->size+1));
+        for(i=key_hash%hash->size; (slot=GI_HASH_SLOT(hash, i))->used; 
+            i=(i+1==hash->size) ? 0 : (i+1));
+    }
+
+    /* fill slot */
+    slot->value = value;
+    slot->hash = key_hash;
+    slot->used = 1;
+    ++hash->count;
+    return slot;
+}
+
+/** \internal
+ *  \brief Empty slot of hash.
+ *  \details Following items of the probe sequence are shifted back, 
+ *  so no deletion markers are needed.
+ *  \param hash hash to remove from
+ *  \param index position of slot to empty
+ *  \return removed item
+ *  \ingroup container
+ */
+static GIvoid* GIHash_erase(GIHash *hash, GIuint index)
+{
+    GIuint i = index, j, k;
+    GIHashSlot *pSlot = GI_HASH_SLOT(hash, i), *pNext;
+    GIvoid *pValue = pSlot->value;
+
+    /* close gap by moving back items whose home is not between gap and them */
+    for(j=(i+1==hash->size) ? 0 : (i+1); (pNext=GI_HASH_SLOT(hash, j))->used; 
+        j=(j+1==hash->size) ? 0 : (j+1))
+    {
+        k = pNext->hash % hash->size;
+        if(i <= j ? (i < k && k <= j) : (i < k || k <= j))
+            continue;
+        memcpy(pSlot, pNext, hash->slot_size);
+        pSlot = pNext;
+        i = j;
+    }
+    pSlot->used = 0;
+    --hash->count;
+    return pValue;
+}
+
 /** \internal
  *  \brief Insert item into hash.
  *  \param hash hash to insert into
@@ -181,34 +291,26 @@ void GIHash_resize(GIHash *hash, GIuint size)
  */
 GIboolean GIHash_insert(GIHash *hash, const GIvoid *key, GIvoid *value)
 {
-    GIuint i;
-    GIHashNode *pItem;
+    GIuint i, uiHash;
+    GIHashSlot *pSlot;
     if(!hash->data)
         return GI_FALSE;
-    i = hash->hash(key, hash->size);
-    pItem = hash->data[i];
+    uiHash = hash->hash(key, UINT_MAX);
 
     /* allready in hash -> overwrite */
-    while(pItem)
+    for(i=uiHash%hash->size; (pSlot=GI_HASH_SLOT(hash, i))->used; 
+        i=(i+1==hash->size) ? 0 : (i+1))
     {
-        if((*hash->comp)(pItem+1, key))
+        if(pSlot->hash == uiHash && (*hash->comp)(pSlot+1, key))
         {
-            pItem->value = value;
+            pSlot->value = value;
             return GI_FALSE;
         }
-        pItem = pItem->next;
     }
 
-    /* create item and insert */
-    pItem = (GIHashNode*)GI_MALLOC_SINGLE(sizeof(GIHashNode)+hash->key_size);
-    (*hash->copy)(pItem+1, key);
-    pItem->value = value;
-    pItem->next = hash->data[i];
-    hash->data[i] = pItem;
-
-    /* grow if neccessary */
-    if(++hash->count >= hash->threshold)
-        GIHash_resize(hash, next_prime(hash->size+1));
+    /* fill slot */
+    pSlot = GIHash_occupy(hash, pSlot, uiHash, value);
+    (*hash->copy)(pSlot+1, key);
     return GI_TRUE;
 }
 
@@ -221,41 +323,17 @@ GIboolean GIHash_insert(GIHash *hash, const GIvoid *key, GIvoid *value)
  */
 GIvoid* GIHash_remove(GIHash *hash, const GIvoid *key)
 {
-    GIuint i;
-    GIHashNode *pItem, *pNext;
-    GIvoid *pValue;
+    GIuint i, uiHash;
+    GIHashSlot *pSlot;
     if(!hash->data)
         return NULL;
-    i = hash->hash(key, hash->size);
-    pItem = hash->data[i];
-    if(!pItem)
-        return NULL;
+    uiHash = hash->hash(key, UINT_MAX);
 
-    /* remove at front */
-    if((*hash->comp)(pItem+1, key))
-    {
-        hash->data[i] = pItem->next;
-        pValue = pItem->value;
-        GI_FREE_SINGLE(pItem, sizeof(GIHashNode)+hash->key_size);
-        --hash->count;
-        return pValue;
-    }
-
-    /* search item and remove */
-    pNext = pItem->next;
-    while(pNext && !(*hash->comp)(pNext+1, key))
-    {
-        pItem = pNext;
-        pNext = pNext->next;
-    }
-    if(pNext)
-    {
-        pItem->next = pNext->next;
-        pValue = pNext->value;
-        GI_FREE_SINGLE(pNext, sizeof(GIHashNode)+hash->key_size);
-        --hash->count;
-        return pValue;
-    }
+    /* search item */
+    for(i=uiHash%hash->size; (pSlot=GI_HASH_SLOT(hash, i))->used; 
+        i=(i+1==hash->size) ? 0 : (i+1))
+        if(pSlot->hash == uiHash && (*hash->comp)(pSlot+1, key))
+            return GIHash_erase(hash, i);
     return NULL;
 }
 
@@ -268,20 +346,19 @@ GIvoid* GIHash_remove(GIHash *hash, const GIvoid *key)
 void GIHash_clear(GIHash *hash, GIuint value_size)
 {
     GIuint i;
-    GIHashNode *pTemp;
+    GIHashSlot *pSlot;
     if(!hash->data)
         return;
 
     /* remove all items */
     for(i=0; i<hash->size && hash->count; ++i)
     {
-        while(hash->data[i])
+        pSlot = GI_HASH_SLOT(hash, i);
+        if(pSlot->used)
         {
-            pTemp = hash->data[i];
-            hash->data[i] = hash->data[i]->next;
             if(value_size)
-                GI_FREE_SINGLE(pTemp->value, value_size);
-            GI_FREE_SINGLE(pTemp, sizeof(GIHashNode)+hash->key_size);
+                GI_FREE_SINGLE(pSlot->value, value_size);
+            pSlot->used = 0;
             --hash->count;
         }
     }
@@ -296,23 +373,84 @@ void GIHash_clear(GIHash *hash, GIuint value_size)
  */
 GIvoid* GIHash_find(const GIHash *hash, const GIvoid *key)
 {
-    GIuint i;
-    GIHashNode *pItem;
+    GIuint i, uiHash;
+    GIHashSlot *pSlot;
     if(!hash->data)
         return NULL;
-    i = hash->hash(key, hash->size);
-    pItem = hash->data[i];
+    uiHash = hash->hash(key, UINT_MAX);
 
-    /* /search for item */
-    while(pItem)
-    {
-        if((*hash->comp)(pItem+1, key))
-            return pItem->value;
-        pItem = pItem->next;
-    }
+    /* search probe sequence till free slot */
+    for(i=uiHash%hash->size; (pSlot=GI_HASH_SLOT(hash, i))->used; 
+        i=(i+1==hash->size) ? 0 : (i+1))
+        if(pSlot->hash == uiHash && (*hash->comp)(pSlot+1, key))
+            return pSlot->value;
     return NULL;
 }
 
+/** \internal
+ *  \brief Define hash methods specialized for a key type.
+ *  \details The generated insert, remove and find functions operate on an ordinary 
+ *  GIHash, but hash, compare and copy keys inline instead of calling the function 
+ *  pointers of the hash. The hash has to be constructed with the generic functions 
+ *  of the same key type, so that both variants compute the same hash values.
+ *  \param type name suffix of key type
+ *  \param HASH macro computing full hash value of key
+ *  \param EQUAL macro comparing two keys
+ *  \param COPY macro copying key
+ *  \ingroup container
+ */
+#define GI_HASH_SPECIALIZE(type, HASH, EQUAL, COPY) \
+GIboolean GIHash_insert_##type(GIHash *hash, const GIvoid *key, GIvoid *value) \
+{ \
+    GIuint i, uiHash; \
+    GIHashSlot *pSlot; \
+    if(!hash->data) \
+        return GI_FALSE; \
+    uiHash = HASH(key); \
+    for(i=uiHash%hash->size; (pSlot=GI_HASH_SLOT(hash, i))->used; \
+        i=(i+1==hash->size) ? 0 : (i+1)) \
+    { \
+        if(pSlot->hash == uiHash && EQUAL(pSlot+1, key)) \
+        { \
+            pSlot->value = value; \
+            return GI_FALSE; \
+        } \
+    } \
+    pSlot = GIHash_occupy(hash, pSlot, uiHash, value); \
+    COPY(pSlot+1, key); \
+    return GI_TRUE; \
+} \
+GIvoid* GIHash_remove_##type(GIHash *hash, const GIvoid *key) \
+{ \
+    GIuint i, uiHash; \
+    GIHashSlot *pSlot; \
+    if(!hash->data) \
+        return NULL; \
+    uiHash = HASH(key); \
+    for(i=uiHash%hash->size; (pSlot=GI_HASH_SLOT(hash, i))->used; \
+        i=(i+1==hash->size) ? 0 : (i+1)) \
+        if(pSlot->hash == uiHash && EQUAL(pSlot+1, key)) \
+            return GIHash_erase(hash, i); \
+    return NULL; \
+} \
+GIvoid* GIHash_find_##type(const GIHash *hash, const GIvoid *key) \
+{ \
+    GIuint i, uiHash; \
+    GIHashSlot *pSlot; \
+    if(!hash->data) \
+        return NULL; \
+    uiHash = HASH(key); \
+    for(i=uiHash%hash->size; (pSlot=GI_HASH_SLOT(hash, i))->used; \
+        i=(i+1==hash->size) ? 0 : (i+1)) \
+        if(pSlot->hash == uiHash && EQUAL(pSlot+1, key)) \
+            return pSlot->value; \
+    return NULL; \
+}
+
+GI_HASH_SPECIALIZE(pointer, GI_HASH_POINTER, GI_EQUAL_POINTER, GI_COPY_POINTER)
+GI_HASH_SPECIALIZE(uintpair, GI_HASH_UINTPAIR, GI_EQUAL_UINTPAIR, GI_COPY_UINTPAIR)
+GI_HASH_SPECIALIZE(blob, GI_HASH_BLOB, GI_EQUAL_BLOB, GI_COPY_BLOB)
+
 /** \internal
  *  \brief Heap constructor.
  *  \param heap heap to construct
@@ -402,7 +540,7 @@ GIboolean GIHeap_enqueue(GIHeap *heap, GIvoid *data, GIdouble priority)
     uintptr_t i = 0, p = 0;
     if(heap->store_pos)
     {
-        i = (uintptr_t)GIHash_find(&heap->pos_map, &data);
+        i = (uintptr_t)GIHash_find_pointer(&heap->pos_map, &data);
         if(i != 0)
         {
             if(pfnComp(pItems[i].priority, priority) < 0)
@@ -419,9 +557,9 @@ GIboolean GIHeap_enqueue(GIHeap *heap, GIvoid *data, GIdouble priority)
         {
             p = i >> 1;
             pItems[i] = pItems[p];
-            GIHash_insert(&heap->pos_map, &pItems[i].data, (GIvoid*)i);
+            GIHash_insert_pointer(&heap->pos_map, &pItems[i].data, (GIvoid*)i);
         }
-        GIHash_insert(&heap->pos_map, &data, (GIvoid*)i);
+        GIHash_insert_pointer(&heap->pos_map, &data, (GIvoid*)i);
     }
     else
     {
@@ -470,7 +608,7 @@ GIvoid* GIHeap_dequeue(GIHeap *heap, GIdouble *priority)
     uintptr_t c = 0;
     if(heap->store_pos)
     {
-        GIHash_remove(&heap->pos_map, &result);
+        GIHash_remove_pointer(&heap->pos_map, &result);
         for(i = 1; (i << 1) < count; i = c)
         {
             c = i << 1;
@@ -479,9 +617,9 @@ GIvoid* GIHeap_dequeue(GIHeap *heap, GIdouble *priority)
             }
             if(pfnComp(lastP, pItems[c].priority) <= 0) break;
             pItems[i] = pItems[c];
-            GIHash_insert(&heap->pos_map, &pItems[i].data, (GIvoid*)i);
+            GIHash_insert_pointer(&heap->pos_map, &pItems[i].data, (GIvoid*)i);
         }
-        GIHash_insert(&heap->pos_map, &pItems[count].data, (GIvoid*)i);
+        GIHash_insert_pointer(&heap->pos_map, &pItems[count].data, (GIvoid*)i);
     }
     else
     {
@@ -534,7 +672,7 @@ GIboolean GIHeap_contains(GIHeap *heap, GIvoid *data)
 {
     /* look up item */
     if(heap->store_pos)
-        return GIHash_find(&heap->pos_map, &data) != NULL;
+        return GIHash_find_pointer(&heap->pos_map, &data) != NULL;
     return GI_FALSE;
 }
 
@@ -554,7 +692,7 @@ GIboolean GIHeap_remove(GIHeap *heap, GIvoid *data)
     GIdouble lastP = pItems[count].priority;
 
     /* item in heap? */
-    if (!heap->store_pos || !(c = (uintptr_t)GIHash_remove(&heap->pos_map, &data))) {
+    if (!heap->store_pos || !(c = (uintptr_t)GIHash_remove_pointer(&heap->pos_map, &data))) {
         return GI_FALSE;
     }
 
@@ -567,9 +705,9 @@ GIboolean GIHeap_remove(GIHeap *heap, GIvoid *data)
         }
         if(pfnComp(lastP, pItems[c].priority) <= 0) break;
         pItems[i] = pItems[c];
-        GIHash_insert(&heap->pos_map, &pItems[i].data, (GIvoid*)i);
+        GIHash_insert_pointer(&heap->pos_map, &pItems[i].data, (GIvoid*)i);
     }
-    GIHash_insert(&heap->pos_map, &pItems[count].data, (GIvoid*)i);
+    GIHash_insert_pointer(&heap->pos_map, &pItems[count].data, (GIvoid*)i);
     pItems[i] = pItems[heap->count--];
     return GI_TRUE;
 }
@@ -587,6 +725,259 @@ void GIHeap_clear(GIHeap *heap)
         GIHash_clear(&heap->pos_map, 0);
 }
 
+/** \internal
+ *  \brief Move item up in indexed heap.
+ *  \param heap heap to work on
+ *  \param index free position to start at
+ *  \param item item to place
+ *  \ingroup container
+ */
+static void GIIndexedHeap_sift_up(GIIndexedHeap *heap, GIuint index, 
+                                  const GIIndexedHeapItem *item)
+{
+    GIIndexedHeapItem *pItems = heap->items;
+    GIdcfunc pfnComp = heap->comp;
+    GIuint p;
+
+    /* move parents down till place found */
+    for(; index; index=p)
+    {
+        p = (index-1) / GI_INDEXED_HEAP_ARITY;
+        if(pfnComp(pItems[p].priority, item->priority) <= 0)
+            break;
+        pItems[index] = pItems[p];
+        heap->positions[pItems[index].id] = index + 1;
+    }
+    pItems[index] = *item;
+    heap->positions[item->id] = index + 1;
+}
+
+/** \internal
+ *  \brief Move item down in indexed heap.
+ *  \param heap heap to work on
+ *  \param index free position to start at
+ *  \param item item to place
+ *  \ingroup container
+ */
+static void GIIndexedHeap_sift_down(GIIndexedHeap *heap, GIuint index, 
+                                    const GIIndexedHeapItem *item)
+{
+    GIIndexedHeapItem *pItems = heap->items;
+    GIdcfunc pfnComp = heap->comp;
+    GIuint c, i, uiEnd, uiCount = heap->count;
+
+    /* move smallest children up till place found */
+    for(c=index*GI_INDEXED_HEAP_ARITY+1; c<uiCount; c=index*GI_INDEXED_HEAP_ARITY+1)
+    {
+        uiEnd = GI_MIN(c+GI_INDEXED_HEAP_ARITY, uiCount);
+        for(i=c+1; i<uiEnd; ++i)
+            if(pfnComp(pItems[i].priority, pItems[c].priority) < 0)
+                c = i;
+        if(pfnComp(item->priority, pItems[c].priority) <= 0)
+            break;
+        pItems[index] = pItems[c];
+        heap->positions[pItems[index].id] = index + 1;
+        index = c;
+    }
+    pItems[index] = *item;
+    heap->positions[item->id] = index + 1;
+}
+
+/** \internal
+ *  \brief Indexed heap constructor.
+ *  \param heap heap to construct
+ *  \param ids number of indices expected (grows if exceeded)
+ *  \param comp function to return GI_TRUE if first argument has higher priority
+ *  \ingroup container
+ */
+void GIIndexedHeap_construct(GIIndexedHeap *heap, GIuint ids, GIdcfunc comp)
+{
+    if(!comp)
+        comp = lessd;
+    if(!ids)
+        ids = 1;
+
+    /* initialize heap */
+    heap->size = ids;
+    heap->count = 0;
+    heap->id_count = ids;
+    heap->comp = comp;
+    heap->items = (GIIndexedHeapItem*)GI_MALLOC_ARRAY(ids, sizeof(GIIndexedHeapItem));
+    heap->positions = (GIuint*)GI_CALLOC_ARRAY(ids, sizeof(GIuint));
+}
+
+/** \internal
+ *  \brief Indexed heap destructor.
+ *  \param heap heap to destruct
+ *  \ingroup container
+ */
+void GIIndexedHeap_destruct(GIIndexedHeap *heap)
+{
+    /* clean up */
+    if(heap->items)
+        GI_FREE_ARRAY(heap->items);
+    if(heap->positions)
+        GI_FREE_ARRAY(heap->positions);
+    memset(heap, 0, sizeof(GIIndexedHeap));
+}
+
+/** \internal
+ *  \brief Enqueue element to indexed heap or update its priority.
+ *  \param heap to insert into
+ *  \param id dense index of item
+ *  \param data data of item
+ *  \param priority priority of item
+ *  \retval GI_TRUE if item enqueued successfully
+ *  \retval GI_FALSE if item already in heap, priority changed
+ *  \ingroup container
+ */
+GIboolean GIIndexedHeap_enqueue(GIIndexedHeap *heap, GIuint id, 
+                                GIvoid *data, GIdouble priority)
+{
+    GIIndexedHeapItem item;
+    GIuint i, uiIDs;
+
+    /* make index addressable */
+    if(id >= heap->id_count)
+    {
+        for(uiIDs=heap->id_count<<1; uiIDs<=id; uiIDs<<=1);
+        heap->positions = (GIuint*)GI_REALLOC_ARRAY(
+            heap->positions, uiIDs, sizeof(GIuint));
+        memset(heap->positions+heap->id_count, 0, 
+            (uiIDs-heap->id_count)*sizeof(GIuint));
+        heap->id_count = uiIDs;
+    }
+    item.priority = priority;
+    item.data = data;
+    item.id = id;
+
+    /* item already in heap -> move to new place */
+    i = heap->positions[id];
+    if(i)
+    {
+        if(heap->comp(priority, heap->items[--i].priority) < 0)
+            GIIndexedHeap_sift_up(heap, i, &item);
+        else
+            GIIndexedHeap_sift_down(heap, i, &item);
+        return GI_FALSE;
+    }
+
+    /* heap full? */
+    if(heap->count == heap->size)
+    {
+        heap->size <<= 1;
+        heap->items = (GIIndexedHeapItem*)GI_REALLOC_ARRAY(
+            heap->items, heap->size, sizeof(GIIndexedHeapItem));
+    }
+
+    /* insert element and move up */
+    GIIndexedHeap_sift_up(heap, heap->count++, &item);
+    return GI_TRUE;
+}
+
+/** \internal
+ *  \brief Dequeue element with highest priority from indexed heap.
+ *  \param heap to get item from
+ *  \param priority address to take priority of item or NULL if not wanted
+ *  \return data of item with highest priority or NULL if heap empty
+ *  \ingroup container
+ */
+GIvoid* GIIndexedHeap_dequeue(GIIndexedHeap *heap, GIdouble *priority)
+{
+    GIIndexedHeapItem *pItems = heap->items;
+    GIvoid *pResult;
+
+    /* heap empty? */
+    if(!heap->count)
+        return NULL;
+
+    /* get first element */
+    if(priority)
+        *priority = pItems[0].priority;
+    pResult = pItems[0].data;
+    heap->positions[pItems[0].id] = 0;
+
+    /* reinsert last element and move down */
+    if(--heap->count)
+        GIIndexedHeap_sift_down(heap, 0, &pItems[heap->count]);
+    return pResult;
+}
+
+/** \internal
+ *  \brief Query element with highest priority without dequeueing.
+ *  \param heap to query
+ *  \param priority address to take priority of item or NULL if not wanted
+ *  \return data of item with highest priority or NULL if heap empty
+ *  \ingroup container
+ */
+GIvoid* GIIndexedHeap_front(GIIndexedHeap *heap, GIdouble *priority)
+{
+    /* heap empty? */
+    if(!heap->count)
+        return NULL;
+    if(priority)
+        *priority = heap->items[0].priority;
+    return heap->items[0].data;
+}
+
+/** \internal
+ *  \brief Check if item is in indexed heap.
+ *  \param heap heap to query
+ *  \param id dense index of item to look for
+ *  \retval GI_TRUE if item in heap
+ *  \retval GI_FALSE if item not in heap
+ *  \ingroup container
+ */
+GIboolean GIIndexedHeap_contains(GIIndexedHeap *heap, GIuint id)
+{
+    return id < heap->id_count && heap->positions[id];
+}
+
+/** \internal
+ *  \brief Remove item from indexed heap.
+ *  \param heap heap to remove from
+ *  \param id dense index of item to remove
+ *  \retval GI_TRUE if item removed successfully
+ *  \retval GI_FALSE if not in heap
+ *  \ingroup container
+ */
+GIboolean GIIndexedHeap_remove(GIIndexedHeap *heap, GIuint id)
+{
+    GIIndexedHeapItem *pItems = heap->items;
+    GIuint i;
+
+    /* item in heap? */
+    if(id >= heap->id_count || !(i = heap->positions[id]))
+        return GI_FALSE;
+    heap->positions[id] = 0;
+
+    /* reinsert last element at free position */
+    if(--i != --heap->count)
+    {
+        if(i && heap->comp(pItems[heap->count].priority, 
+            pItems[(i-1)/GI_INDEXED_HEAP_ARITY].priority) < 0)
+            GIIndexedHeap_sift_up(heap, i, &pItems[heap->count]);
+        else
+            GIIndexedHeap_sift_down(heap, i, &pItems[heap->count]);
+    }
+    return GI_TRUE;
+}
+
+/** \internal
+ *  \brief Remove all items from indexed heap.
+ *  \param heap heap to clear
+ *  \ingroup container
+ */
+void GIIndexedHeap_clear(GIIndexedHeap *heap)
+{
+    GIuint i;
+
+    /* reset positions of contained items only */
+    for(i=0; i<heap->count; ++i)
+        heap->positions[heap->items[i].id] = 0;
+    heap->count = 0;
+}
+
 /** \internal
  *  \brief Fibonacci tree destructor.
  *  \param node tree to destruct
@@ -674,7 +1065,7 @@ void GIFibonacciHeap_destruct(GIFibonacciHeap *heap)
 GIboolean GIFibonacciHeap_enqueue(GIFibonacciHeap *heap, 
                                   GIvoid *data, GIdouble priority)
 {
-    GIFibonacciNode *pNode = (GIFibonacciNode*)GIHash_find(&heap->pos_map, &data);
+    GIFibonacciNode *pNode = (GIFibonacciNode*)GIHash_find_pointer(&heap->pos_map, &data);
     GIdcfunc pfnComp = heap->comp;
     GIboolean bNew = GI_TRUE;
 
@@ -704,7 +1095,7 @@ GIboolean GIFibonacciHeap_enqueue(GIFibonacciHeap *heap,
         GI_LIST_ADD(heap->trees, pNode);
         pNode->data = data;
         pNode->priority = priority;
-        GIHash_insert(&heap->pos_map, &data, pNode);
+        GIHash_insert_pointer(&heap->pos_map, &data, pNode);
     }
 
     /* update min */
@@ -738,7 +1129,7 @@ GIvoid* GIFibonacciHeap_dequeue(GIFibonacciHeap *heap, GIdouble *priority)
         GI_LIST_ADD(heap->trees, pNode)
     GI_LIST_NEXT(pMin->children, pNode)
     GI_LIST_DELETE(heap->trees, pMin, sizeof(GIFibonacciNode));
-    GIHash_remove(&heap->pos_map, &pData);
+    GIHash_remove_pointer(&heap->pos_map, &pData);
 
     /* compress heap */
     memset(pTrees, 0, 32*sizeof(GIFibonacciNode*));
@@ -804,7 +1195,7 @@ GIvoid* GIFibonacciHeap_front(GIFibonacciHeap *heap, GIdouble *priority)
 GIboolean GIFibonacciHeap_contains(GIFibonacciHeap *heap, GIvoid *data)
 {
     /* find item */
-    return GIHash_find(&heap->pos_map, &data) != NULL;
+    return GIHash_find_pointer(&heap->pos_map, &data) != NULL;
 }
 
 /** \internal
@@ -817,7 +1208,7 @@ GIboolean GIFibonacciHeap_contains(GIFibonacciHeap *heap, GIvoid *data)
  */
 GIboolean GIFibonacciHeap_remove(GIFibonacciHeap *heap, GIvoid *data)
 {
-    GIFibonacciNode *pChild, *pNode = (GIFibonacciNode*)GIHash_remove(&heap->pos_map, &data);
+    GIFibonacciNode *pChild, *pNode = (GIFibonacciNode*)GIHash_remove_pointer(&heap->pos_map, &data);
     if(!pNode)
         return GI_FALSE;
 
@@ -848,6 +1239,24 @@ void GIFibonacciHeap_clear(GIFibonacciHeap *heap)
     GIHash_clear(&heap->pos_map, 0);
 }
 
+/** \internal
+ *  \brief Double capacity of dynamic queue.
+ *  \param queue queue to grow
+ *  \ingroup container
+ */
+static void GIDynamicQueue_grow(GIDynamicQueue *queue)
+{
+    GIuint uiOld = queue->capacity;
+
+    /* resize buffer and move wrapped part behind old end */
+    queue->capacity = uiOld ? (uiOld<<1) : GI_QUEUE_MIN_CAPACITY;
+    queue->items = (GIvoid**)GI_REALLOC_ARRAY(
+        queue->items, queue->capacity, sizeof(GIvoid*));
+    if(queue->head+queue->size > uiOld)
+        memcpy(queue->items+uiOld, queue->items, 
+            (queue->head+queue->size-uiOld)*sizeof(GIvoid*));
+}
+
 /** \internal
  *  \brief Dynamic queue constructor.
  *  \param queue queue to construct
@@ -856,8 +1265,8 @@ void GIFibonacciHeap_clear(GIFibonacciHeap *heap)
 void GIDynamicQueue_construct(GIDynamicQueue *queue)
 {
     /* initialize empty queue */
-    queue->size = 0;
-    queue->head = queue->tail = NULL;
+    queue->size = queue->capacity = queue->head = 0;
+    queue->items = NULL;
 }
 
 /** \internal
@@ -868,18 +1277,10 @@ void GIDynamicQueue_construct(GIDynamicQueue *queue)
  */
 void GIDynamicQueue_enqueue(GIDynamicQueue *queue, GIvoid *data)
 {
-    GIQueueNode *pNode = (GIQueueNode*)GI_MALLOC_SINGLE(sizeof(GIQueueNode));
-    pNode->data = data;
-    pNode->next = NULL;
-
     /* insert element at end */
-    if(queue->tail)
-    {
-        queue->tail->next = pNode;
-        queue->tail = pNode;
-    }
-    else
-        queue->head = queue->tail = pNode;
+    if(queue->size == queue->capacity)
+        GIDynamicQueue_grow(queue);
+    queue->items[(queue->head+queue->size)&(queue->capacity-1)] = data;
     ++queue->size;
 }
 
@@ -891,14 +1292,11 @@ void GIDynamicQueue_enqueue(GIDynamicQueue *queue, GIvoid *data)
  */
 void GIDynamicQueue_push(GIDynamicQueue *queue, GIvoid *data)
 {
-    GIQueueNode *pNode = (GIQueueNode*)GI_MALLOC_SINGLE(sizeof(GIQueueNode));
-    pNode->data = data;
-    pNode->next = queue->head;
-
     /* insert element at front */
-    queue->head = pNode;
-    if(!queue->tail)
-        queue->tail = pNode;
+    if(queue->size == queue->capacity)
+        GIDynamicQueue_grow(queue);
+    queue->head = (queue->head+queue->capacity-1) & (queue->capacity-1);
+    queue->items[queue->head] = data;
     ++queue->size;
 }
 
@@ -910,21 +1308,14 @@ void GIDynamicQueue_push(GIDynamicQueue *queue, GIvoid *data)
  */
 GIvoid* GIDynamicQueue_dequeue(GIDynamicQueue *queue)
 {
-    GIQueueNode *pNode = queue->head;
-    GIvoid *result = NULL;
+    GIvoid *result;
 
     /* remove item if not empty */
-    if(pNode)
-    {
-        result = pNode->data;
-        queue->head = pNode->next;
-        GI_FREE_SINGLE(pNode, sizeof(GIQueueNode));
-        --queue->size;
-
-        /* now empty? */
-        if(!queue->head)
-            queue->tail = NULL;
-    }
+    if(!queue->size)
+        return NULL;
+    result = queue->items[queue->head];
+    queue->head = (queue->head+1) & (queue->capacity-1);
+    --queue->size;
     return result;
 }
 
@@ -937,8 +1328,23 @@ GIvoid* GIDynamicQueue_dequeue(GIDynamicQueue *queue)
 GIvoid* GIDynamicQueue_front(GIDynamicQueue *queue)
 {
     /* return head data */
-    if(queue->head)
-        return queue->head->data;
+    if(queue->size)
+        return queue->items[queue->head];
+    return NULL;
+}
+
+/** \internal
+ *  \brief Query element at position without dequeueing.
+ *  \param queue queue to query
+ *  \param index position of item counted from front
+ *  \return data of item or NULL if index out of range
+ *  \ingroup container
+ */
+GIvoid* GIDynamicQueue_at(const GIDynamicQueue *queue, GIuint index)
+{
+    /* return data of slot */
+    if(index < queue->size)
+        return queue->items[(queue->head+index)&(queue->capacity-1)];
     return NULL;
 }
 
@@ -949,17 +1355,10 @@ GIvoid* GIDynamicQueue_front(GIDynamicQueue *queue)
  */
 void GIDynamicQueue_clear(GIDynamicQueue *queue)
 {
-    GIQueueNode *pNode;
-
-    /* remove all items */
-    while(queue->head)
-    {
-        pNode = queue->head;
-        queue->head = pNode->next;
-        GI_FREE_SINGLE(pNode, sizeof(GIQueueNode));
-    }
-    queue->size = 0;
-    queue->tail = NULL;
+    /* release buffer */
+    if(queue->items)
+        GI_FREE_ARRAY(queue->items);
+    GIDynamicQueue_construct(queue);
 }
 
 /** \internal
@@ -1003,7 +1402,7 @@ GIint greaterd(GIdouble a, GIdouble b)
  */
 GIuint hash_uint(const GIvoid *i, GIuint size)
 {
-    return *(const GIuint*)i % size;
+    return GI_HASH_UINT(i) % size;
 }
 
 /** \internal
@@ -1013,7 +1412,7 @@ GIuint hash_uint(const GIvoid *i, GIuint size)
  */
 void copy_uint(GIvoid *d, const GIvoid *s)
 {
-    *((GIuint*)d) = *((const GIuint*)s);
+    GI_COPY_UINT(d, s);
 }
 
 /** \internal
@@ -1026,7 +1425,7 @@ void copy_uint(GIvoid *d, const GIvoid *s)
  */
 GIboolean compare_uint(const GIvoid *i, const GIvoid *j)
 {
-    return *(const GIuint*)i == *(const GIuint*)j;
+    return GI_EQUAL_UINT(i, j);
 }
 
 /** \internal
@@ -1038,7 +1437,7 @@ GIboolean compare_uint(const GIvoid *i, const GIvoid *j)
  */
 GIuint hash_pointer(const GIvoid *pointer, GIuint size)
 {
-    return (*(const GIuint*)pointer >> 2) % size;
+    return GI_HASH_POINTER(pointer) % size;
 }
 
 /** \internal
@@ -1049,7 +1448,7 @@ GIuint hash_pointer(const GIvoid *pointer, GIuint size)
  */
 void copy_pointer(GIvoid *d, const GIvoid *s)
 {
-    *(GIvoid**)d = *(GIvoid**)s;
+    GI_COPY_POINTER(d, s);
 }
 
 /** \internal
@@ -1062,7 +1461,7 @@ void copy_pointer(GIvoid *d, const GIvoid *s)
  */
 GIboolean compare_pointer(const GIvoid *p, const GIvoid *q)
 {
-    return *(const GIvoid**)p == *(const GIvoid**)q;
+    return GI_EQUAL_POINTER(p, q);
 }
 
 /** \internal
@@ -1074,8 +1473,7 @@ GIboolean compare_pointer(const GIvoid *p, const GIvoid *q)
  */
 GIuint hash_vec3f(const GIvoid *v, GIuint size)
 {
-    return (*((const GIuint*)v) ^ *((const GIuint*)v+1) ^ 
-        *((const GIuint*)v+2)) % size;
+    return GI_HASH_VEC3F(v) % size;
 }
 
 /** \internal
@@ -1086,7 +1484,7 @@ GIuint hash_vec3f(const GIvoid *v, GIuint size)
  */
 void copy_vec3f(GIvoid *d, const GIvoid *v)
 {
-    GI_VEC3_COPY((GIfloat*)d, (const GIfloat*)v);
+    GI_COPY_VEC3F(d, v);
 }
 
 /** \internal
@@ -1099,7 +1497,7 @@ void copy_vec3f(GIvoid *d, const GIvoid *v)
  */
 GIboolean compare_vec3f(const GIvoid *v, const GIvoid *w)
 {
-    return GI_VEC3_EQUAL((const GIfloat*)v, (const GIfloat*)w);
+    return GI_EQUAL_VEC3F(v, w);
 }
 
 /** \internal
@@ -1157,8 +1555,7 @@ GIboolean compare_string(const GIvoid *s, const GIvoid *t)
  */
 GIuint hash_uintpair(const GIvoid *pair, GIuint size)
 {
-    return (((const GIUIntPair*)pair)->first + 
-        ((const GIUIntPair*)pair)->second) % size;
+    return GI_HASH_UINTPAIR(pair) % size;
 }
 
 /** \internal
@@ -1169,7 +1566,7 @@ GIuint hash_uintpair(const GIvoid *pair, GIuint size)
  */
 void copy_uintpair(GIvoid *d, const GIvoid *s)
 {
-    *(GIUIntPair*)d = *(const GIUIntPair*)s;
+    GI_COPY_UINTPAIR(d, s);
 }
 
 /** \internal
@@ -1182,8 +1579,41 @@ void copy_uintpair(GIvoid *d, const GIvoid *s)
  */
 GIboolean compare_uintpair(const GIvoid *p, const GIvoid *q)
 {
-    return (((const GIUIntPair*)p)->first == ((const GIUIntPair*)q)->first && 
-        ((const GIUIntPair*)p)->second == ((const GIUIntPair*)q)->second) || 
-        (((const GIUIntPair*)p)->first == ((const GIUIntPair*)q)->second && 
-        ((const GIUIntPair*)p)->second == ((const GIUIntPair*)q)->first);
+    return GI_EQUAL_UINTPAIR(p, q);
+}
+
+/** \internal
+ *  \brief Hash packed blob.
+ *  \param b blob consisting of byte count followed by data
+ *  \param size size of hash table
+ *  \return computed hash value
+ *  \ingroup container
+ */
+GIuint hash_blob(const GIvoid *b, GIuint size)
+{
+    return GI_HASH_BLOB(b) % size;
+}
+
+/** \internal
+ *  \brief Copy packed blob.
+ *  \param d destination blob
+ *  \param s source blob
+ *  \ingroup container
+ */
+void copy_blob(GIvoid *d, const GIvoid *s)
+{
+    GI_COPY_BLOB(d, s);
+}
+
+/** \internal
+ *  \brief Compare packed blobs of equal size.
+ *  \param b first blob
+ *  \param c second blob
+ *  \retval GI_TRUE if blobs are equal
+ *  \retval GI_FALSE if blobs are not equal
+ *  \ingroup container
+ */
+GIboolean compare_blob(const GIvoid *b, const GIvoid *c)
+{
+    return GI_EQUAL_BLOB(b, c);
 }
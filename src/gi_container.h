@@ -75,10 +75,10 @@
 #define GI_LIST_DELETE(h,p,s)		GI_LIST_REMOVE(h,p); GI_FREE_SINGLE(p,s);
 
 /** \internal
- *  \brief Remove item from doubly linked list of persistent data and free its memory.
+ *  \brief Remove item from doubly linked list of arena data and free its memory.
  *  \ingroup container
  */
-#define GI_LIST_DELETE_PERSISTENT(h,p,s)	GI_LIST_REMOVE(h,p); GI_FREE_PERSISTENT(p,s);
+#define GI_LIST_DELETE_ARENA(h,a,p,s)	GI_LIST_REMOVE(h,p); GI_FREE_ARENA(a,p,s);
 
 /** \internal
  *  \brief Remove all items from doubly linked list and free their data.
@@ -90,12 +90,12 @@
 										} while((h)!=e); (h)=NULL; }
 
 /** \internal
- *  \brief Remove all items from doubly linked list of persistent data and free their data.
+ *  \brief Remove all items from doubly linked list of arena data and free their data.
  *  \ingroup container
  */
-#define GI_LIST_CLEAR_PERSISTENT(h,s)	if(h) { \
+#define GI_LIST_CLEAR_ARENA(h,a,s)	if(h) { \
 										void *t, *e=(h); do { \
-											t=(h); (h)=(h)->next; GI_FREE_PERSISTENT(t,s); \
+											t=(h); (h)=(h)->next; GI_FREE_ARENA(a,t,s); \
 										} while((h)!=e); (h)=NULL; }
 
 /** \internal
@@ -143,25 +143,29 @@ typedef GIint (*GIdcfunc)(GIdouble, GIdouble);
 /* Structures */
 
 /** \internal
- *  \brief Generic hash table list node.
- *  \details This structure represents a node in the collision list of a hash entry.
+ *  \brief Generic hash table slot.
+ *  \details This structure represents a slot in the probe array of a hash. 
+ *  It is directly followed by the key data.
  *  \ingroup container
  */
-typedef struct _GIHashNode
+typedef struct _GIHashSlot
 {
 	GIvoid				*value;					/**< Value of item. */
-	struct _GIHashNode	*next;					/**< Next in list. */
-} GIHashNode;
+	GIuint				hash;					/**< Full hash value of key. */
+	GIuint				used;					/**< Slot occupied. */
+} GIHashSlot;
 
 /** \internal
  *  \brief Generic hash table.
- *  \details This structure represents a hash table associating generic data with pointers.
+ *  \details This structure represents a hash table associating generic data with pointers. 
+ *  It uses open addressing with linear probing and stores the keys inline.
  *  \ingroup container
  */
 typedef struct _GIHash
 {
-	GIHashNode	**data;							/**< Hashed items. */
+	GIubyte		*data;							/**< Slots with hashed items. */
 	GIuint		key_size;						/**< Size of keys. */
+	GIuint		slot_size;						/**< Size of slots including keys. */
 	GIuint		size;							/**< Size of hash table. */
 	GIuint		threshold;						/**< Size threshold. */
 	GIuint		count;							/**< Number of items currently in hash. */
@@ -197,6 +201,35 @@ typedef struct _GIHeap
 	GIHash		pos_map;						/**< Positions of items in heap. */
 } GIHeap;
 
+/** \internal
+ *  \brief Indexed heap item.
+ *  \details This structure represents an item of an indexed heap.
+ *  \ingroup container
+ */
+typedef struct _GIIndexedHeapItem
+{
+	GIdouble	priority;						/**< Priority of item. */
+	GIvoid		*data;							/**< Data of item. */
+	GIuint		id;								/**< Dense index of item. */
+} GIIndexedHeapItem;
+
+/** \internal
+ *  \brief Indexed heap.
+ *  \details This structure represents a d-ary heap based priority queue, whose 
+ *  items are addressed by dense indices. The positions of the items are 
+ *  kept in an array indexed by these, instead of a hash.
+ *  \ingroup container
+ */
+typedef struct _GIIndexedHeap
+{
+	GIuint				size;					/**< Maximum number of elements. */
+	GIuint				count;					/**< Number of elements in priority queue. */
+	GIuint				id_count;				/**< Number of addressable indices. */
+	GIdcfunc			comp;					/**< Compare function. */
+	GIIndexedHeapItem	*items;					/**< Items of priority queue. */
+	GIuint				*positions;				/**< Positions of items plus one or 0 if not in heap. */
+} GIIndexedHeap;
+
 /** \internal
  *  \brief Fibonacci tree.
  *  \details This structure represents a node of a Fibonacci tree.
@@ -226,27 +259,18 @@ typedef struct _GIFibonacciHeap
 	GIHash			pos_map;					/**< Positions of items in heap. */
 } GIFibonacciHeap;
 
-/** \internal
- *  \brief Generic dynamic queue list node.
- *  \details This structure represents a node in the singly linked list of a LIFO/FIFO queue.
- *  \ingroup container
- */
-typedef struct _GIQueueNode
-{
-	GIvoid				*data;					/**< Data of item. */
-	struct _GIQueueNode	*next;					/**< Next list item. */
-} GIQueueNode;
-
 /** \internal
  *  \brief Generic dynamic queue.
- *  \details This structure represents a generic dynamic LIFO/FIFO queue.
+ *  \details This structure represents a generic dynamic LIFO/FIFO queue. 
+ *  The items are stored in a growing ring buffer.
  *  \ingroup container
  */
 typedef struct _GIDynamicQueue
 {
 	GIuint		size;							/**< Number of elements in queue. */
-	GIQueueNode	*head;							/**< First element in queue. */
-	GIQueueNode	*tail;							/**< Last element in queue. */
+	GIuint		capacity;						/**< Number of allocated slots. */
+	GIuint		head;							/**< Slot of first element. */
+	GIvoid		**items;						/**< Ring buffer of elements. */
 } GIDynamicQueue;
 
 /** \internal
@@ -278,6 +302,26 @@ void GIHash_clear(GIHash *hash, GIuint value_size);
 GIvoid* GIHash_find(const GIHash *hash, const GIvoid *key);
 /** \} */
 
+/** \internal
+ *  \brief Declare hash methods specialized for a key type.
+ *  \details These have to be used on hashes constructed with the 
+ *  generic hashing functions of the respective key type.
+ *  \param type name suffix of key type
+ *  \ingroup container
+ */
+#define GI_HASH_DECLARE_SPECIALIZED(type) \
+	GIboolean GIHash_insert_##type(GIHash *hash, const GIvoid *key, GIvoid *value); \
+	GIvoid* GIHash_remove_##type(GIHash *hash, const GIvoid *key); \
+	GIvoid* GIHash_find_##type(const GIHash *hash, const GIvoid *key);
+
+/** \name Specialized hash methods
+ *  \{
+ */
+GI_HASH_DECLARE_SPECIALIZED(pointer)
+GI_HASH_DECLARE_SPECIALIZED(uintpair)
+GI_HASH_DECLARE_SPECIALIZED(blob)
+/** \} */
+
 /** \name Heap methods
  *  \{
  */
@@ -293,6 +337,20 @@ GIboolean GIHeap_remove(GIHeap *heap, GIvoid *data);
 void GIHeap_clear(GIHeap *heap);
 /** \} */
 
+/** \name Indexed heap methods
+ *  \{
+ */
+void GIIndexedHeap_construct(GIIndexedHeap *heap, GIuint ids, GIdcfunc comp);
+void GIIndexedHeap_destruct(GIIndexedHeap *heap);
+GIboolean GIIndexedHeap_enqueue(GIIndexedHeap *heap, GIuint id, 
+	GIvoid *data, GIdouble priority);
+GIvoid* GIIndexedHeap_dequeue(GIIndexedHeap *heap, GIdouble *priority);
+GIvoid* GIIndexedHeap_front(GIIndexedHeap *heap, GIdouble *priority);
+GIboolean GIIndexedHeap_contains(GIIndexedHeap *heap, GIuint id);
+GIboolean GIIndexedHeap_remove(GIIndexedHeap *heap, GIuint id);
+void GIIndexedHeap_clear(GIIndexedHeap *heap);
+/** \} */
+
 /** \name Dynamic queue methods
  *  \{
  */
@@ -301,6 +359,7 @@ void GIDynamicQueue_enqueue(GIDynamicQueue *queue, GIvoid *data);
 void GIDynamicQueue_push(GIDynamicQueue *queue, GIvoid *data);
 GIvoid* GIDynamicQueue_dequeue(GIDynamicQueue *queue);
 GIvoid* GIDynamicQueue_front(GIDynamicQueue *queue);
+GIvoid* GIDynamicQueue_at(const GIDynamicQueue *queue, GIuint index);
 void GIDynamicQueue_clear(GIDynamicQueue *queue);
 #define GIDynamicQueue_pop		GIDynamicQueue_dequeue
 #define GIDynamicQueue_top		GIDynamicQueue_front
@@ -345,6 +404,9 @@ GIboolean compare_string(const GIvoid *s, const GIvoid *t);
 GIuint hash_uintpair(const GIvoid *str, GIuint size);
 void copy_uintpair(GIvoid *d, const GIvoid *s);
 GIboolean compare_uintpair(const GIvoid *s, const GIvoid *t);
+GIuint hash_blob(const GIvoid *b, GIuint size);
+void copy_blob(GIvoid *d, const GIvoid *s);
+GIboolean compare_blob(const GIvoid *b, const GIvoid *c);
 /** \} */
 
 
@@ -39,14 +39,19 @@
 
 
 /** \internal
- *  \brief Current OpenGI context.
+ *  \brief Current OpenGI context of calling thread.
  */
 //#ifdef _DEBUG
-	static GIContext *gi_CurrentContext = NULL;
+	static GI_THREAD_LOCAL GIContext *gi_CurrentContext = NULL;
 //#else
 //	GIContext *gi_CurrentContext = NULL;
 //#endif
 
+/** \internal
+ *  \brief Initialization flag for library-wide data.
+ */
+static GIOnce gi_LibraryInit = GI_ONCE_INIT;
+
 /** Create new context.
  *  \return created GI context
  *  \ingroup context
@@ -56,11 +61,16 @@ GIcontext GIAPIENTRY giCreateContext()
 	GIContext *pContext;
 	GIuint i;
 
-	/* create allocator if neccessary */
-	if(!g_SmallObjAlloc.pool)
+	/* create allocators and thread pool if neccessary */
+	if(GIOnce_begin(&gi_LibraryInit))
+	{
 		GISmallObjectAllocator_construct(&g_SmallObjAlloc);
-	if(!g_PersistentAlloc.pool)
-		GISmallObjectAllocator_construct(&g_PersistentAlloc);
+#if OPENGI_NUM_THREADS > 1
+		if(!g_ThreadPool.num_threads)
+			GIThreadPool_construct(&g_ThreadPool, OPENGI_MAX_THREADS);
+#endif
+		GIOnce_end(&gi_LibraryInit);
+	}
 
 	/* create new context and initialize states */
 	pContext = (GIContext*)GI_CALLOC_SINGLE(sizeof(GIContext));
@@ -72,6 +82,9 @@ GIcontext GIAPIENTRY giCreateContext()
 	pContext->next_iid = 1;
 	pContext->use_threads = GI_TRUE;
 	pContext->error = GI_NO_ERROR;
+#if OPENGI_NUM_THREADS > 1
+	GIMutex_construct(&pContext->mutex);
+#endif
 	pContext->semantic[0] = 0;
 	pContext->attrib_semantic[0] = GI_POSITION_ATTRIB;
 	for(i=1; i<GI_SEMANTIC_COUNT; ++i)
@@ -87,17 +100,20 @@ GIcontext GIAPIENTRY giCreateContext()
 	return pContext;
 }
 
-/** Set active Context.
+/** Set active Context of calling thread.
+ *  \details A context must not be current in more than one thread at a time.
  *  \param context GI context to make current
  *  \ingroup context
  */
 void GIAPIENTRY giMakeCurrent(GIcontext context)
 {
-	/* set context */
+	/* set context (return thread's cached memory if unbound) */
 	gi_CurrentContext = (GIContext*)context;
+	if(!context)
+		GIMemory_release_caches();
 }
 
-/** Get active context.
+/** Get active context of calling thread.
  *  \return active GI context
  *  \ingroup context
  */
@@ -131,11 +147,15 @@ void GIAPIENTRY giDestroyContext(GIcontext context)
 	GIHash_destruct(&pContext->image_hash, sizeof(GIImage));
 	GIGLManager_destruct(pContext->gl_manager);
 	GI_FREE_SINGLE(pContext->gl_manager, sizeof(GIGLManager));
+#if OPENGI_NUM_THREADS > 1
+	GIMutex_destruct(&pContext->mutex);
+#endif
 
 	/* unbind if current and delete */
 	if(gi_CurrentContext == pContext)
 		gi_CurrentContext = NULL;
 	GI_FREE_SINGLE(pContext, sizeof(GIContext));
+	GIMemory_release_caches();
 }
 
 /** Retrieve boolean state value.
@@ -167,6 +187,12 @@ void GIAPIENTRY giGetBooleanv(GIenum pname, GIboolean *params)
 	case GI_GL_USE_GEOMETRY_SHADER:
 		*params = ((pContext->renderer.gim_flags&pname) != 0);
 		break;
+	case GI_WARM_START:
+		*params = pContext->parameterizer.warm_start;
+		break;
+	case GI_AUTOTUNE_SOLVER:
+		*params = pContext->parameterizer.autotune;
+		break;
 	default:
 		*params = giIsEnabled(pname);
 	}
@@ -228,6 +254,18 @@ void GIAPIENTRY giGetIntegerv(GIenum pname, GIint *params)
 	case GI_UNSYMMETRIC_SOLVER:
 		*params = pContext->parameterizer.solver;
 		break;
+	case GI_SYMMETRIC_SOLVER:
+		*params = pContext->parameterizer.symmetric_solver;
+		break;
+	case GI_PRECONDITIONER:
+		*params = pContext->parameterizer.preconditioner;
+		break;
+	case GI_PARAM_ORDERING:
+		*params = pContext->parameterizer.param_ordering;
+		break;
+	case GI_SOLVER_PRECISION:
+		*params = pContext->parameterizer.solver_precision;
+		break;
 	case GI_PARAM_SOURCE_ATTRIB:
 		*params = pContext->parameterizer.source_attrib;
 		break;
@@ -246,6 +284,13 @@ void GIAPIENTRY giGetIntegerv(GIenum pname, GIint *params)
 	case GI_SAMPLED_ATTRIBS:
 		*params = pContext->sampler.sampled_attribs;
 		break;
+	case GI_THREAD_COUNT:
+#if OPENGI_NUM_THREADS > 1
+		*params = g_ThreadPool.num_threads;
+#else
+		*params = 1;
+#endif
+		break;
 	case GI_RENDER_RESOLUTION_U:
 	case GI_RENDER_RESOLUTION_V:
 		*params = pContext->renderer.render_res[pname-
@@ -369,6 +414,36 @@ GIboolean GIAPIENTRY giIsEnabled(GIenum pname)
 	return giEnableDisable(pname, -1);
 }
 
+/** Set number of threads used for multithreading.
+ *  \details This setting is shared by all contexts and must not be 
+ *  changed while any context is working. It has no effect if the library 
+ *  was built without thread support (neither Windows nor pthreads).
+ *  \param count number of threads including the calling thread
+ *  \ingroup state
+ */
+void GIAPIENTRY giThreadCount(GIuint count)
+{
+	GIContext *pContext = GIContext_current();
+
+	/* error checking, may be called without current context */
+	if(!count)
+	{
+		if(pContext)
+			GIContext_error(pContext, GI_INVALID_VALUE);
+		return;
+	}
+
+#if OPENGI_NUM_THREADS > 1
+	/* recreate thread pool */
+	if(count != g_ThreadPool.num_threads)
+	{
+		if(g_ThreadPool.num_threads)
+			GIThreadPool_destruct(&g_ThreadPool);
+		GIThreadPool_construct(&g_ThreadPool, count);
+	}
+#endif
+}
+
 /** Set vertex subset.
  *  \param subset subset to set
  *  \param count number of vertices ins subset
@@ -668,8 +743,16 @@ void GIAPIENTRY giGetAttribPointerv(GIuint attrib, GIvoid **params)
 GIenum GIAPIENTRY giGetError()
 {
 	/* return and clear error code */
-	GIuint uiError = GIContext_current()->error;
-	GIContext_current()->error = GI_NO_ERROR;
+	GIContext *pContext = GIContext_current();
+	GIuint uiError;
+#if OPENGI_NUM_THREADS > 1
+	GIMutex_lock(&pContext->mutex);
+#endif
+	uiError = pContext->error;
+	pContext->error = GI_NO_ERROR;
+#if OPENGI_NUM_THREADS > 1
+	GIMutex_unlock(&pContext->mutex);
+#endif
 	return uiError;
 }
 
@@ -727,6 +810,8 @@ const GIchar* GIAPIENTRY giErrorString(GIenum errorCode)
 }
 
 /** Set error callback function.
+ *  \details With multithreading enabled the callback may also be 
+ *  called from internal worker threads.
  *  \param fn function to use
  *  \param data user data
  *  \ingroup error
@@ -745,8 +830,9 @@ void GIAPIENTRY giErrorCallback(GIerrorcb fn, GIvoid *data)
  */
 GIenum GIAPIENTRY giGetEnumValue(const GIchar *name)
 {
-	static GIHash hEnumMap = { NULL, 0, 0, 0, 0, 0.0f, NULL, NULL, NULL };
-	if(!hEnumMap.size)
+	static GIHash hEnumMap = { NULL, 0, 0, 0, 0, 0, 0.0f, NULL, NULL, NULL };
+	static GIOnce onceEnumMap = GI_ONCE_INIT;
+	if(GIOnce_begin(&onceEnumMap))
 	{
 		/* create and fill map */
 		GIHash_construct(&hEnumMap, 256, 1.0f, 48*sizeof(GIchar*), 
@@ -774,6 +860,7 @@ GIenum GIAPIENTRY giGetEnumValue(const GIchar *name)
 		GIHash_insert(&hEnumMap, "GI_IMAGE_BINDING", (GIvoid*)GI_IMAGE_BINDING);
 		GIHash_insert(&hEnumMap, "GI_SAMPLED_ATTRIB_COUNT", (GIvoid*)GI_SAMPLED_ATTRIB_COUNT);
 		GIHash_insert(&hEnumMap, "GI_SAMPLED_ATTRIBS", (GIvoid*)GI_SAMPLED_ATTRIBS);
+		GIHash_insert(&hEnumMap, "GI_THREAD_COUNT", (GIvoid*)GI_THREAD_COUNT);
 		GIHash_insert(&hEnumMap, "GI_EXACT_MAPPING_SUBSET_COUNT", (GIvoid*)GI_EXACT_MAPPING_SUBSET_COUNT);
 		GIHash_insert(&hEnumMap, "GI_PARAM_CORNER_SUBSET_COUNT", (GIvoid*)GI_PARAM_CORNER_SUBSET_COUNT);
 		GIHash_insert(&hEnumMap, "GI_EXACT_MAPPING_SUBSET_SORTED", (GIvoid*)GI_EXACT_MAPPING_SUBSET_SORTED);
@@ -803,6 +890,13 @@ GIenum GIAPIENTRY giGetEnumValue(const GIchar *name)
 		GIHash_insert(&hEnumMap, "GI_PARAM_STRETCH_METRIC", (GIvoid*)GI_PARAM_STRETCH_METRIC);
 		GIHash_insert(&hEnumMap, "GI_TOPOLOGICAL_SIDEBAND_LENGTH", (GIvoid*)GI_TOPOLOGICAL_SIDEBAND_LENGTH);
 		GIHash_insert(&hEnumMap, "GI_TOPOLOGICAL_SIDEBAND", (GIvoid*)GI_TOPOLOGICAL_SIDEBAND);
+		GIHash_insert(&hEnumMap, "GI_SOLVER_ROWS", (GIvoid*)GI_SOLVER_ROWS);
+		GIHash_insert(&hEnumMap, "GI_SOLVER_NONZEROS", (GIvoid*)GI_SOLVER_NONZEROS);
+		GIHash_insert(&hEnumMap, "GI_SOLVER_ITERATIONS", (GIvoid*)GI_SOLVER_ITERATIONS);
+		GIHash_insert(&hEnumMap, "GI_SOLVER_RESIDUAL", (GIvoid*)GI_SOLVER_RESIDUAL);
+		GIHash_insert(&hEnumMap, "GI_ASSEMBLY_TIME", (GIvoid*)GI_ASSEMBLY_TIME);
+		GIHash_insert(&hEnumMap, "GI_PRECONDITIONER_TIME", (GIvoid*)GI_PRECONDITIONER_TIME);
+		GIHash_insert(&hEnumMap, "GI_SOLVER_TIME", (GIvoid*)GI_SOLVER_TIME);
 		GIHash_insert(&hEnumMap, "GI_HAS_ATTRIB", (GIvoid*)GI_HAS_ATTRIB);
 		GIHash_insert(&hEnumMap, "GI_ATTRIB_SIZE", (GIvoid*)GI_ATTRIB_SIZE);
 		GIHash_insert(&hEnumMap, "GI_ATTRIB_NORMALIZED", (GIvoid*)GI_ATTRIB_NORMALIZED);
@@ -821,6 +915,12 @@ GIenum GIAPIENTRY giGetEnumValue(const GIchar *name)
 		GIHash_insert(&hEnumMap, "GI_UNSYMMETRIC_SOLVER", (GIvoid*)GI_UNSYMMETRIC_SOLVER);
 		GIHash_insert(&hEnumMap, "GI_AREA_WEIGHT", (GIvoid*)GI_AREA_WEIGHT);
 		GIHash_insert(&hEnumMap, "GI_PARAM_SOURCE_ATTRIB", (GIvoid*)GI_PARAM_SOURCE_ATTRIB);
+		GIHash_insert(&hEnumMap, "GI_SYMMETRIC_SOLVER", (GIvoid*)GI_SYMMETRIC_SOLVER);
+		GIHash_insert(&hEnumMap, "GI_PRECONDITIONER", (GIvoid*)GI_PRECONDITIONER);
+		GIHash_insert(&hEnumMap, "GI_PARAM_ORDERING", (GIvoid*)GI_PARAM_ORDERING);
+		GIHash_insert(&hEnumMap, "GI_SOLVER_PRECISION", (GIvoid*)GI_SOLVER_PRECISION);
+		GIHash_insert(&hEnumMap, "GI_WARM_START", (GIvoid*)GI_WARM_START);
+		GIHash_insert(&hEnumMap, "GI_AUTOTUNE_SOLVER", (GIvoid*)GI_AUTOTUNE_SOLVER);
 		GIHash_insert(&hEnumMap, "GI_FROM_ATTRIB", (GIvoid*)GI_FROM_ATTRIB);
 		GIHash_insert(&hEnumMap, "GI_TUTTE_BARYCENTRIC", (GIvoid*)GI_TUTTE_BARYCENTRIC);
 		GIHash_insert(&hEnumMap, "GI_SHAPE_PRESERVING", (GIvoid*)GI_SHAPE_PRESERVING);
@@ -832,6 +932,13 @@ GIenum GIAPIENTRY giGetEnumValue(const GIchar *name)
 		GIHash_insert(&hEnumMap, "GI_GIM", (GIvoid*)GI_GIM);
 		GIHash_insert(&hEnumMap, "GI_SOLVER_BICGSTAB", (GIvoid*)GI_SOLVER_BICGSTAB);
 		GIHash_insert(&hEnumMap, "GI_SOLVER_GMRES", (GIvoid*)GI_SOLVER_GMRES);
+		GIHash_insert(&hEnumMap, "GI_SOLVER_CG", (GIvoid*)GI_SOLVER_CG);
+		GIHash_insert(&hEnumMap, "GI_SOLVER_LDLT", (GIvoid*)GI_SOLVER_LDLT);
+		GIHash_insert(&hEnumMap, "GI_PRECONDITIONER_ILU", (GIvoid*)GI_PRECONDITIONER_ILU);
+		GIHash_insert(&hEnumMap, "GI_PRECONDITIONER_AMG", (GIvoid*)GI_PRECONDITIONER_AMG);
+		GIHash_insert(&hEnumMap, "GI_ORDERING_RCM", (GIvoid*)GI_ORDERING_RCM);
+		GIHash_insert(&hEnumMap, "GI_PRECONDITIONER_JACOBI", (GIvoid*)GI_PRECONDITIONER_JACOBI);
+		GIHash_insert(&hEnumMap, "GI_PRECONDITIONER_SSOR", (GIvoid*)GI_PRECONDITIONER_SSOR);
 		GIHash_insert(&hEnumMap, "GI_PARAM_STARTED", (GIvoid*)GI_PARAM_STARTED);
 		GIHash_insert(&hEnumMap, "GI_PARAM_CHANGED", (GIvoid*)GI_PARAM_CHANGED);
 		GIHash_insert(&hEnumMap, "GI_PARAM_FINISHED", (GIvoid*)GI_PARAM_FINISHED);
@@ -895,6 +1002,7 @@ GIenum GIAPIENTRY giGetEnumValue(const GIchar *name)
 		GIHash_insert(&hEnumMap, "GI_NUMERICAL_ERROR", (GIvoid*)GI_NUMERICAL_ERROR);
 		GIHash_insert(&hEnumMap, "GI_UNSUPPORTED_OPERATION", (GIvoid*)GI_UNSUPPORTED_OPERATION);
 		GIHash_insert(&hEnumMap, "GI_INVALID_PARAMETERIZATION", (GIvoid*)GI_INVALID_PARAMETERIZATION);
+		GIOnce_end(&onceEnumMap);
 	}
 
 	/* return enum value */
@@ -921,7 +1029,13 @@ GIContext* GIContext_current()
 void GIContext_error(GIContext *context, GIenum error)
 {
 	/* set and print error */
+#if OPENGI_NUM_THREADS > 1
+	GIMutex_lock(&context->mutex);
+	context->error = error;
+	GIMutex_unlock(&context->mutex);
+#else
 	context->error = error;
+#endif
 	if(context->error_cb)
 		context->error_cb(error, context->edata);
 	else
@@ -96,6 +96,7 @@ typedef struct _GIContext
     GIenum			error;								/**< Error code of last encountered error. */
     GIerrorcb		error_cb;							/**< Error callback function. */
     GIvoid			*edata;								/**< User data for error callback. */
+    GIMutex			mutex;								/**< Mutex for error state and solver tuning. */
     GICutter		cutter;								/**< Cutting state. */
     GIParameterizer	parameterizer;						/**< Parameterizer state. */
     GISampler		sampler;							/**< Sampler state. */
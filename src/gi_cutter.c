@@ -549,7 +549,7 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
 
     /* create one param per vertex */
     GI_LIST_FOREACH(mesh->vertices, pVertex)
-        pParam = (GIParam*)GI_MALLOC_PERSISTENT(sizeof(GIParam));
+        pParam = (GIParam*)GI_MALLOC_ARENA(&mesh->cut_arena, sizeof(GIParam));
         GI_LIST_ADD(pPatch->params, pParam);
         pParam->id = pPatch->pcount++;
         GI_VEC2_SET(pParam->params, 0.0, 0.0);
@@ -578,7 +578,7 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
         pEdgeFlags[pHalfEdge->edge->id] = GI_EDGE_USED;
 
         /* create new param */
-        pParam = (GIParam*)GI_MALLOC_PERSISTENT(sizeof(GIParam));
+        pParam = (GIParam*)GI_MALLOC_ARENA(&mesh->cut_arena, sizeof(GIParam));
         GI_LIST_ADD(pPatch->params, pParam);
         pParam->id = pPatch->pcount++;
         GI_VEC2_SET(pParam->params, 0.0, 0.0);
@@ -625,6 +625,7 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
         if(cutter->straighten && pRoot->cut_degree > 2)
         {
             GIVertex *pVStart, *pVEnd, *pVOther, *pVPrev;
+            GIIndexedHeap qPathFringe;
             GIHash hNodes;
             GIDynamicQueue qCutPath;
             GIdouble *vend;
@@ -634,7 +635,7 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
             GIHalfEdge **pSources = (GIHalfEdge**)GI_CALLOC_ARRAY(mesh->vcount, sizeof(GIHalfEdge*));
             GIdouble *pDistances = (GIdouble*)GI_MALLOC_ARRAY(mesh->vcount, sizeof(GIdouble));
             GIdouble *pCutDistances = (GIdouble*)GI_MALLOC_ARRAY(mesh->ecount, sizeof(GIdouble));
-            GIHeap_construct(&qFringe, mesh->ecount, lessd, -DBL_MAX, GI_TRUE);
+            GIIndexedHeap_construct(&qPathFringe, GI_MAX(mesh->ecount, mesh->vcount), lessd);
             GIHash_construct(&hNodes, uiNodes, 0.0f, sizeof(GIuint), hash_uint, compare_uint, copy_uint);
             GIDynamicQueue_construct(&qCutPath);
 
@@ -721,7 +722,7 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
                             pHWork = pHWork->twin->next;
                             continue;
                         }
-                        GIHeap_clear(&qFringe);
+                        GIIndexedHeap_clear(&qPathFringe);
                         for(i=0; i<mesh->ecount; ++i)
                             pCutDistances[i] = DBL_MAX;
                         pVPrev = pVStart;
@@ -734,7 +735,7 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
                             pVertex->cut_degree = 0;
                             pEdgeFlags[pHalfEdge->edge->id] = GI_EDGE_BLACK;
                             pCutDistances[pHalfEdge->edge->id] = 0.0;
-                            GIHeap_enqueue(&qFringe, pHalfEdge->edge, 0.0);
+                            GIIndexedHeap_enqueue(&qPathFringe, pHalfEdge->edge->id, pHalfEdge->edge, 0.0);
                             GIDynamicQueue_enqueue(&qCutPath, pHalfEdge->edge);
                             pHalfEdge = pVertex->hedge;
                             while(pEdgeFlags[pHalfEdge->edge->id] != GI_EDGE_USEABLE)
@@ -744,10 +745,10 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
                         }
                         pEdgeFlags[pHalfEdge->edge->id] = GI_EDGE_USED;
                         pCutDistances[pHalfEdge->edge->id] = 0.0;
-                        GIHeap_enqueue(&qFringe, pHalfEdge->edge, 0.0);
+                        GIIndexedHeap_enqueue(&qPathFringe, pHalfEdge->edge->id, pHalfEdge->edge, 0.0);
                         GIDynamicQueue_enqueue(&qCutPath, pHalfEdge->edge);
                         pCutDistances[pHWork->edge->id] = 0.0;
-                        GIHeap_enqueue(&qFringe, pHWork->edge, 0.0);
+                        GIIndexedHeap_enqueue(&qPathFringe, pHWork->edge->id, pHWork->edge, 0.0);
                         GIDynamicQueue_enqueue(&qCutPath, pHWork->edge);
                         GIDynamicQueue_enqueue(&qVertices, pVertex);
                         pVEnd = pVPrev;
@@ -756,9 +757,9 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
                         /* compute distances of edges to old cut */
                         GIDebug(printf("dijkstra ... "));
                         dMinDist = DBL_MAX;
-                        while(qFringe.count)
+                        while(qPathFringe.count)
                         {
-                            pEdge = GIHeap_dequeue(&qFringe, &dOldDist);
+                            pEdge = GIIndexedHeap_dequeue(&qPathFringe, &dOldDist);
                             GI_VEC3_ADD(vec, pEdge->hedge[0].vstart->coords, 
                                 pEdge->hedge[1].vstart->coords);
                             GI_VEC3_SCALE(vec, vec, 0.5);
@@ -776,7 +777,7 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
                                     if(dDist < pCutDistances[pEWork->id])
                                     {
                                         pCutDistances[pEWork->id] = dDist;
-                                        GIHeap_enqueue(&qFringe, pEWork, dDist);
+                                        GIIndexedHeap_enqueue(&qPathFringe, pEWork->id, pEWork, dDist);
                                         if(dDist < dMinDist)
                                             dMinDist = dDist;
                                     }
@@ -792,7 +793,7 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
 
                         /* find shortest path (Dijkstra) */
                         GIDebug(printf("dijkstra ... "));
-                        GIHeap_clear(&qFringe);
+                        GIIndexedHeap_clear(&qPathFringe);
                         pDistances[pVStart->id] = 0.0;
                         memset(pSources, 0, mesh->vcount*sizeof(GIHalfEdge*));
                         pVertex = pVStart;
@@ -812,13 +813,13 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
                                     {
                                         pSources[uiID] = pHalfEdge;
                                         pDistances[uiID] = dDist;
-                                        GIHeap_enqueue(&qFringe, pVOther, 
+                                        GIIndexedHeap_enqueue(&qPathFringe, uiID, pVOther, 
                                             dDist/*+GIvec3d_dist(pVOther->coords, vend)*/);
                                     }
                                 }
                                 pHalfEdge = pHalfEdge->twin->next;
                             }while(pHalfEdge != pVertex->hedge);
-                            pVertex = GIHeap_dequeue(&qFringe, NULL);
+                            pVertex = GIIndexedHeap_dequeue(&qPathFringe, NULL);
                         }
 
                         /* retrace shortest path and assemble cut path */
@@ -845,7 +846,7 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
             /* clean up */
             GI_FREE_ARRAY(pSources);
             GI_FREE_ARRAY(pDistances);
-            GIHeap_destruct(&qFringe);
+            GIIndexedHeap_destruct(&qPathFringe);
             GIHash_destruct(&hNodes, 0);
         }
         ubDegree = pRoot->cut_degree;
@@ -869,7 +870,7 @@ GIint GICutter_initial_gim(GICutter *cutter, GIMesh *mesh)
             pParam = pHalfEdge->pstart;
             if(pParam->cut_hedge)
             {
-                pParam = (GIParam*)GI_MALLOC_PERSISTENT(sizeof(GIParam));
+                pParam = (GIParam*)GI_MALLOC_ARENA(&mesh->cut_arena, sizeof(GIParam));
                 GI_LIST_ADD(pPatch->params, pParam);
                 pParam->id = pPatch->pcount++;
                 GI_VEC2_SET(pParam->params, 0.0, 0.0);
@@ -1109,7 +1110,7 @@ GIint GICutter_seamless_atlas(GICutter *cutter, GIMesh *mesh)
             pair.second = pHStart->vstart->id;
 
             /* set median */
-            pVertex = (GIVertex*)GIHash_find(&hMedians, &pair);
+            pVertex = (GIVertex*)GIHash_find_uintpair(&hMedians, &pair);
             if(!pVertex)
             {
                 /* find median */
@@ -1142,7 +1143,7 @@ GIint GICutter_seamless_atlas(GICutter *cutter, GIMesh *mesh)
                     pVertex = pHalfEdge->next->vstart;
                 else
                     pVertex = pHalfEdge->vstart;
-                GIHash_insert(&hMedians, &pair, pVertex);
+                GIHash_insert_uintpair(&hMedians, &pair, pVertex);
             }
             pClusterPatch->boundaries[j].median = pVertex;
         }
@@ -1392,7 +1393,7 @@ GIint GICutter_catmull_clark(GICutter *cutter, GIMesh *mesh)
             for(l=0; l<4; ++l,m=(m+1)&3)
             {
                 pPatch->corners[l] = pBoundary[m]->pstart = pParam = 
-                    (GIParam*)GI_MALLOC_PERSISTENT(sizeof(GIParam));
+                    (GIParam*)GI_MALLOC_ARENA(&mesh->cut_arena, sizeof(GIParam));
                 GI_LIST_ADD(pPatch->params, pParam);
                 pParam->id = l;
                 GI_VEC2_COPY(pParam->params, corners+(l<<1));
@@ -1738,7 +1739,7 @@ GIboolean GICutter_create_params(GICutter *cutter, GIMesh *mesh,
                 pHStart = pHStart->prev->twin;
         pHalfEdge = pHStart->face ? pHStart : pHStart->prev->twin;
         pPatch = mesh->patches + patch_ids[pHalfEdge->face->id];
-        pParam = (GIParam*)GI_MALLOC_PERSISTENT(sizeof(GIParam));
+        pParam = (GIParam*)GI_MALLOC_ARENA(&mesh->cut_arena, sizeof(GIParam));
         GI_LIST_ADD(pPatch->params, pParam);
         pParam->id = pPatch->pcount++;
         GI_VEC2_COPY(pParam->params, (GIfloat*)pHalfEdge->pstart);
@@ -1754,7 +1755,7 @@ GIboolean GICutter_create_params(GICutter *cutter, GIMesh *mesh,
             if(cut_flags[pHalfEdge->edge->id])
             {
                 pPatch = mesh->patches + patch_ids[pHalfEdge->face->id];
-                pParam = (GIParam*)GI_MALLOC_PERSISTENT(sizeof(GIParam));
+                pParam = (GIParam*)GI_MALLOC_ARENA(&mesh->cut_arena, sizeof(GIParam));
                 GI_LIST_ADD(pPatch->params, pParam);
                 pParam->id = pPatch->pcount++;
                 GI_VEC2_COPY(pParam->params, (GIfloat*)pHalfEdge->pstart);
@@ -1815,7 +1816,7 @@ void GICutter_straighten_paths(GICutter *cutter, GIMesh *mesh,
     GIHalfEdge *pHalfEdge;
     GIVertex *pVEnd, *pVStart, *pVertex;
     GIDynamicQueue qCutPaths;
-    GIHeap qFringe;
+    GIIndexedHeap qFringe;
     GIHash hPathInfos;
     GIPathInfo *pInfo;
     GIdouble *vend;
@@ -1824,7 +1825,7 @@ void GICutter_straighten_paths(GICutter *cutter, GIMesh *mesh,
         return;
 
     /* intialize data structures */
-    GIHeap_construct(&qFringe, mesh->vcount, lessd, -DBL_MAX, GI_TRUE);
+    GIIndexedHeap_construct(&qFringe, mesh->vcount, lessd);
     GIHash_construct(&hPathInfos, (GIuint)sqrt((GIdouble)mesh->vcount), 
         0.0f, sizeof(GIuint), hash_uint, compare_uint, copy_uint);
     GIDynamicQueue_construct(&qCutPaths);
@@ -1874,7 +1875,7 @@ void GICutter_straighten_paths(GICutter *cutter, GIMesh *mesh,
             vend = pVEnd->coords;
 
             /* find new cut path by A* */
-            GIHeap_clear(&qFringe);
+            GIIndexedHeap_clear(&qFringe);
             GIHash_clear(&hPathInfos, sizeof(GIPathInfo));
             GIHash_insert(&hPathInfos, &pVStart->id, 
                 GI_CALLOC_SINGLE(sizeof(GIPathInfo)));
@@ -1897,13 +1898,13 @@ void GICutter_straighten_paths(GICutter *cutter, GIMesh *mesh,
                                     (GIPathInfo*)GI_MALLOC_SINGLE(sizeof(GIPathInfo)));
                             pInfo->source = pHalfEdge;
                             pInfo->distance = dDist;
-                            GIHeap_enqueue(&qFringe, pVOther, 
+                            GIIndexedHeap_enqueue(&qFringe, pVOther->id, pVOther, 
                                 dDist+GIvec3d_dist(pVOther->coords, vend));
                         }
                     }
                     pHalfEdge = pHalfEdge->twin->next;
                 }while(pHalfEdge != pVertex->hedge);
-                pVertex = GIHeap_dequeue(&qFringe, &dOldDist);
+                pVertex = GIIndexedHeap_dequeue(&qFringe, &dOldDist);
             }
 
             /* retrace and assemble new cut path */
@@ -1932,7 +1933,7 @@ void GICutter_straighten_paths(GICutter *cutter, GIMesh *mesh,
     }
 
     /* clean up */
-    GIHeap_destruct(&qFringe);
+    GIIndexedHeap_destruct(&qFringe);
     GIHash_destruct(&hPathInfos, sizeof(GIPathInfo));
     GIDynamicQueue_destruct(&qCutPaths);
 }
@@ -2014,7 +2015,7 @@ void GICutter_compute_paths(GICutter *cutter, GIMesh *mesh)
         pPatch->hlength = 0.0;
         pPatch->path_count = 0;
         pPatch->groups = 0;
-        GI_LIST_CLEAR_PERSISTENT(pPatch->paths, sizeof(GICutPath));
+        GI_LIST_CLEAR_ARENA(pPatch->paths, &mesh->cut_arena, sizeof(GICutPath));
         GIDynamicQueue_clear(&pPatch->split_paths);
 
         /* accumulate path information */
@@ -2037,7 +2038,7 @@ void GICutter_compute_paths(GICutter *cutter, GIMesh *mesh)
                 }
 
                 /* cut hedge allready in hash */
-                pPath = (GICutPath*)GI_MALLOC_PERSISTENT(sizeof(GICutPath));
+                pPath = (GICutPath*)GI_MALLOC_ARENA(&mesh->cut_arena, sizeof(GICutPath));
                 GI_LIST_ADD(pPatch->paths, pPath);
                 pPath->id = pPatch->path_count++;
                 pPath->patch = pPatch;
@@ -2087,14 +2088,15 @@ void GICutter_compute_paths(GICutter *cutter, GIMesh *mesh)
 
 /** \internal
  *  \brief Patch destructor.
+ *  \details Params and cut paths are released with the cut arena of the mesh.
  *  \param patch patch to destruct
  *  \ingroup cutting
  */
 void GIPatch_destruct(GIPatch *patch)
 {
-    /* clear lists */
-    GI_LIST_CLEAR_PERSISTENT(patch->paths, sizeof(GICutPath));
-    GI_LIST_CLEAR_PERSISTENT(patch->params, sizeof(GIParam));
+    /* clear lists (released with cut arena of mesh) */
+    patch->paths = NULL;
+    patch->params = NULL;
     GIDynamicQueue_destruct(&patch->split_paths);
 }
 
@@ -2143,6 +2145,170 @@ void GIPatch_renumerate_params(GIPatch *patch)
     GI_LIST_NEXT(patch->params, pParam)
 }
 
+/** \internal
+ *  \brief Breadth-first search over graph of interior params.
+ *  \param xadj start indices of adjacencies
+ *  \param adj adjacent params
+ *  \param root param to start from
+ *  \param level array of levels (unvisited params have UINT_MAX, reset on return)
+ *  \param queue array to store visited params in
+ *  \param last address to store param of last level with minimum degree at
+ *  \return number of levels
+ *  \ingroup cutting
+ */
+static GIuint param_bfs(const GIuint *xadj, const GIuint *adj, GIuint root, 
+                        GIuint *level, GIuint *queue, GIuint *last)
+{
+    GIuint i, ij, uiHead = 0, uiTail = 1, uiLevels;
+
+    /* visit params level by level */
+    queue[0] = root;
+    level[root] = 0;
+    while(uiHead < uiTail)
+    {
+        i = queue[uiHead++];
+        for(ij=xadj[i]; ij<xadj[i+1]; ++ij)
+        {
+            if(level[adj[ij]] == UINT_MAX)
+            {
+                level[adj[ij]] = level[i] + 1;
+                queue[uiTail++] = adj[ij];
+            }
+        }
+    }
+
+    /* find param of last level with minimum degree and reset levels */
+    uiLevels = level[queue[uiTail-1]] + 1;
+    *last = queue[uiTail-1];
+    while(uiTail)
+    {
+        i = queue[--uiTail];
+        if(level[i] == uiLevels-1 && xadj[i+1]-xadj[i] < xadj[*last+1]-xadj[*last])
+            *last = i;
+        level[i] = UINT_MAX;
+    }
+    return uiLevels;
+}
+
+/** \internal
+ *  \brief Renumerate interior params in reverse Cuthill-McKee order.
+ *  \details This reduces the bandwidth of the linear systems built for 
+ *  the patch, so that matrix rows mostly access nearby unknowns. Every 
+ *  connected component starts at a pseudo-peripheral param. Border params 
+ *  keep their ids.
+ *  \param patch patch to work on
+ *  \ingroup cutting
+ */
+void GIPatch_reorder_params(GIPatch *patch)
+{
+    GIParam **pParams, *pParam;
+    GIHalfEdge *pHalfEdge, *pEnd;
+    GIuint *pXAdj, *pAdj, *pLevel, *pOrder, *pQueue;
+    GIuint i, j, ij, s, uiRoot, uiNext, uiCand, uiEcc, uiEcc2, uiHead, uiTail;
+    GIuint uiOldBandwidth = 0, uiNewBandwidth = 0, N = patch->pcount - patch->hcount;
+    if(N < 3)
+        return;
+
+    /* collect interior params and count their interior neighbours */
+    pParams = (GIParam**)GI_MALLOC_ARRAY(N, sizeof(GIParam*));
+    pXAdj = (GIuint*)GI_CALLOC_ARRAY(N+1, sizeof(GIuint));
+    GI_LIST_FOREACH(patch->params, pParam)
+        if(!pParam->cut_hedge)
+        {
+            pParams[pParam->id] = pParam;
+            pHalfEdge = pEnd = pParam->vertex->hedge->twin;
+            do
+            {
+                if(pHalfEdge->pstart->id < N)
+                    ++pXAdj[pParam->id+1];
+                pHalfEdge = pHalfEdge->next->twin;
+            }while(pHalfEdge != pEnd);
+        }
+    GI_LIST_NEXT(patch->params, pParam)
+    for(i=0; i<N; ++i)
+        pXAdj[i+1] += pXAdj[i];
+
+    /* build adjacency graph */
+    pAdj = (GIuint*)GI_MALLOC_ARRAY(pXAdj[N], sizeof(GIuint));
+    for(i=0; i<N; ++i)
+    {
+        ij = pXAdj[i];
+        pHalfEdge = pEnd = pParams[i]->vertex->hedge->twin;
+        do
+        {
+            j = pHalfEdge->pstart->id;
+            if(j < N)
+            {
+                pAdj[ij++] = j;
+                if(i > j && i-j > uiOldBandwidth)
+                    uiOldBandwidth = i - j;
+            }
+            pHalfEdge = pHalfEdge->next->twin;
+        }while(pHalfEdge != pEnd);
+    }
+
+    /* order components breadth-first from pseudo-peripheral params */
+    pLevel = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+    pOrder = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+    pQueue = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+    memset(pLevel, 0xFF, N*sizeof(GIuint));
+    for(s=0,uiTail=0; s<N; ++s)
+    {
+        if(pParams[s] == NULL)
+            continue;
+        uiRoot = s;
+        uiEcc = param_bfs(pXAdj, pAdj, uiRoot, pLevel, pQueue, &uiNext);
+        while((uiEcc2=param_bfs(pXAdj, pAdj, uiNext, pLevel, pQueue, &uiCand)) > uiEcc)
+        {
+            uiRoot = uiNext;
+            uiNext = uiCand;
+            uiEcc = uiEcc2;
+        }
+
+        /* visit neighbours by increasing degree */
+        uiHead = uiTail;
+        pOrder[uiTail++] = uiRoot;
+        pParams[uiRoot] = NULL;
+        while(uiHead < uiTail)
+        {
+            GIuint uiStart = uiTail;
+            i = pOrder[uiHead++];
+            for(ij=pXAdj[i]; ij<pXAdj[i+1]; ++ij)
+            {
+                j = pAdj[ij];
+                if(pParams[j] == NULL)
+                    continue;
+                pParams[j] = NULL;
+                for(uiCand=uiTail++; uiCand>uiStart && pXAdj[j+1]-pXAdj[j] < 
+                    pXAdj[pOrder[uiCand-1]+1]-pXAdj[pOrder[uiCand-1]]; --uiCand)
+                    pOrder[uiCand] = pOrder[uiCand-1];
+                pOrder[uiCand] = j;
+            }
+        }
+    }
+
+    /* renumerate params in reverse order */
+    for(i=0; i<N; ++i)
+        pLevel[pOrder[i]] = N - 1 - i;
+    for(i=0; i<N; ++i)
+        for(ij=pXAdj[i]; ij<pXAdj[i+1]; ++ij)
+            if(pLevel[i] > pLevel[pAdj[ij]] && pLevel[i]-pLevel[pAdj[ij]] > uiNewBandwidth)
+                uiNewBandwidth = pLevel[i] - pLevel[pAdj[ij]];
+    GI_LIST_FOREACH(patch->params, pParam)
+        if(!pParam->cut_hedge)
+            pParam->id = pLevel[pParam->id];
+    GI_LIST_NEXT(patch->params, pParam)
+    GIDebug(printf("param bandwidth: %u -> %u\n", uiOldBandwidth, uiNewBandwidth));
+
+    /* clean up */
+    GI_FREE_ARRAY(pParams);
+    GI_FREE_ARRAY(pXAdj);
+    GI_FREE_ARRAY(pAdj);
+    GI_FREE_ARRAY(pLevel);
+    GI_FREE_ARRAY(pOrder);
+    GI_FREE_ARRAY(pQueue);
+}
+
 /** \internal
  *  \brief Search for vertices with corner flag set.
  *  \param patch patch to work on
@@ -2327,7 +2493,7 @@ GIboolean GIPatch_split_path(GIPatch *patch, GICutPath *path, GIParam *param)
         return GI_FALSE;
 
     /* create path */
-    pNew = (GICutPath*)GI_MALLOC_PERSISTENT(sizeof(GICutPath));
+    pNew = (GICutPath*)GI_MALLOC_ARENA(&patch->mesh->cut_arena, sizeof(GICutPath));
     GI_LIST_INSERT(patch->paths, path->next, pNew);
     pNew->id = patch->path_count++;
     pNew->patch = patch;
@@ -2338,7 +2504,7 @@ GIboolean GIPatch_split_path(GIPatch *patch, GICutPath *path, GIParam *param)
     /* split twin if same patch */
     if(pTwin && pTwin->patch == patch)
     {
-        pNew2 = (GICutPath*)GI_MALLOC_PERSISTENT(sizeof(GICutPath));
+        pNew2 = (GICutPath*)GI_MALLOC_ARENA(&patch->mesh->cut_arena, sizeof(GICutPath));
         GI_LIST_INSERT(patch->paths, pTwin->next, pNew2);
         pNew2->id = patch->path_count++;
         pNew2->patch = patch;
@@ -2375,7 +2541,7 @@ void GIPatch_revert_splits(GIPatch *patch, GIint count)
         /* delete path */
         pPath->elength += pPath2->elength;
         pPath->glength += pPath2->glength;
-        GI_LIST_DELETE_PERSISTENT(patch->paths, pPath2, sizeof(GICutPath));
+        GI_LIST_DELETE_ARENA(patch->paths, &patch->mesh->cut_arena, pPath2, sizeof(GICutPath));
         --patch->path_count;
         --patch->groups;
 
@@ -2383,7 +2549,7 @@ void GIPatch_revert_splits(GIPatch *patch, GIint count)
         if(pTwin && pTwin->patch == patch)
         {
             pPath2 = pTwin->next;
-            GI_LIST_DELETE_PERSISTENT(patch->paths, pPath2, sizeof(GICutPath));
+            GI_LIST_DELETE_ARENA(patch->paths, &patch->mesh->cut_arena, pPath2, sizeof(GICutPath));
             --patch->path_count;
             pTwin->group = pPath->group;
             pTwin->elength = pPath->elength;
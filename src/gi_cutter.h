@@ -41,6 +41,10 @@
 #include "gi_mesh.h"
 #include "gi_container.h"
 
+#define GI_SOLVER_TIME_BASE		GI_ASSEMBLY_TIME
+#define GI_SOLVER_TIME_END		GI_SOLVER_TIME
+#define GI_SOLVER_TIME_COUNT	(GI_SOLVER_TIME_END-GI_SOLVER_TIME_BASE+1)
+
 
 /*************************************************************************/
 /* Structures */
@@ -59,6 +63,19 @@ typedef struct _GICutter
 	GIfloat				shape_weight;				/**< Weight of shape bias for face clustering. */
 } GICutter;
 
+/** \internal
+ *  \brief Statistics of linear systems solved for a patch.
+ *  \ingroup cutting
+ */
+typedef struct _GISolverStats
+{
+	GIuint				rows;						/**< Number of unknowns of last system. */
+	GIuint				nnz;						/**< Number of stored coefficients of last system. */
+	GIuint				iterations;					/**< Iterations of slower coordinate summed over all systems. */
+	GIdouble			residual;					/**< Maximum relative residual of last solution. */
+	GIdouble			times[GI_SOLVER_TIME_COUNT];	/**< Seconds for assembly, setup and solving. */
+} GISolverStats;
+
 /** \internal
  *  \brief Mesh patch.
  *  \details This structure represents a patch as a subset of faces.
@@ -88,6 +105,7 @@ typedef struct _GIPatch
 	GIenum				param_metric;				/**< Current stretch metric for param stretch. */
 	GIboolean			parameterized;				/**< Patch has valid parameterization. */
 	GIboolean			fixed_corners;				/**< Patch corners are permanent. */
+	GISolverStats		solver_stats;				/**< Statistics of last parameterization. */
 	GIDynamicQueue		split_paths;				/**< Stack of path splits. */
 	struct _GIPatch		*next;						/**< Next patch (for convenience). */
 } GIPatch;
@@ -138,6 +156,7 @@ void GICutter_compute_paths(GICutter *cutter, GIMesh *mesh);
 void GIPatch_destruct(GIPatch *patch);
 void GIPatch_prevent_singularities(GIPatch *patch);
 void GIPatch_renumerate_params(GIPatch *patch);
+void GIPatch_reorder_params(GIPatch *patch);
 GIboolean GIPatch_find_corners(GIPatch *patch);
 GIboolean GIPatch_valid_parameterization(GIPatch *patch);
 GIboolean GIPatch_split_path(GIPatch *patch, GICutPath *path, GIParam *param);
@@ -29,21 +29,35 @@
  *  \brief Implementation of structures and functions for memory management.
  */
 
+/* posix_memalign is hidden by strict C standard modes */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+	#define _POSIX_C_SOURCE		200112L
+#endif
+
 #include "gi_memory.h"
 #include "gi_math.h"
 
 #include <assert.h>
 #include <limits.h>
+#ifdef _WIN32
+	#include <malloc.h>
+#endif
 
 #define GI_CHUNKSIZE				2048
 #define GI_MAX_BLOCKSIZE			256
 #define GI_ALIGNMENT				4
 #define GI_MIN_OBJPERCHUNK			8
-#define GI_MAX_OBJPERCHUNK			(UCHAR_MAX+1)
+#define GI_MAX_OBJPERCHUNK			UCHAR_MAX
+#define GI_CHUNK_HEADER				16
 
 #define GI_ALIGN_OFFSET(n)			((n+GI_ALIGNMENT-1)/GI_ALIGNMENT)
 
-#define GI_CHUNK_CONTAINS(c,p,s)	((GIubyte*)p>=c->data && (GIubyte*)p<(c->data+s))
+#define GI_CHUNK_INDEX(c)			(*(GIusize*)((c)->data-GI_CHUNK_HEADER))
+
+#define GI_ARENA_BLOCKSIZE			65536
+#define GI_ARENA_MAX_BLOCKSIZE		4194304
+#define GI_ARENA_SIZE(n)			(((n)+GI_ARENA_ALIGNMENT-1)&~(GIusize)(GI_ARENA_ALIGNMENT-1))
+#define GI_ARENA_HEADER				GI_ARENA_SIZE(sizeof(GIubyte*))
 
 
 /** \internal
@@ -52,11 +66,25 @@
  */
 GISmallObjectAllocator g_SmallObjAlloc = { NULL };
 
+#if OPENGI_NUM_THREADS > 1
 /** \internal
- *  \brief Global allocator object for persistent.
+ *  \brief Block caches of calling thread.
  *  \ingroup memory
  */
-GISmallObjectAllocator g_PersistentAlloc = { NULL };
+static GI_THREAD_LOCAL GIThreadCache *t_pThreadCaches = NULL;
+
+/** \internal
+ *  \brief Key to release block caches of exiting threads.
+ *  \ingroup memory
+ */
+static GIThreadKey g_CacheKey;
+
+/** \internal
+ *  \brief Initialization flag of cache key.
+ *  \ingroup memory
+ */
+static GIOnce g_CacheKeyInit = GI_ONCE_INIT;
+#endif
 
 
 /** \internal
@@ -106,19 +134,31 @@ void GIMemory_deallocate_aligned(GIvoid *address)
 
 /** \internal
  *  \brief Chunk constructor.
+ *  \details The chunk memory is aligned to its size and starts with a header 
+ *  storing the chunk's index, so the chunk of a block can be found directly.
  *  \param chunk chunk to construct
  *  \param block_size size of blocks
  *  \param blocks number of blocks
+ *  \param size size of chunk memory including header (power of 2)
  *  \retval GI_TRUE if constructed successfully
  *  \retval GI_FALSE if out of memory
  *  \ingroup memory
  */
-GIboolean GIChunk_construct(GIChunk *chunk, GIuint block_size, GIuint blocks)
+GIboolean GIChunk_construct(GIChunk *chunk, GIuint block_size, 
+                            GIuint blocks, GIuint size)
 {
     GIuint i;
-    GIubyte *p = chunk->data = (GIubyte*)malloc(block_size*blocks*sizeof(GIubyte));
-    if(!chunk->data)
+    GIubyte *p;
+    assert(GI_POWER_OF_2(size) && GI_CHUNK_HEADER+block_size*blocks <= size);
+#ifdef _WIN32
+    p = (GIubyte*)_aligned_malloc(size, size);
+#else
+    if(posix_memalign((void**)&p, size, size))
+        p = NULL;
+#endif
+    if(!p)
         return GI_FALSE;
+    p = chunk->data = p + GI_CHUNK_HEADER;
 
     /* init list of free blocks */
     chunk->first_free_block = 0;
@@ -137,7 +177,11 @@ void GIChunk_destruct(GIChunk *chunk)
 {
     /* free chunk memory */
     assert(chunk->data);
-    free(chunk->data);
+#ifdef _WIN32
+    _aligned_free(chunk->data-GI_CHUNK_HEADER);
+#else
+    free(chunk->data-GI_CHUNK_HEADER);
+#endif
 }
 
 /** \internal
@@ -186,11 +230,20 @@ void GIChunk_deallocate(GIChunk *chunk, GIvoid *address, GIuint block_size)
  */
 void GIFixedAllocator_construct(GIFixedAllocator *alloc, GIuint block_size)
 {
-    /* init allocator */
+    GIuint uiBlocks;
+
+    /* find power of 2 chunk size (not larger than needed for max blocks) */
     alloc->block_size = block_size;
-    alloc->num_blocks = GI_CHUNKSIZE / block_size;
-    alloc->num_blocks = GI_CLAMP(alloc->num_blocks, 
-        GI_MIN_OBJPERCHUNK, GI_MAX_OBJPERCHUNK);
+    alloc->chunk_size = GI_CHUNKSIZE;
+    while((alloc->chunk_size-GI_CHUNK_HEADER)/block_size < GI_MIN_OBJPERCHUNK)
+        alloc->chunk_size <<= 1;
+    while((alloc->chunk_size-GI_CHUNK_HEADER)/block_size > GI_MAX_OBJPERCHUNK && 
+        ((alloc->chunk_size>>1)-GI_CHUNK_HEADER)/block_size >= GI_MIN_OBJPERCHUNK)
+        alloc->chunk_size >>= 1;
+    uiBlocks = (alloc->chunk_size-GI_CHUNK_HEADER) / block_size;
+    alloc->num_blocks = GI_MIN(uiBlocks, GI_MAX_OBJPERCHUNK);
+
+    /* init allocator */
     alloc->num_chunks = alloc->max_chunks = 0;
     alloc->first_free_chunk = 0;
     alloc->chunks = NULL;
@@ -251,8 +304,10 @@ GIvoid* GIFixedAllocator_allocate(GIFixedAllocator *alloc)
                     /* init chunk and update cache */
                     alloc->dealloc_chunk = alloc->chunks;
                     alloc->alloc_chunk = alloc->chunks + i;
-                    if(!GIChunk_construct(alloc->alloc_chunk, alloc->block_size, alloc->num_blocks))
+                    if(!GIChunk_construct(alloc->alloc_chunk, alloc->block_size, 
+                        alloc->num_blocks, alloc->chunk_size))
                         return alloc->alloc_chunk = NULL;
+                    GI_CHUNK_INDEX(alloc->alloc_chunk) = i;
                     ++alloc->num_chunks;
                     break;
                 }
@@ -300,6 +355,7 @@ void GIFixedAllocator_deallocate(GIFixedAllocator *alloc, GIvoid *address)
             {
                 GIChunk temp;
                 GI_SWAP(*pLast, *alloc->empty_chunk, temp);
+                GI_CHUNK_INDEX(alloc->empty_chunk) = alloc->empty_chunk - alloc->chunks;
             }
             assert(pLast->num_free_blocks == alloc->num_blocks);
             GIChunk_destruct(pLast);
@@ -320,6 +376,8 @@ void GIFixedAllocator_deallocate(GIFixedAllocator *alloc, GIvoid *address)
 
 /** \internal
  *  \brief Find chunk to given memory address
+ *  \details This takes constant time, as chunks are aligned to their size 
+ *  and store their index.
  *  \param alloc fixed allocator to search in
  *  \param address address to look for
  *  \return chunk containing specified block or NULL if not found
@@ -327,41 +385,16 @@ void GIFixedAllocator_deallocate(GIFixedAllocator *alloc, GIvoid *address)
  */
 GIChunk* GIFixedAllocator_find(GIFixedAllocator *alloc, GIvoid *address)
 {
-    GIChunk *pLo = alloc->dealloc_chunk, *pHi = alloc->dealloc_chunk+1, 
-        *pLoBound = alloc->chunks, *pHiBound = alloc->chunks+alloc->num_chunks;
-    GIuint uiChunkSize = alloc->block_size * alloc->num_blocks;
+    GIubyte *pBase = (GIubyte*)((GIusize)address & ~(GIusize)(alloc->chunk_size-1));
+    GIusize i;
+    if(!alloc->num_chunks)
+        return NULL;
 
-    /* bidirectional search starting at last deallocation */
-    if(pHi == pHiBound)
-        pHi = NULL;
-    for(;;)
-    {
-        if(pLo)
-        {
-            if(GI_CHUNK_CONTAINS(pLo, address, uiChunkSize))
-                return pLo;
-            if(pLo == pLoBound)
-            {
-                pLo = NULL;
-                if(!pHi)
-                    break;
-            }
-            else
-                --pLo;
-        }
-        if(pHi)
-        {
-            if(GI_CHUNK_CONTAINS(pHi, address, uiChunkSize))
-                return pHi;
-            if(++pHi == pHiBound)
-            {
-                pHi = NULL;
-                if(!pLo)
-                    break;
-            }
-        }
-    }
-    return NULL;
+    /* read index from header of aligned chunk memory */
+    i = *(GIusize*)pBase;
+    if(i >= alloc->num_chunks || alloc->chunks[i].data != pBase+GI_CHUNK_HEADER)
+        return NULL;
+    return alloc->chunks + i;
 }
 
 /** \internal
@@ -381,6 +414,7 @@ GIboolean GIFixedAllocator_truncate(GIFixedAllocator *alloc)
         {
             GIChunk temp;
             GI_SWAP(*alloc->empty_chunk, *pLast, temp);
+            GI_CHUNK_INDEX(alloc->empty_chunk) = alloc->empty_chunk - alloc->chunks;
         }
         assert(pLast->num_free_blocks == alloc->num_blocks);
         GIChunk_destruct(pLast);
@@ -412,6 +446,53 @@ GIboolean GIFixedAllocator_truncate(GIFixedAllocator *alloc)
     return GI_TRUE;
 }
 
+/** \internal
+ *  \brief Refill magazine from fixed allocator.
+ *  \details Fixed allocator has to be locked by caller.
+ *  \param magazine magazine to refill
+ *  \param alloc fixed allocator to take blocks from
+ *  \param count number of blocks to take
+ *  \return number of blocks actually taken
+ *  \ingroup memory
+ */
+GIuint GIMagazine_refill(GIMagazine *magazine, GIFixedAllocator *alloc, GIuint count)
+{
+    GIuint i;
+    GIvoid *pBlock;
+
+    /* take blocks till full or out of memory */
+    assert(magazine->num_blocks+count <= GI_MAGAZINE_SIZE);
+    for(i=0; i<count; ++i)
+    {
+        if(!(pBlock=GIFixedAllocator_allocate(alloc)))
+            break;
+        magazine->blocks[magazine->num_blocks++] = pBlock;
+    }
+    return i;
+}
+
+/** \internal
+ *  \brief Return blocks of magazine to fixed allocator.
+ *  \details Fixed allocator has to be locked by caller. The least recently 
+ *  cached blocks are returned first.
+ *  \param magazine magazine to take blocks from
+ *  \param alloc fixed allocator to return blocks to
+ *  \param count number of blocks to return
+ *  \ingroup memory
+ */
+void GIMagazine_release(GIMagazine *magazine, GIFixedAllocator *alloc, GIuint count)
+{
+    GIuint i;
+
+    /* return oldest blocks and move remaining to front */
+    if(count > magazine->num_blocks)
+        count = magazine->num_blocks;
+    for(i=0; i<count; ++i)
+        GIFixedAllocator_deallocate(alloc, magazine->blocks[i]);
+    magazine->num_blocks -= count;
+    memmove(magazine->blocks, magazine->blocks+count, magazine->num_blocks*sizeof(GIvoid*));
+}
+
 /** \internal
  *  \brief Small object allocator constructor.
  *  \param alloc allocator to construct
@@ -428,16 +509,34 @@ void GISmallObjectAllocator_construct(GISmallObjectAllocator *alloc)
     alloc->pool = (GIFixedAllocator*)malloc(uiNumAllocs*sizeof(GIFixedAllocator));
     for(i=0; i<uiNumAllocs; ++i)
         GIFixedAllocator_construct(alloc->pool+i, (i+1)*GI_ALIGNMENT);
+    alloc->caches = NULL;
 }
 
 /** \internal
  *  \brief Small object allocator destructor.
+ *  \details Other threads that used the allocator have to release their 
+ *  caches with GIMemory_release_caches or exit before.
  *  \param alloc allocator to destruct
  *  \ingroup memory
  */
 void GISmallObjectAllocator_destruct(GISmallObjectAllocator *alloc)
 {
     GIuint i, uiNumAllocs = GI_ALIGN_OFFSET(GI_MAX_BLOCKSIZE);
+#if OPENGI_NUM_THREADS > 1
+    GIThreadCache *pCache, **pLink;
+
+    /* drop cache of calling thread, blocks are freed with chunks */
+    for(pLink=&t_pThreadCaches; *pLink && (*pLink)->alloc!=alloc; pLink=&(*pLink)->next) ;
+    if((pCache=*pLink))
+    {
+        *pLink = pCache->next;
+        for(pLink=&alloc->caches; *pLink!=pCache; pLink=&(*pLink)->next_alloc) ;
+        *pLink = pCache->next_alloc;
+        free(pCache->magazines);
+        free(pCache);
+    }
+    assert(!alloc->caches);
+#endif
 
     /* clean up */
     for(i=0; i<uiNumAllocs; ++i)
@@ -461,28 +560,44 @@ GIvoid* GISmallObjectAllocator_allocate(GISmallObjectAllocator *alloc,
 {
     GIvoid *pResult;
     GIFixedAllocator *pAlloc;
+#if OPENGI_NUM_THREADS > 1
+    GIThreadCache *pCache;
+#endif
     if(size > GI_MAX_BLOCKSIZE)
         return malloc(size);
 
     /* find allocator for block size and allocate */
     assert(size);
     pAlloc = alloc->pool + (GI_ALIGN_OFFSET(size)-1);
-/*#if OPENGI_NUM_THREADS > 1
-    if(g_uiActiveThreads > 1)
+#if OPENGI_NUM_THREADS > 1
+    if((pCache=GISmallObjectAllocator_cache(alloc)))
     {
+        /* take from thread's magazine, refill in batches */
+        GIMagazine *pMagazine = pCache->magazines + (pAlloc-alloc->pool);
+        if(pMagazine->num_blocks)
+            return pMagazine->blocks[--pMagazine->num_blocks];
         GIMutex_lock(&alloc->mutex);
-        pResult = GIFixedAllocator_allocate(pAlloc);
-        if(!pResult && GISmallObjectAllocator_truncate(alloc))
-            pResult = GIFixedAllocator_allocate(pAlloc);
+        GIMagazine_refill(pMagazine, pAlloc, GI_MAGAZINE_BATCH);
         GIMutex_unlock(&alloc->mutex);
+        if(pMagazine->num_blocks)
+            return pMagazine->blocks[--pMagazine->num_blocks];
     }
-    else
-#endif*/
+
+    /* allocators are shared by all threads (truncation locks itself) */
+    GIMutex_lock(&alloc->mutex);
+    pResult = GIFixedAllocator_allocate(pAlloc);
+    GIMutex_unlock(&alloc->mutex);
+    if(!pResult && GISmallObjectAllocator_truncate(alloc))
     {
+        GIMutex_lock(&alloc->mutex);
         pResult = GIFixedAllocator_allocate(pAlloc);
-        if(!pResult && GISmallObjectAllocator_truncate(alloc))
-            pResult = GIFixedAllocator_allocate(pAlloc);
+        GIMutex_unlock(&alloc->mutex);
     }
+#else
+    pResult = GIFixedAllocator_allocate(pAlloc);
+    if(!pResult && GISmallObjectAllocator_truncate(alloc))
+        pResult = GIFixedAllocator_allocate(pAlloc);
+#endif
     return pResult;
 }
 
@@ -517,6 +632,9 @@ void GISmallObjectAllocator_deallocate(GISmallObjectAllocator *alloc,
                                        GIvoid *address, GIusize size)
 {
     GIFixedAllocator *pAlloc;
+#if OPENGI_NUM_THREADS > 1
+    GIThreadCache *pCache;
+#endif
     assert(address);
     if(size > GI_MAX_BLOCKSIZE)
         free(address);
@@ -525,21 +643,32 @@ void GISmallObjectAllocator_deallocate(GISmallObjectAllocator *alloc,
         /* find allocator for block size and deallocate */
         assert(size);
         pAlloc = alloc->pool + (GI_ALIGN_OFFSET(size)-1);
-/*#if OPENGI_NUM_THREADS > 1
-        if(g_uiActiveThreads > 1)
+#if OPENGI_NUM_THREADS > 1
+        if((pCache=GISmallObjectAllocator_cache(alloc)))
         {
-            GIMutex_lock(&alloc->mutex);
-            GIFixedAllocator_deallocate(pAlloc, address);
-            GIMutex_unlock(&alloc->mutex);
+            /* put into thread's magazine, return batch if full */
+            GIMagazine *pMagazine = pCache->magazines + (pAlloc-alloc->pool);
+            if(pMagazine->num_blocks == GI_MAGAZINE_SIZE)
+            {
+                GIMutex_lock(&alloc->mutex);
+                GIMagazine_release(pMagazine, pAlloc, GI_MAGAZINE_BATCH);
+                GIMutex_unlock(&alloc->mutex);
+            }
+            pMagazine->blocks[pMagazine->num_blocks++] = address;
+            return;
         }
-        else
-#endif*/
-            GIFixedAllocator_deallocate(pAlloc, address);
+        GIMutex_lock(&alloc->mutex);
+        GIFixedAllocator_deallocate(pAlloc, address);
+        GIMutex_unlock(&alloc->mutex);
+#else
+        GIFixedAllocator_deallocate(pAlloc, address);
+#endif
     }
 }
 
 /** \internal
  *  \brief Truncate memory.
+ *  \details Blocks cached by the calling thread are returned before.
  *  \param alloc allocator to truncate
  *  \retval GI_TRUE if truncated successfully
  *  \retval GI_FALSE if nothing to truncate
@@ -551,20 +680,16 @@ GIboolean GISmallObjectAllocator_truncate(GISmallObjectAllocator *alloc)
     GIboolean bFound = GI_FALSE;
 
     /* truncate all fixed allocators */
-/*#if OPENGI_NUM_THREADS > 1
-    if(g_uiActiveThreads > 1)
-    {
-        GIMutex_lock(&alloc->mutex);
-        for(i=0; i<uiNumAllocs; ++i)
-            if(GIFixedAllocator_truncate(alloc->pool+i))
-                bFound = GI_TRUE;
-        GIMutex_unlock(&alloc->mutex);
-    }
-    else
-#endif*/
-        for(i=0; i<uiNumAllocs; ++i)
-            if(GIFixedAllocator_truncate(alloc->pool+i))
-                bFound = GI_TRUE;
+#if OPENGI_NUM_THREADS > 1
+    GISmallObjectAllocator_flush(alloc);
+    GIMutex_lock(&alloc->mutex);
+#endif
+    for(i=0; i<uiNumAllocs; ++i)
+        if(GIFixedAllocator_truncate(alloc->pool+i))
+            bFound = GI_TRUE;
+#if OPENGI_NUM_THREADS > 1
+    GIMutex_unlock(&alloc->mutex);
+#endif
     return bFound;
 }
 
@@ -579,7 +704,7 @@ void GISmallObjectAllocator_print(GISmallObjectAllocator *alloc, FILE *file)
     GIusize i, j, uiMem = 0, uiMaxMem = 0, uiNumAllocs = GI_ALIGN_OFFSET(GI_MAX_BLOCKSIZE);
 
 #if OPENGI_NUM_THREADS > 1
-//	GIMutex_lock(&alloc->mutex);
+    GIMutex_lock(&alloc->mutex);
 #endif
     /* print memory usage */
     for(i=0; i<uiNumAllocs; ++i)
@@ -596,9 +721,252 @@ void GISmallObjectAllocator_print(GISmallObjectAllocator *alloc, FILE *file)
         uiMaxMem += pAlloc->num_chunks * pAlloc->num_blocks * pAlloc->block_size;
     }
 #if OPENGI_NUM_THREADS > 1
-//	GIMutex_unlock(&alloc->mutex);
+    GIMutex_unlock(&alloc->mutex);
 #endif
     fprintf(file, "overall: %zuB, %f\n", uiMem, 
         uiMaxMem ? ((GIfloat)uiMem/(GIfloat)uiMaxMem) : 0.0f);
 }
 
+
+#if OPENGI_NUM_THREADS > 1
+/** \internal
+ *  \brief Release block caches of exiting thread.
+ *  \details Threads that exit without calling GIMemory_release_caches would 
+ *  otherwise keep their cached blocks from ever being returned.
+ *  \param value unused
+ *  \ingroup memory
+ */
+static void GITHREADENTRY release_exiting_caches(GIvoid *value)
+{
+    (void)value;
+    GIMemory_release_caches();
+}
+#endif
+
+/** \internal
+ *  \brief Get block cache of calling thread.
+ *  \details The cache is created on first use and released when the 
+ *  thread exits, if not done before.
+ *  \param alloc allocator to get cache for
+ *  \return thread's cache or NULL if out of memory or not multithreaded
+ *  \ingroup memory
+ */
+GIThreadCache* GISmallObjectAllocator_cache(GISmallObjectAllocator *alloc)
+{
+#if OPENGI_NUM_THREADS > 1
+    GIThreadCache *pCache;
+
+    /* search thread's caches */
+    for(pCache=t_pThreadCaches; pCache; pCache=pCache->next)
+        if(pCache->alloc == alloc)
+            return pCache;
+
+    /* create new cache */
+    if(!(pCache=(GIThreadCache*)malloc(sizeof(GIThreadCache))))
+        return NULL;
+    pCache->magazines = (GIMagazine*)calloc(
+        GI_ALIGN_OFFSET(GI_MAX_BLOCKSIZE), sizeof(GIMagazine));
+    if(!pCache->magazines)
+    {
+        free(pCache);
+        return NULL;
+    }
+    pCache->alloc = alloc;
+    pCache->next = t_pThreadCaches;
+    t_pThreadCaches = pCache;
+
+    /* release on thread exit */
+    if(GIOnce_begin(&g_CacheKeyInit))
+    {
+        GIThreadKey_construct(&g_CacheKey, release_exiting_caches);
+        GIOnce_end(&g_CacheKeyInit);
+    }
+    GIThreadKey_set(&g_CacheKey, pCache);
+
+    /* register at allocator */
+    GIMutex_lock(&alloc->mutex);
+    pCache->next_alloc = alloc->caches;
+    alloc->caches = pCache;
+    GIMutex_unlock(&alloc->mutex);
+    return pCache;
+#else
+    (void)alloc;
+    return NULL;
+#endif
+}
+
+/** \internal
+ *  \brief Return blocks cached by calling thread.
+ *  \param alloc allocator to flush cache of
+ *  \ingroup memory
+ */
+void GISmallObjectAllocator_flush(GISmallObjectAllocator *alloc)
+{
+#if OPENGI_NUM_THREADS > 1
+    GIThreadCache *pCache;
+    GIuint i, uiNumAllocs = GI_ALIGN_OFFSET(GI_MAX_BLOCKSIZE);
+
+    /* return all blocks of thread's cache */
+    for(pCache=t_pThreadCaches; pCache && pCache->alloc!=alloc; pCache=pCache->next);
+    if(!pCache)
+        return;
+    GIMutex_lock(&alloc->mutex);
+    for(i=0; i<uiNumAllocs; ++i)
+        GIMagazine_release(pCache->magazines+i, alloc->pool+i, GI_MAGAZINE_SIZE);
+    GIMutex_unlock(&alloc->mutex);
+#else
+    (void)alloc;
+#endif
+}
+
+/** \internal
+ *  \brief Release all block caches of calling thread.
+ *  \details This is done automatically when a thread exits, but can be 
+ *  called before to return the cached blocks earlier.
+ *  \ingroup memory
+ */
+void GIMemory_release_caches()
+{
+#if OPENGI_NUM_THREADS > 1
+    GIThreadCache *pCache, **pLink;
+    GIuint i, uiNumAllocs = GI_ALIGN_OFFSET(GI_MAX_BLOCKSIZE);
+
+    while((pCache=t_pThreadCaches))
+    {
+        /* return blocks and unregister */
+        GISmallObjectAllocator *pAlloc = pCache->alloc;
+        GIMutex_lock(&pAlloc->mutex);
+        for(i=0; i<uiNumAllocs; ++i)
+            GIMagazine_release(pCache->magazines+i, pAlloc->pool+i, GI_MAGAZINE_SIZE);
+        for(pLink=&pAlloc->caches; *pLink!=pCache; pLink=&(*pLink)->next_alloc);
+        *pLink = pCache->next_alloc;
+        GIMutex_unlock(&pAlloc->mutex);
+
+        /* delete cache */
+        t_pThreadCaches = pCache->next;
+        free(pCache->magazines);
+        free(pCache);
+    }
+#endif
+}
+
+/** \internal
+ *  \brief Arena constructor.
+ *  \param arena arena to construct
+ *  \ingroup memory
+ */
+void GIArena_construct(GIArena *arena)
+{
+    /* init empty arena */
+    memset(arena, 0, sizeof(GIArena));
+    arena->block_size = GI_ARENA_BLOCKSIZE;
+}
+
+/** \internal
+ *  \brief Arena destructor.
+ *  \param arena arena to destruct
+ *  \ingroup memory
+ */
+void GIArena_destruct(GIArena *arena)
+{
+    /* release all blocks */
+    GIArena_clear(arena);
+}
+
+/** \internal
+ *  \brief Allocate memory from arena.
+ *  \param arena arena to take memory from
+ *  \param size size of memory to allocate
+ *  \return pointer to allocated memory or NULL if out of memory
+ *  \ingroup memory
+ */
+GIvoid* GIArena_allocate(GIArena *arena, GIusize size)
+{
+    GIvoid *pResult;
+    GIubyte *pBlock;
+    GIusize uiBlockSize;
+    assert(size);
+
+    /* reuse freed object of same size */
+    size = GI_ARENA_SIZE(size);
+    if(size <= GI_ARENA_MAX_RECYCLE && 
+        (pResult=arena->free_lists[size/GI_ARENA_ALIGNMENT-1]))
+    {
+        arena->free_lists[size/GI_ARENA_ALIGNMENT-1] = *(GIvoid**)pResult;
+        return pResult;
+    }
+
+    /* start new block if neccessary (with growing size) */
+    if((GIusize)(arena->end-arena->pos) < size)
+    {
+        if(!arena->block_size)
+            arena->block_size = GI_ARENA_BLOCKSIZE;
+        uiBlockSize = GI_MAX(arena->block_size, size+GI_ARENA_HEADER);
+        if(!(pBlock=(GIubyte*)malloc(uiBlockSize)))
+            return NULL;
+        *(GIubyte**)pBlock = arena->blocks;
+        arena->blocks = pBlock;
+        arena->pos = pBlock + GI_ARENA_HEADER;
+        arena->end = pBlock + uiBlockSize;
+        if(arena->block_size < GI_ARENA_MAX_BLOCKSIZE)
+            arena->block_size <<= 1;
+    }
+
+    /* take memory from current block */
+    pResult = arena->pos;
+    arena->pos += size;
+    return pResult;
+}
+
+/** \internal
+ *  \brief Allocate and clear memory from arena.
+ *  \param arena arena to take memory from
+ *  \param size size of memory to allocate
+ *  \return pointer to allocated memory or NULL if out of memory
+ *  \ingroup memory
+ */
+GIvoid* GIArena_callocate(GIArena *arena, GIusize size)
+{
+    GIvoid *pResult = GIArena_allocate(arena, size);
+    if(pResult)
+        memset(pResult, 0, size);
+    return pResult;
+}
+
+/** \internal
+ *  \brief Free memory of single object in arena.
+ *  \details The memory is kept for reuse and only released with the arena.
+ *  \param arena arena memory was taken from
+ *  \param address address of memory to free
+ *  \param size size of memory to free
+ *  \ingroup memory
+ */
+void GIArena_deallocate(GIArena *arena, GIvoid *address, GIusize size)
+{
+    /* put into list of freed objects of same size */
+    assert(address && size);
+    size = GI_ARENA_SIZE(size);
+    if(size <= GI_ARENA_MAX_RECYCLE)
+    {
+        *(GIvoid**)address = arena->free_lists[size/GI_ARENA_ALIGNMENT-1];
+        arena->free_lists[size/GI_ARENA_ALIGNMENT-1] = address;
+    }
+}
+
+/** \internal
+ *  \brief Release all memory of arena.
+ *  \param arena arena to clear
+ *  \ingroup memory
+ */
+void GIArena_clear(GIArena *arena)
+{
+    GIubyte *pBlock;
+
+    /* free blocks and reset */
+    while((pBlock=arena->blocks))
+    {
+        arena->blocks = *(GIubyte**)pBlock;
+        free(pBlock);
+    }
+    GIArena_construct(arena);
+}
@@ -56,6 +56,12 @@
 	#define GI_SSE_SIZE(s)			(s)
 #endif
 
+#define GI_MAGAZINE_SIZE			32
+#define GI_MAGAZINE_BATCH			(GI_MAGAZINE_SIZE>>1)
+
+#define GI_ARENA_ALIGNMENT			8
+#define GI_ARENA_MAX_RECYCLE		256
+
 
 /*************************************************************************/
 /* Macros */
@@ -118,25 +124,22 @@
 #define GI_FREE_SINGLE(p,s)			GISmallObjectAllocator_deallocate(&g_SmallObjAlloc, p, s)
 
 /** \internal
- *  \brief Allocate memory for a mesh element.
+ *  \brief Allocate memory for a mesh element from an arena.
  *  \ingroup memory
  */
-//#define GI_MALLOC_PERSISTENT(s)		malloc(s)
-#define GI_MALLOC_PERSISTENT(s)		GISmallObjectAllocator_allocate(&g_PersistentAlloc, s)
+#define GI_MALLOC_ARENA(a,s)		GIArena_allocate(a, s)
 
 /** \internal
- *  \brief Allocate and clear memory for a mesh element.
+ *  \brief Allocate and clear memory for a mesh element from an arena.
  *  \ingroup memory
  */
-//#define GI_CALLOC_PERSISTENT(s)		calloc(1, s)
-#define GI_CALLOC_PERSISTENT(s)		GISmallObjectAllocator_callocate(&g_PersistentAlloc, s)
+#define GI_CALLOC_ARENA(a,s)		GIArena_callocate(a, s)
 
 /** \internal
- *  \brief Free memory of a mesh element.
+ *  \brief Free memory of a mesh element for reuse by its arena.
  *  \ingroup memory
  */
-//#define GI_FREE_PERSISTENT(p,s)		free(p)
-#define GI_FREE_PERSISTENT(p,s)		GISmallObjectAllocator_deallocate(&g_PersistentAlloc, p, s)
+#define GI_FREE_ARENA(a,p,s)		GIArena_deallocate(a, p, s)
 
 /** \internal
  *  \brief Allocate memory aligned to specififc byte boundary.
@@ -188,6 +191,7 @@ typedef struct _GIChunk
 typedef struct _GIFixedAllocator
 {
 	GIuint	block_size;						/**< Block size this allocator serves. */
+	GIuint	chunk_size;						/**< Size and alignment of chunk memory (power of 2). */
 	GIubyte	num_blocks;						/**< Number of blocks per chunk. */
 	GIusize	num_chunks;						/**< Number of chunks. */
 	GIusize	max_chunks;						/**< Maximum number of chunks (till array grow). */
@@ -198,6 +202,33 @@ typedef struct _GIFixedAllocator
 	GIChunk *empty_chunk;					/**< Only empty or NULL if none empty. */
 } GIFixedAllocator;
 
+/** \internal
+ *  \brief Magazine of blocks.
+ *  \details This class represents a thread's cache of free blocks of a 
+ *  fixed size, that is refilled from and returned to the shared allocator 
+ *  in batches.
+ *  \ingroup memory
+ */
+typedef struct _GIMagazine
+{
+	GIuint	num_blocks;						/**< Number of cached blocks. */
+	GIvoid	*blocks[GI_MAGAZINE_SIZE];		/**< Cached blocks. */
+} GIMagazine;
+
+/** \internal
+ *  \brief Block cache of a thread.
+ *  \details This class represents the magazines a thread holds for 
+ *  a small object allocator.
+ *  \ingroup memory
+ */
+typedef struct _GIThreadCache
+{
+	struct _GISmallObjectAllocator	*alloc;			/**< Allocator cached. */
+	GIMagazine						*magazines;		/**< Magazines for served block sizes. */
+	struct _GIThreadCache			*next;			/**< Next cache of same thread. */
+	struct _GIThreadCache			*next_alloc;	/**< Next cache of same allocator. */
+} GIThreadCache;
+
 /** \internal
  *  \brief Allocator for small objects.
  *  \details This class represents an allocator for single small objects. 
@@ -208,11 +239,27 @@ typedef struct _GISmallObjectAllocator
 {
 	GIFixedAllocator	*pool;				/**< Allocators for served block sizes. */
 	GIMutex				mutex;				/**< Mutex for thread-safety */
+	GIThreadCache		*caches;			/**< Block caches of all threads. */
 } GISmallObjectAllocator;
 
-extern GISmallObjectAllocator g_SmallObjAlloc;
+/** \internal
+ *  \brief Arena for mesh elements.
+ *  \details This class represents a region allocator, that serves objects 
+ *  from large memory blocks and releases all of them at once. Freed objects 
+ *  up to a size of \c GI_ARENA_MAX_RECYCLE bytes are reused for further 
+ *  allocations of the same size. An arena is not thread-safe.
+ *  \ingroup memory
+ */
+typedef struct _GIArena
+{
+	GIubyte	*blocks;								/**< List of memory blocks (linked through block headers). */
+	GIubyte	*pos;									/**< Free memory of current block. */
+	GIubyte	*end;									/**< End of current block. */
+	GIusize	block_size;								/**< Size of next block. */
+	GIvoid	*free_lists[GI_ARENA_MAX_RECYCLE/GI_ARENA_ALIGNMENT];	/**< Lists of freed objects by size. */
+} GIArena;
 
-extern GISmallObjectAllocator g_PersistentAlloc;
+extern GISmallObjectAllocator g_SmallObjAlloc;
 
 
 /*************************************************************************/
@@ -229,7 +276,8 @@ void GIMemory_deallocate_aligned(GIvoid *address);
 /** \name Chunk methods
  *  \{
  */
-GIboolean GIChunk_construct(GIChunk *chunk, GIuint block_size, GIuint blocks);
+GIboolean GIChunk_construct(GIChunk *chunk, GIuint block_size, 
+	GIuint blocks, GIuint size);
 void GIChunk_destruct(GIChunk *chunk);
 GIvoid* GIChunk_allocate(GIChunk *chunk, GIuint block_size);
 void GIChunk_deallocate(GIChunk *chunk, GIvoid *address, GIuint block_size);
@@ -246,6 +294,13 @@ GIChunk* GIFixedAllocator_find(GIFixedAllocator *alloc, GIvoid *address);
 GIboolean GIFixedAllocator_truncate(GIFixedAllocator *alloc);
 /** \} */
 
+/** \name Magazine methods
+ *  \{
+ */
+GIuint GIMagazine_refill(GIMagazine *magazine, GIFixedAllocator *alloc, GIuint count);
+void GIMagazine_release(GIMagazine *magazine, GIFixedAllocator *alloc, GIuint count);
+/** \} */
+
 /** \name Small object allocator methods
  *  \{
  */
@@ -256,6 +311,25 @@ GIvoid* GISmallObjectAllocator_callocate(GISmallObjectAllocator *alloc, GIusize
 void GISmallObjectAllocator_deallocate(GISmallObjectAllocator *alloc, GIvoid *address, GIusize size);
 GIboolean GISmallObjectAllocator_truncate(GISmallObjectAllocator *alloc);
 void GISmallObjectAllocator_print(GISmallObjectAllocator *alloc, FILE *file);
+GIThreadCache* GISmallObjectAllocator_cache(GISmallObjectAllocator *alloc);
+void GISmallObjectAllocator_flush(GISmallObjectAllocator *alloc);
+/** \} */
+
+/** \name Arena methods
+ *  \{
+ */
+void GIArena_construct(GIArena *arena);
+void GIArena_destruct(GIArena *arena);
+GIvoid* GIArena_allocate(GIArena *arena, GIusize size);
+GIvoid* GIArena_callocate(GIArena *arena, GIusize size);
+void GIArena_deallocate(GIArena *arena, GIvoid *address, GIusize size);
+void GIArena_clear(GIArena *arena);
+/** \} */
+
+/** \name Thread cache methods
+ *  \{
+ */
+void GIMemory_release_caches();
 /** \} */
 
 
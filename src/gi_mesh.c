@@ -64,53 +64,6 @@ typedef struct _GISplitInfo
     GIPatch		*twin_patch;					/**< Patch twin half edge belongs to (if any). */
 } GISplitInfo;
 
-/** \internal
- *  \brief Hash packed attributes.
- *  \param a attribute package to hash
- *  \param size size of hash table
- *  \return computed hash value
- */
-static GIuint hash_attribs(const GIvoid *a, GIuint size)
-{
-/*	const GIubyte *c = (const GIubyte*)a + sizeof(GIuint);
-    const GIubyte *end = c + *(const GIuint*)a;
-    GIuint uiHash = 2166136261U;
-    while(c != end)
-    {
-        uiHash ^= (GIuint)(*(c++));
-        uiHash *= 16777619;
-    }
-    return uiHash % size;
-*/	GIuint i = 0;
-    const GIuint *p = (const GIuint*)a;
-    p += *p / sizeof(GIuint);
-    for(; p!=a; --p)
-        i ^= *p;
-    return i % size;
-}
-
-/** \internal
- *  \brief Copy packed attributes.
- *  \param d destination
- *  \param s source
- */
-static void copy_attribs(GIvoid *d, const GIvoid *s)
-{
-    memcpy(d, s, *(const GIuint*)s+sizeof(GIuint));
-}
-
-/** \internal
- *  \brief Compare packed attributes.
- *  \param a first attribute package
- *  \param b second attribute package
- *  \retval GI_TRUE if packages are equal
- *  \retval GI_FALSE if packages are not equal
- */
-static GIboolean compare_attribs(const GIvoid *a, const GIvoid *b)
-{
-    return !memcmp((const GIuint*)a+1, (const GIuint*)b+1, *(const GIuint*)a);
-}
-
 /** \internal
  *  \brief Compare unsigned ints for qsort and bsearch.
  *  \param a first value
@@ -138,6 +91,8 @@ GIuint GIAPIENTRY giGenMesh()
     for(a=0; a<GI_ATTRIB_COUNT; ++a)
         pMesh->aoffset[a] = -1;
     pMesh->genus = -1;
+    GIArena_construct(&pMesh->arena);
+    GIArena_construct(&pMesh->cut_arena);
     GIHash_insert(&pContext->mesh_hash, &pMesh->id, pMesh);
     return pMesh->id;
 }
@@ -331,7 +286,7 @@ void GIAPIENTRY giIndexedMesh(GIuint start, GIuint end,
             pIndexAttributeMap = (GIAttribute**)GI_CALLOC_ARRAY(
                 iNumVertices, sizeof(GIAttribute*));
         GIHash_construct(&hAttribMap, iNumVertices, 0.0f, sizeof(GIuint)+
-            pMesh->attrib_size, hash_attribs, compare_attribs, copy_attribs);
+            pMesh->attrib_size, hash_blob, compare_blob, copy_blob);
         pKey = GI_MALLOC_SINGLE(sizeof(GIuint)+pMesh->attrib_size);
         *((GIuint*)pKey) = pMesh->attrib_size;
         pPackedAttribs = (GIfloat*)((GIuint*)pKey+1);
@@ -344,7 +299,7 @@ void GIAPIENTRY giIndexedMesh(GIuint start, GIuint end,
     pMesh->radius = 0.0;
     for(i=0; i<count; i+=3)
     {
-        pFace = (GIFace*)GI_MALLOC_PERSISTENT(sizeof(GIFace));
+        pFace = (GIFace*)GI_MALLOC_ARENA(&pMesh->arena, sizeof(GIFace));
         GI_LIST_ADD(pMesh->faces, pFace);
         pFace->id = pMesh->fcount++;
         pFace->hedges = NULL;
@@ -373,7 +328,7 @@ void GIAPIENTRY giIndexedMesh(GIuint start, GIuint end,
                 if(!pVertex)
                 {
                     /* create new vertex */
-                    pVertex = (GIVertex*)GI_MALLOC_PERSISTENT(sizeof(GIVertex));
+                    pVertex = (GIVertex*)GI_MALLOC_ARENA(&pMesh->arena, sizeof(GIVertex));
                     GI_LIST_ADD(pMesh->vertices, pVertex);
                     pVertex->id = pMesh->vcount++;
                     pVertex->hedge = NULL;
@@ -420,16 +375,16 @@ void GIAPIENTRY giIndexedMesh(GIuint start, GIuint end,
                         }
                     }
                     pPackedAttribs = (GIfloat*)((GIuint*)pKey+1);
-                    pAttribute = (GIAttribute*)GIHash_find(&hAttribMap, pKey);
+                    pAttribute = (GIAttribute*)GIHash_find_blob(&hAttribMap, pKey);
                     if(!pAttribute)
                     {
-                        pAttribute = (GIAttribute*)GI_MALLOC_PERSISTENT(
+                        pAttribute = (GIAttribute*)GI_MALLOC_ARENA(&pMesh->arena, 
                             sizeof(GIAttribute)+pMesh->attrib_size);
                         GI_LIST_ADD(pMesh->attributes, pAttribute);
                         pAttribute->id = pMesh->acount++;
                         memcpy((GIbyte*)pAttribute+sizeof(GIAttribute), 
                             pPackedAttribs, pMesh->attrib_size);
-                        GIHash_insert(&hAttribMap, pKey, pAttribute);
+                        GIHash_insert_blob(&hAttribMap, pKey, pAttribute);
                     }
                     if(indices)
                         pIndexAttributeMap[idx] = pAttribute;
@@ -453,7 +408,7 @@ void GIAPIENTRY giIndexedMesh(GIuint start, GIuint end,
             pVertex2 = pCorners[(j+1)%3];
             pair.first = pVertex1->id;
             pair.second = pVertex2->id;
-            pEdge = (GIEdge*)GIHash_find(&hVertexEdgeMap, &pair);
+            pEdge = (GIEdge*)GIHash_find_uintpair(&hVertexEdgeMap, &pair);
             if(pEdge)
             {
                 if(pEdge->hedge[0].twin)
@@ -468,7 +423,7 @@ void GIAPIENTRY giIndexedMesh(GIuint start, GIuint end,
             }
             else
             {
-                pEdge = (GIEdge*)GI_MALLOC_PERSISTENT(sizeof(GIEdge));
+                pEdge = (GIEdge*)GI_MALLOC_ARENA(&pMesh->arena, sizeof(GIEdge));
                 GI_LIST_ADD(pMesh->edges, pEdge);
                 pEdge->id = pMesh->ecount++;
                 pHalfEdge = &pEdge->hedge[0];
@@ -477,7 +432,7 @@ void GIAPIENTRY giIndexedMesh(GIuint start, GIuint end,
                 pEdge->length = GIvec3d_dist(pHalfEdge->vstart->coords, 
                     pHalfEdge->next->vstart->coords);
                 pMesh->mean_edge += pEdge->length;
-                GIHash_insert(&hVertexEdgeMap, &pair, pEdge);
+                GIHash_insert_uintpair(&hVertexEdgeMap, &pair, pEdge);
             }
             pHalfEdge->edge = pEdge;
             if(!pHalfEdge->vstart->hedge)
@@ -601,9 +556,8 @@ void GIAPIENTRY giCopyMesh(GIuint mesh)
     GIAttribute **pIndexAttributeMap;
     GIParam **pIndexParamMap;
     GICutPath ***pIndexPathMap;
-    GIQueueNode *pQNode;
     GISplitInfo *pSSplit, *pDSplit;
-    GIuint i, a, uiFaces = 0, uiNextPatch = 0;
+    GIuint i, j, a, uiFaces = 0, uiNextPatch = 0;
 
     /* error checking */
     if(!pMesh)
@@ -675,7 +629,7 @@ void GIAPIENTRY giCopyMesh(GIuint mesh)
 
     /* copy faces (and other data respectively) */
     GI_LIST_FOREACH(pSource->faces, pSFace)
-        pDFace = (GIFace*)GI_MALLOC_PERSISTENT(sizeof(GIFace));
+        pDFace = (GIFace*)GI_MALLOC_ARENA(&pMesh->arena, sizeof(GIFace));
         GI_LIST_ADD(pMesh->faces, pDFace);
         pDFace->id = pSFace->id;
         pDFace->hedges = NULL;
@@ -706,6 +660,7 @@ void GIAPIENTRY giCopyMesh(GIuint mesh)
             pDPatch->param_metric = pSPatch->param_metric;
             pDPatch->parameterized = pSPatch->parameterized;
             pDPatch->fixed_corners = pSPatch->fixed_corners;
+            pDPatch->solver_stats = pSPatch->solver_stats;
             GIDynamicQueue_construct(&pDPatch->split_paths);
             pDPatch->next = pMesh->patches + ((pDPatch->id+1)%pMesh->patch_count);
             pIndexPatchMap[pSPatch->id] = pDPatch;
@@ -720,7 +675,7 @@ void GIAPIENTRY giCopyMesh(GIuint mesh)
             pDEdge = pIndexEdgeMap[pSEdge->id];
             if(!pDEdge)
             {
-                pDEdge = (GIEdge*)GI_MALLOC_PERSISTENT(sizeof(GIEdge));
+                pDEdge = (GIEdge*)GI_MALLOC_ARENA(&pMesh->arena, sizeof(GIEdge));
                 GI_LIST_ADD(pMesh->edges, pDEdge);
                 pDEdge->id = pSEdge->id;
                 pDEdge->length = pSEdge->length;
@@ -743,7 +698,7 @@ void GIAPIENTRY giCopyMesh(GIuint mesh)
             pDVertex = pIndexVertexMap[pSVertex->id];
             if(!pDVertex)
             {
-                pDVertex = (GIVertex*)GI_MALLOC_PERSISTENT(sizeof(GIVertex));
+                pDVertex = (GIVertex*)GI_MALLOC_ARENA(&pMesh->arena, sizeof(GIVertex));
                 GI_LIST_ADD(pMesh->vertices, pDVertex);
                 pDVertex->id = pSVertex->id;
                 GI_VEC3_COPY(pDVertex->coords, pSVertex->coords);
@@ -761,7 +716,7 @@ void GIAPIENTRY giCopyMesh(GIuint mesh)
                 pDAttribute = pIndexAttributeMap[pSAttribute->id];
                 if(!pDAttribute)
                 {
-                    pDAttribute = (GIAttribute*)GI_MALLOC_PERSISTENT(sizeof(GIAttribute)+pSource->attrib_size);
+                    pDAttribute = (GIAttribute*)GI_MALLOC_ARENA(&pMesh->arena, sizeof(GIAttribute)+pSource->attrib_size);
                     GI_LIST_ADD(pMesh->attributes, pDAttribute);
                     pDAttribute->id = pSAttribute->id;
                     memcpy((GIbyte*)pDAttribute+sizeof(GIAttribute), 
@@ -780,7 +735,7 @@ void GIAPIENTRY giCopyMesh(GIuint mesh)
                 pDParam = pIndexParamMap[pSParam->id];
                 if(!pDParam)
                 {
-                    pDParam = (GIParam*)GI_MALLOC_PERSISTENT(sizeof(GIParam));
+                    pDParam = (GIParam*)GI_MALLOC_ARENA(&pMesh->cut_arena, sizeof(GIParam));
                     GI_LIST_ADD(pDPatch->params, pDParam);
                     pDParam->id = pSParam->id;
                     GI_VEC2_COPY(pDParam->params, pSParam->params);
@@ -811,7 +766,7 @@ void GIAPIENTRY giCopyMesh(GIuint mesh)
             /* create paths */
             i = pDPatch->id;
             GI_LIST_FOREACH(pSPatch->paths, pSPath)
-                pDPath = (GICutPath*)GI_MALLOC_PERSISTENT(sizeof(GICutPath));
+                pDPath = (GICutPath*)GI_MALLOC_ARENA(&pMesh->cut_arena, sizeof(GICutPath));
                 GI_LIST_ADD(pDPatch->paths, pDPath);
                 pDPath->id = pSPath->id;
                 pDPath->patch = pDPatch;
@@ -824,13 +779,9 @@ void GIAPIENTRY giCopyMesh(GIuint mesh)
             GI_LIST_NEXT(pSPatch->paths, pSPath)
 
             /* copy split stack */
-            pQNode = pSPatch->split_paths.head;
-            while(pQNode)
-            {
-                GIDynamicQueue_enqueue(&pDPatch->split_paths, 
-                    pIndexPathMap[i][((GICutPath*)pQNode->data)->id]);
-                pQNode = pQNode->next;
-            }
+            for(j=0; j<pSPatch->split_paths.size; ++j)
+                GIDynamicQueue_enqueue(&pDPatch->split_paths, pIndexPathMap[i][
+                    ((GICutPath*)GIDynamicQueue_at(&pSPatch->split_paths, j))->id]);
 
             /* next patch */
             pDPatch = NULL;
@@ -865,11 +816,10 @@ void GIAPIENTRY giCopyMesh(GIuint mesh)
     GI_LIST_NEXT(pSource->edges, pSEdge)
 
     /* copy split stack */
-    pQNode = pSource->split_hedges.head;
-    while(pQNode)
+    for(j=0; j<pSource->split_hedges.size; ++j)
     {
-        pSSplit = (GISplitInfo*)pQNode->data;
-        pDSplit = (GISplitInfo*)GI_MALLOC_PERSISTENT(sizeof(GISplitInfo));
+        pSSplit = (GISplitInfo*)GIDynamicQueue_at(&pSource->split_hedges, j);
+        pDSplit = (GISplitInfo*)GI_MALLOC_ARENA(&pMesh->arena, sizeof(GISplitInfo));
         pDSplit->hedge = GIFace_halfedge_at(pIndexFaceMap[
             pSSplit->hedge->face->id], GIHalfEdge_index(pSSplit->hedge));
         if(pSSplit->patch)
@@ -877,7 +827,6 @@ void GIAPIENTRY giCopyMesh(GIuint mesh)
         if(pSSplit->twin_patch)
             pDSplit->twin_patch = pIndexPatchMap[pSSplit->twin_patch->id];
         GIDynamicQueue_enqueue(&pMesh->split_hedges, pDSplit);
-        pQNode = pQNode->next;
     }
 
     /* connect path twins */
@@ -1090,6 +1039,27 @@ void GIAPIENTRY giGetMeshiv(GIenum pname, GIint *params)
     case GI_ACTIVE_PATCH:
         *params = pMesh->active_patch != NULL ? pPatch->id : GI_ALL_PATCHES;
         break;
+    case GI_SOLVER_ROWS:
+    case GI_SOLVER_NONZEROS:
+    case GI_SOLVER_ITERATIONS:
+        {
+            /* sum up patches for whole mesh */
+            GIPatch *pFirst = pPatch ? pPatch : pMesh->patches;
+            GIuint i, uiCount = pPatch ? 1 : (pMesh->patches ? pMesh->patch_count : 0);
+            GISolverStats *pStats;
+            *params = 0;
+            for(i=0; i<uiCount; ++i)
+            {
+                pStats = &pFirst[i].solver_stats;
+                if(pname == GI_SOLVER_ROWS)
+                    *params += pStats->rows;
+                else if(pname == GI_SOLVER_NONZEROS)
+                    *params += pStats->nnz;
+                else
+                    *params += pStats->iterations;
+            }
+        }
+        break;
     case GI_POSITION_ATTRIB:
     case GI_PARAM_ATTRIB:
     case GI_PARAM_STRETCH_ATTRIB:
@@ -1185,6 +1155,27 @@ void GIAPIENTRY giGetMeshfv(GIenum pname, GIfloat *params)
         else
             GIContext_error(pContext, GI_INVALID_OPERATION);
         break;
+    case GI_SOLVER_RESIDUAL:
+    case GI_ASSEMBLY_TIME:
+    case GI_PRECONDITIONER_TIME:
+    case GI_SOLVER_TIME:
+        {
+            /* worst residual and total times for whole mesh */
+            GIPatch *pFirst = pPatch ? pPatch : pMesh->patches;
+            GIuint i, uiCount = pPatch ? 1 : (pMesh->patches ? pMesh->patch_count : 0);
+            GISolverStats *pStats;
+            GIdouble dValue = 0.0;
+            for(i=0; i<uiCount; ++i)
+            {
+                pStats = &pFirst[i].solver_stats;
+                if(pname == GI_SOLVER_RESIDUAL)
+                    dValue = GI_MAX(dValue, pStats->residual);
+                else
+                    dValue += pStats->times[pname-GI_SOLVER_TIME_BASE];
+            }
+            *params = dValue;
+        }
+        break;
     default:
         {
             GIint iInt = 0;
@@ -1390,7 +1381,7 @@ void GIAPIENTRY giGetIndexedMesh(GIuint *vcount, GIuint *icount,
     /* create hash table */
     GIHash_construct(&hAttribIndex, pPatch ? pPatch->pcount : 
         pMesh->vcount, 0.0f, sizeof(GIuint)+uiAttribSize, 
-        hash_attribs, compare_attribs, copy_attribs);
+        hash_blob, compare_blob, copy_blob);
     pKey = GI_MALLOC_SINGLE(sizeof(GIuint)+uiAttribSize);
     *(GIuint*)pKey = uiAttribSize;
 
@@ -1425,11 +1416,11 @@ void GIAPIENTRY giGetIndexedMesh(GIuint *vcount, GIuint *icount,
             }
 
             /* Compute index and copy data if neccessary */
-            idx = (uintptr_t)GIHash_find(&hAttribIndex, pKey);
+            idx = (uintptr_t)GIHash_find_blob(&hAttribIndex, pKey);
             if(!idx)
             {
                 idx = ++*vcount;
-                GIHash_insert(&hAttribIndex, pKey, (GIvoid*)idx);
+                GIHash_insert_blob(&hAttribIndex, pKey, (GIvoid*)idx);
             }
             if(indices)
             {
@@ -1553,12 +1544,12 @@ void GIMesh_destruct(GIMesh *mesh)
 {
     GIuint a;
 
-    /* clear lists */
+    /* clear lists (elements are released with arena, splits need no revert) */
     GIDynamicQueue_destruct(&mesh->split_hedges);
-    GI_LIST_CLEAR_PERSISTENT(mesh->faces, sizeof(GIFace));
-    GI_LIST_CLEAR_PERSISTENT(mesh->edges, sizeof(GIEdge));
-    GI_LIST_CLEAR_PERSISTENT(mesh->vertices, sizeof(GIVertex));
-    GI_LIST_CLEAR_PERSISTENT(mesh->attributes, sizeof(GIAttribute)+mesh->attrib_size);
+    mesh->faces = NULL;
+    mesh->edges = NULL;
+    mesh->vertices = NULL;
+    mesh->attributes = NULL;
 
     /* reset properties */
     mesh->fcount = mesh->ecount = mesh->vcount = mesh->acount = 0;
@@ -1578,8 +1569,9 @@ void GIMesh_destruct(GIMesh *mesh)
     mesh->radius = 0.0;
     mesh->mean_edge = 0.0;
 
-    /* destroy patches */
+    /* destroy patches and release memory */
     GIMesh_destroy_cut(mesh);
+    GIArena_clear(&mesh->arena);
 }
 
 /** \internal
@@ -1643,6 +1635,9 @@ void GIMesh_destroy_cut(GIMesh *mesh)
         GI_FREE_ARRAY(mesh->old_coords);
         mesh->old_coords = NULL;
     }
+
+    /* release params and paths */
+    GIArena_clear(&mesh->cut_arena);
 }
 
 /** \internal
@@ -1702,37 +1697,37 @@ void GIMesh_revert_splits(GIMesh *mesh, GIint count)
         GIHalfEdge_revert_half_split(pHTwin, pHDel, mesh, pTwinPatch, GI_FALSE);
 
         /* delete vertex */
-        GI_LIST_DELETE_PERSISTENT(mesh->vertices, pVDel, sizeof(GIVertex));
+        GI_LIST_DELETE_ARENA(mesh->vertices, &mesh->arena, pVDel, sizeof(GIVertex));
         --mesh->vcount;
         if(pADel1)
         {
-            GI_LIST_DELETE_PERSISTENT(mesh->attributes, pADel1, 
+            GI_LIST_DELETE_ARENA(mesh->attributes, &mesh->arena, pADel1, 
                 sizeof(GIAttribute)+mesh->attrib_size);
             --mesh->acount;
         }
         if(pPDel1)
         {
-            GI_LIST_DELETE_PERSISTENT(pPatch->params, pPDel1, sizeof(GIParam));
+            GI_LIST_DELETE_ARENA(pPatch->params, &mesh->cut_arena, pPDel1, sizeof(GIParam));
             --pPatch->pcount;
         }
         if(pADel2 && pADel1 != pADel2)
         {
-            GI_LIST_DELETE_PERSISTENT(mesh->attributes, pADel2, 
+            GI_LIST_DELETE_ARENA(mesh->attributes, &mesh->arena, pADel2, 
                 sizeof(GIAttribute)+mesh->attrib_size);
             --mesh->acount;
         }
         if(pPDel2 && pPDel1 != pPDel2)
         {
-            GI_LIST_DELETE_PERSISTENT(pTwinPatch->params, pPDel2, sizeof(GIParam));
+            GI_LIST_DELETE_ARENA(pTwinPatch->params, &mesh->cut_arena, pPDel2, sizeof(GIParam));
             --pTwinPatch->pcount;
         }
 
         /* delete edge and split record */
-        GI_LIST_DELETE_PERSISTENT(mesh->edges, pEDel, sizeof(GIEdge));
+        GI_LIST_DELETE_ARENA(mesh->edges, &mesh->arena, pEDel, sizeof(GIEdge));
         --mesh->ecount;
         pHalfEdge->edge->length = GIvec3d_dist(pHalfEdge->vstart->coords, 
             pHalfEdge->next->vstart->coords);
-        GI_FREE_PERSISTENT(pSplit, sizeof(GISplitInfo));
+        GI_FREE_ARENA(&mesh->arena, pSplit, sizeof(GISplitInfo));
     }
 }
 
@@ -2188,7 +2183,7 @@ void GIHalfEdge_split(GIHalfEdge *hedge, struct _GIPatch *patch,
         twin_patch = NULL;
 
     /* create and connect new edge */
-    pEdge2 = (GIEdge*)GI_MALLOC_PERSISTENT(sizeof(GIEdge));
+    pEdge2 = (GIEdge*)GI_MALLOC_ARENA(&pMesh->arena, sizeof(GIEdge));
     GI_LIST_ADD(pMesh->edges, pEdge2);
     pEdge2->id = pMesh->ecount++;
     pEdge2->length = dOneF * pEdge1->length;
@@ -2201,7 +2196,7 @@ void GIHalfEdge_split(GIHalfEdge *hedge, struct _GIPatch *patch,
     pHNew2->twin = pHNew1;
 
     /* create center vertex */
-    pVertex = (GIVertex*)GI_MALLOC_PERSISTENT(sizeof(GIVertex));
+    pVertex = (GIVertex*)GI_MALLOC_ARENA(&pMesh->arena, sizeof(GIVertex));
     GI_LIST_ADD(pMesh->vertices, pVertex);
     pVertex->id = pMesh->vcount++;
     GI_VEC3_SCALE(pVertex->coords, hedge->vstart->coords, dOneF);
@@ -2224,7 +2219,7 @@ void GIHalfEdge_split(GIHalfEdge *hedge, struct _GIPatch *patch,
     /* create center param */
     if(hedge->pstart)
     {
-        pParam = (GIParam*)GI_MALLOC_PERSISTENT(sizeof(GIParam));
+        pParam = (GIParam*)GI_MALLOC_ARENA(&pMesh->cut_arena, sizeof(GIParam));
         GI_LIST_ADD(patch->params, pParam);
         pParam->id = patch->pcount++;
         if(params)
@@ -2280,7 +2275,7 @@ void GIHalfEdge_split(GIHalfEdge *hedge, struct _GIPatch *patch,
         pParam = NULL;
     else if(bCut)
     {
-        pParam = (GIParam*)GI_MALLOC_PERSISTENT(sizeof(GIParam));
+        pParam = (GIParam*)GI_MALLOC_ARENA(&pMesh->cut_arena, sizeof(GIParam));
         GI_LIST_ADD(twin_patch->params, pParam);
         pParam->id = twin_patch->pcount++;
         GI_VEC2_SCALE(pParam->params, pHTwin->pstart->params, f);
@@ -2318,7 +2313,7 @@ void GIHalfEdge_split(GIHalfEdge *hedge, struct _GIPatch *patch,
         pHNew2->pstart->cut_hedge = pHNew2;
 
     /* save split */
-    pSplit = (GISplitInfo*)GI_MALLOC_PERSISTENT(sizeof(GISplitInfo));
+    pSplit = (GISplitInfo*)GI_MALLOC_ARENA(&pMesh->arena, sizeof(GISplitInfo));
     pSplit->hedge = hedge;
     pSplit->patch = patch;
     pSplit->twin_patch = patch ? twin_patch : NULL;
@@ -2347,7 +2342,7 @@ void GIHalfEdge_half_split(GIHalfEdge *hedge, GIHalfEdge *hnew,
         /* create edge and connect half edges */
         GIHalfEdge *pHMov = hedge_first ? hedge->next : hedge->prev, 
             *pHIns = pHMov->next, *pHNew1, *pHNew2, *pHTmp;
-        GIEdge *pENew = (GIEdge*)GI_MALLOC_PERSISTENT(sizeof(GIEdge));
+        GIEdge *pENew = (GIEdge*)GI_MALLOC_ARENA(&mesh->arena, sizeof(GIEdge));
         GI_LIST_ADD(mesh->edges, pENew);
         pENew->id = mesh->ecount++;
         pHNew1 = &pENew->hedge[0];
@@ -2370,7 +2365,7 @@ void GIHalfEdge_half_split(GIHalfEdge *hedge, GIHalfEdge *hnew,
         pHNew1->face = pFace;
 
         /* create second face */
-        pFNew = (GIFace*)GI_MALLOC_PERSISTENT(sizeof(GIFace));
+        pFNew = (GIFace*)GI_MALLOC_ARENA(&mesh->arena, sizeof(GIFace));
         if(patch)
         {
             GI_LIST_INSERT(mesh->faces, patch->next->faces, pFNew);
@@ -2432,8 +2427,8 @@ void GIHalfEdge_revert_half_split(GIHalfEdge *hedge, GIHalfEdge *hdel,
         GI_LIST_REMOVE(pFace->hedges, pHDel);
         GI_LIST_INSERT(pFace->hedges, pHIns, pHMov);
         pHMov->face = pFace;
-        GI_LIST_DELETE_PERSISTENT(mesh->faces, pFDel, sizeof(GIFace));
-        GI_LIST_DELETE_PERSISTENT(mesh->edges, pEDel, sizeof(GIEdge));
+        GI_LIST_DELETE_ARENA(mesh->faces, &mesh->arena, pFDel, sizeof(GIFace));
+        GI_LIST_DELETE_ARENA(mesh->edges, &mesh->arena, pEDel, sizeof(GIEdge));
         --mesh->fcount;
         --mesh->ecount;
         if(patch)
@@ -2465,7 +2460,7 @@ GIAttribute* GIAttribute_create_interpolated(GIAttribute *attrib1,
     GIuint i, iFloatCount = mesh->attrib_size / sizeof(GIfloat);
 
     /* create attribute and interpolate data (renormalize normals) */
-    pAttribute = (GIAttribute*)GI_MALLOC_PERSISTENT(sizeof(GIAttribute)+mesh->attrib_size);
+    pAttribute = (GIAttribute*)GI_MALLOC_ARENA(&mesh->arena, sizeof(GIAttribute)+mesh->attrib_size);
     vec = (GIfloat*)((GIbyte*)pAttribute+sizeof(GIAttribute));
     for(i=0; i<iFloatCount; ++i)
         vec[i] = f*vec1[i] + fOneF*vec2[i];
@@ -104,6 +104,8 @@ typedef struct _GIMesh
 	GIdouble			*old_coords;				/**< Original vertex coordinates. */
 	struct _GIPatch		*patches;					/**< Patches. */
 	struct _GIPatch		*active_patch;				/**< Currently selected patch. */
+	GIArena				arena;						/**< Memory of faces, edges, vertices, attributes and splits. */
+	GIArena				cut_arena;					/**< Memory of params and cut paths. */
 } GIMesh;
 
 /** \internal
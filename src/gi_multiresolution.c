@@ -50,7 +50,7 @@ GIuint GIMultiresolution_face_clustering(GIMesh *mesh,
 	GIEdge *pEdge;
 	GIHalfEdge *pHedge1, *pHedge2, *pHedge3;
 	GIFaceCluster **pFaceClusterMap;
-	GIHeap qFringe;
+	GIIndexedHeap qFringe;
 	GIHash hNeighbours;
 	GIdouble dError;
 	GIuint i = 0, uiClusters = mesh->fcount;
@@ -92,10 +92,11 @@ GIuint GIMultiresolution_face_clustering(GIMesh *mesh,
 	GI_LIST_NEXT(mesh->faces, pFace)
 
 	/* create intial merge operations and cluster boundaries */
-	GIHeap_construct(&qFringe, mesh->ecount, lessd, -DBL_MAX, GI_TRUE);
+	GIIndexedHeap_construct(&qFringe, mesh->ecount, lessd);
 	GI_LIST_FOREACH(mesh->edges, pEdge)
 		pMerge = (GIClusterMerge*)GI_MALLOC_SINGLE(sizeof(GIClusterMerge));
 		pMerge->length = pEdge->length;
+		pMerge->id = pEdge->id;
 		for(i=0; i<2; ++i)
 		{
 			pMerge->boundary[i].twin = &pMerge->boundary[1-i];
@@ -110,7 +111,7 @@ GIuint GIMultiresolution_face_clustering(GIMesh *mesh,
 			else
 				pMerge->boundary[i].cluster = NULL;
 		}
-		GIHeap_enqueue(&qFringe, pMerge, 
+		GIIndexedHeap_enqueue(&qFringe, pMerge->id, pMerge, 
 			GIClusterMerge_error(pMerge, orientation, shape));
 	GI_LIST_NEXT(mesh->edges, pEdge)
 
@@ -119,7 +120,7 @@ GIuint GIMultiresolution_face_clustering(GIMesh *mesh,
 		hash_pointer, compare_pointer, copy_pointer);
 	while(qFringe.count && uiClusters > min_clusters)
 	{
-		pMerge = GIHeap_dequeue(&qFringe, &dError);
+		pMerge = GIIndexedHeap_dequeue(&qFringe, &dError);
 		if(dError > max_error && uiClusters <= max_clusters)
 			break;
 
@@ -173,7 +174,7 @@ GIuint GIMultiresolution_face_clustering(GIMesh *mesh,
 					GI_LIST_REMOVE(pBoundary2->twin->cluster
 						->boundaries, pBoundary2->twin);
 				}
-				GIHeap_remove(&qFringe, pBoundary2->merge);
+				GIIndexedHeap_remove(&qFringe, pBoundary2->merge->id);
 				GI_FREE_SINGLE(pBoundary2->merge, sizeof(GIClusterMerge));
 			}
 		}
@@ -202,15 +203,18 @@ GIuint GIMultiresolution_face_clustering(GIMesh *mesh,
 			if(dError == 0.0)
 				dError = GIClusterMerge_error(
 					pBoundary->merge, orientation, shape);
-			GIHeap_enqueue(&qFringe, pBoundary->merge, dError);
+			GIIndexedHeap_enqueue(&qFringe, pBoundary->merge->id, 
+				pBoundary->merge, dError);
 		GI_LIST_NEXT(pCluster->boundaries, pBoundary)
 	}
 
 	/* clean up */
-	for(i=1; i<=qFringe.count; ++i)
+	for(i=0; i<qFringe.count; ++i)
 	{
 		GI_FREE_SINGLE(qFringe.items[i].data, sizeof(GIClusterMerge));
 	}
+	GIIndexedHeap_destruct(&qFringe);
+	GIHash_destruct(&hNeighbours, 0);
 	return uiClusters;
 }
 
@@ -148,6 +148,7 @@ typedef struct _GIClusterMerge
 {
 	GIdouble			length;					/**< Length of boundary. */
 	GIClusterBoundary	boundary[2];			/**< Half boundaries. */
+	GIuint				id;						/**< ID of merge operation. */
 } GIClusterMerge;
 
 
@@ -33,6 +33,7 @@
 #include "gi_blas.h"
 #include "gi_memory.h"
 #include "gi_math.h"
+#include "gi_thread.h"
 
 #include <math.h>
 #include <stdlib.h>
@@ -53,1482 +54,4896 @@
 
 
 /** \internal
- *  \brief Apply IC/ILU preconditioner with compressed matrix.
- *  \param A system matrix
- *  \param values value array to use instead of matrix values
- *  \param x vector to multiply preconditioning matrix with
- *  \param y vector to store result
+ *  \brief Minimum number of rows for parallel matrix-vector multiplication.
  *  \ingroup numerics
  */
-static void incomplete_lu(const GISparseMatrixCSR *A, 
-						  const GIdouble *values, 
-						  const GIdouble *x, GIdouble *y)
-{
-	GIint i, ij, N = A->n;
-	if(!values)
-		values = A->values;
-
-	/* forward-eliminate for lower triangle */
-	for(i=0; i<N; ++i)
-	{
-		register GIdouble temp = 0.0;
-		for(ij=A->ptr[i]; A->idx[ij]<i; ++ij)
-			temp += values[ij] * y[A->idx[ij]];
-		y[i] = (x[i]-temp) * values[ij];
-	}
-
-	/* backward-eliminate for upper triangle */
-	if(A->symmetric)
-	{
-		for(i=N-1,ij=A->nnz-1; i>0; --i)
-		{
-			register GIdouble temp = y[i] *= values[ij--];
-			for(; ij>=A->ptr[i]; --ij)
-				y[A->idx[ij]] -= values[ij] * temp;
-		}
-		y[0] *= values[ij];
-	}
-	else
-	{
-		for(i=N-2; i>=0; --i)
-		{
-			register GIdouble temp = 0.0;
-			for(ij=A->ptr[i+1]-1; A->idx[ij]>i; --ij)
-				temp += values[ij] * y[A->idx[ij]];
-			y[i] -= temp;
-		}
-	}
-}
+#define GI_PARALLEL_AX_MIN_ROWS		16384
 
 /** \internal
- *  \brief Sparse vector constructor.
- *  \param vec vector to construct
+ *  \brief Minimum number of rows per task for parallel triangular solves.
  *  \ingroup numerics
  */
-void GISparseVector_construct(GISparseVector *vec)
-{
-	/* empty vector */
-	vec->size = vec->capacity = 0;
-	vec->elements = NULL;
-}
+#define GI_PARALLEL_ILU_MIN_ROWS	256
 
 /** \internal
- *  \brief Let sparse vector grow.
- *  \param vec vector to grow
+ *  \brief Number of rows orthogonalized at once in GMRES (fits into L1 cache).
  *  \ingroup numerics
  */
-void GISparseVector_grow(GISparseVector *vec)
-{
-	if(vec->capacity)
-	{
-		/* double size */
-		vec->capacity <<= 1;
-		vec->elements = (GIVectorElement*)GI_REALLOC_ARRAY(vec->elements, 
-			vec->capacity, sizeof(GIVectorElement));
-	}
-	else
-	{
-		/* init elements */
-		vec->capacity = 4;
-		vec->elements = (GIVectorElement*)GI_MALLOC_ARRAY(
-			vec->capacity, sizeof(GIVectorElement));
-	}
-}
+#define GI_ORTH_BLOCK_SIZE			512
 
 /** \internal
- *  \brief Set value of sparse vector element.
- *  \param vec vector to work on
- *  \param index index of element
- *  \param value new value of element
+ *  \brief Minimum relative accuracy of single precision solves in iterative refinement.
  *  \ingroup numerics
  */
-void GISparseVector_set(GISparseVector *vec, GIuint index, GIdouble value)
-{
-	GIuint i;
-
-	/* element allready in vector */
-	for(i=0; i<vec->size && vec->elements[i].index<index; ++i) ;
-	if(i < vec->size && vec->elements[i].index == index)
-		vec->elements[i].value = value;
-	else
-		GISparseVector_append(vec, index, value);
-}
+#define GI_REFINEMENT_EPS			1e-5
 
 /** \internal
- *  \brief Add value to sparse vector element.
- *  \param vec vector to work on
- *  \param index index of element
- *  \param value value to add
+ *  \brief Factor for relative accuracy of single precision solves in iterative refinement.
+ *  \details A correction is solved to this factor times the square root of
+ *  the residual reduction still needed, so that the last steps do not
+ *  oversolve for a few remaining digits.
  *  \ingroup numerics
  */
-void GISparseVector_add(GISparseVector *vec, GIuint index, GIdouble value)
-{
-	GIuint i;
-
-	for(i=0; i<vec->size && vec->elements[i].index<index; ++i) ;
-	if(i < vec->size && vec->elements[i].index == index)
-		vec->elements[i].value += value;
-	else
-		GISparseVector_append(vec, index, value);
-}
+#define GI_REFINEMENT_FACTOR		0.5
 
 /** \internal
- *  \brief Append element to sparse vector.
- *  \param vec vector to work on
- *  \param index index of element
- *  \param value value of element
+ *  \brief Maximum number of iterative refinement steps.
  *  \ingroup numerics
  */
-void GISparseVector_append(GISparseVector *vec, GIuint index, GIdouble value)
-{
-	GIuint i;
-
-	/* just add new element (grow if neccessary) */
-	if(vec->size == vec->capacity)
-		GISparseVector_grow(vec);
-	for(i=vec->size; i>0 && index<vec->elements[i-1].index; --i)
-		vec->elements[i] = vec->elements[i-1];
-	vec->elements[i].index = index;
-	vec->elements[i].value = value;
-	++vec->size;
-}
+#define GI_REFINEMENT_MAX_STEPS		8
 
 /** \internal
- *  \brief Set sparse vector to zero vector.
- *  \param vec vector to zero
+ *  \brief Maximum size of subgraphs not split by nested dissection.
  *  \ingroup numerics
  */
-void GISparseVector_to_zero(GISparseVector *vec)
-{
-	/* just no elements */
-	vec->size = 0;
-}
+#define GI_ND_LEAF_SIZE				64
 
 /** \internal
- *  \brief Clear sparse vector.
- *  \param vec vector to clear
+ *  \brief Maximum size of coarsest multigrid level.
  *  \ingroup numerics
  */
-void GISparseVector_clear(GISparseVector *vec)
-{
-	/* clear data */
-	vec->size = vec->capacity = 0;
-	if(vec->elements)
-	{
-		GI_FREE_ARRAY(vec->elements);
-		vec->elements = NULL;
-	}
-}
+#define GI_AMG_COARSE_SIZE			512
 
 /** \internal
- *  \brief Sparse matrix constructor.
- *  \param mat matrix to construct
- *  \param n number of rows/columns
- *  \param symmetric GI_TRUE if matrix is symmetric GI_FALSE else
+ *  \brief Maximum number of multigrid levels.
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_construct(GISparseMatrixLIL *mat, 
-								 GIuint n, GIboolean symmetric)
-{
-	/* init data */
-	mat->n = n;
-	mat->symmetric = symmetric;
-	mat->data = NULL;
-
-	/* create rows */
-	mat->rows = (GISparseVector*)GI_CALLOC_ARRAY(n, sizeof(GISparseVector));
-}
+#define GI_AMG_MAX_LEVELS			16
 
 /** \internal
- *  \brief Sparse matrix destructor.
- *  \param mat matrix to destruct
+ *  \brief Strength threshold for aggregation on finest multigrid level.
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_destruct(GISparseMatrixLIL *mat)
-{
-	GIuint i;
-
-	/* clear and delete rows */
-	for(i=0; i<mat->n; ++i)
-		GISparseVector_clear(mat->rows+i);
-	GI_FREE_ARRAY(mat->rows);
-
-	/* clear data */
-	if(mat->data)
-		GI_FREE_ARRAY(mat->data);
-	memset(mat, 0, sizeof(GISparseMatrixLIL));
-}
+#define GI_AMG_STRENGTH				0.08
 
+#if OPENGI_NUM_THREADS > 1
 /** \internal
- *  \brief Set value of sparse matrix element.
- *  \param mat matrix to work on
- *  \param i column of element
- *  \param j row of element
- *  \param value new value of element
+ *  \brief Arguments of parallel matrix-vector multiplication.
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_set(GISparseMatrixLIL *mat, GIuint i, 
-						   GIuint j, GIdouble value)
+typedef struct _GIAxTaskData
 {
-	/* set row element */
-	if(mat->symmetric && (j > i))
-	{
-		register GIuint temp;
-		GI_SWAP(i, j, temp);
-	}
-	GISparseVector_set(mat->rows+i, j, value);
-}
+	const GISparseMatrixCSR	*mat;				/**< Matrix in full storage. */
+	const GIuint			*block_ptr;			/**< Start rows of row blocks. */
+	const GIdouble			*x;					/**< Vector to multiply with. */
+	GIdouble				*y;					/**< Vector to store result. */
+	GIuint					columns;			/**< Number of interleaved vectors. */
+	const GIfloat			*fx;				/**< Single precision vectors to multiply with or NULL. */
+	GIfloat					*fy;				/**< Single precision vectors to store result or NULL. */
+} GIAxTaskData;
 
 /** \internal
- *  \brief Add value to sparse matrix element.
- *  \param mat matrix to work on
- *  \param i column of element
- *  \param j row of element
- *  \param value value to add
+ *  \brief Arguments of parallel elimination of level of IC/ILU preconditioner.
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_add(GISparseMatrixLIL *mat, GIuint i, 
-						   GIuint j, GIdouble value)
+typedef struct _GIIluTaskData
 {
-	/* add to row element */
-	if(mat->symmetric && (j > i))
-	{
-		register GIuint temp;
-		GI_SWAP(i, j, temp);
-	}
-	GISparseVector_add(mat->rows+i, j, value);
-}
+	const GISparseMatrixCSR	*mat;				/**< System matrix with level schedule. */
+	const GIdouble			*values;			/**< Values of factorization. */
+	const GIuint			*rows;				/**< Rows of level. */
+	GIuint					count;				/**< Number of rows of level. */
+	GIuint					tasks;				/**< Number of tasks to split level into. */
+	GIboolean				backward;			/**< Backward elimination for upper triangle. */
+	const GIdouble			*x;					/**< Vector to multiply preconditioning matrix with. */
+	GIdouble				*y;					/**< Vector to store result. */
+	GIuint					columns;			/**< Number of interleaved vectors. */
+	const GIfloat			*fvalues;			/**< Single precision values of factorization or NULL. */
+	const GIfloat			*fx;				/**< Single precision vectors to multiply preconditioning matrix with. */
+	GIfloat					*fy;				/**< Single precision vectors to store result. */
+} GIIluTaskData;
+#endif
 
+#if OPENGI_NUM_THREADS > 1
 /** \internal
- *  \brief Append value to sparse matrix.
- *  \param mat matrix to work on
- *  \param i column of element
- *  \param j row of element
- *  \param value value to add
+ *  \brief Compute level schedule of triangular solves of IC/ILU preconditioner.
+ *  \details For symmetric matrices the backward elimination gathers from 
+ *  the transposed lower triangle, whose elements are subtracted in the 
+ *  same order as by the sequential scattering elimination.
+ *  \param mat system matrix
+ *  \return level schedule
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_append(GISparseMatrixLIL *mat, GIuint i, GIuint j, GIdouble value)
+static GILevelSchedule* create_schedule(const GISparseMatrixCSR *mat)
 {
-	/* append element to row */
+	GILevelSchedule *pSched = (GILevelSchedule*)GI_MALLOC_SINGLE(sizeof(GILevelSchedule));
+	GIuint *pLevel = (GIuint*)GI_MALLOC_ARRAY(mat->n, sizeof(GIuint));
+	GIuint c, d, i, ij, l, p, uiLevels, N = mat->n;
+	GIint k;
+
+	/* transpose lower triangle of symmetric matrix */
+	pSched->upper_ptr = pSched->upper_idx = pSched->upper_row = NULL;
 	if(mat->symmetric)
 	{
-		if(j > i)
+		pSched->upper_ptr = (GIuint*)GI_CALLOC_ARRAY(N+1, sizeof(GIuint));
+		pSched->upper_idx = (GIuint*)GI_MALLOC_ARRAY(mat->nnz-N+1, sizeof(GIuint));
+		pSched->upper_row = (GIuint*)GI_MALLOC_ARRAY(mat->nnz-N+1, sizeof(GIuint));
+		for(i=0; i<N; ++i)
+			for(ij=mat->ptr[i]; ij<mat->ptr[i+1]-1; ++ij)
+				++pSched->upper_ptr[mat->idx[ij]+1];
+		for(i=0; i<N; ++i)
+			pSched->upper_ptr[i+1] += pSched->upper_ptr[i];
+		memcpy(pLevel, pSched->upper_ptr, N*sizeof(GIuint));
+		for(k=N-1; k>=0; --k)
 		{
-			register GIuint temp;
-			GI_SWAP(i, j, temp);
+			for(ij=mat->ptr[k]; ij<mat->ptr[k+1]-1; ++ij)
+			{
+				p = pLevel[mat->idx[ij]]++;
+				pSched->upper_idx[p] = ij;
+				pSched->upper_row[p] = k;
+			}
 		}
-		GISparseVector_set(mat->rows+i, j, value);
 	}
-	else
-		GISparseVector_append(mat->rows+i, j, value);
+
+	for(d=0; d<2; ++d)
+	{
+		/* compute levels of rows */
+		for(c=0,uiLevels=0; c<N; ++c)
+		{
+			i = d ? N-1-c : c;
+			l = 0;
+			if(!d)
+			{
+				for(ij=mat->ptr[i]; mat->idx[ij]<i; ++ij)
+					if(pLevel[mat->idx[ij]] >= l)
+						l = pLevel[mat->idx[ij]] + 1;
+			}
+			else if(mat->symmetric)
+			{
+				for(p=pSched->upper_ptr[i]; p<pSched->upper_ptr[i+1]; ++p)
+					if(pLevel[pSched->upper_row[p]] >= l)
+						l = pLevel[pSched->upper_row[p]] + 1;
+			}
+			else
+			{
+				for(ij=mat->ptr[i+1]-1; mat->idx[ij]>i; --ij)
+					if(pLevel[mat->idx[ij]] >= l)
+						l = pLevel[mat->idx[ij]] + 1;
+			}
+			pLevel[i] = l;
+			if(l >= uiLevels)
+				uiLevels = l + 1;
+		}
+
+		/* sort rows by level */
+		pSched->levels[d] = uiLevels;
+		pSched->level_ptr[d] = (GIuint*)GI_CALLOC_ARRAY(uiLevels+1, sizeof(GIuint));
+		pSched->rows[d] = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+		for(i=0; i<N; ++i)
+			++pSched->level_ptr[d][pLevel[i]+1];
+		for(l=0; l<uiLevels; ++l)
+			pSched->level_ptr[d][l+1] += pSched->level_ptr[d][l];
+		for(i=0; i<N; ++i)
+			pSched->rows[d][pSched->level_ptr[d][pLevel[i]]++] = i;
+		for(l=uiLevels; l>0; --l)
+			pSched->level_ptr[d][l] = pSched->level_ptr[d][l-1];
+		pSched->level_ptr[d][0] = 0;
+	}
+	GI_FREE_ARRAY(pLevel);
+	return pSched;
 }
 
 /** \internal
- *  \brief Set sparse matrix to zero matrix.
- *  \param mat matrix to clear
+ *  \brief Eliminate range of rows of level of IC/ILU preconditioner.
+ *  \details This computes the same values as the sequential elimination.
+ *  \param data elimination data
+ *  \param start first row of level to eliminate
+ *  \param end row of level to stop at
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_to_zero(GISparseMatrixLIL *mat)
+static void eliminate_rows(const GIIluTaskData *data, GIuint start, GIuint end)
 {
-	GIuint i, N = mat->n;
+	const GISparseMatrixCSR *A = data->mat;
+	const GILevelSchedule *pSched = A->ilu_schedule;
+	const GIdouble *values = data->values, *x = data->x;
+	GIdouble *y = data->y;
+	GIuint r, i, ij, p, c, C = data->columns;
 
-	/* zero row */
-	for(i=0; i<N; ++i)
-		GISparseVector_to_zero(mat->rows+i);
+	for(r=start; r<end; ++r)
+	{
+		i = data->rows[r];
+		for(c=0; c<C; ++c)
+		{
+			register GIdouble temp = 0.0;
+			if(!data->backward)
+			{
+				for(ij=A->ptr[i]; A->idx[ij]<i; ++ij)
+					temp += values[ij] * y[A->idx[ij]*C+c];
+				y[i*C+c] = (x[i*C+c]-temp) * values[ij];
+			}
+			else if(A->symmetric)
+			{
+				temp = y[i*C+c];
+				for(p=pSched->upper_ptr[i]; p<pSched->upper_ptr[i+1]; ++p)
+					temp -= values[pSched->upper_idx[p]] * y[pSched->upper_row[p]*C+c];
+				y[i*C+c] = temp * values[A->ptr[i+1]-1];
+			}
+			else
+			{
+				for(ij=A->ptr[i+1]-1; A->idx[ij]>i; --ij)
+					temp += values[ij] * y[A->idx[ij]*C+c];
+				y[i*C+c] -= temp;
+			}
+		}
+	}
 }
 
 /** \internal
- *  \brief Clear sparse matrix (set to zero matrix and release memory).
- *  \param mat matrix to clear
+ *  \brief Eliminate range of rows of level of single precision IC/ILU preconditioner.
+ *  \details This is the same as eliminate_rows for two interleaved single 
+ *  precision vectors.
+ *  \param data elimination data
+ *  \param start first row of level to eliminate
+ *  \param end row of level to stop at
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_clear(GISparseMatrixLIL *mat)
+static void eliminate_rows2f(const GIIluTaskData *data, GIuint start, GIuint end)
 {
-	GIuint i, N = mat->n;
+	const GISparseMatrixCSR *A = data->mat;
+	const GILevelSchedule *pSched = A->ilu_schedule;
+	const GIfloat *values = data->fvalues, *x = data->fx;
+	GIfloat *y = data->fy;
+	GIuint r, i, ij, p, k;
 
-	/* clear row */
-	for(i=0; i<N; ++i)
-		GISparseVector_clear(mat->rows+i);
-}
-
-/** \internal
- *  \brief Get number of non-zero elements in sparse matrix.
- *  \param mat matrix to query
- *  \return number of non-zero elements
- *  \ingroup numerics
- */
-GIuint GISparseMatrixLIL_nnz(const GISparseMatrixLIL *mat)
-{
-	GIuint i, N = mat->n;
-	register GIuint uiResult = 0;
-
-	/* count row sizes */
-	for(i=0; i<N; ++i)
-		uiResult += mat->rows[i].size;
-	return uiResult;
-}
-
-/** \internal
- *  \brief print sparse matrix to file.
- *  \param mat matrix to print
- *  \param file file to print to
- *  \ingroup numerics
- */
-void GISparseMatrixLIL_print(const GISparseMatrixLIL *mat, FILE *file)
-{
-	GISparseVector *pVec;
-	GIVectorElement *pElement;
-	GIuint i, j, ij, N = mat->n;
-
-	if(mat->symmetric)
+	for(r=start; r<end; ++r)
 	{
-		/* convert to dense matrix and print */
-		GIdouble *out = (GIdouble*)GI_CALLOC_ARRAY(N*N, sizeof(GIdouble));
-		for(i=0; i<N; ++i)
+		register GIfloat temp0 = 0.0f, temp1 = 0.0f;
+		i = data->rows[r];
+		if(!data->backward)
 		{
-			pVec = mat->rows + i;
-			for(ij=0; ij<pVec->size; ++ij)
+			for(ij=A->ptr[i]; A->idx[ij]<i; ++ij)
 			{
-				pElement = pVec->elements + ij;
-				out[i*N+pElement->index] = pElement->value;
-				out[pElement->index*N+i] = pElement->value;
+				k = A->idx[ij] << 1;
+				temp0 += values[ij] * y[k];
+				temp1 += values[ij] * y[k+1];
 			}
+			y[2*i] = (x[2*i]-temp0) * values[ij];
+			y[2*i+1] = (x[2*i+1]-temp1) * values[ij];
 		}
-		for(i=0,ij=0; i<N; ++i)
+		else if(A->symmetric)
 		{
-			for(j=0; j<N; ++j,++ij)
-				fprintf(file, "%.17f ", out[ij]);
-			fprintf(file, "\n");
+			temp0 = y[2*i];
+			temp1 = y[2*i+1];
+			for(p=pSched->upper_ptr[i]; p<pSched->upper_ptr[i+1]; ++p)
+			{
+				k = pSched->upper_row[p] << 1;
+				temp0 -= values[pSched->upper_idx[p]] * y[k];
+				temp1 -= values[pSched->upper_idx[p]] * y[k+1];
+			}
+			y[2*i] = temp0 * values[A->ptr[i+1]-1];
+			y[2*i+1] = temp1 * values[A->ptr[i+1]-1];
 		}
-		GI_FREE_ARRAY(out);
-	}
-	else
-	{
-		/* print rows and fill gaps with zeros */
-		for(i=0,j=0; i<N; ++i,j=0)
+		else
 		{
-			pVec = mat->rows + i;
-			for(ij=0; ij<pVec->size; ++ij,++j)
+			for(ij=A->ptr[i+1]-1; A->idx[ij]>i; --ij)
 			{
-				pElement = pVec->elements + ij;
-				for(; j<pElement->index; ++j)
-					fprintf(file, "0 ");
-				fprintf(file, "%.17f ", pElement->value);
+				k = A->idx[ij] << 1;
+				temp0 += values[ij] * y[k];
+				temp1 += values[ij] * y[k+1];
 			}
-			for(; j<N; ++j)
-				fprintf(file, "0 ");
-			fprintf(file, "\n");
+			y[2*i] -= temp0;
+			y[2*i+1] -= temp1;
 		}
 	}
 }
 
 /** \internal
- *  \brief Multiply sparse matrix by vector
- *  \param A matrix
- *  \param x vector to multiply with
- *  \param y vector to store result
+ *  \brief Eliminate part of level of IC/ILU preconditioner.
+ *  \param arg elimination data
+ *  \param index index of part of level
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_ax(const GISparseMatrix *A, 
-						  const GIdouble *x, GIdouble *y)
+static void incomplete_lu_task(GIvoid *arg, GIuint index)
 {
-	const GISparseMatrixLIL *mat = (const GISparseMatrixLIL*)A;
-	const GISparseVector *pVec;
-	const GIVectorElement *pElement;
-	GIuint i, j, N = mat->n;
-
-	if(mat->symmetric)
-	{
-		/* symmetric mutliplication */
-		for(i=0; i<N; ++i)
-		{
-			register GIdouble temp = 0.0, xi = x[i];
-			for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement)
-			{
-				temp += pElement->value * x[pElement->index];
-				y[pElement->index] += pElement->value * xi;
-			}
-			y[i] = temp + pElement->value*x[pElement->index];
-		}
-	}
+	const GIIluTaskData *pData = (const GIIluTaskData*)arg;
+	GIuint uiStart = (pData->count*index) / pData->tasks;
+	GIuint uiEnd = (pData->count*(index+1)) / pData->tasks;
+	if(pData->fy)
+		eliminate_rows2f(pData, uiStart, uiEnd);
 	else
-	{
-		/* general mutliplication */
-		for(i=0; i<N; ++i)
-		{
-			register GIdouble temp = 0.0;
-			pVec = mat->rows + i;
-			for(j=0,pElement=pVec->elements; j<pVec->size; ++j,++pElement)
-				temp += pElement->value * x[pElement->index];
-			y[i] = temp;
-		}
-	}
+		eliminate_rows(pData, uiStart, uiEnd);
 }
 
 /** \internal
- *  \brief Compressed matrix constructor.
- *  \param mat matrix to construct
- *  \param src dynamic sparse matrix to construct from
+ *  \brief Eliminate all levels of IC/ILU preconditioner.
+ *  \details Levels with enough rows are eliminated in parallel.
+ *  \param data elimination data with matrix, values and vectors set
  *  \ingroup numerics
  */
-void GISparseMatrixCSR_construct(GISparseMatrixCSR *mat, 
-								 const GISparseMatrixLIL *src)
+static void eliminate_levels(GIIluTaskData *data)
 {
-	const GISparseVector *pVec;
-	GIint i, j, c, N = src->n;
-
-	/* create matrix */
-	mat->n = N;
-	mat->symmetric = src->symmetric;
-	mat->data = NULL;
-	mat->nnz = GISparseMatrixLIL_nnz(src);
-	mat->values = (GIdouble*)GI_MALLOC_ARRAY(mat->nnz, sizeof(GIdouble));
-	mat->idx = (GIuint*)GI_MALLOC_ARRAY(mat->nnz, sizeof(GIuint));
-	mat->ptr = (GIuint*)GI_MALLOC_ARRAY(N+1, sizeof(GIuint));
+	const GILevelSchedule *pSched = data->mat->ilu_schedule;
+	GIuint d, l, uiStart;
 
-	/* copy data */
-	for(i=0,c=0; i<N; ++i)
+	for(d=0; d<2; ++d)
 	{
-		pVec = src->rows + i;
-		mat->ptr[i] = c;
-		for(j=0; j<pVec->size; ++j,++c)
+		data->backward = d;
+		for(l=0; l<pSched->levels[d]; ++l)
 		{
-			mat->values[c] = pVec->elements[j].value;
-			mat->idx[c] = pVec->elements[j].index;
+			uiStart = pSched->level_ptr[d][l];
+			data->rows = pSched->rows[d] + uiStart;
+			data->count = pSched->level_ptr[d][l+1] - uiStart;
+			data->tasks = data->count / GI_PARALLEL_ILU_MIN_ROWS;
+			if(data->tasks > g_ThreadPool.num_threads)
+				data->tasks = g_ThreadPool.num_threads;
+			if(data->tasks > 1)
+				GIThreadPool_run(&g_ThreadPool, incomplete_lu_task, data, data->tasks);
+			else
+			{
+				data->tasks = 1;
+				incomplete_lu_task(data, 0);
+			}
 		}
 	}
-	mat->ptr[N] = c;
 }
 
 /** \internal
- *  \brief Compressed matrix destructor.
- *  \param mat matrix to destruct
+ *  \brief Apply IC/ILU preconditioner level by level.
+ *  \param A system matrix with level schedule
+ *  \param values values of factorization
+ *  \param x interleaved vectors to multiply preconditioning matrix with
+ *  \param y interleaved vectors to store result
+ *  \param columns number of interleaved vectors
  *  \ingroup numerics
  */
-void GISparseMatrixCSR_destruct(GISparseMatrixCSR *mat)
+static void incomplete_lu_levels(const GISparseMatrixCSR *A, 
+								 const GIdouble *values, 
+								 const GIdouble *x, GIdouble *y, 
+								 GIuint columns)
 {
-	/* delete arrays and clear data */
-	GI_FREE_ARRAY(mat->values);
-	GI_FREE_ARRAY(mat->idx);
-	GI_FREE_ARRAY(mat->ptr);
-	if(mat->data)
-		GI_FREE_ARRAY(mat->data);
-	memset(mat, 0, sizeof(GISparseMatrixCSR));
+	GIIluTaskData data;
+	data.mat = A;
+	data.values = values;
+	data.x = x;
+	data.y = y;
+	data.columns = columns;
+	data.fvalues = data.fx = NULL;
+	data.fy = NULL;
+	eliminate_levels(&data);
 }
 
 /** \internal
- *  \brief print compressed matrix to file.
- *  \param mat matrix to print
- *  \param file file to print to
+ *  \brief Apply single precision IC/ILU preconditioner level by level to two vectors.
+ *  \param A system matrix with level schedule
+ *  \param values single precision values of factorization
+ *  \param x two interleaved vectors to multiply preconditioning matrix with
+ *  \param y two interleaved vectors to store result
  *  \ingroup numerics
  */
-void GISparseMatrixCSR_print(const GISparseMatrixCSR *mat, FILE *file)
+static void incomplete_lu_levels2f(const GISparseMatrixCSR *A, 
+								   const GIfloat *values, 
+								   const GIfloat *x, GIfloat *y)
 {
-	GIuint i, j, ij, N = mat->n;
+	GIIluTaskData data;
+	data.mat = A;
+	data.values = NULL;
+	data.x = NULL;
+	data.y = NULL;
+	data.columns = 2;
+	data.fvalues = values;
+	data.fx = x;
+	data.fy = y;
+	eliminate_levels(&data);
+}
+#endif
 
-	if(mat->symmetric)
+/** \internal
+ *  \brief Level schedule destructor.
+ *  \param sched level schedule to destruct
+ *  \ingroup numerics
+ */
+static void destruct_schedule(GILevelSchedule *sched)
+{
+	GIuint d;
+	for(d=0; d<2; ++d)
 	{
-		/* convert to dense matrix and print */
-		GIdouble *out = (GIdouble*)GI_CALLOC_ARRAY(N*N, sizeof(GIdouble));
-		for(i=0,ij=0; i<N; ++i)
-		{
-			for(; ij<mat->ptr[i+1]; ++ij)
-			{
-				out[i*N+mat->idx[ij]] = mat->values[ij];
-				out[mat->idx[ij]*N+i] = mat->values[ij];
-			}
-		}
-		for(i=0,ij=0; i<N; ++i)
-		{
-			for(j=0; j<N; ++j,++ij)
-				fprintf(file, "%.17f ", out[ij]);
-			fprintf(file, "\n");
-		}
-		GI_FREE_ARRAY(out);
+		GI_FREE_ARRAY(sched->level_ptr[d]);
+		GI_FREE_ARRAY(sched->rows[d]);
 	}
-	else
+	if(sched->upper_ptr)
 	{
-		/* print rows and fill gaps with zeros */
-		for(i=0,j=0,ij=0; i<N; ++i,j=0)
-		{
-			for(; ij<mat->ptr[i+1]; ++ij,++j)
-			{
-				for(; j<mat->idx[ij]; ++j)
-					fprintf(file, "0 ");
-				fprintf(file, "%.17f ", mat->values[ij]);
-			}
-			for(; j<N; ++j)
-				fprintf(file, "0 ");
-			fprintf(file, "\n");
-		}
+		GI_FREE_ARRAY(sched->upper_ptr);
+		GI_FREE_ARRAY(sched->upper_idx);
+		GI_FREE_ARRAY(sched->upper_row);
 	}
+	GI_FREE_SINGLE(sched, sizeof(GILevelSchedule));
 }
 
+
 /** \internal
- *  \brief Multiply compressed matrix by vector
- *  \param A matrix
- *  \param x vector to multiply with
+ *  \brief Apply IC/ILU preconditioner with compressed matrix.
+ *  \param A system matrix
+ *  \param values value array to use instead of matrix values
+ *  \param x vector to multiply preconditioning matrix with
  *  \param y vector to store result
  *  \ingroup numerics
  */
-void GISparseMatrixCSR_ax(const GISparseMatrix *A, 
+static void incomplete_lu(const GISparseMatrixCSR *A, 
+						  const GIdouble *values, 
 						  const GIdouble *x, GIdouble *y)
 {
-	const GISparseMatrixCSR *mat = (const GISparseMatrixCSR*)A;
-	GIuint i, ij, N = mat->n;
+	GIint i, ij, N = A->n;
+	if(!values)
+		values = A->values;
+#if OPENGI_NUM_THREADS > 1
+	if(A->blocks > 1 && A->ilu_schedule)
+	{
+		incomplete_lu_levels(A, values, x, y, 1);
+		return;
+	}
+#endif
 
-	if(mat->symmetric)
+	/* forward-eliminate for lower triangle */
+	for(i=0; i<N; ++i)
 	{
-		/* symmetric mutliplication */
-		for(i=0,ij=0; i<N; ++i,++ij)
+		register GIdouble temp = 0.0;
+		for(ij=A->ptr[i]; A->idx[ij]<i; ++ij)
+			temp += values[ij] * y[A->idx[ij]];
+		y[i] = (x[i]-temp) * values[ij];
+	}
+
+	/* backward-eliminate for upper triangle */
+	if(A->symmetric)
+	{
+		for(i=N-1,ij=A->nnz-1; i>0; --i)
 		{
-			register GIdouble temp = 0.0, xi = x[i];
-			for(; ij<mat->ptr[i+1]-1; ++ij)
-			{
-				temp += mat->values[ij] * x[mat->idx[ij]];
-				y[mat->idx[ij]] += mat->values[ij] * xi;
-			}
-			y[i] = temp + mat->values[ij]*x[mat->idx[ij]];
+			register GIdouble temp = y[i] *= values[ij--];
+			for(; ij>=A->ptr[i]; --ij)
+				y[A->idx[ij]] -= values[ij] * temp;
 		}
+		y[0] *= values[ij];
 	}
 	else
 	{
-		/* general mutliplication */
-		for(i=0,ij=0; i<N; ++i)
+		for(i=N-2; i>=0; --i)
 		{
 			register GIdouble temp = 0.0;
-			for(; ij<mat->ptr[i+1]; ++ij)
-				temp += mat->values[ij] * x[mat->idx[ij]];
-			y[i] = temp;
+			for(ij=A->ptr[i+1]-1; A->idx[ij]>i; --ij)
+				temp += values[ij] * y[A->idx[ij]];
+			y[i] -= temp;
 		}
 	}
 }
 
 /** \internal
- *  \brief Block compressed matrix constructor.
- *  \param mat matrix to construct
- *  \param src dynamic sparse matrix to construct from
+ *  \brief Apply IC/ILU preconditioner with compressed matrix to two vectors.
+ *  \param A system matrix
+ *  \param values value array to use instead of matrix values
+ *  \param x two interleaved vectors to multiply preconditioning matrix with
+ *  \param y two interleaved vectors to store result
  *  \ingroup numerics
  */
-void GISparseMatrixBCSR2_construct(GISparseMatrixBCSR2 *mat, 
-								   const GISparseMatrixLIL *src)
+static void incomplete_lu2(const GISparseMatrixCSR *A, 
+						   const GIdouble *values, 
+						   const GIdouble *x, GIdouble *y)
 {
-	GIint i, i2, c = -1, N = (src->n+1) >> 1, NNZ = GISparseMatrixLIL_nnz(src);
-	GIdouble *pValues;
-	GIuint *pIdx;
+	GIint i, ij, k, N = A->n;
+	if(!values)
+		values = A->values;
+#if OPENGI_NUM_THREADS > 1
+	if(A->blocks > 1 && A->ilu_schedule)
+	{
+		incomplete_lu_levels(A, values, x, y, 2);
+		return;
+	}
+#endif
 
-	/* create matrix */
-	mat->n = src->n;
-	mat->symmetric = src->symmetric;
-	mat->data = NULL;
-	mat->nnz = 0;
-	mat->ptr = (GIuint*)GI_MALLOC_ARRAY(N+1, sizeof(GIuint));
-	pValues = (GIdouble*)GI_MALLOC_ARRAY(NNZ<<2, sizeof(GIdouble));
-	pIdx = (GIuint*)GI_MALLOC_ARRAY(NNZ, sizeof(GIuint));
+	/* forward-eliminate for lower triangle */
+	for(i=0; i<N; ++i)
+	{
+		register GIdouble temp0 = 0.0, temp1 = 0.0;
+		for(ij=A->ptr[i]; A->idx[ij]<i; ++ij)
+		{
+			k = A->idx[ij] << 1;
+			temp0 += values[ij] * y[k];
+			temp1 += values[ij] * y[k+1];
+		}
+		y[2*i] = (x[2*i]-temp0) * values[ij];
+		y[2*i+1] = (x[2*i+1]-temp1) * values[ij];
+	}
 
-	/* copy data */
-	for(i=0,i2=0; i<N; ++i,i2+=2)
+	/* backward-eliminate for upper triangle */
+	if(A->symmetric)
 	{
-		const GISparseVector *pVec[2] = { src->rows+i2, 
-			(i2+1<src->n) ? src->rows+i2+1 : NULL };
-		GIuint ij[2] = { 0, 0 };
-		GIint jCur = -1, j, r;
-		mat->ptr[i] = c + 1;
-		while(pVec[0] || pVec[1])
+		for(i=N-1,ij=A->nnz-1; i>0; --i)
 		{
-			if(pVec[0] && pVec[1])
-				r = (pVec[0]->elements[ij[0]].index<
-					pVec[1]->elements[ij[1]].index) ? 0 : 1;
-			else
-				r = pVec[0] ? 0 : 1;
-			j = pVec[r]->elements[ij[r]].index >> 1;
-			if(j > jCur)
+			register GIdouble temp0 = y[2*i] *= values[ij];
+			register GIdouble temp1 = y[2*i+1] *= values[ij--];
+			for(; ij>=A->ptr[i]; --ij)
 			{
-				pIdx[++c] = jCur = j;
-				pValues[c<<2] = pValues[(c<<2)+1] = 
-					pValues[(c<<2)+2] = pValues[(c<<2)+3] = 0.0;
+				k = A->idx[ij] << 1;
+				y[k] -= values[ij] * temp0;
+				y[k+1] -= values[ij] * temp1;
 			}
-			pValues[(c<<2)+(r<<1)+(pVec[r]->elements[ij[r]].index&1)] = 
-				pVec[r]->elements[ij[r]].value;
-			if(++ij[r] == pVec[r]->size)
-				pVec[r] = NULL;
 		}
+		y[0] *= values[ij];
+		y[1] *= values[ij];
 	}
-	mat->ptr[N] = mat->nnz = ++c;
+	else
+	{
+		for(i=N-2; i>=0; --i)
+		{
+			register GIdouble temp0 = 0.0, temp1 = 0.0;
+			for(ij=A->ptr[i+1]-1; A->idx[ij]>i; --ij)
+			{
+				k = A->idx[ij] << 1;
+				temp0 += values[ij] * y[k];
+				temp1 += values[ij] * y[k+1];
+			}
+			y[2*i] -= temp0;
+			y[2*i+1] -= temp1;
+		}
+	}
+}
 
-	/* complete blocks for diagonal of symmetric matrix */
-	if(mat->symmetric)
+/** \internal
+ *  \brief Apply single precision IC/ILU preconditioner with compressed matrix to two vectors.
+ *  \details This is the same as incomplete_lu2 in single precision.
+ *  \param A system matrix
+ *  \param values single precision factors
+ *  \param x two interleaved vectors to multiply preconditioning matrix with
+ *  \param y two interleaved vectors to store result
+ *  \ingroup numerics
+ */
+static void incomplete_lu2f(const GISparseMatrixCSR *A, 
+							const GIfloat *values, 
+							const GIfloat *x, GIfloat *y)
+{
+	GIint i, ij, k, N = A->n;
+#if OPENGI_NUM_THREADS > 1
+	if(A->blocks > 1 && A->ilu_schedule)
 	{
-		for(i=0; i<N; ++i)
+		incomplete_lu_levels2f(A, values, x, y);
+		return;
+	}
+#endif
+
+	/* forward-eliminate for lower triangle */
+	for(i=0; i<N; ++i)
+	{
+		register GIfloat temp0 = 0.0f, temp1 = 0.0f;
+		for(ij=A->ptr[i]; A->idx[ij]<i; ++ij)
 		{
-			GIuint ij = (mat->ptr[i+1]-1) << 2;
-			pValues[ij+1] = pValues[ij+2];
+			k = A->idx[ij] << 1;
+			temp0 += values[ij] * y[k];
+			temp1 += values[ij] * y[k+1];
 		}
+		y[2*i] = (x[2*i]-temp0) * values[ij];
+		y[2*i+1] = (x[2*i+1]-temp1) * values[ij];
 	}
 
-	/* compress data */
-	mat->values = (GIdouble*)GI_MALLOC_ALIGNED(
-		GI_SSE_SIZE(mat->nnz<<2*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-	memcpy(mat->values, pValues, (mat->nnz<<2)*sizeof(GIdouble));
-	GI_FREE_ARRAY(pValues);
-	mat->idx = (GIuint*)GI_MALLOC_ARRAY(mat->nnz, sizeof(GIuint));
-	memcpy(mat->idx, pIdx, mat->nnz*sizeof(GIuint));
-	GI_FREE_ARRAY(pIdx);
+	/* backward-eliminate for upper triangle */
+	if(A->symmetric)
+	{
+		for(i=N-1,ij=A->nnz-1; i>0; --i)
+		{
+			register GIfloat temp0 = y[2*i] *= values[ij];
+			register GIfloat temp1 = y[2*i+1] *= values[ij--];
+			for(; ij>=A->ptr[i]; --ij)
+			{
+				k = A->idx[ij] << 1;
+				y[k] -= values[ij] * temp0;
+				y[k+1] -= values[ij] * temp1;
+			}
+		}
+		y[0] *= values[ij];
+		y[1] *= values[ij];
+	}
+	else
+	{
+		for(i=N-2; i>=0; --i)
+		{
+			register GIfloat temp0 = 0.0f, temp1 = 0.0f;
+			for(ij=A->ptr[i+1]-1; A->idx[ij]>i; --ij)
+			{
+				k = A->idx[ij] << 1;
+				temp0 += values[ij] * y[k];
+				temp1 += values[ij] * y[k+1];
+			}
+			y[2*i] -= temp0;
+			y[2*i+1] -= temp1;
+		}
+	}
 }
 
 /** \internal
- *  \brief Block compressed matrix destructor.
- *  \param mat matrix to destruct
+ *  \brief Compute dot products of two pairs of interleaved vectors.
+ *  \details The summation order matches the one of ddot.
+ *  \param n size of vectors
+ *  \param x first two interleaved vectors
+ *  \param y second two interleaved vectors
+ *  \param d array to store both dot products
  *  \ingroup numerics
  */
-void GISparseMatrixBCSR2_destruct(GISparseMatrixBCSR2 *mat)
+static void ddot2(GIint n, const GIdouble *x, const GIdouble *y, GIdouble *d)
 {
-	/* delete arrays and clear data */
-	GI_FREE_ALIGNED(mat->values);
-	GI_FREE_ARRAY(mat->idx);
-	GI_FREE_ARRAY(mat->ptr);
-	if(mat->data)
-		GI_FREE_ARRAY(mat->data);
-	memset(mat, 0, sizeof(GISparseMatrixBCSR2));
+	register GIdouble temp0 = 0.0, temp1 = 0.0;
+	GIint i = 0, m = (n & ~3) << 1;
+	for(; i<m; i+=8)
+	{
+		temp0 += x[i]*y[i] + x[i+2]*y[i+2] + 
+			x[i+4]*y[i+4] + x[i+6]*y[i+6];
+		temp1 += x[i+1]*y[i+1] + x[i+3]*y[i+3] + 
+			x[i+5]*y[i+5] + x[i+7]*y[i+7];
+	}
+	for(n<<=1; i<n; i+=2)
+	{
+		temp0 += x[i] * y[i];
+		temp1 += x[i+1] * y[i+1];
+	}
+	d[0] = temp0;
+	d[1] = temp1;
 }
 
 /** \internal
- *  \brief print block compressed matrix to file.
- *  \param mat matrix to print
- *  \param file file to print to
+ *  \brief Add scaled interleaved vectors to interleaved vectors.
+ *  \param n size of vectors
+ *  \param a scale factors for both vectors
+ *  \param active flags for vectors to work on
+ *  \param x interleaved vectors to add
+ *  \param y interleaved vectors to add to
  *  \ingroup numerics
  */
-void GISparseMatrixBCSR2_print(const GISparseMatrixBCSR2 *mat, FILE *file)
+static void daxpy2(GIint n, const GIdouble *a, const GIboolean *active, 
+				   const GIdouble *x, GIdouble *y)
 {
-	GIuint i, j, ij, ij4, N = (mat->n+1) >> 1, M = N << 1;
+	GIint i;
+	if(active[0] && active[1])
+	{
+		for(i=0,n<<=1; i<n; i+=2)
+		{
+			y[i] += a[0] * x[i];
+			y[i+1] += a[1] * x[i+1];
+		}
+	}
+	else
+	{
+		for(i=0; i<2; ++i)
+			if(active[i])
+				daxpy(n, a[i], x+i, 2, y+i, 2);
+	}
+}
 
-	if(mat->symmetric)
+/** \internal
+ *  \brief Update solution and residual and compute residual norms in one pass.
+ *  \details This computes y += a*x, w += a*z and the squared norms of the new 
+ *  w, which would otherwise take three passes over the vectors. The results 
+ *  match the ones of daxpy2 and ddot2. Norms of inactive vectors are zero.
+ *  \param n size of vectors
+ *  \param a scale factors for both vectors
+ *  \param active flags for vectors to work on
+ *  \param x interleaved vectors to add to y
+ *  \param y interleaved vectors to add to
+ *  \param z interleaved vectors to add to w
+ *  \param w interleaved vectors to add to and compute norms of
+ *  \param d array to store both squared norms
+ *  \ingroup numerics
+ */
+static void daxpy2_nrm2(GIint n, const GIdouble *a, const GIboolean *active, 
+						const GIdouble *x, GIdouble *y, const GIdouble *z, 
+						GIdouble *w, GIdouble *d)
+{
+	register GIdouble temp0 = 0.0, temp1 = 0.0;
+	GIint i, k, c, m = (n & ~3) << 1;
+	n <<= 1;
+	if(active[0] && active[1])
 	{
-		/* convert to dense matrix and print */
-		GIdouble *out = (GIdouble*)GI_CALLOC_ARRAY(M*M, sizeof(GIdouble));
-		for(i=0,ij=0,ij4=0; i<N; ++i)
+		for(i=0; i<m; i+=8)
 		{
-			for(; ij<mat->ptr[i+1]; ++ij,ij4+=4)
+			for(k=i; k<i+8; k+=2)
 			{
-				GIuint I = i << 1, J = mat->idx[ij] << 1;
-				out[I*M+J] = out[J*M+I] = mat->values[ij4];
-				out[(I+1)*M+J] = out[J*M+I+1] = mat->values[ij4+1];
-				out[I*M+J+1] = out[(J+1)*M+I] = mat->values[ij4+2];
-				out[(I+1)*M+J+1] = out[(J+1)*M+I+1] = mat->values[ij4+3];
+				y[k] += a[0] * x[k];
+				w[k] += a[0] * z[k];
+				y[k+1] += a[1] * x[k+1];
+				w[k+1] += a[1] * z[k+1];
 			}
+			temp0 += w[i]*w[i] + w[i+2]*w[i+2] + 
+				w[i+4]*w[i+4] + w[i+6]*w[i+6];
+			temp1 += w[i+1]*w[i+1] + w[i+3]*w[i+3] + 
+				w[i+5]*w[i+5] + w[i+7]*w[i+7];
 		}
-		for(i=0,ij=0; i<M; ++i)
+		for(; i<n; i+=2)
 		{
-			for(j=0; j<M; ++j,++ij)
-				fprintf(file, "%.17f ", out[ij]);
-			fprintf(file, "\n");
+			y[i] += a[0] * x[i];
+			w[i] += a[0] * z[i];
+			y[i+1] += a[1] * x[i+1];
+			w[i+1] += a[1] * z[i+1];
+			temp0 += w[i] * w[i];
+			temp1 += w[i+1] * w[i+1];
 		}
-		GI_FREE_ARRAY(out);
+		d[0] = temp0;
+		d[1] = temp1;
 	}
 	else
 	{
-		/* print rows and fill gaps with zeros */
-		for(i=0,j=0; i<N; ++i)
+		for(c=0; c<2; ++c)
 		{
-			for(ij=mat->ptr[i],j=0; ij<mat->ptr[i+1]; ++ij,++j)
-			{
-				for(; j<mat->idx[ij]; ++j)
-					fprintf(file, "0 0 ");
-				fprintf(file, "%.17f %.17f ", 
-					mat->values[ij<<2], mat->values[(ij<<2)+1]);
-			}
-			for(; j<N; ++j)
-				fprintf(file, "0 0 ");
-			fprintf(file, "\n");
-			for(ij=mat->ptr[i],j=0; ij<mat->ptr[i+1]; ++ij,++j)
+			temp0 = 0.0;
+			if(active[c])
 			{
-				for(; j<mat->idx[ij]; ++j)
-					fprintf(file, "0 0 ");
-				fprintf(file, "%.17f %.17f ", 
-					mat->values[(ij<<2)+2], mat->values[(ij<<2)+3]);
+				for(i=c; i<m; i+=8)
+				{
+					for(k=i; k<i+8; k+=2)
+					{
+						y[k] += a[c] * x[k];
+						w[k] += a[c] * z[k];
+					}
+					temp0 += w[i]*w[i] + w[i+2]*w[i+2] + 
+						w[i+4]*w[i+4] + w[i+6]*w[i+6];
+				}
+				for(; i<n; i+=2)
+				{
+					y[i] += a[c] * x[i];
+					w[i] += a[c] * z[i];
+					temp0 += w[i] * w[i];
+				}
 			}
-			for(; j<N; ++j)
-				fprintf(file, "0 0 ");
-			fprintf(file, "\n");
+			d[c] = temp0;
 		}
 	}
 }
 
 /** \internal
- *  \brief Multiply block compressed matrix by vector
- *  \param A matrix
- *  \param x vector to multiply with
- *  \param y vector to store result
+ *  \brief Update search directions of interleaved vectors in one pass.
+ *  \details This computes y = x + b*(y + a*z) for every active vector, or 
+ *  y = x + b*y if z is NULL, which would otherwise take two or three passes.
+ *  \param n size of vectors
+ *  \param a scale factors for z or NULL if z is NULL
+ *  \param b scale factors for y
+ *  \param active flags for vectors to work on
+ *  \param x interleaved vectors to add
+ *  \param z interleaved vectors to add to y before scaling or NULL
+ *  \param y interleaved vectors to update
  *  \ingroup numerics
  */
-void GISparseMatrixBCSR2_ax(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+static void dxpay2(GIint n, const GIdouble *a, const GIdouble *b, 
+				   const GIboolean *active, const GIdouble *x, 
+				   const GIdouble *z, GIdouble *y)
 {
-	const GISparseMatrixCSR *mat = (const GISparseMatrixCSR*)A;
-	GIuint i, j2, ij, ij4, N = (mat->n+1) >> 1;
-
-	if(mat->symmetric)
+	GIint i, c;
+	n <<= 1;
+	if(active[0] && active[1])
 	{
-		/* symmetric mutliplication */
-		for(i=0,ij=0,ij4=0; i<N; ++i,++ij,ij4+=4)
+		if(z)
 		{
-#if OPENGI_SSE >= 2
-			GIuint i2 = i << 1;
-			__m128d XMM0 = _mm_setzero_pd(), XMM1;
-			__m128d XMM2 = _mm_load1_pd(x+i2);
-			__m128d XMM3 = _mm_load1_pd(x+i2+1);
-			__m128d XMM4, XMM5, XMM6, XMM7;
-			for(; ij<mat->ptr[i+1]-1; ++ij,ij4+=4)
+			for(i=0; i<n; i+=2)
 			{
-				j2 = mat->idx[ij] << 1;
-				XMM1 = _mm_load_pd(y+j2);
-				XMM4 = _mm_load_pd(mat->values+ij4);
-				XMM5 = _mm_load_pd(mat->values+ij4+2);
-				XMM6 = _mm_mul_pd(XMM4, XMM2);
-				XMM7 = _mm_mul_pd(XMM5, XMM3);
-				XMM1 = _mm_add_pd(XMM1, XMM6);
-				XMM1 = _mm_add_pd(XMM1, XMM7);
-				_mm_store_pd(y+j2, XMM1);
-				XMM1 = _mm_load_pd(x+j2);
-				XMM4 = _mm_mul_pd(XMM4, XMM1);
-				XMM5 = _mm_mul_pd(XMM5, XMM1);
-#if OPENGI_SSE >= 3
-				XMM4 = _mm_hadd_pd(XMM4, XMM5);
-				XMM0 = _mm_add_pd(XMM0, XMM4);
-#else
-				XMM6 = _mm_shuffle_pd(XMM4, XMM5, _MM_SHUFFLE2(0, 0));
-				XMM7 = _mm_shuffle_pd(XMM4, XMM5, _MM_SHUFFLE2(1, 1));
-				XMM0 = _mm_add_pd(XMM0, XMM6);
-				XMM0 = _mm_add_pd(XMM0, XMM7);
-#endif	/* SSE3 */
+				y[i] = (y[i]+a[0]*z[i])*b[0] + x[i];
+				y[i+1] = (y[i+1]+a[1]*z[i+1])*b[1] + x[i+1];
 			}
-			XMM1 = _mm_load_pd(x+(mat->idx[ij]<<1));
-			XMM2 = _mm_load_pd(mat->values+ij4);
-			XMM3 = _mm_load_pd(mat->values+ij4+2);
-			XMM2 = _mm_mul_pd(XMM2, XMM1);
-			XMM3 = _mm_mul_pd(XMM3, XMM1);
-#if OPENGI_SSE >= 3
-			XMM2 = _mm_hadd_pd(XMM2, XMM3);
-			XMM0 = _mm_add_pd(XMM0, XMM2);
-#else
-			XMM4 = _mm_shuffle_pd(XMM2, XMM3, _MM_SHUFFLE2(0, 0));
-			XMM5 = _mm_shuffle_pd(XMM2, XMM3, _MM_SHUFFLE2(1, 1));
-			XMM0 = _mm_add_pd(XMM0, XMM4);
-			XMM0 = _mm_add_pd(XMM0, XMM5);
-#endif	/* SSE3 */
-			_mm_store_pd(y+i2, XMM0);
-#else
-			register GIdouble temp0 = 0.0, temp1 = 0.0;
-			GIuint i2 = i << 1;
-			for(; ij<mat->ptr[i+1]-1; ++ij,ij4+=4)
+		}
+		else
+		{
+			for(i=0; i<n; i+=2)
 			{
-				j2 = mat->idx[ij] << 1;
-				temp0 += mat->values[ij4]*x[j2] + mat->values[ij4+1]*x[j2+1];
-				temp1 += mat->values[ij4+2]*x[j2] + mat->values[ij4+3]*x[j2+1];
-				y[j2] += mat->values[ij4]*x[i2] + mat->values[ij4+2]*x[i2+1];
-				y[j2+1] += mat->values[ij4+1]*x[i2] + mat->values[ij4+3]*x[i2+1];
+				y[i] = y[i]*b[0] + x[i];
+				y[i+1] = y[i+1]*b[1] + x[i+1];
 			}
-			j2 = mat->idx[ij] << 1;
-			y[i2] = temp0 + mat->values[ij4]*x[j2] + mat->values[ij4+1]*x[j2+1];
-			y[i2+1] = temp1 + mat->values[ij4+2]*x[j2] + mat->values[ij4+3]*x[j2+1];
-#endif /* SSE2 */
 		}
+		return;
 	}
-	else
+	for(c=0; c<2; ++c)
 	{
-		/* general mutliplication */
-		for(i=0,ij=0,ij4=0; i<N; ++i,y+=2)
-		{
-#if OPENGI_SSE >= 2
-			__m128d XMM0 = _mm_setzero_pd();
-			__m128d XMM1, XMM2, XMM3;
-#if OPENGI_SSE < 3
-			__m128d XMM4, XMM5;
-#endif
-			for(; ij<mat->ptr[i+1]; ++ij,ij4+=4)
-			{
-				XMM1 = _mm_load_pd(x+(mat->idx[ij]<<1));
-				XMM2 = _mm_load_pd(mat->values+ij4);
-				XMM3 = _mm_load_pd(mat->values+ij4+2);
-				XMM2 = _mm_mul_pd(XMM2, XMM1);
-				XMM3 = _mm_mul_pd(XMM3, XMM1);
-#if OPENGI_SSE >= 3
-				XMM2 = _mm_hadd_pd(XMM2, XMM3);
-				XMM0 = _mm_add_pd(XMM0, XMM2);
-#else
-				XMM4 = _mm_shuffle_pd(XMM2, XMM3, _MM_SHUFFLE2(0, 0));
-				XMM5 = _mm_shuffle_pd(XMM2, XMM3, _MM_SHUFFLE2(1, 1));
-				XMM0 = _mm_add_pd(XMM0, XMM4);
-				XMM0 = _mm_add_pd(XMM0, XMM5);
-#endif	/* SSE3 */
-			}
-			_mm_store_pd(y, XMM0);
-#else
-			register GIdouble temp0 = 0.0, temp1 = 0.0;
-			for(; ij<mat->ptr[i+1]; ++ij,ij4+=4)
-			{
-				j2 = mat->idx[ij] << 1;
-				temp0 += mat->values[ij4]*x[j2] + mat->values[ij4+1]*x[j2+1];
-				temp1 += mat->values[ij4+2]*x[j2] + mat->values[ij4+3]*x[j2+1];
-			}
-			y[0] = temp0;
-			y[1] = temp1;
-#endif	/* SSE2 */
-		}
+		if(!active[c])
+			continue;
+		if(z)
+			for(i=c; i<n; i+=2)
+				y[i] = (y[i]+a[c]*z[i])*b[c] + x[i];
+		else
+			for(i=c; i<n; i+=2)
+				y[i] = y[i]*b[c] + x[i];
 	}
 }
 
 /** \internal
- *  \brief Prepare data for Jacobi preconditioner with sparse matrix.
- *  \param mat matrix to create data for
+ *  \brief Compute dot products of two pairs of interleaved vectors and norms of first ones in one pass.
+ *  \details The summation order matches the one of ddot2.
+ *  \param n size of vectors
+ *  \param x first two interleaved vectors
+ *  \param y second two interleaved vectors
+ *  \param dxy array to store both dot products
+ *  \param dxx array to store both squared norms of x
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_prepare_jacobi(GISparseMatrixLIL *mat)
+static void ddot2_nrm2(GIint n, const GIdouble *x, const GIdouble *y, 
+					   GIdouble *dxy, GIdouble *dxx)
 {
-	GIdouble *pData;
-	GIuint i, N = mat->n, uiSize = N * sizeof(GIdouble);
-
-	/* create data if neccessary */
-	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	register GIdouble temp0 = 0.0, temp1 = 0.0, temp2 = 0.0, temp3 = 0.0;
+	GIint i = 0, m = (n & ~3) << 1;
+	for(; i<m; i+=8)
 	{
-		if(mat->data)
-			GI_FREE_ARRAY(mat->data);
-		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
-		*((GIuint*)mat->data) = uiSize;
+		temp0 += x[i]*y[i] + x[i+2]*y[i+2] + 
+			x[i+4]*y[i+4] + x[i+6]*y[i+6];
+		temp1 += x[i+1]*y[i+1] + x[i+3]*y[i+3] + 
+			x[i+5]*y[i+5] + x[i+7]*y[i+7];
+		temp2 += x[i]*x[i] + x[i+2]*x[i+2] + 
+			x[i+4]*x[i+4] + x[i+6]*x[i+6];
+		temp3 += x[i+1]*x[i+1] + x[i+3]*x[i+3] + 
+			x[i+5]*x[i+5] + x[i+7]*x[i+7];
 	}
-	pData = (GIdouble*)((GIuint*)mat->data+1);
+	for(n<<=1; i<n; i+=2)
+	{
+		temp0 += x[i] * y[i];
+		temp1 += x[i+1] * y[i+1];
+		temp2 += x[i] * x[i];
+		temp3 += x[i+1] * x[i+1];
+	}
+	dxy[0] = temp0;
+	dxy[1] = temp1;
+	dxx[0] = temp2;
+	dxx[1] = temp3;
+}
 
-	/* store inverted diagonal */
-	if(mat->symmetric)
-		for(i=0; i<N; ++i)
-			pData[i] = 1.0 / mat->rows[i].elements[mat->rows[i].size-1].value;
-	else
+/** \internal
+ *  \brief Compute dot products of two pairs of interleaved single precision vectors.
+ *  \details The products are accumulated in double precision.
+ *  \param n size of vectors
+ *  \param x first two interleaved vectors
+ *  \param y second two interleaved vectors
+ *  \param d array to store both dot products
+ *  \ingroup numerics
+ */
+static void sdot2(GIint n, const GIfloat *x, const GIfloat *y, GIdouble *d)
+{
+	register GIdouble temp0 = 0.0, temp1 = 0.0;
+	GIint i;
+	for(i=0,n<<=1; i<n; i+=2)
 	{
-		GIVectorElement *pElement;
+		temp0 += x[i] * y[i];
+		temp1 += x[i+1] * y[i+1];
+	}
+	d[0] = temp0;
+	d[1] = temp1;
+}
 
-		/* search for diagonal entry */
-		for(i=0; i<N; ++i)
+/** \internal
+ *  \brief Add scaled interleaved single precision vectors to interleaved vectors.
+ *  \param n size of vectors
+ *  \param a scale factors for both vectors
+ *  \param active flags for vectors to work on
+ *  \param x interleaved vectors to add
+ *  \param y interleaved vectors to add to
+ *  \ingroup numerics
+ */
+static void saxpy2(GIint n, const GIdouble *a, const GIboolean *active, 
+				   const GIfloat *x, GIfloat *y)
+{
+	GIfloat a0 = (GIfloat)a[0], a1 = (GIfloat)a[1];
+	GIint i, c;
+	n <<= 1;
+	if(active[0] && active[1])
+	{
+		for(i=0; i<n; i+=2)
 		{
-			for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement) ;
-			pData[i] = 1.0 / pElement->value;
+			y[i] += a0 * x[i];
+			y[i+1] += a1 * x[i+1];
 		}
+		return;
 	}
+	for(c=0; c<2; ++c)
+		if(active[c])
+			for(i=c; i<n; i+=2)
+				y[i] += (c ? a1 : a0) * x[i];
 }
 
 /** \internal
- *  \brief Prepare data for SSOR preconditioner with sparse matrix.
- *  \param mat matrix to create data for
- *  \param omega relaxation parameter in [0,2]
+ *  \brief Update single precision solution and residual and compute residual norms in one pass.
+ *  \details This is the same as daxpy2_nrm2 for single precision vectors, 
+ *  with the norms accumulated in double precision.
+ *  \param n size of vectors
+ *  \param a scale factors for both vectors
+ *  \param active flags for vectors to work on
+ *  \param x interleaved vectors to add to y
+ *  \param y interleaved vectors to add to
+ *  \param z interleaved vectors to add to w
+ *  \param w interleaved vectors to add to and compute norms of
+ *  \param d array to store both squared norms
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_prepare_ssor(GISparseMatrixLIL *mat, GIdouble omega)
+static void saxpy2_nrm2(GIint n, const GIdouble *a, const GIboolean *active, 
+						const GIfloat *x, GIfloat *y, const GIfloat *z, 
+						GIfloat *w, GIdouble *d)
 {
-	GIdouble *pData;
-	GIuint i, N = mat->n, uiSize = (N+1) * sizeof(GIdouble);
-
-	/* create data if neccessary */
-	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	GIfloat af[2] = { (GIfloat)a[0], (GIfloat)a[1] };
+	register GIdouble temp0 = 0.0, temp1 = 0.0;
+	GIint i, c;
+	n <<= 1;
+	if(active[0] && active[1])
 	{
-		if(mat->data)
-			GI_FREE_ARRAY(mat->data);
-		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
-		*((GIuint*)mat->data) = uiSize;
+		for(i=0; i<n; i+=2)
+		{
+			y[i] += af[0] * x[i];
+			w[i] += af[0] * z[i];
+			y[i+1] += af[1] * x[i+1];
+			w[i+1] += af[1] * z[i+1];
+			temp0 += w[i] * w[i];
+			temp1 += w[i+1] * w[i+1];
+		}
+		d[0] = temp0;
+		d[1] = temp1;
+		return;
 	}
-	pData = (GIdouble*)((GIuint*)mat->data+1);
-
-	/* save diagonal and omega */
-	if(mat->symmetric)
-		for(i=0; i<N; ++i)
-			pData[i] = mat->rows[i].elements[mat->rows[i].size-1].value;
-	else
+	for(c=0; c<2; ++c)
 	{
-		GIVectorElement *pElement;
-
-		/* search for diagonal entry */
-		for(i=0; i<N; ++i)
+		temp0 = 0.0;
+		if(active[c])
 		{
-			for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement) ;
-			pData[i] = pElement->value;
+			for(i=c; i<n; i+=2)
+			{
+				y[i] += af[c] * x[i];
+				w[i] += af[c] * z[i];
+				temp0 += w[i] * w[i];
+			}
 		}
+		d[c] = temp0;
 	}
-	pData[N] = omega;
 }
 
 /** \internal
- *  \brief Prepare data for IC/ILU preconditioner with sparse matrix.
- *  \param mat matrix to create data for
+ *  \brief Update search directions of interleaved single precision vectors in one pass.
+ *  \details This is the same as dxpay2 for single precision vectors.
+ *  \param n size of vectors
+ *  \param a scale factors for z or NULL if z is NULL
+ *  \param b scale factors for y
+ *  \param active flags for vectors to work on
+ *  \param x interleaved vectors to add
+ *  \param z interleaved vectors to add to y before scaling or NULL
+ *  \param y interleaved vectors to update
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_prepare_ilu(GISparseMatrixLIL *mat)
+static void sxpay2(GIint n, const GIdouble *a, const GIdouble *b, 
+				   const GIboolean *active, const GIfloat *x, 
+				   const GIfloat *z, GIfloat *y)
 {
-	GISparseMatrixCSR *pData;
-	GIVectorElement *pElement;
-	GIuint uiSize = sizeof(GISparseMatrixCSR);
-	GIuint e, i, j, k, ij, ik, jk, kj, N = mat->n;
-
-	/* create data if neccessary */
-	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	GIfloat af[2] = { 0.0f, 0.0f }, bf[2] = { (GIfloat)b[0], (GIfloat)b[1] };
+	GIint i, c;
+	n <<= 1;
+	if(a)
 	{
-		if(mat->data)
-			GI_FREE_ARRAY(mat->data);
-		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
-		*((GIuint*)mat->data) = uiSize;
+		af[0] = (GIfloat)a[0];
+		af[1] = (GIfloat)a[1];
 	}
-	pData = (GISparseMatrixCSR*)((GIuint*)mat->data+1);
-
-	/* create compressed matrix */
-	pData->n = N;
-	pData->nnz = GISparseMatrixLIL_nnz(mat);
-	pData->symmetric = mat->symmetric;
-	pData->data = NULL;
-	pData->values = (GIdouble*)GI_MALLOC_ARRAY(pData->nnz, sizeof(GIdouble));
-	pData->idx = (GIuint*)GI_MALLOC_ARRAY(pData->nnz, sizeof(GIuint));
-	pData->ptr = (GIuint*)GI_MALLOC_ARRAY(N+1, sizeof(GIuint));
-
-	if(mat->symmetric)
+	if(active[0] && active[1])
 	{
-		/* compute incomplete Cholesky factorization */
-		for(i=0,ij=0; i<N; ++i,++ij)
+		if(z)
 		{
-			register GIdouble temp = 0.0;
-			pData->ptr[i] = ij;
-			for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement,++ij)
+			for(i=0; i<n; i+=2)
 			{
-				register GIdouble temp2 = 0.0;
-				pData->idx[ij] = j = pElement->index;
-				for(ik=pData->ptr[i],jk=pData->ptr[j]; ik<ij; ++ik)
-				{
-					for(; pData->idx[jk]<pData->idx[ik]; ++jk) ;
-					if(pData->idx[ik] == pData->idx[jk])
-						temp2 += pData->values[ik] * pData->values[jk];
-				}
-				pData->values[ij] = (pElement->value-temp2) * 
-					pData->values[pData->ptr[j+1]-1];
-				temp += pData->values[ij] * pData->values[ij];
+				y[i] = (y[i]+af[0]*z[i])*bf[0] + x[i];
+				y[i+1] = (y[i+1]+af[1]*z[i+1])*bf[1] + x[i+1];
 			}
-			pData->values[ij] = 1.0 / sqrt(pElement->value-temp);
-			pData->idx[ij] = i;
 		}
-		pData->ptr[N] = pData->nnz;
-	}
-	else
-	{
-		/* compute incomplete LU factorization */
-		for(i=0,ij=0; i<N; ++i)
+		else
 		{
-			pData->ptr[i] = ij;
-			for(e=0,pElement=mat->rows[i].elements; 
-				e<mat->rows[i].size; ++e,++pElement,++ij)
+			for(i=0; i<n; i+=2)
 			{
-				register GIdouble temp = 0.0;
-				pData->idx[ij] = j = pElement->index;
-				if(i >= j)
-				{
-					for(ik=pData->ptr[i]; ik<ij; ++ik)
-					{
-						k = pData->idx[ik];
-						for(kj=pData->ptr[k]; kj<pData->ptr[k+1]; ++kj)
-						{
-							if(pData->idx[kj] == j)
-							{
-								temp += pData->values[ik] * pData->values[kj];
-								break;
-							}
-						}
-					}
-					pData->values[ij] = pElement->value - temp;
-					if(i == j)
-						pData->values[ij] = 1.0 / pData->values[ij];
-				}
-				else
-				{
-					for(ik=pData->ptr[i]; pData->idx[ik]<i; ++ik)
-					{
-						k = pData->idx[ik];
-						for(kj=pData->ptr[k]; kj<pData->ptr[k+1]; ++kj)
-						{
-							if(pData->idx[kj] == j)
-							{
-								temp += pData->values[ik] * pData->values[kj];
-								break;
-							}
-						}
-					}
-					pData->values[ij] = (pElement->value-temp) * pData->values[ik];
-				}
+				y[i] = y[i]*bf[0] + x[i];
+				y[i+1] = y[i+1]*bf[1] + x[i+1];
 			}
 		}
-		pData->ptr[N] = pData->nnz;
+		return;
+	}
+	for(c=0; c<2; ++c)
+	{
+		if(!active[c])
+			continue;
+		if(z)
+			for(i=c; i<n; i+=2)
+				y[i] = (y[i]+af[c]*z[i])*bf[c] + x[i];
+		else
+			for(i=c; i<n; i+=2)
+				y[i] = y[i]*bf[c] + x[i];
 	}
 }
 
 /** \internal
- *  \brief Prepare data for Jacobi preconditioner with compressed matrix.
- *  \param mat matrix to create data for
+ *  \brief Compute dot products and norms of interleaved single precision vectors in one pass.
+ *  \details The products are accumulated in double precision.
+ *  \param n size of vectors
+ *  \param x first two interleaved vectors
+ *  \param y second two interleaved vectors
+ *  \param dxy array to store both dot products
+ *  \param dxx array to store both squared norms of x
  *  \ingroup numerics
  */
-void GISparseMatrixCSR_prepare_jacobi(GISparseMatrixCSR *mat)
+static void sdot2_nrm2(GIint n, const GIfloat *x, const GIfloat *y, 
+					   GIdouble *dxy, GIdouble *dxx)
 {
-	GIdouble *pData;
-	GIuint i, N = mat->n, uiSize = N * sizeof(GIdouble);
-
-	/* create data if neccessary */
-	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	register GIdouble temp0 = 0.0, temp1 = 0.0, temp2 = 0.0, temp3 = 0.0;
+	GIint i;
+	for(i=0,n<<=1; i<n; i+=2)
 	{
-		if(mat->data)
-			GI_FREE_ARRAY(mat->data);
-		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
-		*((GIuint*)mat->data) = uiSize;
+		temp0 += x[i] * y[i];
+		temp1 += x[i+1] * y[i+1];
+		temp2 += x[i] * x[i];
+		temp3 += x[i+1] * x[i+1];
 	}
-	pData = (GIdouble*)((GIuint*)mat->data+1);
+	dxy[0] = temp0;
+	dxy[1] = temp1;
+	dxx[0] = temp2;
+	dxx[1] = temp3;
+}
 
-	/* save inverted diagonal */
-	if(mat->symmetric)
+/** \internal
+ *  \brief Orthogonalize vector against orthonormal basis and compute its norm.
+ *  \details This computes q -= Q*h and the norm of the result blockwise, so 
+ *  that every block of q stays in cache for all basis vectors instead of 
+ *  passing over the whole of q once per basis vector and again for the norm. 
+ *  The coefficients h still have to be computed beforehand by dgemv, which 
+ *  reads the basis once more and q once per basis vector.
+ *  \param n size of vectors
+ *  \param k number of basis vectors
+ *  \param Q basis vectors
+ *  \param ldq leading dimension of Q
+ *  \param h coefficients of basis vectors
+ *  \param q vector to orthogonalize
+ *  \return norm of orthogonalized vector
+ *  \ingroup numerics
+ */
+static GIdouble dorth(GIint n, GIint k, const GIdouble *Q, GIint ldq, 
+					  const GIdouble *h, GIdouble *q)
+{
+	GIdouble nrm = 0.0;
+	GIint i, j, m;
+	for(i=0; i<n; i+=GI_ORTH_BLOCK_SIZE)
 	{
-		for(i=0; i<N; ++i)
-			pData[i] = 1.0 / mat->values[mat->ptr[i+1]-1];
+		m = GI_MIN(n-i, GI_ORTH_BLOCK_SIZE);
+		for(j=0; j<k; ++j)
+			daxpy(m, -h[j], Q+j*ldq+i, 1, q+i, 1);
+		nrm += ddot(m, q+i, 1, q+i, 1);
 	}
-	else
-	{
-		GIuint ij;
+	return sqrt(nrm);
+}
 
-		for(i=0; i<N; ++i)
-		{
-			for(ij=mat->ptr[i]; mat->idx[ij]<i; ++ij) ;
-			pData[i] = 1.0 / mat->values[ij];
-		}
-	}
+/** \internal
+ *  \brief Report residuals of two systems to convergence monitor.
+ *  \param monitor convergence monitor
+ *  \param iteration current iteration
+ *  \param res squared residual norms of both systems
+ *  \param ref squared norms the residuals are relative to
+ *  \ingroup numerics
+ */
+static void report_residuals(const GISolverMonitor *monitor, GIuint iteration, 
+							 const GIdouble *res, const GIdouble *ref)
+{
+	GIdouble rel[2];
+	GIuint c;
+	for(c=0; c<2; ++c)
+		rel[c] = sqrt((ref[c] > 0.0) ? (res[c]/ref[c]) : res[c]);
+	monitor->report(monitor->data, iteration, rel);
 }
 
 /** \internal
- *  \brief Prepare data for SSOR preconditioner with compressed matrix.
- *  \param mat matrix to create data for
- *  \param omega relaxation parameter in [0,2]
+ *  \brief Allocate compressed matrix.
+ *  \param mat matrix to create
+ *  \param n number of rows
+ *  \param nnz number of non-zero elements
  *  \ingroup numerics
  */
-void GISparseMatrixCSR_prepare_ssor(GISparseMatrixCSR *mat, GIdouble omega)
+static void create_csr(GISparseMatrixCSR *mat, GIuint n, GIuint nnz)
 {
-	GIdouble *pData;
-	GIuint i, N = mat->n, uiSize = (N+1) * sizeof(GIdouble);
+	mat->n = n;
+	mat->symmetric = GI_FALSE;
+	mat->data = NULL;
+	mat->nnz = nnz;
+	mat->values = (GIdouble*)GI_MALLOC_ARRAY(nnz, sizeof(GIdouble));
+	mat->idx = (GIuint*)GI_MALLOC_ARRAY(nnz, sizeof(GIuint));
+	mat->ptr = (GIuint*)GI_CALLOC_ARRAY(n+1, sizeof(GIuint));
+	mat->blocks = 0;
+	mat->block_ptr = NULL;
+	mat->full = NULL;
+	mat->full_map = NULL;
+	mat->ilu_ptr = NULL;
+	mat->ilu_pairs = NULL;
+	mat->ilu_schedule = NULL;
+	mat->amg = NULL;
+	mat->fvalues = NULL;
+	mat->filu = NULL;
+	mat->fscale = 1.0;
+}
 
-	/* create data if neccessary */
-	if(!mat->data || *((GIuint*)mat->data) != uiSize)
-	{
-		if(mat->data)
-			GI_FREE_ARRAY(mat->data);
-		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
-		*((GIuint*)mat->data) = uiSize;
-	}
-	pData = (GIdouble*)((GIuint*)mat->data+1);
+/** \internal
+ *  \brief Expand symmetric compressed matrix to full storage.
+ *  \details Rows of the result are sorted by column.
+ *  \param mat symmetric matrix to expand
+ *  \param map array to store indices of elements into values or NULL
+ *  \return fully stored matrix
+ *  \ingroup numerics
+ */
+static GISparseMatrixCSR* expand_symmetric(const GISparseMatrixCSR *mat, GIuint *map)
+{
+	GISparseMatrixCSR *pFull = (GISparseMatrixCSR*)GI_MALLOC_SINGLE(sizeof(GISparseMatrixCSR));
+	GIuint i, ij, c, N = mat->n;
+	create_csr(pFull, N, 2*mat->nnz-N);
 
-	/* save diagonal and omega */
-	if(mat->symmetric)
+	/* count row lengths and compute row starts */
+	for(i=0; i<N; ++i)
 	{
-		for(i=0; i<N; ++i)
-			pData[i] = mat->values[mat->ptr[i+1]-1];
+		pFull->ptr[i+1] += mat->ptr[i+1] - mat->ptr[i];
+		for(ij=mat->ptr[i]; ij<mat->ptr[i+1]-1; ++ij)
+			++pFull->ptr[mat->idx[ij]+1];
 	}
-	else
-	{
-		GIuint ij;
+	for(i=0; i<N; ++i)
+		pFull->ptr[i+1] += pFull->ptr[i];
 
-		for(i=0; i<N; ++i)
+	/* rows are filled in ascending column order using running positions */
+	for(i=0; i<N; ++i)
+	{
+		for(ij=mat->ptr[i]; ij<mat->ptr[i+1]; ++ij)
 		{
-			for(ij=mat->ptr[i]; mat->idx[ij]<i; ++ij) ;
-			pData[i] = mat->values[ij];
+			c = pFull->ptr[i]++;
+			pFull->values[c] = mat->values[ij];
+			pFull->idx[c] = mat->idx[ij];
+			if(map)
+				map[c] = ij;
+		}
+		for(ij=mat->ptr[i]; ij<mat->ptr[i+1]-1; ++ij)
+		{
+			c = pFull->ptr[mat->idx[ij]]++;
+			pFull->values[c] = mat->values[ij];
+			pFull->idx[c] = i;
+			if(map)
+				map[c] = ij;
 		}
 	}
-	pData[N] = omega;
+	for(i=N; i>0; --i)
+		pFull->ptr[i] = pFull->ptr[i-1];
+	pFull->ptr[0] = 0;
+	return pFull;
 }
 
 /** \internal
- *  \brief Prepare data for IC/ILU preconditioner with compressed matrix.
- *  \param mat matrix to create data for
+ *  \brief Compute nested dissection ordering of graph.
+ *  \details The graph is recursively split by the middle level of a breadth 
+ *  first search from a pseudo-peripheral vertex. Separator vertices are 
+ *  numbered after both halves, subgraphs of at most GI_ND_LEAF_SIZE vertices 
+ *  are not split any further.
+ *  \param n number of vertices
+ *  \param xadj start indices of adjacency lists
+ *  \param adj adjacency lists
+ *  \param perm array to store old indices of reordered vertices
  *  \ingroup numerics
  */
-void GISparseMatrixCSR_prepare_ilu(GISparseMatrixCSR *mat)
+static void nested_dissection(GIuint n, const GIuint *xadj, 
+							  const GIuint *adj, GIuint *perm)
 {
-	GIdouble *pData;
-	GIuint uiSize = mat->nnz * sizeof(GIdouble);
-	GIuint i, j, k, ij, ik, jk, kj, N = mat->n;
+	GIuint *part = (GIuint*)GI_MALLOC_ARRAY(n, sizeof(GIuint));
+	GIuint *level = (GIuint*)GI_MALLOC_ARRAY(n, sizeof(GIuint));
+	GIuint *queue = (GIuint*)GI_MALLOC_ARRAY(n, sizeof(GIuint));
+	GIuint *stack = (GIuint*)GI_MALLOC_ARRAY(2*n+2, sizeof(GIuint));
+	GIuint i, j, k, s, c, v, w, uiRoot, uiDepth, uiOldDepth, uiCount, uiSep, uiA, uiB, uiTop = 0;
 
-	/* create data if neccessary */
-	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	/* start with whole graph */
+	for(i=0; i<n; ++i)
 	{
-		if(mat->data)
-			GI_FREE_ARRAY(mat->data);
-		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
-		*((GIuint*)mat->data) = uiSize;
+		perm[i] = i;
+		part[i] = 0;
+	}
+	if(n)
+	{
+		stack[uiTop++] = 0;
+		stack[uiTop++] = n;
 	}
-	pData = (GIdouble*)((GIuint*)mat->data+1);
 
-	if(mat->symmetric)
+	while(uiTop)
 	{
-		/* compute incomplete Cholesky factorization */
-		for(i=0,ij=0; i<N; ++i,++ij)
+		c = stack[--uiTop];
+		s = stack[--uiTop];
+		if(c <= GI_ND_LEAF_SIZE)
+			continue;
+
+		/* search pseudo-peripheral vertex */
+		uiRoot = perm[s];
+		uiOldDepth = 0;
+		for(;;)
 		{
-			register GIdouble temp = 0.0;
-			for(; mat->idx[ij]<i; ++ij)
+			for(i=s; i<s+c; ++i)
+				level[perm[i]] = n;
+			level[uiRoot] = 0;
+			queue[0] = uiRoot;
+			for(i=0,uiCount=1; i<uiCount; ++i)
 			{
-				register GIdouble temp2 = 0.0;
-				j = mat->idx[ij];
-				for(ik=mat->ptr[i],jk=mat->ptr[j]; ik<ij; ++ik)
+				v = queue[i];
+				for(j=xadj[v]; j<xadj[v+1]; ++j)
 				{
-					for(; mat->idx[jk]<mat->idx[ik]; ++jk) ;
-					if(mat->idx[ik] == mat->idx[jk])
-						temp2 += pData[ik] * pData[jk];
+					w = adj[j];
+					if(part[w] == s && level[w] == n)
+					{
+						level[w] = level[v] + 1;
+						queue[uiCount++] = w;
+					}
 				}
-				pData[ij] = (mat->values[ij]-temp2) * pData[mat->ptr[j+1]-1];
-				temp += pData[ij] * pData[ij];
 			}
-			pData[ij] = 1.0 / sqrt(mat->values[ij]-temp);
+			uiDepth = level[queue[uiCount-1]] + 1;
+			if(uiDepth <= uiOldDepth)
+				break;
+			uiOldDepth = uiDepth;
+			for(i=uiCount-1,k=queue[i]; i>0 && level[queue[i]]==uiDepth-1; --i)
+				if(xadj[queue[i]+1]-xadj[queue[i]] < xadj[k+1]-xadj[k])
+					k = queue[i];
+			if(k == uiRoot)
+				break;
+			uiRoot = k;
+		}
+		if(uiCount == c && uiDepth < 3)
+			continue;
+
+		/* separate by middle level or split off unreached vertices */
+		if(uiCount < c)
+			uiSep = n - 1;
+		else
+		{
+			/* separator vertices not adjacent to second half belong to first */
+			uiSep = GI_CLAMP(level[queue[uiCount>>1]], 1, uiDepth-2);
+			for(i=0; i<uiCount; ++i)
+			{
+				v = queue[i];
+				if(level[v] == uiSep)
+				{
+					for(j=xadj[v]; j<xadj[v+1] && 
+						(part[adj[j]]!=s || level[adj[j]]!=uiSep+1); ++j) ;
+					if(j == xadj[v+1])
+						level[v] = uiSep - 1;
+				}
+			}
+		}
+
+		/* reorder first half, second half and separator */
+		for(i=s,uiA=0; i<s+c; ++i)
+			if(level[perm[i]] < uiSep)
+				queue[uiA++] = perm[i];
+		for(i=s,uiB=uiA; i<s+c; ++i)
+			if(level[perm[i]] > uiSep)
+				queue[uiB++] = perm[i];
+		for(i=s,k=uiB; i<s+c; ++i)
+			if(level[perm[i]] == uiSep)
+				queue[k++] = perm[i];
+		for(i=0; i<c; ++i)
+		{
+			v = perm[s+i] = queue[i];
+			part[v] = (i < uiA) ? s : ((i < uiB) ? (s+uiA) : n);
 		}
+		stack[uiTop++] = s;
+		stack[uiTop++] = uiA;
+		stack[uiTop++] = s + uiA;
+		stack[uiTop++] = uiB - uiA;
 	}
-	else
+
+	/* clean up */
+	GI_FREE_ARRAY(part);
+	GI_FREE_ARRAY(level);
+	GI_FREE_ARRAY(queue);
+	GI_FREE_ARRAY(stack);
+}
+
+/** \internal
+ *  \brief Multiply compressed matrices.
+ *  \param A first matrix
+ *  \param B second matrix
+ *  \param columns number of columns of second matrix
+ *  \param C matrix to create as product
+ *  \ingroup numerics
+ */
+static void multiply_csr(const GISparseMatrixCSR *A, const GISparseMatrixCSR *B, 
+						 GIuint columns, GISparseMatrixCSR *C)
+{
+	GIuint *pPos = (GIuint*)GI_MALLOC_ARRAY(columns, sizeof(GIuint));
+	GIuint i, j, ij, jk, c, N = A->n;
+
+	/* count elements of rows */
+	for(j=0; j<columns; ++j)
+		pPos[j] = N;
+	create_csr(C, N, 0);
+	for(i=0,c=0; i<N; ++i)
 	{
-		/* compute incomplete LU factorization */
-		for(i=0,ij=0; i<N; ++i)
+		for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
 		{
-			for(; ij<mat->ptr[i+1]; ++ij)
+			j = A->idx[ij];
+			for(jk=B->ptr[j]; jk<B->ptr[j+1]; ++jk)
 			{
-				register GIdouble temp = 0.0;
-				j = mat->idx[ij];
-				if(i >= j)
+				if(pPos[B->idx[jk]] != i)
 				{
-					for(ik=mat->ptr[i]; ik<ij; ++ik)
-					{
-						k = mat->idx[ik];
-						for(kj=mat->ptr[k]; kj<mat->ptr[k+1]; ++kj)
-						{
-							if(mat->idx[kj] == j)
-							{
-								temp += pData[ik] * pData[kj];
-								break;
-							}
-						}
-					}
-					pData[ij] = mat->values[ij] - temp;
-					if(i == j)
-						pData[ij] = 1.0 / pData[ij];
+					pPos[B->idx[jk]] = i;
+					++c;
 				}
-				else
+			}
+		}
+		C->ptr[i+1] = c;
+	}
+	C->nnz = c;
+	C->values = (GIdouble*)GI_REALLOC_ARRAY(C->values, c, sizeof(GIdouble));
+	C->idx = (GIuint*)GI_REALLOC_ARRAY(C->idx, c, sizeof(GIuint));
+
+	/* accumulate products */
+	for(j=0; j<columns; ++j)
+		pPos[j] = C->nnz;
+	for(i=0,c=0; i<N; ++i)
+	{
+		GIuint uiStart = c;
+		for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
+		{
+			j = A->idx[ij];
+			for(jk=B->ptr[j]; jk<B->ptr[j+1]; ++jk)
+			{
+				GIuint k = B->idx[jk];
+				if(pPos[k] < uiStart || pPos[k] >= c)
 				{
-					for(ik=mat->ptr[i]; mat->idx[ik]<i; ++ik)
-					{
-						k = mat->idx[ik];
-						for(kj=mat->ptr[k]; kj<mat->ptr[k+1]; ++kj)
-						{
-							if(mat->idx[kj] == j)
-							{
-								temp += pData[ik] * pData[kj];
-								break;
-							}
-						}
-					}
-					pData[ij] = (mat->values[ij]-temp) * pData[ik];
+					pPos[k] = c;
+					C->idx[c] = k;
+					C->values[c++] = A->values[ij] * B->values[jk];
 				}
+				else
+					C->values[pPos[k]] += A->values[ij] * B->values[jk];
 			}
 		}
 	}
+	GI_FREE_ARRAY(pPos);
 }
 
 /** \internal
- *  \brief Prepare data for Jacobi preconditioner with block compressed matrix.
- *  \param mat matrix to create data for
+ *  \brief Transpose compressed matrix.
+ *  \param A matrix to transpose
+ *  \param columns number of columns of matrix
+ *  \param T matrix to create as transposed
  *  \ingroup numerics
  */
-void GISparseMatrixBCSR2_prepare_jacobi(GISparseMatrixBCSR2 *mat)
+static void transpose_csr(const GISparseMatrixCSR *A, GIuint columns, 
+						  GISparseMatrixCSR *T)
 {
-	GIdouble *pData;
-	GIuint i, N = (mat->n+1) >> 1, uiSize = (N<<1) * sizeof(GIdouble);
-
-	/* create data if neccessary */
-	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	GIuint i, ij, c;
+	create_csr(T, columns, A->nnz);
+	for(ij=0; ij<A->nnz; ++ij)
+		++T->ptr[A->idx[ij]+1];
+	for(i=0; i<columns; ++i)
+		T->ptr[i+1] += T->ptr[i];
+	for(i=0; i<A->n; ++i)
 	{
-		if(mat->data)
-			GI_FREE_ARRAY(mat->data);
-		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
-		*((GIuint*)mat->data) = uiSize;
+		for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
+		{
+			c = T->ptr[A->idx[ij]]++;
+			T->idx[c] = i;
+			T->values[c] = A->values[ij];
+		}
 	}
-	pData = (GIdouble*)((GIuint*)mat->data+1);
+	for(i=columns; i>0; --i)
+		T->ptr[i] = T->ptr[i-1];
+	T->ptr[0] = 0;
+}
 
-	/* save inverted diagonal */
-	if(mat->symmetric)
+/** \internal
+ *  \brief Multiply compressed matrices into existing product.
+ *  \details Only the values of the product are computed, its structure has 
+ *  to be the one created by multiply_csr for matrices of the same structure.
+ *  \param A first matrix
+ *  \param B second matrix
+ *  \param columns number of columns of second matrix
+ *  \param C product to compute values of
+ *  \ingroup numerics
+ */
+static void multiply_csr_values(const GISparseMatrixCSR *A, const GISparseMatrixCSR *B, 
+								GIuint columns, GISparseMatrixCSR *C)
+{
+	GIuint *pPos = (GIuint*)GI_MALLOC_ARRAY(columns, sizeof(GIuint));
+	GIuint i, j, ij, jk;
+
+	/* accumulate products at known positions */
+	memset(C->values, 0, C->nnz*sizeof(GIdouble));
+	for(i=0; i<A->n; ++i)
 	{
-		for(i=0; i<N; ++i,pData+=2)
+		for(ij=C->ptr[i]; ij<C->ptr[i+1]; ++ij)
+			pPos[C->idx[ij]] = ij;
+		for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
 		{
-			pData[0] = 1.0 / mat->values[(mat->ptr[i+1]-1)<<2];
-			pData[1] = 1.0 / mat->values[((mat->ptr[i+1]-1)<<2)+3];
+			j = A->idx[ij];
+			for(jk=B->ptr[j]; jk<B->ptr[j+1]; ++jk)
+				C->values[pPos[B->idx[jk]]] += A->values[ij] * B->values[jk];
 		}
 	}
-	else
+	GI_FREE_ARRAY(pPos);
+}
+
+/** \internal
+ *  \brief Transpose compressed matrix into existing transposed.
+ *  \details Only the values are copied, the structure of the transposed 
+ *  has to be the one created by transpose_csr.
+ *  \param A matrix to transpose
+ *  \param T transposed to copy values into
+ *  \ingroup numerics
+ */
+static void transpose_csr_values(const GISparseMatrixCSR *A, GISparseMatrixCSR *T)
+{
+	GIuint *pPos = (GIuint*)GI_MALLOC_ARRAY(T->n, sizeof(GIuint));
+	GIuint i, ij;
+	memcpy(pPos, T->ptr, T->n*sizeof(GIuint));
+	for(i=0; i<A->n; ++i)
+		for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
+			T->values[pPos[A->idx[ij]]++] = A->values[ij];
+	GI_FREE_ARRAY(pPos);
+}
+
+/** \internal
+ *  \brief Aggregate unknowns for smoothed aggregation multigrid.
+ *  \details Unknowns are grouped with their strongly connected neighbours 
+ *  in three passes: new aggregates of untouched neighbourhoods, joining 
+ *  neighbouring aggregates and aggregating the remainder.
+ *  \param A fully stored matrix
+ *  \param inv_diag inverted diagonal of matrix
+ *  \param theta strength threshold
+ *  \param agg array to store aggregates of unknowns
+ *  \return number of aggregates
+ *  \ingroup numerics
+ */
+static GIuint aggregate(const GISparseMatrixCSR *A, const GIdouble *inv_diag, 
+						GIdouble theta, GIuint *agg)
+{
+	GIuint *pFirst = (GIuint*)GI_MALLOC_ARRAY(A->n, sizeof(GIuint));
+	GIuint i, j, ij, k, uiCount = 0, N = A->n;
+	GIdouble dTheta2 = theta * theta, dMax;
+
+	#define GI_STRONG(i,ij)	((A->idx[ij] != (i)) && A->values[ij]*A->values[ij]* \
+		fabs(inv_diag[i]*inv_diag[A->idx[ij]]) >= dTheta2)
+
+	/* aggregate untouched neighbourhoods */
+	for(i=0; i<N; ++i)
+		agg[i] = N;
+	for(i=0; i<N; ++i)
 	{
-		GIuint ij;
+		if(agg[i] != N)
+			continue;
+		for(ij=A->ptr[i],k=0; ij<A->ptr[i+1]; ++ij)
+		{
+			if(GI_STRONG(i, ij))
+			{
+				if(agg[A->idx[ij]] != N)
+					break;
+				++k;
+			}
+		}
+		if(ij < A->ptr[i+1] || !k)
+			continue;
+		agg[i] = uiCount;
+		for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
+			if(GI_STRONG(i, ij))
+				agg[A->idx[ij]] = uiCount;
+		++uiCount;
+	}
 
-		for(i=0; i<N; ++i,pData+=2)
+	/* join strongest neighbouring aggregate */
+	memcpy(pFirst, agg, N*sizeof(GIuint));
+	for(i=0; i<N; ++i)
+	{
+		if(pFirst[i] != N)
+			continue;
+		for(ij=A->ptr[i],dMax=0.0; ij<A->ptr[i+1]; ++ij)
 		{
-			for(ij=mat->ptr[i]; mat->idx[ij]<i; ++ij) ;
-			pData[0] = 1.0 / mat->values[ij<<2];
-			pData[1] = 1.0 / mat->values[(ij<<2)+3];
+			j = A->idx[ij];
+			if(pFirst[j] != N && GI_STRONG(i, ij) && fabs(A->values[ij]) > dMax)
+			{
+				dMax = fabs(A->values[ij]);
+				agg[i] = pFirst[j];
+			}
 		}
 	}
+
+	/* aggregate remaining neighbourhoods */
+	for(i=0; i<N; ++i)
+	{
+		if(agg[i] != N)
+			continue;
+		agg[i] = uiCount;
+		for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
+			if(agg[A->idx[ij]] == N && GI_STRONG(i, ij))
+				agg[A->idx[ij]] = uiCount;
+		++uiCount;
+	}
+	#undef GI_STRONG
+
+	GI_FREE_ARRAY(pFirst);
+	return uiCount;
 }
 
 /** \internal
- *  \brief Apply Jacobi preconditioner with generic matrix.
- *  \param A system matrix
- *  \param x vector to multiply preconditioning matrix with
- *  \param y vector to store result
+ *  \brief Smooth by Gauss-Seidel sweep.
+ *  \param A fully stored matrix
+ *  \param inv_diag inverted diagonal of matrix
+ *  \param b interleaved right hand sides
+ *  \param x interleaved solutions to improve
+ *  \param columns number of interleaved vectors
+ *  \param backward GI_TRUE to sweep from last to first row
  *  \ingroup numerics
  */
-void GISparseMatrix_pc_jacobi(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+static void gauss_seidel(const GISparseMatrixCSR *A, const GIdouble *inv_diag, 
+						 const GIdouble *b, GIdouble *x, GIuint columns, 
+						 GIboolean backward)
 {
-	GIuint i, N = A->n;
-	const GIdouble *pInvDiag = (const GIdouble*)((const GIuint*)A->data+1);
-
-	/* divide vector by diagonal of matrix */
-	for(i=0; i<N; ++i)
-		y[i] = x[i] * pInvDiag[i];
+	GIuint r, i, ij, c, N = A->n;
+	for(r=0; r<N; ++r)
+	{
+		i = backward ? (N-1-r) : r;
+		for(c=0; c<columns; ++c)
+		{
+			register GIdouble temp = b[i*columns+c];
+			for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
+				if(A->idx[ij] != i)
+					temp -= A->values[ij] * x[A->idx[ij]*columns+c];
+			x[i*columns+c] = temp * inv_diag[i];
+		}
+	}
 }
 
 /** \internal
- *  \brief Apply SSOR preconditioner with sparse matrix.
- *  \param A system matrix
- *  \param x vector to multiply preconditioning matrix with
- *  \param y vector to store result
+ *  \brief Apply multigrid V-cycle.
+ *  \details Symmetric Gauss-Seidel smoothing keeps the cycle symmetric, 
+ *  so it can precondition the conjugate gradient method.
+ *  \param mg multigrid hierarchy
+ *  \param l level to start on
+ *  \param b interleaved right hand sides on level
+ *  \param x interleaved vectors to store approximate solutions
+ *  \param columns number of interleaved vectors
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_pc_ssor(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+static void multigrid_cycle(const GIMultigrid *mg, GIuint l, const GIdouble *b, 
+							GIdouble *x, GIuint columns)
 {
-	const GISparseMatrixLIL *mat = (const GISparseMatrixLIL*)A;
-	const GIVectorElement *pElement;
-	const GIdouble *pDiag = (const GIdouble*)((const GIuint*)A->data+1);
-	GIint i, N = mat->n;
-	GIdouble dOmega = pDiag[N];
+	const GIMultigridLevel *pLevel = mg->level + l, *pCoarse = pLevel + 1;
+	GIuint i, ij, c, N = pLevel->A->n;
 
-	/* forward-eliminate for lower triangle */
-	for(i=0; i<N; ++i)
+	/* solve directly on coarsest level */
+	if(l == mg->levels-1)
 	{
-		register GIdouble temp = 0.0;
-		for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement)
-			temp += pElement->value * y[pElement->index];
-		y[i] = (x[i]-dOmega*temp) / pDiag[i];
+		GISparseLDL_solve(&mg->coarse, b, x, columns);
+		return;
 	}
 
-	/* multiply by diagonal */
+	/* pre-smooth and compute residual */
+	memset(x, 0, N*columns*sizeof(GIdouble));
+	gauss_seidel(pLevel->A, pLevel->inv_diag, b, x, columns, GI_FALSE);
 	for(i=0; i<N; ++i)
-		y[i] *= pDiag[i];
-
-	/* backward-eliminate for upper triangle */
-	if(mat->symmetric)
 	{
-		for(i=N-1; i>0; --i)
+		for(c=0; c<columns; ++c)
 		{
-			register GIdouble temp = dOmega * (y[i]/=pDiag[i]);
-			for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement)
-				y[pElement->index] -= pElement->value * temp;
+			register GIdouble temp = b[i*columns+c];
+			for(ij=pLevel->A->ptr[i]; ij<pLevel->A->ptr[i+1]; ++ij)
+				temp -= pLevel->A->values[ij] * x[pLevel->A->idx[ij]*columns+c];
+			pLevel->r[i*columns+c] = temp;
 		}
-		y[0] /= pDiag[0];
 	}
-	else
+
+	/* restrict, correct on coarse level and prolongate */
+	for(i=0; i<pLevel->R.n; ++i)
 	{
-		for(i=N-1; i>=0; --i)
+		for(c=0; c<columns; ++c)
 		{
 			register GIdouble temp = 0.0;
-			for(pElement=mat->rows[i].elements+mat->rows[i].size-1; 
-				pElement->index>i; --pElement)
-				temp += pElement->value * y[pElement->index];
-			y[i] = (y[i]-dOmega*temp) / pDiag[i];
+			for(ij=pLevel->R.ptr[i]; ij<pLevel->R.ptr[i+1]; ++ij)
+				temp += pLevel->R.values[ij] * pLevel->r[pLevel->R.idx[ij]*columns+c];
+			pCoarse->b[i*columns+c] = temp;
 		}
 	}
+	multigrid_cycle(mg, l+1, pCoarse->b, pCoarse->x, columns);
+	for(i=0; i<N; ++i)
+		for(c=0; c<columns; ++c)
+			for(ij=pLevel->P.ptr[i]; ij<pLevel->P.ptr[i+1]; ++ij)
+				x[i*columns+c] += pLevel->P.values[ij] * pCoarse->x[pLevel->P.idx[ij]*columns+c];
+
+	/* post-smooth */
+	gauss_seidel(pLevel->A, pLevel->inv_diag, b, x, columns, GI_TRUE);
 }
 
 /** \internal
- *  \brief Apply IC/ILU preconditioner with sparse matrix.
- *  \param A system matrix
- *  \param x vector to multiply preconditioning matrix with
- *  \param y vector to store result
+ *  \brief Multigrid hierarchy destructor.
+ *  \param mg hierarchy to destruct and free
  *  \ingroup numerics
  */
-void GISparseMatrixLIL_pc_ilu(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+static void destruct_multigrid(GIMultigrid *mg)
 {
-	incomplete_lu((const GISparseMatrixCSR*)((GIuint*)A->data+1), NULL, x, y);
+	GIuint l;
+	for(l=0; l<mg->levels; ++l)
+	{
+		GIMultigridLevel *pLevel = mg->level + l;
+		GISparseMatrixCSR_destruct(pLevel->A);
+		GI_FREE_SINGLE(pLevel->A, sizeof(GISparseMatrixCSR));
+		GI_FREE_ARRAY(pLevel->inv_diag);
+		if(l)
+		{
+			GI_FREE_ARRAY(pLevel->b);
+			GI_FREE_ARRAY(pLevel->x);
+		}
+		if(l < mg->levels-1)
+		{
+			GISparseMatrixCSR_destruct(&pLevel->P);
+			GISparseMatrixCSR_destruct(&pLevel->R);
+			GISparseMatrixCSR_destruct(&pLevel->AP);
+			GI_FREE_ARRAY(pLevel->agg);
+			GI_FREE_ARRAY(pLevel->r);
+		}
+	}
+	GISparseLDL_destruct(&mg->coarse);
+	GISparseMatrixCSR_destruct(&mg->lower);
+	GI_FREE_ARRAY(mg->map);
+	GI_FREE_ARRAY(mg->level);
+	GI_FREE_SINGLE(mg, sizeof(GIMultigrid));
 }
 
+
 /** \internal
- *  \brief Apply SSOR preconditioner with compressed matrix.
- *  \param A system matrix
- *  \param x vector to multiply preconditioning matrix with
- *  \param y vector to store result
+ *  \brief Sparse vector constructor.
+ *  \param vec vector to construct
  *  \ingroup numerics
  */
-void GISparseMatrixCSR_pc_ssor(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+void GISparseVector_construct(GISparseVector *vec)
 {
-	const GISparseMatrixCSR *mat = (const GISparseMatrixCSR*)A;
-	const GIdouble *pDiag = (const GIdouble*)((const GIuint*)A->data+1);
-	GIint i, ij, N = mat->n;
-	GIdouble dOmega = pDiag[N];
+	/* empty vector */
+	vec->size = vec->capacity = 0;
+	vec->elements = NULL;
+}
 
-	/* forward-eliminate for lower triangle */
-	for(i=0,ij=0; i<N; ++i)
+/** \internal
+ *  \brief Let sparse vector grow.
+ *  \param vec vector to grow
+ *  \ingroup numerics
+ */
+void GISparseVector_grow(GISparseVector *vec)
+{
+	if(vec->capacity)
 	{
-		register GIdouble temp = 0.0;
-		for(ij=mat->ptr[i]; mat->idx[ij]<i; ++ij)
-			temp += mat->values[ij] * y[mat->idx[ij]];
-		y[i] = (x[i]-dOmega*temp) / mat->values[ij];
+		/* double size */
+		vec->capacity <<= 1;
+		vec->elements = (GIVectorElement*)GI_REALLOC_ARRAY(vec->elements, 
+			vec->capacity, sizeof(GIVectorElement));
 	}
+	else
+	{
+		/* init elements */
+		vec->capacity = 4;
+		vec->elements = (GIVectorElement*)GI_MALLOC_ARRAY(
+			vec->capacity, sizeof(GIVectorElement));
+	}
+}
 
-	/* multiply by diagonal */
-	for(i=0; i<N; ++i)
-		y[i] *= pDiag[i];
-
-	/* backward-eliminate for upper triangle */
-	if(mat->symmetric)
+/** \internal
+ *  \brief Set value of sparse vector element.
+ *  \param vec vector to work on
+ *  \param index index of element
+ *  \param value new value of element
+ *  \ingroup numerics
+ */
+void GISparseVector_set(GISparseVector *vec, GIuint index, GIdouble value)
+{
+	GIuint i;
+
+	/* element allready in vector */
+	for(i=0; i<vec->size && vec->elements[i].index<index; ++i) ;
+	if(i < vec->size && vec->elements[i].index == index)
+		vec->elements[i].value = value;
+	else
+		GISparseVector_append(vec, index, value);
+}
+
+/** \internal
+ *  \brief Add value to sparse vector element.
+ *  \param vec vector to work on
+ *  \param index index of element
+ *  \param value value to add
+ *  \ingroup numerics
+ */
+void GISparseVector_add(GISparseVector *vec, GIuint index, GIdouble value)
+{
+	GIuint i;
+
+	for(i=0; i<vec->size && vec->elements[i].index<index; ++i) ;
+	if(i < vec->size && vec->elements[i].index == index)
+		vec->elements[i].value += value;
+	else
+		GISparseVector_append(vec, index, value);
+}
+
+/** \internal
+ *  \brief Append element to sparse vector.
+ *  \param vec vector to work on
+ *  \param index index of element
+ *  \param value value of element
+ *  \ingroup numerics
+ */
+void GISparseVector_append(GISparseVector *vec, GIuint index, GIdouble value)
+{
+	GIuint i;
+
+	/* just add new element (grow if neccessary) */
+	if(vec->size == vec->capacity)
+		GISparseVector_grow(vec);
+	for(i=vec->size; i>0 && index<vec->elements[i-1].index; --i)
+		vec->elements[i] = vec->elements[i-1];
+	vec->elements[i].index = index;
+	vec->elements[i].value = value;
+	++vec->size;
+}
+
+/** \internal
+ *  \brief Set sparse vector to zero vector.
+ *  \param vec vector to zero
+ *  \ingroup numerics
+ */
+void GISparseVector_to_zero(GISparseVector *vec)
+{
+	/* just no elements */
+	vec->size = 0;
+}
+
+/** \internal
+ *  \brief Clear sparse vector.
+ *  \param vec vector to clear
+ *  \ingroup numerics
+ */
+void GISparseVector_clear(GISparseVector *vec)
+{
+	/* clear data */
+	vec->size = vec->capacity = 0;
+	if(vec->elements)
+	{
+		GI_FREE_ARRAY(vec->elements);
+		vec->elements = NULL;
+	}
+}
+
+/** \internal
+ *  \brief Sparse matrix constructor.
+ *  \param mat matrix to construct
+ *  \param n number of rows/columns
+ *  \param symmetric GI_TRUE if matrix is symmetric GI_FALSE else
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_construct(GISparseMatrixLIL *mat, 
+								 GIuint n, GIboolean symmetric)
+{
+	/* init data */
+	mat->n = n;
+	mat->symmetric = symmetric;
+	mat->data = NULL;
+
+	/* create rows */
+	mat->rows = (GISparseVector*)GI_CALLOC_ARRAY(n, sizeof(GISparseVector));
+}
+
+/** \internal
+ *  \brief Sparse matrix destructor.
+ *  \param mat matrix to destruct
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_destruct(GISparseMatrixLIL *mat)
+{
+	GIuint i;
+
+	/* clear and delete rows */
+	for(i=0; i<mat->n; ++i)
+		GISparseVector_clear(mat->rows+i);
+	GI_FREE_ARRAY(mat->rows);
+
+	/* clear data */
+	if(mat->data)
+		GI_FREE_ARRAY(mat->data);
+	memset(mat, 0, sizeof(GISparseMatrixLIL));
+}
+
+/** \internal
+ *  \brief Set value of sparse matrix element.
+ *  \param mat matrix to work on
+ *  \param i column of element
+ *  \param j row of element
+ *  \param value new value of element
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_set(GISparseMatrixLIL *mat, GIuint i, 
+						   GIuint j, GIdouble value)
+{
+	/* set row element */
+	if(mat->symmetric && (j > i))
+	{
+		register GIuint temp;
+		GI_SWAP(i, j, temp);
+	}
+	GISparseVector_set(mat->rows+i, j, value);
+}
+
+/** \internal
+ *  \brief Add value to sparse matrix element.
+ *  \param mat matrix to work on
+ *  \param i column of element
+ *  \param j row of element
+ *  \param value value to add
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_add(GISparseMatrixLIL *mat, GIuint i, 
+						   GIuint j, GIdouble value)
+{
+	/* add to row element */
+	if(mat->symmetric && (j > i))
+	{
+		register GIuint temp;
+		GI_SWAP(i, j, temp);
+	}
+	GISparseVector_add(mat->rows+i, j, value);
+}
+
+/** \internal
+ *  \brief Append value to sparse matrix.
+ *  \param mat matrix to work on
+ *  \param i column of element
+ *  \param j row of element
+ *  \param value value to add
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_append(GISparseMatrixLIL *mat, GIuint i, GIuint j, GIdouble value)
+{
+	/* append element to row */
+	if(mat->symmetric)
+	{
+		if(j > i)
+		{
+			register GIuint temp;
+			GI_SWAP(i, j, temp);
+		}
+		GISparseVector_set(mat->rows+i, j, value);
+	}
+	else
+		GISparseVector_append(mat->rows+i, j, value);
+}
+
+/** \internal
+ *  \brief Set sparse matrix to zero matrix.
+ *  \param mat matrix to clear
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_to_zero(GISparseMatrixLIL *mat)
+{
+	GIuint i, N = mat->n;
+
+	/* zero row */
+	for(i=0; i<N; ++i)
+		GISparseVector_to_zero(mat->rows+i);
+}
+
+/** \internal
+ *  \brief Clear sparse matrix (set to zero matrix and release memory).
+ *  \param mat matrix to clear
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_clear(GISparseMatrixLIL *mat)
+{
+	GIuint i, N = mat->n;
+
+	/* clear row */
+	for(i=0; i<N; ++i)
+		GISparseVector_clear(mat->rows+i);
+}
+
+/** \internal
+ *  \brief Get number of non-zero elements in sparse matrix.
+ *  \param mat matrix to query
+ *  \return number of non-zero elements
+ *  \ingroup numerics
+ */
+GIuint GISparseMatrixLIL_nnz(const GISparseMatrixLIL *mat)
+{
+	GIuint i, N = mat->n;
+	register GIuint uiResult = 0;
+
+	/* count row sizes */
+	for(i=0; i<N; ++i)
+		uiResult += mat->rows[i].size;
+	return uiResult;
+}
+
+/** \internal
+ *  \brief print sparse matrix to file.
+ *  \param mat matrix to print
+ *  \param file file to print to
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_print(const GISparseMatrixLIL *mat, FILE *file)
+{
+	GISparseVector *pVec;
+	GIVectorElement *pElement;
+	GIuint i, j, ij, N = mat->n;
+
+	if(mat->symmetric)
+	{
+		/* convert to dense matrix and print */
+		GIdouble *out = (GIdouble*)GI_CALLOC_ARRAY(N*N, sizeof(GIdouble));
+		for(i=0; i<N; ++i)
+		{
+			pVec = mat->rows + i;
+			for(ij=0; ij<pVec->size; ++ij)
+			{
+				pElement = pVec->elements + ij;
+				out[i*N+pElement->index] = pElement->value;
+				out[pElement->index*N+i] = pElement->value;
+			}
+		}
+		for(i=0,ij=0; i<N; ++i)
+		{
+			for(j=0; j<N; ++j,++ij)
+				fprintf(file, "%.17f ", out[ij]);
+			fprintf(file, "\n");
+		}
+		GI_FREE_ARRAY(out);
+	}
+	else
+	{
+		/* print rows and fill gaps with zeros */
+		for(i=0,j=0; i<N; ++i,j=0)
+		{
+			pVec = mat->rows + i;
+			for(ij=0; ij<pVec->size; ++ij,++j)
+			{
+				pElement = pVec->elements + ij;
+				for(; j<pElement->index; ++j)
+					fprintf(file, "0 ");
+				fprintf(file, "%.17f ", pElement->value);
+			}
+			for(; j<N; ++j)
+				fprintf(file, "0 ");
+			fprintf(file, "\n");
+		}
+	}
+}
+
+/** \internal
+ *  \brief Multiply sparse matrix by vector
+ *  \param A matrix
+ *  \param x vector to multiply with
+ *  \param y vector to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_ax(const GISparseMatrix *A, 
+						  const GIdouble *x, GIdouble *y)
+{
+	const GISparseMatrixLIL *mat = (const GISparseMatrixLIL*)A;
+	const GISparseVector *pVec;
+	const GIVectorElement *pElement;
+	GIuint i, j, N = mat->n;
+
+	if(mat->symmetric)
+	{
+		/* symmetric mutliplication */
+		for(i=0; i<N; ++i)
+		{
+			register GIdouble temp = 0.0, xi = x[i];
+			for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement)
+			{
+				temp += pElement->value * x[pElement->index];
+				y[pElement->index] += pElement->value * xi;
+			}
+			y[i] = temp + pElement->value*x[pElement->index];
+		}
+	}
+	else
+	{
+		/* general mutliplication */
+		for(i=0; i<N; ++i)
+		{
+			register GIdouble temp = 0.0;
+			pVec = mat->rows + i;
+			for(j=0,pElement=pVec->elements; j<pVec->size; ++j,++pElement)
+				temp += pElement->value * x[pElement->index];
+			y[i] = temp;
+		}
+	}
+}
+
+/** \internal
+ *  \brief Compressed matrix constructor.
+ *  \param mat matrix to construct
+ *  \param src dynamic sparse matrix to construct from
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_construct(GISparseMatrixCSR *mat, 
+								 const GISparseMatrixLIL *src)
+{
+	const GISparseVector *pVec;
+	GIint i, j, c, N = src->n;
+
+	/* create matrix */
+	mat->n = N;
+	mat->symmetric = src->symmetric;
+	mat->data = NULL;
+	mat->nnz = GISparseMatrixLIL_nnz(src);
+	mat->values = (GIdouble*)GI_MALLOC_ARRAY(mat->nnz, sizeof(GIdouble));
+	mat->idx = (GIuint*)GI_MALLOC_ARRAY(mat->nnz, sizeof(GIuint));
+	mat->ptr = (GIuint*)GI_MALLOC_ARRAY(N+1, sizeof(GIuint));
+	mat->blocks = 0;
+	mat->block_ptr = NULL;
+	mat->full = NULL;
+	mat->full_map = NULL;
+	mat->ilu_ptr = NULL;
+	mat->ilu_pairs = NULL;
+	mat->ilu_schedule = NULL;
+	mat->amg = NULL;
+	mat->fvalues = NULL;
+	mat->filu = NULL;
+	mat->fscale = 1.0;
+
+	/* copy data */
+	for(i=0,c=0; i<N; ++i)
+	{
+		pVec = src->rows + i;
+		mat->ptr[i] = c;
+		for(j=0; j<pVec->size; ++j,++c)
+		{
+			mat->values[c] = pVec->elements[j].value;
+			mat->idx[c] = pVec->elements[j].index;
+		}
+	}
+	mat->ptr[N] = c;
+}
+
+/** \internal
+ *  \brief Compressed matrix constructor for direct assembly.
+ *  \details This reserves the given number of elements for every row. The 
+ *  elements are then added with GISparseMatrixCSR_append or 
+ *  GISparseMatrixCSR_add and the matrix is completed with 
+ *  GISparseMatrixCSR_finish_rows.
+ *  \param mat matrix to construct
+ *  \param n number of rows
+ *  \param symmetric GI_TRUE to store lower triangle of symmetric matrix only
+ *  \param sizes maximum numbers of elements of rows, reset to zero for use 
+ *  as current row sizes during assembly
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_construct_rows(GISparseMatrixCSR *mat, GIuint n, 
+									  GIboolean symmetric, GIuint *sizes)
+{
+	GIuint i, c;
+
+	/* reserve rows */
+	for(i=0,c=0; i<n; ++i)
+		c += sizes[i];
+	create_csr(mat, n, c);
+	mat->symmetric = symmetric;
+	for(i=0,c=0; i<n; ++i)
+	{
+		mat->ptr[i] = c;
+		c += sizes[i];
+		sizes[i] = 0;
+	}
+	mat->ptr[n] = c;
+}
+
+/** \internal
+ *  \brief Append element to row of compressed matrix under assembly.
+ *  \details Elements above the diagonal of symmetric matrices are ignored, 
+ *  so every row has to provide its elements of the lower triangle.
+ *  \param mat matrix to work on
+ *  \param sizes current row sizes
+ *  \param i row of element
+ *  \param j column of element
+ *  \param value value of element
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_append(GISparseMatrixCSR *mat, GIuint *sizes, 
+							  GIuint i, GIuint j, GIdouble value)
+{
+	GIuint ij = mat->ptr[i] + sizes[i];
+	if(mat->symmetric && j > i)
+		return;
+	mat->idx[ij] = j;
+	mat->values[ij] = value;
+	++sizes[i];
+}
+
+/** \internal
+ *  \brief Add value to element of compressed matrix under assembly.
+ *  \details The element is appended to the row if not yet present. Elements 
+ *  above the diagonal of symmetric matrices are ignored.
+ *  \param mat matrix to work on
+ *  \param sizes current row sizes
+ *  \param i row of element
+ *  \param j column of element
+ *  \param value value to add
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_add(GISparseMatrixCSR *mat, GIuint *sizes, 
+						   GIuint i, GIuint j, GIdouble value)
+{
+	GIuint ij, end = mat->ptr[i] + sizes[i];
+	for(ij=mat->ptr[i]; ij<end && mat->idx[ij]!=j; ++ij) ;
+	if(ij < end)
+		mat->values[ij] += value;
+	else
+		GISparseMatrixCSR_append(mat, sizes, i, j, value);
+}
+
+/** \internal
+ *  \brief Complete assembly of compressed matrix.
+ *  \details This sorts the rows by column and removes unused space.
+ *  \param mat matrix to complete
+ *  \param sizes current row sizes
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_finish_rows(GISparseMatrixCSR *mat, const GIuint *sizes)
+{
+	GIuint i, j, ij, ik, start, c, N = mat->n;
+	GIdouble value;
+
+	for(i=0,c=0; i<N; ++i)
+	{
+		/* move row to front and sort by insertion */
+		start = mat->ptr[i];
+		mat->ptr[i] = c;
+		for(ij=start; ij<start+sizes[i]; ++ij,++c)
+		{
+			j = mat->idx[ij];
+			value = mat->values[ij];
+			for(ik=c; ik>mat->ptr[i] && mat->idx[ik-1]>j; --ik)
+			{
+				mat->idx[ik] = mat->idx[ik-1];
+				mat->values[ik] = mat->values[ik-1];
+			}
+			mat->idx[ik] = j;
+			mat->values[ik] = value;
+		}
+	}
+	mat->ptr[N] = c;
+
+	/* shrink arrays */
+	if(c && c < mat->nnz)
+	{
+		mat->values = (GIdouble*)GI_REALLOC_ARRAY(mat->values, c, sizeof(GIdouble));
+		mat->idx = (GIuint*)GI_REALLOC_ARRAY(mat->idx, c, sizeof(GIuint));
+	}
+	mat->nnz = c;
+}
+
+/** \internal
+ *  \brief Compressed matrix destructor.
+ *  \param mat matrix to destruct
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_destruct(GISparseMatrixCSR *mat)
+{
+	/* delete arrays and clear data */
+	GI_FREE_ARRAY(mat->values);
+	GI_FREE_ARRAY(mat->idx);
+	GI_FREE_ARRAY(mat->ptr);
+	if(mat->data)
+		GI_FREE_ARRAY(mat->data);
+	if(mat->block_ptr)
+		GI_FREE_ARRAY(mat->block_ptr);
+	if(mat->full)
+	{
+		GISparseMatrixCSR_destruct(mat->full);
+		GI_FREE_SINGLE(mat->full, sizeof(GISparseMatrixCSR));
+	}
+	if(mat->full_map)
+		GI_FREE_ARRAY(mat->full_map);
+	if(mat->ilu_ptr)
+	{
+		GI_FREE_ARRAY(mat->ilu_ptr);
+		GI_FREE_ARRAY(mat->ilu_pairs);
+	}
+	if(mat->ilu_schedule)
+		destruct_schedule(mat->ilu_schedule);
+	if(mat->amg)
+		destruct_multigrid(mat->amg);
+	if(mat->fvalues)
+		GI_FREE_ARRAY(mat->fvalues);
+	if(mat->filu)
+		GI_FREE_ARRAY(mat->filu);
+	memset(mat, 0, sizeof(GISparseMatrixCSR));
+}
+
+/** \internal
+ *  \brief print compressed matrix to file.
+ *  \param mat matrix to print
+ *  \param file file to print to
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_print(const GISparseMatrixCSR *mat, FILE *file)
+{
+	GIuint i, j, ij, N = mat->n;
+
+	if(mat->symmetric)
+	{
+		/* convert to dense matrix and print */
+		GIdouble *out = (GIdouble*)GI_CALLOC_ARRAY(N*N, sizeof(GIdouble));
+		for(i=0,ij=0; i<N; ++i)
+		{
+			for(; ij<mat->ptr[i+1]; ++ij)
+			{
+				out[i*N+mat->idx[ij]] = mat->values[ij];
+				out[mat->idx[ij]*N+i] = mat->values[ij];
+			}
+		}
+		for(i=0,ij=0; i<N; ++i)
+		{
+			for(j=0; j<N; ++j,++ij)
+				fprintf(file, "%.17f ", out[ij]);
+			fprintf(file, "\n");
+		}
+		GI_FREE_ARRAY(out);
+	}
+	else
+	{
+		/* print rows and fill gaps with zeros */
+		for(i=0,j=0,ij=0; i<N; ++i,j=0)
+		{
+			for(; ij<mat->ptr[i+1]; ++ij,++j)
+			{
+				for(; j<mat->idx[ij]; ++j)
+					fprintf(file, "0 ");
+				fprintf(file, "%.17f ", mat->values[ij]);
+			}
+			for(; j<N; ++j)
+				fprintf(file, "0 ");
+			fprintf(file, "\n");
+		}
+	}
+}
+
+#if OPENGI_NUM_THREADS > 1
+/** \internal
+ *  \brief Multiply block of rows of fully stored compressed matrix by vector.
+ *  \param arg multiplication data
+ *  \param index index of row block
+ *  \ingroup numerics
+ */
+static void GISparseMatrixCSR_ax_task(GIvoid *arg, GIuint index)
+{
+	const GIAxTaskData *pData = (const GIAxTaskData*)arg;
+	const GISparseMatrixCSR *mat = pData->mat;
+	const GIdouble *x = pData->x;
+	GIuint i, ij, end = pData->block_ptr[index+1];
+
+	if(pData->fy)
+	{
+		/* single precision mutliplication of rows in block with two vectors */
+		for(i=pData->block_ptr[index],ij=mat->ptr[i]; i<end; ++i)
+		{
+			register GIfloat temp0 = 0.0f, temp1 = 0.0f;
+			for(; ij<mat->ptr[i+1]; ++ij)
+			{
+				temp0 += mat->fvalues[ij] * pData->fx[mat->idx[ij]<<1];
+				temp1 += mat->fvalues[ij] * pData->fx[(mat->idx[ij]<<1)+1];
+			}
+			pData->fy[i<<1] = temp0;
+			pData->fy[(i<<1)+1] = temp1;
+		}
+	}
+	else if(pData->columns == 2)
+	{
+		/* general mutliplication of rows in block with two vectors */
+		for(i=pData->block_ptr[index],ij=mat->ptr[i]; i<end; ++i)
+		{
+			register GIdouble temp0 = 0.0, temp1 = 0.0;
+			for(; ij<mat->ptr[i+1]; ++ij)
+			{
+				temp0 += mat->values[ij] * x[mat->idx[ij]<<1];
+				temp1 += mat->values[ij] * x[(mat->idx[ij]<<1)+1];
+			}
+			pData->y[i<<1] = temp0;
+			pData->y[(i<<1)+1] = temp1;
+		}
+	}
+	else
+	{
+		/* general mutliplication of rows in block */
+		for(i=pData->block_ptr[index],ij=mat->ptr[i]; i<end; ++i)
+		{
+			register GIdouble temp = 0.0;
+			for(; ij<mat->ptr[i+1]; ++ij)
+				temp += mat->values[ij] * x[mat->idx[ij]];
+			pData->y[i] = temp;
+		}
+	}
+}
+#endif
+
+/** \internal
+ *  \brief Multiply compressed matrix by vector
+ *  \param A matrix
+ *  \param x vector to multiply with
+ *  \param y vector to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_ax(const GISparseMatrix *A, 
+						  const GIdouble *x, GIdouble *y)
+{
+	const GISparseMatrixCSR *mat = (const GISparseMatrixCSR*)A;
+	GIuint i, ij, N = mat->n;
+
+#if OPENGI_NUM_THREADS > 1
+	if(mat->blocks > 1)
+	{
+		/* multiply row blocks in parallel */
+		GIAxTaskData data;
+		data.mat = mat->full ? mat->full : mat;
+		data.block_ptr = mat->block_ptr;
+		data.x = x;
+		data.y = y;
+		data.columns = 1;
+		data.fx = NULL;
+		data.fy = NULL;
+		GIThreadPool_run(&g_ThreadPool, GISparseMatrixCSR_ax_task, &data, mat->blocks);
+		return;
+	}
+#endif
+
+	if(mat->symmetric)
+	{
+		/* symmetric mutliplication */
+		for(i=0,ij=0; i<N; ++i,++ij)
+		{
+			register GIdouble temp = 0.0, xi = x[i];
+			for(; ij<mat->ptr[i+1]-1; ++ij)
+			{
+				temp += mat->values[ij] * x[mat->idx[ij]];
+				y[mat->idx[ij]] += mat->values[ij] * xi;
+			}
+			y[i] = temp + mat->values[ij]*x[mat->idx[ij]];
+		}
+	}
+	else
+	{
+		/* general mutliplication */
+		for(i=0,ij=0; i<N; ++i)
+		{
+			register GIdouble temp = 0.0;
+			for(; ij<mat->ptr[i+1]; ++ij)
+				temp += mat->values[ij] * x[mat->idx[ij]];
+			y[i] = temp;
+		}
+	}
+}
+
+/** \internal
+ *  \brief Multiply compressed matrix by two vectors
+ *  \details Every matrix element is read once for both vectors.
+ *  \param A matrix
+ *  \param x two interleaved vectors to multiply with
+ *  \param y two interleaved vectors to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_ax2(const GISparseMatrix *A, 
+						   const GIdouble *x, GIdouble *y)
+{
+	const GISparseMatrixCSR *mat = (const GISparseMatrixCSR*)A;
+	GIuint i, j, ij, N = mat->n;
+
+#if OPENGI_NUM_THREADS > 1
+	if(mat->blocks > 1)
+	{
+		/* multiply row blocks in parallel */
+		GIAxTaskData data;
+		data.mat = mat->full ? mat->full : mat;
+		data.block_ptr = mat->block_ptr;
+		data.x = x;
+		data.y = y;
+		data.columns = 2;
+		data.fx = NULL;
+		data.fy = NULL;
+		GIThreadPool_run(&g_ThreadPool, GISparseMatrixCSR_ax_task, &data, mat->blocks);
+		return;
+	}
+#endif
+
+	if(mat->symmetric)
+	{
+		/* symmetric mutliplication */
+		for(i=0,ij=0; i<N; ++i,++ij)
+		{
+			register GIdouble temp0 = 0.0, temp1 = 0.0;
+			register GIdouble xi0 = x[i<<1], xi1 = x[(i<<1)+1];
+			for(; ij<mat->ptr[i+1]-1; ++ij)
+			{
+				j = mat->idx[ij] << 1;
+				temp0 += mat->values[ij] * x[j];
+				temp1 += mat->values[ij] * x[j+1];
+				y[j] += mat->values[ij] * xi0;
+				y[j+1] += mat->values[ij] * xi1;
+			}
+			j = mat->idx[ij] << 1;
+			y[i<<1] = temp0 + mat->values[ij]*x[j];
+			y[(i<<1)+1] = temp1 + mat->values[ij]*x[j+1];
+		}
+	}
+	else
+	{
+		/* general mutliplication */
+		for(i=0,ij=0; i<N; ++i)
+		{
+			register GIdouble temp0 = 0.0, temp1 = 0.0;
+			for(; ij<mat->ptr[i+1]; ++ij)
+			{
+				j = mat->idx[ij] << 1;
+				temp0 += mat->values[ij] * x[j];
+				temp1 += mat->values[ij] * x[j+1];
+			}
+			y[i<<1] = temp0;
+			y[(i<<1)+1] = temp1;
+		}
+	}
+}
+
+/** \internal
+ *  \brief Prepare compressed matrix for parallel multiplication.
+ *  \details Matrices with less than GI_PARALLEL_AX_MIN_ROWS rows are left 
+ *  for sequential multiplication. Otherwise the rows are split into blocks 
+ *  of about equal numbers of non-zeros. As the lower triangle storage of 
+ *  symmetric matrices scatters into foreign rows, these get an additional 
+ *  copy in full storage, whose rows can be multiplied independently. 
+ *  When called again, only the values of this copy are updated.
+ *  \param mat matrix to prepare
+ *  \param threads number of threads to use
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_prepare_parallel(GISparseMatrixCSR *mat, GIuint threads)
+{
+	GISparseMatrixCSR *pFull;
+	GIuint i, b, c, uiNNZ, N = mat->n;
+	if(mat->blocks)
+	{
+		/* refresh values of full copy */
+		if(mat->full)
+			for(c=0; c<mat->full->nnz; ++c)
+				mat->full->values[c] = mat->values[mat->full_map[c]];
+		return;
+	}
+	mat->blocks = 1;
+	if(threads < 2 || N < GI_PARALLEL_AX_MIN_ROWS)
+		return;
+
+	/* expand symmetric matrix to full storage */
+	if(mat->symmetric)
+	{
+		mat->full_map = (GIuint*)GI_MALLOC_ARRAY(2*mat->nnz-N, sizeof(GIuint));
+		pFull = mat->full = expand_symmetric(mat, mat->full_map);
+	}
+	else
+		pFull = mat;
+
+	/* split rows into blocks with equal work */
+	uiNNZ = pFull->nnz;
+	mat->blocks = threads;
+	mat->block_ptr = (GIuint*)GI_MALLOC_ARRAY(threads+1, sizeof(GIuint));
+	for(b=0,i=0; b<threads; ++b)
+	{
+		while(i < N && pFull->ptr[i] < (GIuint)(((GIdouble)b/threads)*uiNNZ))
+			++i;
+		mat->block_ptr[b] = i;
+	}
+	mat->block_ptr[threads] = N;
+}
+
+/** \internal
+ *  \brief Multiply compressed matrix in single precision by two vectors.
+ *  \details This multiplies the scaled single precision values created by 
+ *  GISparseMatrixCSR_prepare_float, so the result is the one of the matrix 
+ *  scaled by its fscale.
+ *  \param A matrix
+ *  \param x two interleaved single precision vectors to multiply with
+ *  \param y two interleaved single precision vectors to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_ax2f(const GISparseMatrix *A, 
+							const GIfloat *x, GIfloat *y)
+{
+	const GISparseMatrixCSR *mat = (const GISparseMatrixCSR*)A;
+	const GIfloat *values = mat->fvalues;
+	GIuint i, j, ij, N = mat->n;
+
+#if OPENGI_NUM_THREADS > 1
+	if(mat->blocks > 1)
+	{
+		/* multiply row blocks in parallel */
+		GIAxTaskData data;
+		data.mat = mat->full ? mat->full : mat;
+		data.block_ptr = mat->block_ptr;
+		data.x = NULL;
+		data.y = NULL;
+		data.columns = 2;
+		data.fx = x;
+		data.fy = y;
+		GIThreadPool_run(&g_ThreadPool, GISparseMatrixCSR_ax_task, &data, mat->blocks);
+		return;
+	}
+#endif
+
+	if(mat->symmetric)
+	{
+		/* symmetric mutliplication */
+		for(i=0,ij=0; i<N; ++i,++ij)
+		{
+			register GIfloat temp0 = 0.0f, temp1 = 0.0f;
+			register GIfloat xi0 = x[i<<1], xi1 = x[(i<<1)+1];
+			for(; ij<mat->ptr[i+1]-1; ++ij)
+			{
+				j = mat->idx[ij] << 1;
+				temp0 += values[ij] * x[j];
+				temp1 += values[ij] * x[j+1];
+				y[j] += values[ij] * xi0;
+				y[j+1] += values[ij] * xi1;
+			}
+			j = mat->idx[ij] << 1;
+			y[i<<1] = temp0 + values[ij]*x[j];
+			y[(i<<1)+1] = temp1 + values[ij]*x[j+1];
+		}
+	}
+	else
+	{
+		/* general mutliplication */
+		for(i=0,ij=0; i<N; ++i)
+		{
+			register GIfloat temp0 = 0.0f, temp1 = 0.0f;
+			for(; ij<mat->ptr[i+1]; ++ij)
+			{
+				j = mat->idx[ij] << 1;
+				temp0 += values[ij] * x[j];
+				temp1 += values[ij] * x[j+1];
+			}
+			y[i<<1] = temp0;
+			y[(i<<1)+1] = temp1;
+		}
+	}
+}
+
+/** \internal
+ *  \brief Prepare compressed matrix for mixed precision solving.
+ *  \details This rounds the values (and those of the full copy for parallel 
+ *  multiplication) and the IC/ILU factors, if prepared, to single precision. 
+ *  As the values of the stretch minimizer easily leave the range of single 
+ *  precision, everything is stored for the matrix scaled by an even power of 
+ *  two, which keeps the largest value near one and the scaling exact. It has 
+ *  to be called again whenever the values or factors change.
+ *  \param mat matrix to prepare
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_prepare_float(GISparseMatrixCSR *mat)
+{
+	const GIdouble *pILU;
+	GIdouble dMax = 0.0, dScale, dRoot;
+	GIuint i, ij, N = mat->n;
+	GIint iExp;
+
+	/* compute scale */
+	for(i=0; i<mat->nnz; ++i)
+		dMax = GI_MAX(dMax, fabs(mat->values[i]));
+	frexp(dMax, &iExp);
+	iExp /= 2;
+	dRoot = ldexp(1.0, -iExp);
+	mat->fscale = dScale = dRoot * dRoot;
+
+	/* round values */
+	if(!mat->fvalues)
+		mat->fvalues = (GIfloat*)GI_MALLOC_ARRAY(mat->nnz, sizeof(GIfloat));
+	for(i=0; i<mat->nnz; ++i)
+		mat->fvalues[i] = (GIfloat)(mat->values[i]*dScale);
+	if(mat->full)
+		GISparseMatrixCSR_prepare_float(mat->full);
+
+	/* round IC/ILU factors of scaled matrix */
+	if(mat->data && *((GIuint*)mat->data) == mat->nnz*sizeof(GIdouble))
+	{
+		pILU = (const GIdouble*)((const GIuint*)mat->data+1);
+		if(!mat->filu)
+			mat->filu = (GIfloat*)GI_MALLOC_ARRAY(mat->nnz, sizeof(GIfloat));
+		for(i=0,ij=0; i<N; ++i)
+		{
+			for(; ij<mat->ptr[i+1]; ++ij)
+			{
+				if(mat->idx[ij] == i)
+					mat->filu[ij] = (GIfloat)(pILU[ij]/(mat->symmetric ? dRoot : dScale));
+				else if(mat->symmetric)
+					mat->filu[ij] = (GIfloat)(pILU[ij]*dRoot);
+				else if(mat->idx[ij] < i)
+					mat->filu[ij] = (GIfloat)(pILU[ij]*dScale);
+				else
+					mat->filu[ij] = (GIfloat)pILU[ij];
+			}
+		}
+	}
+}
+
+/** \internal
+ *  \brief Block compressed matrix constructor.
+ *  \param mat matrix to construct
+ *  \param src dynamic sparse matrix to construct from
+ *  \ingroup numerics
+ */
+void GISparseMatrixBCSR2_construct(GISparseMatrixBCSR2 *mat, 
+								   const GISparseMatrixLIL *src)
+{
+	GIint i, i2, c = -1, N = (src->n+1) >> 1, NNZ = GISparseMatrixLIL_nnz(src);
+	GIdouble *pValues;
+	GIuint *pIdx;
+
+	/* create matrix */
+	mat->n = src->n;
+	mat->symmetric = src->symmetric;
+	mat->data = NULL;
+	mat->nnz = 0;
+	mat->ptr = (GIuint*)GI_MALLOC_ARRAY(N+1, sizeof(GIuint));
+	pValues = (GIdouble*)GI_MALLOC_ARRAY(NNZ<<2, sizeof(GIdouble));
+	pIdx = (GIuint*)GI_MALLOC_ARRAY(NNZ, sizeof(GIuint));
+
+	/* copy data */
+	for(i=0,i2=0; i<N; ++i,i2+=2)
+	{
+		const GISparseVector *pVec[2] = { src->rows+i2, 
+			(i2+1<src->n) ? src->rows+i2+1 : NULL };
+		GIuint ij[2] = { 0, 0 };
+		GIint jCur = -1, j, r;
+		mat->ptr[i] = c + 1;
+		while(pVec[0] || pVec[1])
+		{
+			if(pVec[0] && pVec[1])
+				r = (pVec[0]->elements[ij[0]].index<
+					pVec[1]->elements[ij[1]].index) ? 0 : 1;
+			else
+				r = pVec[0] ? 0 : 1;
+			j = pVec[r]->elements[ij[r]].index >> 1;
+			if(j > jCur)
+			{
+				pIdx[++c] = jCur = j;
+				pValues[c<<2] = pValues[(c<<2)+1] = 
+					pValues[(c<<2)+2] = pValues[(c<<2)+3] = 0.0;
+			}
+			pValues[(c<<2)+(r<<1)+(pVec[r]->elements[ij[r]].index&1)] = 
+				pVec[r]->elements[ij[r]].value;
+			if(++ij[r] == pVec[r]->size)
+				pVec[r] = NULL;
+		}
+	}
+	mat->ptr[N] = mat->nnz = ++c;
+
+	/* complete blocks for diagonal of symmetric matrix */
+	if(mat->symmetric)
+	{
+		for(i=0; i<N; ++i)
+		{
+			GIuint ij = (mat->ptr[i+1]-1) << 2;
+			pValues[ij+1] = pValues[ij+2];
+		}
+	}
+
+	/* compress data */
+	mat->values = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(mat->nnz<<2*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	memcpy(mat->values, pValues, (mat->nnz<<2)*sizeof(GIdouble));
+	GI_FREE_ARRAY(pValues);
+	mat->idx = (GIuint*)GI_MALLOC_ARRAY(mat->nnz, sizeof(GIuint));
+	memcpy(mat->idx, pIdx, mat->nnz*sizeof(GIuint));
+	GI_FREE_ARRAY(pIdx);
+}
+
+/** \internal
+ *  \brief Block compressed matrix destructor.
+ *  \param mat matrix to destruct
+ *  \ingroup numerics
+ */
+void GISparseMatrixBCSR2_destruct(GISparseMatrixBCSR2 *mat)
+{
+	/* delete arrays and clear data */
+	GI_FREE_ALIGNED(mat->values);
+	GI_FREE_ARRAY(mat->idx);
+	GI_FREE_ARRAY(mat->ptr);
+	if(mat->data)
+		GI_FREE_ARRAY(mat->data);
+	memset(mat, 0, sizeof(GISparseMatrixBCSR2));
+}
+
+/** \internal
+ *  \brief print block compressed matrix to file.
+ *  \param mat matrix to print
+ *  \param file file to print to
+ *  \ingroup numerics
+ */
+void GISparseMatrixBCSR2_print(const GISparseMatrixBCSR2 *mat, FILE *file)
+{
+	GIuint i, j, ij, ij4, N = (mat->n+1) >> 1, M = N << 1;
+
+	if(mat->symmetric)
+	{
+		/* convert to dense matrix and print */
+		GIdouble *out = (GIdouble*)GI_CALLOC_ARRAY(M*M, sizeof(GIdouble));
+		for(i=0,ij=0,ij4=0; i<N; ++i)
+		{
+			for(; ij<mat->ptr[i+1]; ++ij,ij4+=4)
+			{
+				GIuint I = i << 1, J = mat->idx[ij] << 1;
+				out[I*M+J] = out[J*M+I] = mat->values[ij4];
+				out[(I+1)*M+J] = out[J*M+I+1] = mat->values[ij4+1];
+				out[I*M+J+1] = out[(J+1)*M+I] = mat->values[ij4+2];
+				out[(I+1)*M+J+1] = out[(J+1)*M+I+1] = mat->values[ij4+3];
+			}
+		}
+		for(i=0,ij=0; i<M; ++i)
+		{
+			for(j=0; j<M; ++j,++ij)
+				fprintf(file, "%.17f ", out[ij]);
+			fprintf(file, "\n");
+		}
+		GI_FREE_ARRAY(out);
+	}
+	else
+	{
+		/* print rows and fill gaps with zeros */
+		for(i=0,j=0; i<N; ++i)
+		{
+			for(ij=mat->ptr[i],j=0; ij<mat->ptr[i+1]; ++ij,++j)
+			{
+				for(; j<mat->idx[ij]; ++j)
+					fprintf(file, "0 0 ");
+				fprintf(file, "%.17f %.17f ", 
+					mat->values[ij<<2], mat->values[(ij<<2)+1]);
+			}
+			for(; j<N; ++j)
+				fprintf(file, "0 0 ");
+			fprintf(file, "\n");
+			for(ij=mat->ptr[i],j=0; ij<mat->ptr[i+1]; ++ij,++j)
+			{
+				for(; j<mat->idx[ij]; ++j)
+					fprintf(file, "0 0 ");
+				fprintf(file, "%.17f %.17f ", 
+					mat->values[(ij<<2)+2], mat->values[(ij<<2)+3]);
+			}
+			for(; j<N; ++j)
+				fprintf(file, "0 0 ");
+			fprintf(file, "\n");
+		}
+	}
+}
+
+/** \internal
+ *  \brief Multiply block compressed matrix by vector
+ *  \param A matrix
+ *  \param x vector to multiply with
+ *  \param y vector to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixBCSR2_ax(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+	const GISparseMatrixCSR *mat = (const GISparseMatrixCSR*)A;
+	GIuint i, j2, ij, ij4, N = (mat->n+1) >> 1;
+
+	if(mat->symmetric)
+	{
+		/* symmetric mutliplication */
+		for(i=0,ij=0,ij4=0; i<N; ++i,++ij,ij4+=4)
+		{
+#if OPENGI_SSE >= 2
+			GIuint i2 = i << 1;
+			__m128d XMM0 = _mm_setzero_pd(), XMM1;
+			__m128d XMM2 = _mm_load1_pd(x+i2);
+			__m128d XMM3 = _mm_load1_pd(x+i2+1);
+			__m128d XMM4, XMM5, XMM6, XMM7;
+			for(; ij<mat->ptr[i+1]-1; ++ij,ij4+=4)
+			{
+				j2 = mat->idx[ij] << 1;
+				XMM1 = _mm_load_pd(y+j2);
+				XMM4 = _mm_load_pd(mat->values+ij4);
+				XMM5 = _mm_load_pd(mat->values+ij4+2);
+				XMM6 = _mm_mul_pd(XMM4, XMM2);
+				XMM7 = _mm_mul_pd(XMM5, XMM3);
+				XMM1 = _mm_add_pd(XMM1, XMM6);
+				XMM1 = _mm_add_pd(XMM1, XMM7);
+				_mm_store_pd(y+j2, XMM1);
+				XMM1 = _mm_load_pd(x+j2);
+				XMM4 = _mm_mul_pd(XMM4, XMM1);
+				XMM5 = _mm_mul_pd(XMM5, XMM1);
+#if OPENGI_SSE >= 3
+				XMM4 = _mm_hadd_pd(XMM4, XMM5);
+				XMM0 = _mm_add_pd(XMM0, XMM4);
+#else
+				XMM6 = _mm_shuffle_pd(XMM4, XMM5, _MM_SHUFFLE2(0, 0));
+				XMM7 = _mm_shuffle_pd(XMM4, XMM5, _MM_SHUFFLE2(1, 1));
+				XMM0 = _mm_add_pd(XMM0, XMM6);
+				XMM0 = _mm_add_pd(XMM0, XMM7);
+#endif	/* SSE3 */
+			}
+			XMM1 = _mm_load_pd(x+(mat->idx[ij]<<1));
+			XMM2 = _mm_load_pd(mat->values+ij4);
+			XMM3 = _mm_load_pd(mat->values+ij4+2);
+			XMM2 = _mm_mul_pd(XMM2, XMM1);
+			XMM3 = _mm_mul_pd(XMM3, XMM1);
+#if OPENGI_SSE >= 3
+			XMM2 = _mm_hadd_pd(XMM2, XMM3);
+			XMM0 = _mm_add_pd(XMM0, XMM2);
+#else
+			XMM4 = _mm_shuffle_pd(XMM2, XMM3, _MM_SHUFFLE2(0, 0));
+			XMM5 = _mm_shuffle_pd(XMM2, XMM3, _MM_SHUFFLE2(1, 1));
+			XMM0 = _mm_add_pd(XMM0, XMM4);
+			XMM0 = _mm_add_pd(XMM0, XMM5);
+#endif	/* SSE3 */
+			_mm_store_pd(y+i2, XMM0);
+#else
+			register GIdouble temp0 = 0.0, temp1 = 0.0;
+			GIuint i2 = i << 1;
+			for(; ij<mat->ptr[i+1]-1; ++ij,ij4+=4)
+			{
+				j2 = mat->idx[ij] << 1;
+				temp0 += mat->values[ij4]*x[j2] + mat->values[ij4+1]*x[j2+1];
+				temp1 += mat->values[ij4+2]*x[j2] + mat->values[ij4+3]*x[j2+1];
+				y[j2] += mat->values[ij4]*x[i2] + mat->values[ij4+2]*x[i2+1];
+				y[j2+1] += mat->values[ij4+1]*x[i2] + mat->values[ij4+3]*x[i2+1];
+			}
+			j2 = mat->idx[ij] << 1;
+			y[i2] = temp0 + mat->values[ij4]*x[j2] + mat->values[ij4+1]*x[j2+1];
+			y[i2+1] = temp1 + mat->values[ij4+2]*x[j2] + mat->values[ij4+3]*x[j2+1];
+#endif /* SSE2 */
+		}
+	}
+	else
+	{
+		/* general mutliplication */
+		for(i=0,ij=0,ij4=0; i<N; ++i,y+=2)
+		{
+#if OPENGI_SSE >= 2
+			__m128d XMM0 = _mm_setzero_pd();
+			__m128d XMM1, XMM2, XMM3;
+#if OPENGI_SSE < 3
+			__m128d XMM4, XMM5;
+#endif
+			for(; ij<mat->ptr[i+1]; ++ij,ij4+=4)
+			{
+				XMM1 = _mm_load_pd(x+(mat->idx[ij]<<1));
+				XMM2 = _mm_load_pd(mat->values+ij4);
+				XMM3 = _mm_load_pd(mat->values+ij4+2);
+				XMM2 = _mm_mul_pd(XMM2, XMM1);
+				XMM3 = _mm_mul_pd(XMM3, XMM1);
+#if OPENGI_SSE >= 3
+				XMM2 = _mm_hadd_pd(XMM2, XMM3);
+				XMM0 = _mm_add_pd(XMM0, XMM2);
+#else
+				XMM4 = _mm_shuffle_pd(XMM2, XMM3, _MM_SHUFFLE2(0, 0));
+				XMM5 = _mm_shuffle_pd(XMM2, XMM3, _MM_SHUFFLE2(1, 1));
+				XMM0 = _mm_add_pd(XMM0, XMM4);
+				XMM0 = _mm_add_pd(XMM0, XMM5);
+#endif	/* SSE3 */
+			}
+			_mm_store_pd(y, XMM0);
+#else
+			register GIdouble temp0 = 0.0, temp1 = 0.0;
+			for(; ij<mat->ptr[i+1]; ++ij,ij4+=4)
+			{
+				j2 = mat->idx[ij] << 1;
+				temp0 += mat->values[ij4]*x[j2] + mat->values[ij4+1]*x[j2+1];
+				temp1 += mat->values[ij4+2]*x[j2] + mat->values[ij4+3]*x[j2+1];
+			}
+			y[0] = temp0;
+			y[1] = temp1;
+#endif	/* SSE2 */
+		}
+	}
+}
+
+/** \internal
+ *  \brief Prepare data for Jacobi preconditioner with sparse matrix.
+ *  \param mat matrix to create data for
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_prepare_jacobi(GISparseMatrixLIL *mat)
+{
+	GIdouble *pData;
+	GIuint i, N = mat->n, uiSize = N * sizeof(GIdouble);
+
+	/* create data if neccessary */
+	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	{
+		if(mat->data)
+			GI_FREE_ARRAY(mat->data);
+		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
+		*((GIuint*)mat->data) = uiSize;
+	}
+	pData = (GIdouble*)((GIuint*)mat->data+1);
+
+	/* store inverted diagonal */
+	if(mat->symmetric)
+		for(i=0; i<N; ++i)
+			pData[i] = 1.0 / mat->rows[i].elements[mat->rows[i].size-1].value;
+	else
+	{
+		GIVectorElement *pElement;
+
+		/* search for diagonal entry */
+		for(i=0; i<N; ++i)
+		{
+			for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement) ;
+			pData[i] = 1.0 / pElement->value;
+		}
+	}
+}
+
+/** \internal
+ *  \brief Prepare data for SSOR preconditioner with sparse matrix.
+ *  \param mat matrix to create data for
+ *  \param omega relaxation parameter in [0,2]
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_prepare_ssor(GISparseMatrixLIL *mat, GIdouble omega)
+{
+	GIdouble *pData;
+	GIuint i, N = mat->n, uiSize = (N+1) * sizeof(GIdouble);
+
+	/* create data if neccessary */
+	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	{
+		if(mat->data)
+			GI_FREE_ARRAY(mat->data);
+		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
+		*((GIuint*)mat->data) = uiSize;
+	}
+	pData = (GIdouble*)((GIuint*)mat->data+1);
+
+	/* save diagonal and omega */
+	if(mat->symmetric)
+		for(i=0; i<N; ++i)
+			pData[i] = mat->rows[i].elements[mat->rows[i].size-1].value;
+	else
+	{
+		GIVectorElement *pElement;
+
+		/* search for diagonal entry */
+		for(i=0; i<N; ++i)
+		{
+			for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement) ;
+			pData[i] = pElement->value;
+		}
+	}
+	pData[N] = omega;
+}
+
+/** \internal
+ *  \brief Prepare data for IC/ILU preconditioner with sparse matrix.
+ *  \param mat matrix to create data for
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_prepare_ilu(GISparseMatrixLIL *mat)
+{
+	GISparseMatrixCSR *pData;
+	GIVectorElement *pElement;
+	GIuint uiSize = sizeof(GISparseMatrixCSR);
+	GIuint e, i, j, k, ij, ik, jk, kj, N = mat->n;
+
+	/* create data if neccessary */
+	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	{
+		if(mat->data)
+			GI_FREE_ARRAY(mat->data);
+		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
+		*((GIuint*)mat->data) = uiSize;
+	}
+	pData = (GISparseMatrixCSR*)((GIuint*)mat->data+1);
+
+	/* create compressed matrix */
+	pData->n = N;
+	pData->nnz = GISparseMatrixLIL_nnz(mat);
+	pData->symmetric = mat->symmetric;
+	pData->data = NULL;
+	pData->values = (GIdouble*)GI_MALLOC_ARRAY(pData->nnz, sizeof(GIdouble));
+	pData->idx = (GIuint*)GI_MALLOC_ARRAY(pData->nnz, sizeof(GIuint));
+	pData->ptr = (GIuint*)GI_MALLOC_ARRAY(N+1, sizeof(GIuint));
+
+	if(mat->symmetric)
+	{
+		/* compute incomplete Cholesky factorization */
+		for(i=0,ij=0; i<N; ++i,++ij)
+		{
+			register GIdouble temp = 0.0;
+			pData->ptr[i] = ij;
+			for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement,++ij)
+			{
+				register GIdouble temp2 = 0.0;
+				pData->idx[ij] = j = pElement->index;
+				for(ik=pData->ptr[i],jk=pData->ptr[j]; ik<ij; ++ik)
+				{
+					for(; pData->idx[jk]<pData->idx[ik]; ++jk) ;
+					if(pData->idx[ik] == pData->idx[jk])
+						temp2 += pData->values[ik] * pData->values[jk];
+				}
+				pData->values[ij] = (pElement->value-temp2) * 
+					pData->values[pData->ptr[j+1]-1];
+				temp += pData->values[ij] * pData->values[ij];
+			}
+			pData->values[ij] = 1.0 / sqrt(pElement->value-temp);
+			pData->idx[ij] = i;
+		}
+		pData->ptr[N] = pData->nnz;
+	}
+	else
+	{
+		/* compute incomplete LU factorization */
+		for(i=0,ij=0; i<N; ++i)
+		{
+			pData->ptr[i] = ij;
+			for(e=0,pElement=mat->rows[i].elements; 
+				e<mat->rows[i].size; ++e,++pElement,++ij)
+			{
+				register GIdouble temp = 0.0;
+				pData->idx[ij] = j = pElement->index;
+				if(i >= j)
+				{
+					for(ik=pData->ptr[i]; ik<ij; ++ik)
+					{
+						k = pData->idx[ik];
+						for(kj=pData->ptr[k]; kj<pData->ptr[k+1]; ++kj)
+						{
+							if(pData->idx[kj] == j)
+							{
+								temp += pData->values[ik] * pData->values[kj];
+								break;
+							}
+						}
+					}
+					pData->values[ij] = pElement->value - temp;
+					if(i == j)
+						pData->values[ij] = 1.0 / pData->values[ij];
+				}
+				else
+				{
+					for(ik=pData->ptr[i]; pData->idx[ik]<i; ++ik)
+					{
+						k = pData->idx[ik];
+						for(kj=pData->ptr[k]; kj<pData->ptr[k+1]; ++kj)
+						{
+							if(pData->idx[kj] == j)
+							{
+								temp += pData->values[ik] * pData->values[kj];
+								break;
+							}
+						}
+					}
+					pData->values[ij] = (pElement->value-temp) * pData->values[ik];
+				}
+			}
+		}
+		pData->ptr[N] = pData->nnz;
+	}
+}
+
+/** \internal
+ *  \brief Prepare data for Jacobi preconditioner with compressed matrix.
+ *  \param mat matrix to create data for
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_prepare_jacobi(GISparseMatrixCSR *mat)
+{
+	GIdouble *pData;
+	GIuint i, N = mat->n, uiSize = N * sizeof(GIdouble);
+
+	/* create data if neccessary */
+	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	{
+		if(mat->data)
+			GI_FREE_ARRAY(mat->data);
+		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
+		*((GIuint*)mat->data) = uiSize;
+	}
+	pData = (GIdouble*)((GIuint*)mat->data+1);
+
+	/* save inverted diagonal */
+	if(mat->symmetric)
+	{
+		for(i=0; i<N; ++i)
+			pData[i] = 1.0 / mat->values[mat->ptr[i+1]-1];
+	}
+	else
+	{
+		GIuint ij;
+
+		for(i=0; i<N; ++i)
+		{
+			for(ij=mat->ptr[i]; mat->idx[ij]<i; ++ij) ;
+			pData[i] = 1.0 / mat->values[ij];
+		}
+	}
+}
+
+/** \internal
+ *  \brief Prepare data for SSOR preconditioner with compressed matrix.
+ *  \param mat matrix to create data for
+ *  \param omega relaxation parameter in [0,2]
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_prepare_ssor(GISparseMatrixCSR *mat, GIdouble omega)
+{
+	GIdouble *pData;
+	GIuint i, N = mat->n, uiSize = (N+1) * sizeof(GIdouble);
+
+	/* create data if neccessary */
+	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	{
+		if(mat->data)
+			GI_FREE_ARRAY(mat->data);
+		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
+		*((GIuint*)mat->data) = uiSize;
+	}
+	pData = (GIdouble*)((GIuint*)mat->data+1);
+
+	/* save diagonal and omega */
+	if(mat->symmetric)
+	{
+		for(i=0; i<N; ++i)
+			pData[i] = mat->values[mat->ptr[i+1]-1];
+	}
+	else
+	{
+		GIuint ij;
+
+		for(i=0; i<N; ++i)
+		{
+			for(ij=mat->ptr[i]; mat->idx[ij]<i; ++ij) ;
+			pData[i] = mat->values[ij];
+		}
+	}
+	pData[N] = omega;
+}
+
+/** \internal
+ *  \brief Prepare data for IC/ILU preconditioner with compressed matrix.
+ *  \details The products contributing to every element of the factorization 
+ *  only depend on the structure of the matrix. Their index pairs are computed 
+ *  on the first call and reused for later matrices with the same structure.
+ *  \param mat matrix to create data for
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_prepare_ilu(GISparseMatrixCSR *mat)
+{
+	GIdouble *pData;
+	GIuint uiSize = mat->nnz * sizeof(GIdouble);
+	GIuint i, j, k, p, ii, ij, ik, kj, N = mat->n;
+
+	/* create data if neccessary */
+	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	{
+		if(mat->data)
+			GI_FREE_ARRAY(mat->data);
+		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
+		*((GIuint*)mat->data) = uiSize;
+	}
+	pData = (GIdouble*)((GIuint*)mat->data+1);
+
+	/* collect update pairs if neccessary */
+	if(!mat->ilu_ptr)
+	{
+		GIuint uiCapacity = 2 * mat->nnz + 2;
+		mat->ilu_ptr = (GIuint*)GI_MALLOC_ARRAY(mat->nnz+1, sizeof(GIuint));
+		mat->ilu_pairs = (GIuint*)GI_MALLOC_ARRAY(uiCapacity, 2*sizeof(GIuint));
+		mat->ilu_ptr[0] = p = 0;
+		for(i=0,ij=0; i<N; ++i)
+		{
+			for(; ij<mat->ptr[i+1]; ++ij)
+			{
+				j = mat->idx[ij];
+				for(ik=mat->ptr[i]; ik<ij && (mat->symmetric || 
+					i>=j || mat->idx[ik]<i); ++ik)
+				{
+					k = mat->idx[ik];
+					if(mat->symmetric)
+					{
+						if(i == j)
+							break;
+						for(kj=mat->ptr[j]; mat->idx[kj]<k; ++kj) ;
+						if(mat->idx[kj] != k)
+							continue;
+					}
+					else
+					{
+						for(kj=mat->ptr[k]; kj<mat->ptr[k+1] && mat->idx[kj]!=j; ++kj) ;
+						if(kj == mat->ptr[k+1])
+							continue;
+					}
+					if(p == uiCapacity)
+					{
+						uiCapacity <<= 1;
+						mat->ilu_pairs = (GIuint*)GI_REALLOC_ARRAY(
+							mat->ilu_pairs, uiCapacity, 2*sizeof(GIuint));
+					}
+					mat->ilu_pairs[2*p] = ik;
+					mat->ilu_pairs[2*p+1] = kj;
+					++p;
+				}
+				mat->ilu_ptr[ij+1] = p;
+			}
+		}
+#if OPENGI_NUM_THREADS > 1
+
+		/* schedule triangular solves for parallel application */
+		if(N >= GI_PARALLEL_AX_MIN_ROWS)
+			mat->ilu_schedule = create_schedule(mat);
+#endif
+	}
+
+	if(mat->symmetric)
+	{
+		/* compute incomplete Cholesky factorization */
+		for(i=0,ij=0; i<N; ++i,++ij)
+		{
+			register GIdouble temp = 0.0;
+			for(; mat->idx[ij]<i; ++ij)
+			{
+				register GIdouble temp2 = 0.0;
+				j = mat->idx[ij];
+				for(p=mat->ilu_ptr[ij]; p<mat->ilu_ptr[ij+1]; ++p)
+					temp2 += pData[mat->ilu_pairs[2*p]] * pData[mat->ilu_pairs[2*p+1]];
+				pData[ij] = (mat->values[ij]-temp2) * pData[mat->ptr[j+1]-1];
+				temp += pData[ij] * pData[ij];
+			}
+			pData[ij] = 1.0 / sqrt(mat->values[ij]-temp);
+		}
+	}
+	else
+	{
+		/* compute incomplete LU factorization */
+		for(i=0,ij=0,ii=0; i<N; ++i)
+		{
+			for(; ij<mat->ptr[i+1]; ++ij)
+			{
+				register GIdouble temp = 0.0;
+				j = mat->idx[ij];
+				for(p=mat->ilu_ptr[ij]; p<mat->ilu_ptr[ij+1]; ++p)
+					temp += pData[mat->ilu_pairs[2*p]] * pData[mat->ilu_pairs[2*p+1]];
+				if(i > j)
+					pData[ij] = mat->values[ij] - temp;
+				else if(i == j)
+				{
+					pData[ij] = 1.0 / (mat->values[ij]-temp);
+					ii = ij;
+				}
+				else
+					pData[ij] = (mat->values[ij]-temp) * pData[ii];
+			}
+		}
+	}
+}
+
+/** \internal
+ *  \brief Invert diagonal of multigrid level.
+ *  \param level level to compute inverted diagonal of
+ *  \return estimate of spectral radius of inverted diagonal times matrix
+ *  \ingroup numerics
+ */
+static GIdouble invert_diagonal(GIMultigridLevel *level)
+{
+	const GISparseMatrixCSR *A = level->A;
+	GIuint i, ij;
+	GIdouble dRho = 0.0;
+	for(i=0; i<A->n; ++i)
+	{
+		GIdouble dSum = 0.0;
+		for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
+		{
+			if(A->idx[ij] == i)
+				level->inv_diag[i] = 1.0 / A->values[ij];
+			dSum += fabs(A->values[ij]);
+		}
+		dRho = GI_MAX(dRho, dSum*fabs(level->inv_diag[i]));
+	}
+	return dRho;
+}
+
+/** \internal
+ *  \brief Smooth tentative prolongation of multigrid level.
+ *  \details This computes the values of P = (I-omega*D^-1*A)*T, with T
+ *  the piecewise constant interpolation of the aggregates. The structure
+ *  of the prolongation has to exist already.
+ *  \param level level to compute prolongation of
+ *  \param coarse number of aggregates
+ *  \param omega damping factor
+ *  \ingroup numerics
+ */
+static void smooth_prolongation(GIMultigridLevel *level, GIuint coarse, GIdouble omega)
+{
+	const GISparseMatrixCSR *A = level->A;
+	GISparseMatrixCSR *P = &level->P;
+	GIuint *pPos = (GIuint*)GI_MALLOC_ARRAY(coarse, sizeof(GIuint));
+	GIuint i, ij;
+	for(i=0; i<A->n; ++i)
+	{
+		for(ij=P->ptr[i]; ij<P->ptr[i+1]; ++ij)
+		{
+			pPos[P->idx[ij]] = ij;
+			P->values[ij] = 0.0;
+		}
+		for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
+			P->values[pPos[level->agg[A->idx[ij]]]] -= omega * level->inv_diag[i] * A->values[ij];
+		P->values[pPos[level->agg[i]]] += 1.0;
+	}
+	GI_FREE_ARRAY(pPos);
+}
+
+/** \internal
+ *  \brief Prepare data for algebraic multigrid preconditioner with compressed matrix.
+ *  \details This builds a smoothed aggregation hierarchy with Galerkin
+ *  coarse matrices until the system is small enough to be factorized. The
+ *  aggregates, the structures of all levels and the ordering of the coarse
+ *  factorization are computed on the first call and reused for later
+ *  matrices with the same structure, which only recompute the values.
+ *  \param mat symmetric matrix to create hierarchy for
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_prepare_amg(GISparseMatrixCSR *mat)
+{
+	GIMultigrid *pMG = mat->amg;
+	GIMultigridLevel *pLevel;
+	GISparseMatrixCSR *A;
+	GIuint *pPos;
+	GIuint l, i, j, k, ij, c, uiStart, uiCoarse, N;
+	GIdouble dTheta = GI_AMG_STRENGTH, dRho;
+
+	/* only recompute values of existing hierarchy */
+	if(pMG)
+	{
+		A = pMG->level[0].A;
+		for(ij=0; ij<A->nnz; ++ij)
+			A->values[ij] = mat->values[pMG->map[ij]];
+		for(l=0; l<pMG->levels-1; ++l)
+		{
+			pLevel = pMG->level + l;
+			uiCoarse = pLevel->R.n;
+			dRho = invert_diagonal(pLevel);
+			smooth_prolongation(pLevel, uiCoarse, 4.0/(3.0*dRho));
+			transpose_csr_values(&pLevel->P, &pLevel->R);
+			multiply_csr_values(pLevel->A, &pLevel->P, uiCoarse, &pLevel->AP);
+			multiply_csr_values(&pLevel->R, &pLevel->AP, uiCoarse, pLevel[1].A);
+		}
+		invert_diagonal(pMG->level + l);
+		A = pMG->level[l].A;
+		for(i=0,c=0; i<A->n; ++i)
+			for(ij=A->ptr[i]; ij<A->ptr[i+1] && A->idx[ij]<=i; ++ij,++c)
+				pMG->lower.values[c] = A->values[ij];
+		GISparseLDL_factorize(&pMG->coarse, &pMG->lower);
+		return;
+	}
+
+	/* create hierarchy with fine level */
+	pMG = mat->amg = (GIMultigrid*)GI_MALLOC_SINGLE(sizeof(GIMultigrid));
+	pMG->level = (GIMultigridLevel*)GI_MALLOC_ARRAY(
+		GI_AMG_MAX_LEVELS, sizeof(GIMultigridLevel));
+	pMG->map = (GIuint*)GI_MALLOC_ARRAY(2*mat->nnz-mat->n, sizeof(GIuint));
+	pMG->level[0].A = expand_symmetric(mat, pMG->map);
+
+	for(l=0; ; ++l)
+	{
+		/* initialize level */
+		pLevel = pMG->level + l;
+		A = pLevel->A;
+		N = A->n;
+		pLevel->inv_diag = (GIdouble*)GI_MALLOC_ARRAY(N, sizeof(GIdouble));
+		dRho = invert_diagonal(pLevel);
+		if(l)
+		{
+			pLevel->b = (GIdouble*)GI_MALLOC_ARRAY(2*N, sizeof(GIdouble));
+			pLevel->x = (GIdouble*)GI_MALLOC_ARRAY(2*N, sizeof(GIdouble));
+		}
+		else
+			pLevel->b = pLevel->x = NULL;
+		if(N <= GI_AMG_COARSE_SIZE || l == GI_AMG_MAX_LEVELS-1)
+			break;
+
+		/* aggregate and stop if coarsening stagnates */
+		pLevel->agg = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+		uiCoarse = aggregate(A, pLevel->inv_diag, dTheta, pLevel->agg);
+		if(4*uiCoarse > 3*N)
+		{
+			GI_FREE_ARRAY(pLevel->agg);
+			break;
+		}
+
+		/* create structure of prolongation and smooth it by damped Jacobi */
+		pPos = (GIuint*)GI_MALLOC_ARRAY(uiCoarse, sizeof(GIuint));
+		for(k=0; k<uiCoarse; ++k)
+			pPos[k] = A->nnz;
+		create_csr(&pLevel->P, N, A->nnz);
+		for(i=0,c=0; i<N; ++i)
+		{
+			uiStart = c;
+			for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
+			{
+				k = pLevel->agg[A->idx[ij]];
+				if(pPos[k] < uiStart || pPos[k] >= c)
+				{
+					pPos[k] = c;
+					pLevel->P.idx[c++] = k;
+				}
+			}
+			pLevel->P.ptr[i+1] = c;
+		}
+		pLevel->P.nnz = c;
+		GI_FREE_ARRAY(pPos);
+		smooth_prolongation(pLevel, uiCoarse, 4.0/(3.0*dRho));
+
+		/* compute Galerkin product R*A*P with R = P^T */
+		transpose_csr(&pLevel->P, uiCoarse, &pLevel->R);
+		multiply_csr(A, &pLevel->P, uiCoarse, &pLevel->AP);
+		A = pLevel[1].A = (GISparseMatrixCSR*)GI_MALLOC_SINGLE(sizeof(GISparseMatrixCSR));
+		multiply_csr(&pLevel->R, &pLevel->AP, uiCoarse, A);
+		pLevel->r = (GIdouble*)GI_MALLOC_ARRAY(2*N, sizeof(GIdouble));
+		dTheta *= 0.5;
+
+		/* sort rows of coarse matrix */
+		for(i=0; i<uiCoarse; ++i)
+		{
+			for(ij=A->ptr[i]+1; ij<A->ptr[i+1]; ++ij)
+			{
+				GIdouble dValue = A->values[ij];
+				k = A->idx[ij];
+				for(j=ij; j>A->ptr[i] && A->idx[j-1]>k; --j)
+				{
+					A->idx[j] = A->idx[j-1];
+					A->values[j] = A->values[j-1];
+				}
+				A->idx[j] = k;
+				A->values[j] = dValue;
+			}
+		}
+	}
+	pMG->levels = l + 1;
+
+	/* factorize lower triangle of coarsest matrix */
+	create_csr(&pMG->lower, N, A->nnz);
+	pMG->lower.symmetric = GI_TRUE;
+	for(i=0,c=0; i<N; ++i)
+	{
+		for(ij=A->ptr[i]; ij<A->ptr[i+1] && A->idx[ij]<=i; ++ij,++c)
+		{
+			pMG->lower.idx[c] = A->idx[ij];
+			pMG->lower.values[c] = A->values[ij];
+		}
+		pMG->lower.ptr[i+1] = c;
+	}
+	pMG->lower.nnz = c;
+	GISparseLDL_construct(&pMG->coarse, &pMG->lower);
+	GISparseLDL_factorize(&pMG->coarse, &pMG->lower);
+}
+
+/** \internal
+ *  \brief Prepare data for Jacobi preconditioner with block compressed matrix.
+ *  \param mat matrix to create data for
+ *  \ingroup numerics
+ */
+void GISparseMatrixBCSR2_prepare_jacobi(GISparseMatrixBCSR2 *mat)
+{
+	GIdouble *pData;
+	GIuint i, N = (mat->n+1) >> 1, uiSize = (N<<1) * sizeof(GIdouble);
+
+	/* create data if neccessary */
+	if(!mat->data || *((GIuint*)mat->data) != uiSize)
+	{
+		if(mat->data)
+			GI_FREE_ARRAY(mat->data);
+		mat->data = GI_MALLOC_ARRAY(uiSize+sizeof(GIuint), 1);
+		*((GIuint*)mat->data) = uiSize;
+	}
+	pData = (GIdouble*)((GIuint*)mat->data+1);
+
+	/* save inverted diagonal */
+	if(mat->symmetric)
+	{
+		for(i=0; i<N; ++i,pData+=2)
+		{
+			pData[0] = 1.0 / mat->values[(mat->ptr[i+1]-1)<<2];
+			pData[1] = 1.0 / mat->values[((mat->ptr[i+1]-1)<<2)+3];
+		}
+	}
+	else
+	{
+		GIuint ij;
+
+		for(i=0; i<N; ++i,pData+=2)
+		{
+			for(ij=mat->ptr[i]; mat->idx[ij]<i; ++ij) ;
+			pData[0] = 1.0 / mat->values[ij<<2];
+			pData[1] = 1.0 / mat->values[(ij<<2)+3];
+		}
+	}
+}
+
+/** \internal
+ *  \brief Apply Jacobi preconditioner with generic matrix.
+ *  \param A system matrix
+ *  \param x vector to multiply preconditioning matrix with
+ *  \param y vector to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrix_pc_jacobi(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+	GIuint i, N = A->n;
+	const GIdouble *pInvDiag = (const GIdouble*)((const GIuint*)A->data+1);
+
+	/* divide vector by diagonal of matrix */
+	for(i=0; i<N; ++i)
+		y[i] = x[i] * pInvDiag[i];
+}
+
+/** \internal
+ *  \brief Apply Jacobi preconditioner to two interleaved vectors.
+ *  \param A system matrix
+ *  \param x two interleaved vectors to multiply preconditioning matrix with
+ *  \param y two interleaved vectors to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrix_pc_jacobi2(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+	GIuint i, N = A->n;
+	const GIdouble *pInvDiag = (const GIdouble*)((const GIuint*)A->data+1);
+
+	/* divide vectors by diagonal of matrix */
+	for(i=0; i<N; ++i)
+	{
+		y[i<<1] = x[i<<1] * pInvDiag[i];
+		y[(i<<1)+1] = x[(i<<1)+1] * pInvDiag[i];
+	}
+}
+
+/** \internal
+ *  \brief Apply SSOR preconditioner with sparse matrix.
+ *  \param A system matrix
+ *  \param x vector to multiply preconditioning matrix with
+ *  \param y vector to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_pc_ssor(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+	const GISparseMatrixLIL *mat = (const GISparseMatrixLIL*)A;
+	const GIVectorElement *pElement;
+	const GIdouble *pDiag = (const GIdouble*)((const GIuint*)A->data+1);
+	GIint i, N = mat->n;
+	GIdouble dOmega = pDiag[N];
+
+	/* forward-eliminate for lower triangle */
+	for(i=0; i<N; ++i)
+	{
+		register GIdouble temp = 0.0;
+		for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement)
+			temp += pElement->value * y[pElement->index];
+		y[i] = (x[i]-dOmega*temp) / pDiag[i];
+	}
+
+	/* multiply by diagonal */
+	for(i=0; i<N; ++i)
+		y[i] *= pDiag[i];
+
+	/* backward-eliminate for upper triangle */
+	if(mat->symmetric)
+	{
+		for(i=N-1; i>0; --i)
+		{
+			register GIdouble temp = dOmega * (y[i]/=pDiag[i]);
+			for(pElement=mat->rows[i].elements; pElement->index<i; ++pElement)
+				y[pElement->index] -= pElement->value * temp;
+		}
+		y[0] /= pDiag[0];
+	}
+	else
+	{
+		for(i=N-1; i>=0; --i)
+		{
+			register GIdouble temp = 0.0;
+			for(pElement=mat->rows[i].elements+mat->rows[i].size-1; 
+				pElement->index>i; --pElement)
+				temp += pElement->value * y[pElement->index];
+			y[i] = (y[i]-dOmega*temp) / pDiag[i];
+		}
+	}
+}
+
+/** \internal
+ *  \brief Apply IC/ILU preconditioner with sparse matrix.
+ *  \param A system matrix
+ *  \param x vector to multiply preconditioning matrix with
+ *  \param y vector to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixLIL_pc_ilu(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+	incomplete_lu((const GISparseMatrixCSR*)((GIuint*)A->data+1), NULL, x, y);
+}
+
+/** \internal
+ *  \brief Apply SSOR preconditioner with compressed matrix.
+ *  \param A system matrix
+ *  \param x vector to multiply preconditioning matrix with
+ *  \param y vector to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_pc_ssor(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+	const GISparseMatrixCSR *mat = (const GISparseMatrixCSR*)A;
+	const GIdouble *pDiag = (const GIdouble*)((const GIuint*)A->data+1);
+	GIint i, ij, N = mat->n;
+	GIdouble dOmega = pDiag[N];
+
+	/* forward-eliminate for lower triangle */
+	for(i=0,ij=0; i<N; ++i)
+	{
+		register GIdouble temp = 0.0;
+		for(ij=mat->ptr[i]; mat->idx[ij]<i; ++ij)
+			temp += mat->values[ij] * y[mat->idx[ij]];
+		y[i] = (x[i]-dOmega*temp) / mat->values[ij];
+	}
+
+	/* multiply by diagonal */
+	for(i=0; i<N; ++i)
+		y[i] *= pDiag[i];
+
+	/* backward-eliminate for upper triangle */
+	if(mat->symmetric)
+	{
+		for(i=N-1,ij=mat->nnz-2; i>0; --i,--ij)
+		{
+			register GIdouble temp = dOmega * (y[i]/=pDiag[i]);
+			for(; ij>=mat->ptr[i]; --ij)
+				y[mat->idx[ij]] -= mat->values[ij] * temp;
+		}
+		y[0] /= mat->values[0];
+	}
+	else
+	{
+		for(i=N-1; i>=0; --i)
+		{
+			register GIdouble temp = 0.0;
+			for(ij=mat->ptr[i+1]-1; mat->idx[ij]>i; --ij)
+				temp += mat->values[ij] * y[mat->idx[ij]];
+			y[i] = (y[i]-dOmega*temp) / mat->values[ij];
+		}
+	}
+}
+
+/** \internal
+ *  \brief Apply SSOR preconditioner to two interleaved vectors.
+ *  \param A system matrix
+ *  \param x two interleaved vectors to multiply preconditioning matrix with
+ *  \param y two interleaved vectors to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_pc_ssor2(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+	const GISparseMatrixCSR *mat = (const GISparseMatrixCSR*)A;
+	const GIdouble *pDiag = (const GIdouble*)((const GIuint*)A->data+1);
+	GIint i, j, ij, N = mat->n;
+	GIdouble dOmega = pDiag[N];
+
+	/* forward-eliminate for lower triangle */
+	for(i=0; i<N; ++i)
+	{
+		register GIdouble temp0 = 0.0, temp1 = 0.0;
+		for(ij=mat->ptr[i]; mat->idx[ij]<i; ++ij)
+		{
+			j = mat->idx[ij] << 1;
+			temp0 += mat->values[ij] * y[j];
+			temp1 += mat->values[ij] * y[j+1];
+		}
+		y[i<<1] = (x[i<<1]-dOmega*temp0) / mat->values[ij];
+		y[(i<<1)+1] = (x[(i<<1)+1]-dOmega*temp1) / mat->values[ij];
+	}
+
+	/* multiply by diagonal */
+	for(i=0; i<N; ++i)
+	{
+		y[i<<1] *= pDiag[i];
+		y[(i<<1)+1] *= pDiag[i];
+	}
+
+	/* backward-eliminate for upper triangle */
+	if(mat->symmetric)
+	{
+		for(i=N-1,ij=mat->nnz-2; i>0; --i,--ij)
+		{
+			register GIdouble temp0 = dOmega * (y[i<<1]/=pDiag[i]);
+			register GIdouble temp1 = dOmega * (y[(i<<1)+1]/=pDiag[i]);
+			for(; ij>=mat->ptr[i]; --ij)
+			{
+				j = mat->idx[ij] << 1;
+				y[j] -= mat->values[ij] * temp0;
+				y[j+1] -= mat->values[ij] * temp1;
+			}
+		}
+		y[0] /= mat->values[0];
+		y[1] /= mat->values[0];
+	}
+	else
+	{
+		for(i=N-1; i>=0; --i)
+		{
+			register GIdouble temp0 = 0.0, temp1 = 0.0;
+			for(ij=mat->ptr[i+1]-1; mat->idx[ij]>i; --ij)
+			{
+				j = mat->idx[ij] << 1;
+				temp0 += mat->values[ij] * y[j];
+				temp1 += mat->values[ij] * y[j+1];
+			}
+			y[i<<1] = (y[i<<1]-dOmega*temp0) / mat->values[ij];
+			y[(i<<1)+1] = (y[(i<<1)+1]-dOmega*temp1) / mat->values[ij];
+		}
+	}
+}
+
+/** \internal
+ *  \brief Apply IC/ILU preconditioner with compressed matrix.
+ *  \param A system matrix
+ *  \param x vector to multiply preconditioning matrix with
+ *  \param y vector to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_pc_ilu(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+	incomplete_lu((const GISparseMatrixCSR*)A, 
+		(const GIdouble*)((const GIuint*)A->data+1), x, y);
+}
+
+/** \internal
+ *  \brief Apply IC/ILU preconditioner to two vectors.
+ *  \param A system matrix
+ *  \param x two interleaved vectors to multiply preconditioning matrix with
+ *  \param y two interleaved vectors to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_pc_ilu2(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+	incomplete_lu2((const GISparseMatrixCSR*)A, 
+		(const GIdouble*)((const GIuint*)A->data+1), x, y);
+}
+
+/** \internal
+ *  \brief Apply single precision IC/ILU preconditioner to two vectors.
+ *  \details The factors of the scaled matrix have to be rounded by 
+ *  GISparseMatrixCSR_prepare_float.
+ *  \param A system matrix
+ *  \param x two interleaved single precision vectors to multiply preconditioning matrix with
+ *  \param y two interleaved single precision vectors to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_pc_ilu2f(const GISparseMatrix *A, const GIfloat *x, GIfloat *y)
+{
+	const GISparseMatrixCSR *mat = (const GISparseMatrixCSR*)A;
+	incomplete_lu2f(mat, mat->filu, x, y);
+}
+
+/** \internal
+ *  \brief Apply single precision Jacobi preconditioner to two vectors.
+ *  \details This divides by the diagonal of the matrix scaled by the fscale 
+ *  of GISparseMatrixCSR_prepare_float, using the data of 
+ *  GISparseMatrixCSR_prepare_jacobi.
+ *  \param A system matrix
+ *  \param x two interleaved single precision vectors to multiply preconditioning matrix with
+ *  \param y two interleaved single precision vectors to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_pc_jacobi2f(const GISparseMatrix *A, const GIfloat *x, GIfloat *y)
+{
+	const GIdouble *pInvDiag = (const GIdouble*)((const GIuint*)A->data+1);
+	GIdouble dScale = 1.0 / ((const GISparseMatrixCSR*)A)->fscale;
+	GIuint i, N = A->n;
+
+	/* divide vectors by scaled diagonal of matrix */
+	for(i=0; i<N; ++i)
+	{
+		register GIfloat d = (GIfloat)(pInvDiag[i]*dScale);
+		y[i<<1] = x[i<<1] * d;
+		y[(i<<1)+1] = x[(i<<1)+1] * d;
+	}
+}
+
+/** \internal
+ *  \brief Apply algebraic multigrid preconditioner with compressed matrix.
+ *  \param A system matrix
+ *  \param x vector to multiply preconditioning matrix with
+ *  \param y vector to store result
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_pc_amg(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+	multigrid_cycle(((const GISparseMatrixCSR*)A)->amg, 0, x, y, 1);
+}
+
+/** \internal
+ *  \brief Apply algebraic multigrid preconditioner to two interleaved vectors.
+ *  \param A system matrix
+ *  \param x interleaved vectors to multiply preconditioning matrix with
+ *  \param y interleaved vectors to store results
+ *  \ingroup numerics
+ */
+void GISparseMatrixCSR_pc_amg2(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
+{
+	multigrid_cycle(((const GISparseMatrixCSR*)A)->amg, 0, x, y, 2);
+}
+
+/** \internal
+ *  \brief Sparse LDL^T factorization constructor.
+ *  \details This computes the fill-reducing ordering and the structure of 
+ *  the factor, the numerical factorization is done by GISparseLDL_factorize.
+ *  \param ldl factorization to construct
+ *  \param A symmetric compressed matrix to factorize
+ *  \ingroup numerics
+ */
+void GISparseLDL_construct(GISparseLDL *ldl, const GISparseMatrixCSR *A)
+{
+	GIuint *xadj, *adj, *pFlag, *pCount;
+	GIuint i, j, k, ij, N = A->n;
+
+	/* create structure */
+	ldl->n = N;
+	ldl->perm = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+	ldl->iperm = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+	ldl->parent = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+	ldl->aptr = (GIuint*)GI_CALLOC_ARRAY(N+1, sizeof(GIuint));
+	ldl->aidx = (GIuint*)GI_MALLOC_ARRAY(A->nnz, sizeof(GIuint));
+	ldl->amap = (GIuint*)GI_MALLOC_ARRAY(A->nnz, sizeof(GIuint));
+	ldl->lptr = (GIuint*)GI_MALLOC_ARRAY(N+1, sizeof(GIuint));
+
+	/* build adjacency graph and compute ordering */
+	xadj = (GIuint*)GI_CALLOC_ARRAY(N+1, sizeof(GIuint));
+	adj = (GIuint*)GI_MALLOC_ARRAY(2*(A->nnz-N)+1, sizeof(GIuint));
+	for(i=0; i<N; ++i)
+	{
+		for(ij=A->ptr[i]; A->idx[ij]<i; ++ij)
+		{
+			++xadj[i+1];
+			++xadj[A->idx[ij]+1];
+		}
+	}
+	for(i=0; i<N; ++i)
+		xadj[i+1] += xadj[i];
+	pCount = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+	memcpy(pCount, xadj, N*sizeof(GIuint));
+	for(i=0; i<N; ++i)
+	{
+		for(ij=A->ptr[i]; (j=A->idx[ij])<i; ++ij)
+		{
+			adj[pCount[i]++] = j;
+			adj[pCount[j]++] = i;
+		}
+	}
+	nested_dissection(N, xadj, adj, ldl->perm);
+	for(i=0; i<N; ++i)
+		ldl->iperm[ldl->perm[i]] = i;
+	GI_FREE_ARRAY(xadj);
+	GI_FREE_ARRAY(adj);
+
+	/* permute lower triangle */
+	for(i=0; i<N; ++i)
+		for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
+			++ldl->aptr[GI_MAX(ldl->iperm[i], ldl->iperm[A->idx[ij]])+1];
+	for(i=0; i<N; ++i)
+	{
+		ldl->aptr[i+1] += ldl->aptr[i];
+		pCount[i] = ldl->aptr[i];
+	}
+	for(i=0; i<N; ++i)
+	{
+		for(ij=A->ptr[i]; ij<A->ptr[i+1]; ++ij)
+		{
+			j = ldl->iperm[i];
+			k = ldl->iperm[A->idx[ij]];
+			ldl->aidx[pCount[GI_MAX(j, k)]] = GI_MIN(j, k);
+			ldl->amap[pCount[GI_MAX(j, k)]++] = ij;
+		}
+	}
+
+	/* compute elimination tree and column counts */
+	pFlag = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+	for(k=0; k<N; ++k)
+	{
+		ldl->parent[k] = N;
+		pFlag[k] = k;
+		pCount[k] = 0;
+		for(ij=ldl->aptr[k]; ij<ldl->aptr[k+1]; ++ij)
+		{
+			for(i=ldl->aidx[ij]; pFlag[i]!=k; i=ldl->parent[i])
+			{
+				if(ldl->parent[i] == N)
+					ldl->parent[i] = k;
+				++pCount[i];
+				pFlag[i] = k;
+			}
+		}
+	}
+	for(k=0,ldl->lptr[0]=0; k<N; ++k)
+		ldl->lptr[k+1] = ldl->lptr[k] + pCount[k];
+	ldl->nnz = ldl->lptr[N];
+	ldl->lidx = (GIuint*)GI_MALLOC_ARRAY(ldl->nnz, sizeof(GIuint));
+	ldl->lvalues = (GIdouble*)GI_MALLOC_ARRAY(ldl->nnz, sizeof(GIdouble));
+	ldl->diag = (GIdouble*)GI_MALLOC_ARRAY(N, sizeof(GIdouble));
+	GI_FREE_ARRAY(pFlag);
+	GI_FREE_ARRAY(pCount);
+}
+
+/** \internal
+ *  \brief Sparse LDL^T factorization destructor.
+ *  \param ldl factorization to destruct
+ *  \ingroup numerics
+ */
+void GISparseLDL_destruct(GISparseLDL *ldl)
+{
+	/* delete arrays and clear data */
+	GI_FREE_ARRAY(ldl->perm);
+	GI_FREE_ARRAY(ldl->iperm);
+	GI_FREE_ARRAY(ldl->parent);
+	GI_FREE_ARRAY(ldl->aptr);
+	GI_FREE_ARRAY(ldl->aidx);
+	GI_FREE_ARRAY(ldl->amap);
+	GI_FREE_ARRAY(ldl->lptr);
+	GI_FREE_ARRAY(ldl->lidx);
+	GI_FREE_ARRAY(ldl->lvalues);
+	GI_FREE_ARRAY(ldl->diag);
+	memset(ldl, 0, sizeof(GISparseLDL));
+}
+
+/** \internal
+ *  \brief Compute numerical LDL^T factorization.
+ *  \details The rows of L are computed one after the other by sparse 
+ *  triangular solves along the elimination tree. The matrix has to have 
+ *  the same structure as the one the factorization was constructed with.
+ *  \param ldl factorization to compute
+ *  \param A symmetric compressed matrix to factorize
+ *  \retval GI_TRUE if factorized successfully
+ *  \retval GI_FALSE if zero pivot encountered
+ *  \ingroup numerics
+ */
+GIboolean GISparseLDL_factorize(GISparseLDL *ldl, const GISparseMatrixCSR *A)
+{
+	GIuint N = ldl->n;
+	GIdouble *y = (GIdouble*)GI_CALLOC_ARRAY(N, sizeof(GIdouble));
+	GIuint *pPattern = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+	GIuint *pFlag = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+	GIuint *pCount = (GIuint*)GI_MALLOC_ARRAY(N, sizeof(GIuint));
+	GIuint i, k, ij, kj, uiTop, uiLen;
+	GIboolean bSuccess = GI_TRUE;
+
+	for(k=0; k<N && bSuccess; ++k)
+	{
+		/* scatter row k and compute its pattern in topological order */
+		pFlag[k] = k;
+		pCount[k] = 0;
+		uiTop = N;
+		for(ij=ldl->aptr[k]; ij<ldl->aptr[k+1]; ++ij)
+		{
+			i = ldl->aidx[ij];
+			y[i] += A->values[ldl->amap[ij]];
+			for(uiLen=0; pFlag[i]!=k; i=ldl->parent[i])
+			{
+				pPattern[uiLen++] = i;
+				pFlag[i] = k;
+			}
+			while(uiLen)
+				pPattern[--uiTop] = pPattern[--uiLen];
+		}
+
+		/* solve for row k of L */
+		ldl->diag[k] = y[k];
+		y[k] = 0.0;
+		for(; uiTop<N; ++uiTop)
+		{
+			register GIdouble yi, lki;
+			i = pPattern[uiTop];
+			yi = y[i];
+			y[i] = 0.0;
+			for(kj=ldl->lptr[i]; kj<ldl->lptr[i]+pCount[i]; ++kj)
+				y[ldl->lidx[kj]] -= ldl->lvalues[kj] * yi;
+			lki = yi / ldl->diag[i];
+			ldl->diag[k] -= lki * yi;
+			ldl->lidx[kj] = k;
+			ldl->lvalues[kj] = lki;
+			++pCount[i];
+		}
+		if(ldl->diag[k] == 0.0)
+			bSuccess = GI_FALSE;
+	}
+
+	/* clean up */
+	GI_FREE_ARRAY(y);
+	GI_FREE_ARRAY(pPattern);
+	GI_FREE_ARRAY(pFlag);
+	GI_FREE_ARRAY(pCount);
+	return bSuccess;
+}
+
+/** \internal
+ *  \brief Solve equation system with LDL^T factorization.
+ *  \param ldl factorization of system matrix
+ *  \param b interleaved right hand side vectors
+ *  \param x interleaved vectors to store solutions
+ *  \param columns number of interleaved vectors
+ *  \ingroup numerics
+ */
+void GISparseLDL_solve(const GISparseLDL *ldl, const GIdouble *b, 
+					   GIdouble *x, GIuint columns)
+{
+	GIuint N = ldl->n;
+	GIdouble *y = (GIdouble*)GI_MALLOC_ARRAY(N*columns, sizeof(GIdouble));
+	GIuint i, j, c, ij;
+
+	/* permute right hand side */
+	for(i=0; i<N; ++i)
+		for(c=0; c<columns; ++c)
+			y[i*columns+c] = b[ldl->perm[i]*columns+c];
+
+	/* forward-eliminate for L, scale by D and backward-eliminate for L^T */
+	for(j=0; j<N; ++j)
+		for(ij=ldl->lptr[j]; ij<ldl->lptr[j+1]; ++ij)
+			for(i=ldl->lidx[ij]*columns,c=0; c<columns; ++c)
+				y[i+c] -= ldl->lvalues[ij] * y[j*columns+c];
+	for(j=0; j<N; ++j)
+		for(c=0; c<columns; ++c)
+			y[j*columns+c] /= ldl->diag[j];
+	for(j=N; j-->0; )
+		for(ij=ldl->lptr[j]; ij<ldl->lptr[j+1]; ++ij)
+			for(i=ldl->lidx[ij]*columns,c=0; c<columns; ++c)
+				y[j*columns+c] -= ldl->lvalues[ij] * y[i+c];
+
+	/* permute solution back */
+	for(i=0; i<N; ++i)
+		for(c=0; c<columns; ++c)
+			x[ldl->perm[i]*columns+c] = y[i*columns+c];
+	GI_FREE_ARRAY(y);
+}
+
+/** \internal
+ *  \brief Solve equation system by conjugate gradient method.
+ *  \param A system matrix
+ *  \param b right hand side vector
+ *  \param x vector of unknowns
+ *  \param ax matrix-vector-multiplication function
+ *  \param pc preconditioning function or NULL if no preconditioning
+ *  \param eps error threshold
+ *  \param max_iter maximum number of iterations
+ *  \return number of used iterations
+ *  \ingroup numerics
+ */
+GIuint GISolver_cg(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
+				   GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter)
+{
+	GIuint N = A->n;
+	GIdouble *r = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *q = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *v = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *w = (pc ? v : r);
+	GIdouble alpha, beta, gamma, tol = eps * eps * ddot(N, b, 1, b, 1);
+	GIuint i = 0;
+
+	/* initialize */
+	ax(A, x, r);
+	daxpy(N, -1.0, b, 1, r, 1);
+	if(pc)
+		pc(A, r, w);
+	dcopy(N, w, 1, q, 1);
+	gamma = ddot(N, r, 1, w, 1);
+
+	/* iterate */
+	for(i=1; i<=max_iter; ++i)
+	{
+		ax(A, q, v);
+		alpha = -gamma / ddot(N, v, 1, q, 1);
+		daxpy(N, alpha, q, 1, x, 1);
+		daxpy(N, alpha, v, 1, r, 1);
+		if(pc)
+			pc(A, r, w);
+		beta = 1.0 / gamma;
+		if(pc)
+		{
+			if(ddot(N, r, 1, r, 1) <= tol)
+				break;
+			gamma = ddot(N, r, 1, w, 1);
+		}
+		else
+		{
+			gamma = ddot(N, r, 1, r, 1);
+			if(gamma <= tol)
+				break;
+		}
+		beta *= gamma;
+		dscal(N, beta, q, 1);
+		daxpy(N, 1.0, w, 1, q, 1);
+	}
+
+	/* clean up */
+	GI_FREE_ALIGNED(r);
+	GI_FREE_ALIGNED(q);
+	GI_FREE_ALIGNED(v);
+	return i;
+}
+
+/** \internal
+ *  \brief Solve equation system by stabilized biconjugate gradient method.
+ *  \param A system matrix
+ *  \param b right hand side vector
+ *  \param x vector of unknowns
+ *  \param ax matrix-vector-multiplication function
+ *  \param pc preconditioning function or NULL if no preconditioning
+ *  \param eps error threshold
+ *  \param max_iter maximum number of iterations
+ *  \return number of used iterations
+ *  \ingroup numerics
+ */
+GIuint GISolver_bicgstab(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
+						 GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter)
+{
+	GIuint N = A->n;
+	GIdouble *r = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *r0 = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *q = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *v = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *t = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *s = r, *tP = t, *rP = r, *sP = r, *vP = v;
+	GIdouble alpha, beta, gamma, omega, tol = eps * eps * ddot(N, b, 1, b, 1);
+	GIuint i = 0;
+
+	/* initialize */
+	ax(A, x, r);
+	daxpy(N, -1.0, b, 1, r, 1);
+	if(pc)
+	{
+		vP = (GIdouble*)GI_MALLOC_ALIGNED(
+			GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+		sP = rP = (GIdouble*)GI_MALLOC_ALIGNED(
+			GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+		tP = v;
+		pc(A, r, rP);
+	}
+	dcopy(N, rP, 1, q, 1);
+	dcopy(N, rP, 1, r0, 1);
+	gamma = ddot(N, rP, 1, r0, 1);
+
+	/* iterate */
+	for(i=1; i<=max_iter; ++i)
+	{
+		ax(A, q, v);
+		if(pc)
+			pc(A, v, vP);
+		alpha = gamma / ddot(N, vP, 1, r0, 1);
+		daxpy(N, -alpha, q, 1, x, 1);
+		daxpy(N, -alpha, v, 1, s, 1);
+		if(ddot(N, r, 1, r, 1) <= tol)
+			break;
+		if(pc)
+			daxpy(N, -alpha, vP, 1, sP, 1);
+		ax(A, sP, t);
+		if(pc)
+			pc(A, t, tP);
+		omega = ddot(N, tP, 1, sP, 1) / ddot(N, tP, 1, tP, 1);
+		daxpy(N, -omega, sP, 1, x, 1);
+		daxpy(N, -omega, t, 1, r, 1);
+		if(ddot(N, r, 1, r, 1) <= tol)
+			break;
+		if(pc)
+			daxpy(N, -omega, tP, 1, rP, 1);
+		beta = alpha / (omega*gamma);
+		gamma = ddot(N, rP, 1, r0, 1);
+		beta *= gamma;
+		daxpy(N, -omega, vP, 1, q, 1);
+		dscal(N, beta, q, 1);
+		daxpy(N, 1.0, rP, 1, q, 1);
+	}
+
+	/* clean up */
+	GI_FREE_ALIGNED(r);
+	GI_FREE_ALIGNED(r0);
+	GI_FREE_ALIGNED(q);
+	GI_FREE_ALIGNED(v);
+	GI_FREE_ALIGNED(t);
+	if(pc)
+	{
+		GI_FREE_ALIGNED(vP);
+		GI_FREE_ALIGNED(rP);
+	}
+	return i;
+}
+
+/** \internal
+ *  \brief Solve equation system by generalized minimized residual method.
+ *  \param A system matrix
+ *  \param b right hand side vector
+ *  \param x vector of unknowns
+ *  \param ax matrix-vector-multiplication function
+ *  \param pc preconditioning function or NULL if no preconditioning
+ *  \param eps error threshold
+ *  \param max_iter maximum number of iterations
+ *  \return number of used iterations
+ *  \ingroup numerics
+ */
+GIuint GISolver_gmres(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
+					  GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter)
+{
+	GIuint N = A->n, M = max_iter & 0xFF;
+#if OPENGI_SSE >= 2
+	GIuint LDQ = (N+1) & (~1);
+#else
+	GIuint LDQ = N;
+#endif
+	GIdouble *Q = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(LDQ*(M+1)*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *H = (GIdouble*)GI_MALLOC_ALIGNED(
+		((M*(M+1))/2)*sizeof(GIdouble), sizeof(GIdouble));
+	GIdouble *r = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *c = (GIdouble*)GI_MALLOC_ALIGNED(M*sizeof(GIdouble), sizeof(GIdouble));
+	GIdouble *s = (GIdouble*)GI_MALLOC_ALIGNED(M*sizeof(GIdouble), sizeof(GIdouble));
+	GIdouble *y = (GIdouble*)GI_MALLOC_ALIGNED((M+1)*sizeof(GIdouble), sizeof(GIdouble));
+	GIdouble *w = r;
+	GIdouble beta, tol, tmp, hjj;
+	GIuint i = 0, j, k, Hij;
+
+	/* outer initialization, padding of Krylov vectors has to be zero */
+	max_iter >>= 8;
+	memset(Q, 0, LDQ*(M+1)*sizeof(GIdouble));
+	if(pc)
+	{
+		w = (GIdouble*)GI_MALLOC_ALIGNED(
+			GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+		pc(A, b, w);
+		tol = eps * eps * ddot(N, w, 1, w, 1);
+	}
+	else
+		tol = eps * eps * ddot(N, b, 1, b, 1);
+
+	/* outer iteration */
+	do
+	{
+		/* inner initialization */
+		ax(A, x, r);
+		daxpy(N, -1.0, b, 1, r, 1);
+		if(pc)
+			pc(A, r, w);
+		y[0] = beta = dnrm2(N, w, 1);
+		dcopy(N, w, 1, Q, 1);
+		dscal(N, 1.0/beta, Q, 1);
+		Hij = 0;
+
+		/* inner iteration */
+		for(j=0; j<M; ++j)
+		{
+			GIdouble *qj = Q + j*LDQ, *qj1 = Q + (j+1)*LDQ;
+
+			/* compute and orthogonalize q[j+1] */
+			if(pc)
+			{
+				ax(A, qj, w);
+				pc(A, w, qj1);
+			}
+			else
+				ax(A, qj, qj1);
+			dgemv('T', N, j+1, 1.0, Q, LDQ, qj1, 1, 0.0, H+Hij, 1);
+			beta = dorth(N, j+1, Q, LDQ, H+Hij, qj1);
+
+			/* rotate new H-column */
+			for(k=0; k<j; ++k,++Hij)
+			{
+				tmp = c[k]*H[Hij] - s[k]*H[Hij+1];
+				H[Hij+1] = s[k]*H[Hij] + c[k]*H[Hij+1];
+				H[Hij] = tmp;
+			}
+
+			/* compute new rotation */
+			hjj = H[Hij];
+			tmp = sqrt(hjj*hjj+beta*beta);
+			c[j] = hjj / tmp;
+			s[j] = -beta / tmp;
+			H[Hij++] = tmp;
+
+			/* rotate right hand side and normalize q[j+1] if needed further */
+			y[j+1] = s[j] * y[j];
+			y[j] = c[j] * y[j];
+			if(fabs(y[j+1]) <= tol)
+			{
+				++j;
+				break;
+			}
+			dscal(N, 1.0/beta, qj1, 1);
+		}
+
+		/* backward-eliminate for y and compute x */
+		dtpsv('U', 'N', 'N', j, H, y, 1);
+		dgemv('N', N, j, -1.0, Q, LDQ, y, 1, 1.0, x, 1);
+		++i;
+	}while(fabs(y[j]) > tol && i < max_iter);
+
+	/* clean up */
+	GI_FREE_ALIGNED(Q);
+	GI_FREE_ALIGNED(H);
+	GI_FREE_ALIGNED(r);
+	GI_FREE_ALIGNED(c);
+	GI_FREE_ALIGNED(s);
+	GI_FREE_ALIGNED(y);
+	if(pc)
+		GI_FREE_ALIGNED(w);
+	return (i-1)*M + j;
+}
+
+/** \internal
+ *  \brief Solve equation system for two right hand sides by conjugate gradient method.
+ *  \details Both systems are iterated simultaneously, so every matrix and 
+ *  preconditioner application serves both of them. Every system follows the 
+ *  same recurrences as with GISolver_cg and stops on its own convergence.
+ *  \param A system matrix
+ *  \param b two interleaved right hand side vectors
+ *  \param x two interleaved vectors of unknowns
+ *  \param ax matrix-vector-multiplication function for two interleaved vectors
+ *  \param pc preconditioning function for two interleaved vectors or NULL if no preconditioning
+ *  \param eps error threshold
+ *  \param max_iter maximum number of iterations
+ *  \param iterations array to store number of used iterations for both systems
+ *  \param monitor convergence monitor or NULL
+ *  \return maximum number of used iterations
+ *  \ingroup numerics
+ */
+GIuint GISolver_cg2(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
+					GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter, 
+					GIuint *iterations, const GISolverMonitor *monitor)
+{
+	GIuint N = A->n;
+	GIdouble *r = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *q = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *v = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *w = (pc ? v : r);
+	GIdouble alpha[2], beta[2], gamma[2], tol[2], temp[2], nb[2], res[2];
+	GIboolean active[2] = { GI_TRUE, GI_TRUE };
+	GIuint i = 0, c;
+
+	/* initialize */
+	ddot2(N, b, b, nb);
+	for(c=0; c<2; ++c)
+		tol[c] = eps * eps * nb[c];
+	ax(A, x, r);
+	daxpy(2*N, -1.0, b, 1, r, 1);
+	if(pc)
+		pc(A, r, w);
+	dcopy(2*N, w, 1, q, 1);
+	ddot2(N, r, w, gamma);
+
+	/* iterate */
+	for(i=1; i<=max_iter; ++i)
+	{
+		ax(A, q, v);
+		ddot2(N, v, q, temp);
+		for(c=0; c<2; ++c)
+			alpha[c] = -gamma[c] / temp[c];
+		daxpy2_nrm2(N, alpha, active, q, x, v, r, temp);
+		for(c=0; c<2; ++c)
+			if(active[c])
+				res[c] = temp[c];
+		if(pc)
+			pc(A, r, w);
+		for(c=0; c<2; ++c)
+			beta[c] = 1.0 / gamma[c];
+		if(pc)
+		{
+			for(c=0; c<2; ++c)
+			{
+				if(active[c] && temp[c] <= tol[c])
+				{
+					iterations[c] = i;
+					active[c] = GI_FALSE;
+				}
+			}
+			ddot2(N, r, w, gamma);
+		}
+		else
+		{
+			for(c=0; c<2; ++c)
+			{
+				gamma[c] = temp[c];
+				if(active[c] && gamma[c] <= tol[c])
+				{
+					iterations[c] = i;
+					active[c] = GI_FALSE;
+				}
+			}
+		}
+		if(monitor)
+			report_residuals(monitor, i, res, nb);
+		if(!active[0] && !active[1])
+			break;
+		for(c=0; c<2; ++c)
+			beta[c] *= gamma[c];
+		dxpay2(N, NULL, beta, active, w, NULL, q);
+	}
+	for(c=0; c<2; ++c)
+		if(active[c])
+			iterations[c] = i;
+
+	/* clean up */
+	GI_FREE_ALIGNED(r);
+	GI_FREE_ALIGNED(q);
+	GI_FREE_ALIGNED(v);
+	return GI_MAX(iterations[0], iterations[1]);
+}
+
+/** \internal
+ *  \brief Solve equation system for two right hand sides by stabilized biconjugate gradient method.
+ *  \details Both systems are iterated simultaneously, so every matrix and 
+ *  preconditioner application serves both of them. Every system follows the 
+ *  same recurrences as with GISolver_bicgstab and stops on its own convergence.
+ *  \param A system matrix
+ *  \param b two interleaved right hand side vectors
+ *  \param x two interleaved vectors of unknowns
+ *  \param ax matrix-vector-multiplication function for two interleaved vectors
+ *  \param pc preconditioning function for two interleaved vectors or NULL if no preconditioning
+ *  \param eps error threshold
+ *  \param max_iter maximum number of iterations
+ *  \param iterations array to store number of used iterations for both systems
+ *  \param monitor convergence monitor or NULL
+ *  \return maximum number of used iterations
+ *  \ingroup numerics
+ */
+GIuint GISolver_bicgstab2(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
+						  GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter, 
+						  GIuint *iterations, const GISolverMonitor *monitor)
+{
+	GIuint N = A->n;
+	GIdouble *r = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *r0 = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *q = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *v = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *t = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *s = r, *tP = t, *rP = r, *sP = r, *vP = v;
+	GIdouble alpha[2], beta[2], gamma[2], omega[2], tol[2], temp[2], temp2[2];
+	GIdouble nb[2], res[2];
+	GIboolean active[2] = { GI_TRUE, GI_TRUE };
+	GIuint i = 0, c;
+
+	/* initialize */
+	ddot2(N, b, b, nb);
+	for(c=0; c<2; ++c)
+		tol[c] = eps * eps * nb[c];
+	ax(A, x, r);
+	daxpy(2*N, -1.0, b, 1, r, 1);
+	if(pc)
+	{
+		vP = (GIdouble*)GI_MALLOC_ALIGNED(
+			GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+		sP = rP = (GIdouble*)GI_MALLOC_ALIGNED(
+			GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+		tP = v;
+		pc(A, r, rP);
+	}
+	dcopy(2*N, rP, 1, q, 1);
+	dcopy(2*N, rP, 1, r0, 1);
+	ddot2(N, rP, r0, gamma);
+
+	/* iterate */
+	for(i=1; i<=max_iter; ++i)
+	{
+		ax(A, q, v);
+		if(pc)
+			pc(A, v, vP);
+		ddot2(N, vP, r0, temp);
+		for(c=0; c<2; ++c)
+			alpha[c] = gamma[c] / temp[c];
+		for(c=0; c<2; ++c)
+			temp[c] = -alpha[c];
+		daxpy2_nrm2(N, temp, active, q, x, v, s, temp2);
+		for(c=0; c<2; ++c)
+		{
+			if(active[c])
+			{
+				res[c] = temp2[c];
+				if(temp2[c] <= tol[c])
+				{
+					iterations[c] = i;
+					active[c] = GI_FALSE;
+				}
+			}
+		}
+		if(!active[0] && !active[1])
+		{
+			if(monitor)
+				report_residuals(monitor, i, res, nb);
+			break;
+		}
+		if(pc)
+			daxpy2(N, temp, active, vP, sP);
+		ax(A, sP, t);
+		if(pc)
+			pc(A, t, tP);
+		ddot2_nrm2(N, tP, sP, temp, temp2);
+		for(c=0; c<2; ++c)
+			omega[c] = -temp[c] / temp2[c];
+		daxpy2_nrm2(N, omega, active, sP, x, t, r, temp2);
+		for(c=0; c<2; ++c)
+		{
+			if(active[c])
+			{
+				res[c] = temp2[c];
+				if(temp2[c] <= tol[c])
+				{
+					iterations[c] = i;
+					active[c] = GI_FALSE;
+				}
+			}
+		}
+		if(monitor)
+			report_residuals(monitor, i, res, nb);
+		if(!active[0] && !active[1])
+			break;
+		if(pc)
+			daxpy2(N, omega, active, tP, rP);
+		for(c=0; c<2; ++c)
+			beta[c] = alpha[c] / (-omega[c]*gamma[c]);
+		ddot2(N, rP, r0, gamma);
+		for(c=0; c<2; ++c)
+			beta[c] *= gamma[c];
+		dxpay2(N, omega, beta, active, rP, vP, q);
+	}
+	for(c=0; c<2; ++c)
+		if(active[c])
+			iterations[c] = i;
+
+	/* clean up */
+	GI_FREE_ALIGNED(r);
+	GI_FREE_ALIGNED(r0);
+	GI_FREE_ALIGNED(q);
+	GI_FREE_ALIGNED(v);
+	GI_FREE_ALIGNED(t);
+	if(pc)
+	{
+		GI_FREE_ALIGNED(vP);
+		GI_FREE_ALIGNED(rP);
+	}
+	return GI_MAX(iterations[0], iterations[1]);
+}
+
+/** \internal
+ *  \brief Solve equation system for two right hand sides by generalized minimized residual method.
+ *  \details Both systems run their own (restarted) Arnoldi process, but the 
+ *  matrix and preconditioner applications of a step are done for both at once. 
+ *  Every system follows the same recurrences as with GISolver_gmres and stops 
+ *  on its own convergence. A system that did not converge within the allowed 
+ *  restarts gets one more than the maximum number of steps as iterations.
+ *  \param A system matrix
+ *  \param b two interleaved right hand side vectors
+ *  \param x two interleaved vectors of unknowns
+ *  \param ax matrix-vector-multiplication function for two interleaved vectors
+ *  \param pc preconditioning function for two interleaved vectors or NULL if no preconditioning
+ *  \param eps error threshold
+ *  \param max_iter maximum number of iterations
+ *  \param iterations array to store number of used iterations for both systems
+ *  \param monitor convergence monitor or NULL (called after every matrix application)
+ *  \return maximum number of used iterations
+ *  \ingroup numerics
+ */
+GIuint GISolver_gmres2(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
+					   GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter, 
+					   GIuint *iterations, const GISolverMonitor *monitor)
+{
+	GIuint N = A->n, M = max_iter & 0xFF;
+#if OPENGI_SSE >= 2
+	GIuint LDQ = (N+1) & (~1);
+#else
+	GIuint LDQ = N;
+#endif
+	GIdouble *Q[2], *H[2], *cs[2], *sn[2], *y[2], *xc[2];
+	GIdouble *z = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *r = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble *w = r;
+	GIdouble beta, tol[2], nb[2], res[2], tmp, hjj;
+	GIuint i[2] = { 0, 0 }, j[2] = { 0, 0 }, Hij[2] = { 0, 0 }, c, k, n, p = 0;
+	GIboolean restart[2] = { GI_TRUE, GI_TRUE }, active[2] = { GI_TRUE, GI_TRUE };
+	GIboolean bFinished;
+
+	/* outer initialization, padding of Krylov vectors has to be zero */
+	max_iter >>= 8;
+	for(c=0; c<2; ++c)
+	{
+		Q[c] = (GIdouble*)GI_MALLOC_ALIGNED(
+			GI_SSE_SIZE(LDQ*(M+1)*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+		memset(Q[c], 0, LDQ*(M+1)*sizeof(GIdouble));
+		H[c] = (GIdouble*)GI_MALLOC_ALIGNED(
+			((M*(M+1))/2)*sizeof(GIdouble), sizeof(GIdouble));
+		cs[c] = (GIdouble*)GI_MALLOC_ALIGNED(M*sizeof(GIdouble), sizeof(GIdouble));
+		sn[c] = (GIdouble*)GI_MALLOC_ALIGNED(M*sizeof(GIdouble), sizeof(GIdouble));
+		y[c] = (GIdouble*)GI_MALLOC_ALIGNED((M+1)*sizeof(GIdouble), sizeof(GIdouble));
+		xc[c] = (GIdouble*)GI_MALLOC_ALIGNED(
+			GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+		dcopy(N, x+c, 2, xc[c], 1);
+	}
+	if(pc)
 	{
-		for(i=N-1,ij=mat->nnz-2; i>0; --i,--ij)
-		{
-			register GIdouble temp = dOmega * (y[i]/=pDiag[i]);
-			for(; ij>=mat->ptr[i]; --ij)
-				y[mat->idx[ij]] -= mat->values[ij] * temp;
-		}
-		y[0] /= mat->values[0];
+		w = (GIdouble*)GI_MALLOC_ALIGNED(
+			GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+		pc(A, b, w);
+		ddot2(N, w, w, nb);
 	}
 	else
+		ddot2(N, b, b, nb);
+	for(c=0; c<2; ++c)
+		tol[c] = eps * eps * nb[c];
+
+	/* advance both systems by one matrix application at a time */
+	while(active[0] || active[1])
 	{
-		for(i=N-1; i>=0; --i)
+		/* residual of restarting systems, next Krylov vector of others */
+		for(c=0; c<2; ++c)
+			if(active[c])
+				dcopy(N, restart[c] ? xc[c] : (Q[c]+j[c]*LDQ), 1, z+c, 2);
+		ax(A, z, r);
+		for(c=0; c<2; ++c)
+			if(active[c] && restart[c])
+				daxpy(N, -1.0, b+c, 2, r+c, 2);
+		if(pc)
+			pc(A, r, w);
+
+		for(c=0; c<2; ++c)
 		{
-			register GIdouble temp = 0.0;
-			for(ij=mat->ptr[i+1]-1; mat->idx[ij]>i; --ij)
-				temp += mat->values[ij] * y[mat->idx[ij]];
-			y[i] = (y[i]-dOmega*temp) / mat->values[ij];
+			GIdouble *qj1, *h = H[c];
+			if(!active[c])
+				continue;
+			bFinished = GI_FALSE;
+			if(restart[c])
+			{
+				/* inner initialization */
+				dcopy(N, w+c, 2, Q[c], 1);
+				y[c][0] = beta = dnrm2(N, Q[c], 1);
+				res[c] = beta * beta;
+				dscal(N, 1.0/beta, Q[c], 1);
+				Hij[c] = j[c] = 0;
+				restart[c] = GI_FALSE;
+				bFinished = (M == 0);
+			}
+			else
+			{
+				/* orthogonalize q[j+1] */
+				n = j[c];
+				qj1 = Q[c] + (n+1)*LDQ;
+				dcopy(N, w+c, 2, qj1, 1);
+				dgemv('T', N, n+1, 1.0, Q[c], LDQ, qj1, 1, 0.0, h+Hij[c], 1);
+				beta = dorth(N, n+1, Q[c], LDQ, h+Hij[c], qj1);
+
+				/* rotate new H-column */
+				for(k=0; k<n; ++k,++Hij[c])
+				{
+					tmp = cs[c][k]*h[Hij[c]] - sn[c][k]*h[Hij[c]+1];
+					h[Hij[c]+1] = sn[c][k]*h[Hij[c]] + cs[c][k]*h[Hij[c]+1];
+					h[Hij[c]] = tmp;
+				}
+
+				/* compute new rotation */
+				hjj = h[Hij[c]];
+				tmp = sqrt(hjj*hjj+beta*beta);
+				cs[c][n] = hjj / tmp;
+				sn[c][n] = -beta / tmp;
+				h[Hij[c]++] = tmp;
+
+				/* rotate right hand side and normalize q[j+1] if needed further */
+				y[c][n+1] = sn[c][n] * y[c][n];
+				y[c][n] = cs[c][n] * y[c][n];
+				res[c] = y[c][n+1] * y[c][n+1];
+				if(fabs(y[c][n+1]) <= tol[c])
+					bFinished = GI_TRUE;
+				else
+				{
+					dscal(N, 1.0/beta, qj1, 1);
+					bFinished = (n+1 == M);
+				}
+				j[c] = n + 1;
+			}
+
+			/* backward-eliminate for y, compute x and check for restart */
+			if(bFinished)
+			{
+				dtpsv('U', 'N', 'N', j[c], h, y[c], 1);
+				dgemv('N', N, j[c], -1.0, Q[c], LDQ, y[c], 1, 1.0, xc[c], 1);
+				++i[c];
+				if(fabs(y[c][j[c]]) > tol[c] && i[c] < max_iter)
+					restart[c] = GI_TRUE;
+				else
+				{
+					iterations[c] = (fabs(y[c][j[c]]) > tol[c]) ? 
+						max_iter*M+1 : (i[c]-1)*M + j[c];
+					active[c] = GI_FALSE;
+				}
+			}
 		}
+		if(monitor)
+			report_residuals(monitor, ++p, res, nb);
 	}
-}
 
-/** \internal
- *  \brief Apply IC/ILU preconditioner with compressed matrix.
- *  \param A system matrix
- *  \param x vector to multiply preconditioning matrix with
- *  \param y vector to store result
- *  \ingroup numerics
- */
-void GISparseMatrixCSR_pc_ilu(const GISparseMatrix *A, const GIdouble *x, GIdouble *y)
-{
-	incomplete_lu((const GISparseMatrixCSR*)A, 
-		(const GIdouble*)((const GIuint*)A->data+1), x, y);
+	/* copy back and clean up */
+	for(c=0; c<2; ++c)
+	{
+		dcopy(N, xc[c], 1, x+c, 2);
+		GI_FREE_ALIGNED(Q[c]);
+		GI_FREE_ALIGNED(H[c]);
+		GI_FREE_ALIGNED(cs[c]);
+		GI_FREE_ALIGNED(sn[c]);
+		GI_FREE_ALIGNED(y[c]);
+		GI_FREE_ALIGNED(xc[c]);
+	}
+	GI_FREE_ALIGNED(z);
+	GI_FREE_ALIGNED(r);
+	if(pc)
+		GI_FREE_ALIGNED(w);
+	return GI_MAX(iterations[0], iterations[1]);
 }
 
 /** \internal
- *  \brief Solve equation system by conjugate gradient method.
+ *  \brief Solve equation system for two right hand sides by conjugate gradient method in single precision.
+ *  \details This follows the same recurrences as GISolver_cg2 with single
+ *  precision vectors, matrix and preconditioner. Only the dot products are
+ *  accumulated in double precision.
  *  \param A system matrix
- *  \param b right hand side vector
- *  \param x vector of unknowns
- *  \param ax matrix-vector-multiplication function
- *  \param pc preconditioning function or NULL if no preconditioning
+ *  \param b two interleaved right hand side vectors
+ *  \param x two interleaved vectors of unknowns
+ *  \param ax single precision matrix-vector-multiplication function for two interleaved vectors
+ *  \param pc single precision preconditioning function for two interleaved vectors or NULL if no preconditioning
  *  \param eps error threshold
  *  \param max_iter maximum number of iterations
- *  \return number of used iterations
+ *  \param iterations array to store number of used iterations for both systems
+ *  \return maximum number of used iterations
  *  \ingroup numerics
  */
-GIuint GISolver_cg(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
-				   GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter)
+GIuint GISolver_cg2f(const GISparseMatrix *A, const GIfloat *b, GIfloat *x,
+					 GImvfuncf ax, GImvfuncf pc, GIdouble eps, GIuint max_iter,
+					 GIuint *iterations)
 {
 	GIuint N = A->n;
-	GIdouble *r = (GIdouble*)GI_MALLOC_ALIGNED(
-		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-	GIdouble *q = (GIdouble*)GI_MALLOC_ALIGNED(
-		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-	GIdouble *v = (GIdouble*)GI_MALLOC_ALIGNED(
-		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-	GIdouble *w = (pc ? v : r);
-	GIdouble alpha, beta, gamma, tol = eps * eps * ddot(N, b, 1, b, 1);
-	GIuint i = 0;
+	GIfloat *r = (GIfloat*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
+	GIfloat *q = (GIfloat*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
+	GIfloat *v = (GIfloat*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
+	GIfloat *w = (pc ? v : r);
+	GIdouble alpha[2], beta[2], gamma[2], tol[2], temp[2], nb[2];
+	GIboolean active[2] = { GI_TRUE, GI_TRUE };
+	GIuint i = 0, c;
 
 	/* initialize */
+	sdot2(N, b, b, nb);
+	for(c=0; c<2; ++c)
+		tol[c] = eps * eps * nb[c];
 	ax(A, x, r);
-	daxpy(N, -1.0, b, 1, r, 1);
+	for(c=0; c<2*N; ++c)
+		r[c] -= b[c];
 	if(pc)
 		pc(A, r, w);
-	dcopy(N, w, 1, q, 1);
-	gamma = ddot(N, r, 1, w, 1);
+	memcpy(q, w, 2*N*sizeof(GIfloat));
+	sdot2(N, r, w, gamma);
 
 	/* iterate */
 	for(i=1; i<=max_iter; ++i)
 	{
 		ax(A, q, v);
-		alpha = -gamma / ddot(N, v, 1, q, 1);
-		daxpy(N, alpha, q, 1, x, 1);
-		daxpy(N, alpha, v, 1, r, 1);
+		sdot2(N, v, q, temp);
+		for(c=0; c<2; ++c)
+			alpha[c] = -gamma[c] / temp[c];
+		saxpy2_nrm2(N, alpha, active, q, x, v, r, temp);
 		if(pc)
 			pc(A, r, w);
-		beta = 1.0 / gamma;
+		for(c=0; c<2; ++c)
+			beta[c] = 1.0 / gamma[c];
 		if(pc)
 		{
-			if(ddot(N, r, 1, r, 1) <= tol)
-				break;
-			gamma = ddot(N, r, 1, w, 1);
+			for(c=0; c<2; ++c)
+			{
+				if(active[c] && temp[c] <= tol[c])
+				{
+					iterations[c] = i;
+					active[c] = GI_FALSE;
+				}
+			}
+			sdot2(N, r, w, gamma);
 		}
 		else
 		{
-			gamma = ddot(N, r, 1, r, 1);
-			if(gamma <= tol)
-				break;
+			for(c=0; c<2; ++c)
+			{
+				gamma[c] = temp[c];
+				if(active[c] && gamma[c] <= tol[c])
+				{
+					iterations[c] = i;
+					active[c] = GI_FALSE;
+				}
+			}
 		}
-		beta *= gamma;
-		dscal(N, beta, q, 1);
-		daxpy(N, 1.0, w, 1, q, 1);
+		if(!active[0] && !active[1])
+			break;
+		for(c=0; c<2; ++c)
+			beta[c] *= gamma[c];
+		sxpay2(N, NULL, beta, active, w, NULL, q);
 	}
+	for(c=0; c<2; ++c)
+		if(active[c])
+			iterations[c] = i;
 
 	/* clean up */
 	GI_FREE_ALIGNED(r);
 	GI_FREE_ALIGNED(q);
 	GI_FREE_ALIGNED(v);
-	return i;
+	return GI_MAX(iterations[0], iterations[1]);
 }
 
 /** \internal
- *  \brief Solve equation system by stabilized biconjugate gradient method.
+ *  \brief Solve equation system for two right hand sides by stabilized biconjugate gradient method in single precision.
+ *  \details This follows the same recurrences as GISolver_bicgstab2 with
+ *  single precision vectors, matrix and preconditioner. Only the dot products
+ *  are accumulated in double precision.
  *  \param A system matrix
- *  \param b right hand side vector
- *  \param x vector of unknowns
- *  \param ax matrix-vector-multiplication function
- *  \param pc preconditioning function or NULL if no preconditioning
+ *  \param b two interleaved right hand side vectors
+ *  \param x two interleaved vectors of unknowns
+ *  \param ax single precision matrix-vector-multiplication function for two interleaved vectors
+ *  \param pc single precision preconditioning function for two interleaved vectors or NULL if no preconditioning
  *  \param eps error threshold
  *  \param max_iter maximum number of iterations
- *  \return number of used iterations
+ *  \param iterations array to store number of used iterations for both systems
+ *  \return maximum number of used iterations
  *  \ingroup numerics
  */
-GIuint GISolver_bicgstab(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
-						 GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter)
+GIuint GISolver_bicgstab2f(const GISparseMatrix *A, const GIfloat *b, GIfloat *x,
+						   GImvfuncf ax, GImvfuncf pc, GIdouble eps, GIuint max_iter,
+						   GIuint *iterations)
 {
 	GIuint N = A->n;
-	GIdouble *r = (GIdouble*)GI_MALLOC_ALIGNED(
-		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-	GIdouble *r0 = (GIdouble*)GI_MALLOC_ALIGNED(
-		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-	GIdouble *q = (GIdouble*)GI_MALLOC_ALIGNED(
-		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-	GIdouble *v = (GIdouble*)GI_MALLOC_ALIGNED(
-		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-	GIdouble *t = (GIdouble*)GI_MALLOC_ALIGNED(
-		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-	GIdouble *s = r, *tP = t, *rP = r, *sP = r, *vP = v;
-	GIdouble alpha, beta, gamma, omega, tol = eps * eps * ddot(N, b, 1, b, 1);
-	GIuint i = 0;
+	GIfloat *r = (GIfloat*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
+	GIfloat *r0 = (GIfloat*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
+	GIfloat *q = (GIfloat*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
+	GIfloat *v = (GIfloat*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
+	GIfloat *t = (GIfloat*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
+	GIfloat *s = r, *tP = t, *rP = r, *sP = r, *vP = v;
+	GIdouble alpha[2], beta[2], gamma[2], omega[2], tol[2], temp[2], temp2[2], nb[2];
+	GIboolean active[2] = { GI_TRUE, GI_TRUE };
+	GIuint i = 0, c;
 
 	/* initialize */
+	sdot2(N, b, b, nb);
+	for(c=0; c<2; ++c)
+		tol[c] = eps * eps * nb[c];
 	ax(A, x, r);
-	daxpy(N, -1.0, b, 1, r, 1);
+	for(c=0; c<2*N; ++c)
+		r[c] -= b[c];
 	if(pc)
 	{
-		vP = (GIdouble*)GI_MALLOC_ALIGNED(
-			GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-		sP = rP = (GIdouble*)GI_MALLOC_ALIGNED(
-			GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+		vP = (GIfloat*)GI_MALLOC_ALIGNED(
+			GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
+		sP = rP = (GIfloat*)GI_MALLOC_ALIGNED(
+			GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
 		tP = v;
 		pc(A, r, rP);
 	}
-	dcopy(N, rP, 1, q, 1);
-	dcopy(N, rP, 1, r0, 1);
-	gamma = ddot(N, rP, 1, r0, 1);
+	memcpy(q, rP, 2*N*sizeof(GIfloat));
+	memcpy(r0, rP, 2*N*sizeof(GIfloat));
+	sdot2(N, rP, r0, gamma);
 
 	/* iterate */
 	for(i=1; i<=max_iter; ++i)
@@ -1536,30 +4951,53 @@ GIuint GISolver_bicgstab(const GISparseMatrix *A, const GIdouble *b, GIdouble *x
 		ax(A, q, v);
 		if(pc)
 			pc(A, v, vP);
-		alpha = gamma / ddot(N, vP, 1, r0, 1);
-		daxpy(N, -alpha, q, 1, x, 1);
-		daxpy(N, -alpha, v, 1, s, 1);
-		if(ddot(N, r, 1, r, 1) <= tol)
+		sdot2(N, vP, r0, temp);
+		for(c=0; c<2; ++c)
+			alpha[c] = gamma[c] / temp[c];
+		for(c=0; c<2; ++c)
+			temp[c] = -alpha[c];
+		saxpy2_nrm2(N, temp, active, q, x, v, s, temp2);
+		for(c=0; c<2; ++c)
+		{
+			if(active[c] && temp2[c] <= tol[c])
+			{
+				iterations[c] = i;
+				active[c] = GI_FALSE;
+			}
+		}
+		if(!active[0] && !active[1])
 			break;
 		if(pc)
-			daxpy(N, -alpha, vP, 1, sP, 1);
+			saxpy2(N, temp, active, vP, sP);
 		ax(A, sP, t);
 		if(pc)
 			pc(A, t, tP);
-		omega = ddot(N, tP, 1, sP, 1) / ddot(N, tP, 1, tP, 1);
-		daxpy(N, -omega, sP, 1, x, 1);
-		daxpy(N, -omega, t, 1, r, 1);
-		if(ddot(N, r, 1, r, 1) <= tol)
+		sdot2_nrm2(N, tP, sP, temp, temp2);
+		for(c=0; c<2; ++c)
+			omega[c] = -temp[c] / temp2[c];
+		saxpy2_nrm2(N, omega, active, sP, x, t, r, temp2);
+		for(c=0; c<2; ++c)
+		{
+			if(active[c] && temp2[c] <= tol[c])
+			{
+				iterations[c] = i;
+				active[c] = GI_FALSE;
+			}
+		}
+		if(!active[0] && !active[1])
 			break;
 		if(pc)
-			daxpy(N, -omega, tP, 1, rP, 1);
-		beta = alpha / (omega*gamma);
-		gamma = ddot(N, rP, 1, r0, 1);
-		beta *= gamma;
-		daxpy(N, -omega, vP, 1, q, 1);
-		dscal(N, beta, q, 1);
-		daxpy(N, 1.0, rP, 1, q, 1);
+			saxpy2(N, omega, active, tP, rP);
+		for(c=0; c<2; ++c)
+			beta[c] = alpha[c] / (-omega[c]*gamma[c]);
+		sdot2(N, rP, r0, gamma);
+		for(c=0; c<2; ++c)
+			beta[c] *= gamma[c];
+		sxpay2(N, omega, beta, active, rP, vP, q);
 	}
+	for(c=0; c<2; ++c)
+		if(active[c])
+			iterations[c] = i;
 
 	/* clean up */
 	GI_FREE_ALIGNED(r);
@@ -1572,127 +5010,114 @@ GIuint GISolver_bicgstab(const GISparseMatrix *A, const GIdouble *b, GIdouble *x
 		GI_FREE_ALIGNED(vP);
 		GI_FREE_ALIGNED(rP);
 	}
-	return i;
+	return GI_MAX(iterations[0], iterations[1]);
 }
 
 /** \internal
- *  \brief Solve equation system by generalized minimized residual method.
- *  \param A system matrix
- *  \param b right hand side vector
- *  \param x vector of unknowns
- *  \param ax matrix-vector-multiplication function
- *  \param pc preconditioning function or NULL if no preconditioning
+ *  \brief Solve equation system for two right hand sides by mixed precision iterative refinement.
+ *  \details The residuals are computed in double precision, normalized and
+ *  rounded to single precision. The corrections are solved for with a single
+ *  precision solver on the matrix scaled by GISparseMatrixCSR_prepare_float
+ *  up to a relative accuracy derived from the residual reduction still
+ *  needed, but at least GI_REFINEMENT_EPS. The Krylov vectors, the matrix
+ *  values and the preconditioner take half the memory traffic, which pays
+ *  off for systems exceeding the caches, while the corrections need some
+ *  more iterations in total than a double precision solve. This is repeated
+ *  until both residuals meet the error threshold or GI_REFINEMENT_MAX_STEPS
+ *  corrections have been applied.
+ *  \param A compressed system matrix prepared by GISparseMatrixCSR_prepare_float
+ *  \param b two interleaved right hand side vectors
+ *  \param x two interleaved vectors of unknowns
+ *  \param solver single precision solver for corrections
+ *  \param ax double precision matrix-vector-multiplication function for two interleaved vectors
+ *  \param axf single precision matrix-vector-multiplication function for two interleaved vectors
+ *  \param pc single precision preconditioning function for two interleaved vectors or NULL
  *  \param eps error threshold
- *  \param max_iter maximum number of iterations
- *  \return number of used iterations
+ *  \param max_iter maximum number of iterations of every correction
+ *  \param iterations array to store total number of solver iterations for both systems
+ *  \param monitor convergence monitor or NULL (called for double precision
+ *  residuals with total number of iterations)
+ *  \retval GI_TRUE if both systems converged
+ *  \retval GI_FALSE if refinement did not converge
  *  \ingroup numerics
  */
-GIuint GISolver_gmres(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
-					  GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter)
+GIboolean GISolver_refine2(const GISparseMatrix *A, const GIdouble *b, GIdouble *x,
+						   GIsolver2ffunc solver, GImvfunc ax, GImvfuncf axf, GImvfuncf pc,
+						   GIdouble eps, GIuint max_iter, GIuint *iterations,
+						   const GISolverMonitor *monitor)
 {
-	GIuint N = A->n, M = max_iter & 0xFF;
-#if OPENGI_SSE >= 2
-	GIuint LDQ = (N+1) & (~1);
-#else
-	GIuint LDQ = N;
-#endif
-	GIdouble *Q = (GIdouble*)GI_MALLOC_ALIGNED(
-		GI_SSE_SIZE(LDQ*(M+1)*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-	GIdouble *H = (GIdouble*)GI_MALLOC_ALIGNED(
-		((M*(M+1))/2)*sizeof(GIdouble), sizeof(GIdouble));
+	GIuint N = A->n;
 	GIdouble *r = (GIdouble*)GI_MALLOC_ALIGNED(
-		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-	GIdouble *c = (GIdouble*)GI_MALLOC_ALIGNED(M*sizeof(GIdouble), sizeof(GIdouble));
-	GIdouble *s = (GIdouble*)GI_MALLOC_ALIGNED(M*sizeof(GIdouble), sizeof(GIdouble));
-	GIdouble *y = (GIdouble*)GI_MALLOC_ALIGNED((M+1)*sizeof(GIdouble), sizeof(GIdouble));
-	GIdouble *w = r;
-	GIdouble beta, tol, tmp, hjj;
-	GIuint i = 0, j, k, Hij;
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIfloat *rf = (GIfloat*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
+	GIfloat *d = (GIfloat*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
+	GIdouble tol[2], temp[2], nb[2], scale[2], dEps;
+	GIdouble dMatScale = ((const GISparseMatrixCSR*)A)->fscale;
+	GIuint uiIter[2], i, j, c;
+	GIboolean bConverged = GI_FALSE;
 
-	/* outer initialization */
-	max_iter >>= 8;
-	if(pc)
+	/* initialize */
+	ddot2(N, b, b, nb);
+	for(c=0; c<2; ++c)
 	{
-		w = (GIdouble*)GI_MALLOC_ALIGNED(
-			GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
-		pc(A, b, w);
-		tol = eps * eps * ddot(N, w, 1, w, 1);
+		tol[c] = eps * eps * nb[c];
+		iterations[c] = 0;
 	}
-	else
-		tol = eps * eps * ddot(N, b, 1, b, 1);
 
-	/* outer iteration */
-	do
+	/* correct by solutions for double precision residuals */
+	for(i=0; i<=GI_REFINEMENT_MAX_STEPS; ++i)
 	{
-		/* inner initialization */
 		ax(A, x, r);
-		daxpy(N, -1.0, b, 1, r, 1);
-		if(pc)
-			pc(A, r, w);
-		y[0] = beta = dnrm2(N, w, 1);
-		dcopy(N, w, 1, Q, 1);
-		dscal(N, 1.0/beta, Q, 1);
-		Hij = 0;
-
-		/* inner iteration */
-		for(j=0; j<M; ++j)
+		for(c=0; c<2*N; ++c)
+			r[c] = b[c] - r[c];
+		ddot2(N, r, r, temp);
+		if(monitor)
+			report_residuals(monitor, GI_MAX(iterations[0], iterations[1]), temp, nb);
+		if(temp[0] <= tol[0] && temp[1] <= tol[1])
 		{
-			GIdouble *qj = Q + j*LDQ, *qj1 = Q + (j+1)*LDQ;
-
-			/* compute and orthogonalize q[j+1] */
-			if(pc)
-			{
-				ax(A, qj, w);
-				pc(A, w, qj1);
-			}
-			else
-				ax(A, qj, qj1);
-			dgemv('T', N, j+1, 1.0, Q, LDQ, qj1, 1, 0.0, H+Hij, 1);
-			dgemv('N', N, j+1, -1.0, Q, LDQ, H+Hij, 1, 1.0, qj1, 1);
-			beta = dnrm2(N, qj1, 1);
-
-			/* rotate new H-column */
-			for(k=0; k<j; ++k,++Hij)
-			{
-				tmp = c[k]*H[Hij] - s[k]*H[Hij+1];
-				H[Hij+1] = s[k]*H[Hij] + c[k]*H[Hij+1];
-				H[Hij] = tmp;
-			}
+			bConverged = GI_TRUE;
+			break;
+		}
+		if(i == GI_REFINEMENT_MAX_STEPS)
+			break;
 
-			/* compute new rotation */
-			hjj = H[Hij];
-			tmp = sqrt(hjj*hjj+beta*beta);
-			c[j] = hjj / tmp;
-			s[j] = -beta / tmp;
-			H[Hij++] = tmp;
+		/* normalize residuals to keep them in single precision range */
+		dEps = 0.5;
+		for(c=0; c<2; ++c)
+		{
+			scale[c] = (temp[c] > 0.0) ? 1.0/sqrt(temp[c]) : 1.0;
+			if(temp[c] > tol[c])
+				dEps = GI_MIN(dEps, GI_REFINEMENT_FACTOR*sqrt(tol[c]/temp[c]));
+		}
+		for(j=0; j<N; ++j)
+		{
+			rf[j<<1] = (GIfloat)(r[j<<1]*scale[0]);
+			rf[(j<<1)+1] = (GIfloat)(r[(j<<1)+1]*scale[1]);
+		}
+		memset(d, 0, 2*N*sizeof(GIfloat));
+		solver(A, rf, d, axf, pc, GI_MAX(dEps, GI_REFINEMENT_EPS), max_iter, uiIter);
 
-			/* rotate right hand side and normalize q[j+1] if needed further */
-			y[j+1] = s[j] * y[j];
-			y[j] = c[j] * y[j];
-			if(fabs(y[j+1]) <= tol)
+		/* undo scaling of matrix and residuals */
+		for(c=0; c<2; ++c)
+		{
+			/* converged systems may have broken down on zero residuals */
+			if(temp[c] > tol[c])
 			{
-				++j;
-				break;
+				GIdouble dScale = dMatScale / scale[c];
+				for(j=c; j<2*N; j+=2)
+					x[j] += dScale * d[j];
+				iterations[c] += uiIter[c];
 			}
-			dscal(N, 1.0/beta, qj1, 1);
 		}
-
-		/* backward-eliminate for y and compute x */
-		dtpsv('U', 'N', 'N', j, H, y, 1);
-		dgemv('N', N, j, -1.0, Q, LDQ, y, 1, 1.0, x, 1);
-		++i;
-	}while(fabs(y[j]) > tol && i < max_iter);
+	}
 
 	/* clean up */
-	GI_FREE_ALIGNED(Q);
-	GI_FREE_ALIGNED(H);
 	GI_FREE_ALIGNED(r);
-	GI_FREE_ALIGNED(c);
-	GI_FREE_ALIGNED(s);
-	GI_FREE_ALIGNED(y);
-	if(pc)
-		GI_FREE_ALIGNED(w);
-	return (i-1)*M + j;
+	GI_FREE_ALIGNED(rf);
+	GI_FREE_ALIGNED(d);
+	return bConverged;
 }
 
 /** \internal
@@ -43,26 +43,51 @@
 /*************************************************************************/
 /* Typedefs */
 
-/* forward declaration */
-//typedef struct _GISparseMatrix GISparseMatrix;
+/* forward declarations */
+typedef struct _GISparseMatrix GISparseMatrix;
+typedef struct _GISolverMonitor GISolverMonitor;
 
 /** \internal
  *  \brief Matrix-vector multiplication function
  *  \ingroup numerics
  */
-typedef void (*GImvfunc)(const struct _GISparseMatrix*, const GIdouble*, GIdouble*);
+typedef void (*GImvfunc)(const GISparseMatrix*, const GIdouble*, GIdouble*);
+
+/** \internal
+ *  \brief Single precision matrix-vector multiplication function
+ *  \ingroup numerics
+ */
+typedef void (*GImvfuncf)(const GISparseMatrix*, const GIfloat*, GIfloat*);
 
 /** \internal
  *  \brief Matrix manipulation function
  *  \ingroup numerics
  */
-typedef void (*GImfunc)(struct _GISparseMatrix*);
+typedef void (*GImfunc)(GISparseMatrix*);
 
 /** \internal
  *  \brief Iterative solving function
  *  \ingroup numerics
  */
-typedef GIuint (*GIsolverfunc)(const struct _GISparseMatrix*, const GIdouble*, GIdouble*, GImvfunc, GImvfunc, GIdouble, GIuint);
+typedef GIuint (*GIsolverfunc)(const GISparseMatrix*, const GIdouble*, GIdouble*, GImvfunc, GImvfunc, GIdouble, GIuint);
+
+/** \internal
+ *  \brief Iterative solving function for two interleaved right hand sides
+ *  \ingroup numerics
+ */
+typedef GIuint (*GIsolver2func)(const GISparseMatrix*, const GIdouble*, GIdouble*, GImvfunc, GImvfunc, GIdouble, GIuint, GIuint*, const GISolverMonitor*);
+
+/** \internal
+ *  \brief Single precision iterative solving function for two interleaved right hand sides
+ *  \ingroup numerics
+ */
+typedef GIuint (*GIsolver2ffunc)(const GISparseMatrix*, const GIfloat*, GIfloat*, GImvfuncf, GImvfuncf, GIdouble, GIuint, GIuint*);
+
+/** \internal
+ *  \brief Convergence report function taking iteration and relative residuals of two systems
+ *  \ingroup numerics
+ */
+typedef void (*GImonitorfunc)(GIvoid*, GIuint, const GIdouble*);
 
 
 /*************************************************************************/
@@ -91,17 +116,28 @@ typedef struct _GISparseVector
 	GIVectorElement	*elements;					/**< Vector elements. */
 } GISparseVector;
 
+/** \internal
+ *  \brief Convergence monitor.
+ *  \details This structure receives the residuals of iterative solvers after every iteration.
+ *  \ingroup numerics
+ */
+struct _GISolverMonitor
+{
+	GImonitorfunc	report;						/**< Function to report residuals to. */
+	GIvoid			*data;						/**< Data passed to report function. */
+};
+
 /** \internal
  *  \brief Square matrix.
  *  \details This structure represents the base class for square matrices.
  *  \ingroup numerics
  */
-typedef struct _GISparseMatrix
+struct _GISparseMatrix
 {
 	GIuint		n;								/**< Size of matrix. */
 	GIboolean	symmetric;						/**< Symmetric matrix. */
 	GIvoid		*data;							/**< Custom data (used by preconditioners). */
-} GISparseMatrix;
+};
 
 /** \internal
  *  \brief Dynamic sparse matrix.
@@ -116,6 +152,22 @@ typedef struct _GISparseMatrixLIL
 	GISparseVector	*rows;						/**< Rows of matrix. */
 } GISparseMatrixLIL;
 
+/** \internal
+ *  \brief Level schedule of triangular solves.
+ *  \details Rows of a level only depend on rows of previous levels and can 
+ *  therefore be eliminated in parallel.
+ *  \ingroup numerics
+ */
+typedef struct _GILevelSchedule
+{
+	GIuint		levels[2];						/**< Number of levels of forward and backward elimination. */
+	GIuint		*level_ptr[2];					/**< Start indices of levels into rows. */
+	GIuint		*rows[2];						/**< Rows sorted by level. */
+	GIuint		*upper_ptr;						/**< Start indices of columns of lower triangle (symmetric only). */
+	GIuint		*upper_idx;						/**< Indices of column elements by decreasing row (symmetric only). */
+	GIuint		*upper_row;						/**< Rows of column elements (symmetric only). */
+} GILevelSchedule;
+
 /** \internal
  *  \brief Compressed sparse matrix.
  *  \details This structure represents a sparse matrix in CSR format.
@@ -130,6 +182,17 @@ typedef struct _GISparseMatrixCSR
 	GIdouble	*values;						/**< Non-zero elements. */
 	GIuint		*idx;							/**< Column indices. */
 	GIuint		*ptr;							/**< Start indices of rows. */
+	GIuint		blocks;							/**< Number of row blocks for parallel multiplication. */
+	GIuint		*block_ptr;						/**< Start rows of row blocks. */
+	struct _GISparseMatrixCSR	*full;			/**< Fully stored copy of symmetric matrix for parallel multiplication. */
+	GIuint		*full_map;						/**< Indices of elements of full copy into values. */
+	GIuint		*ilu_ptr;						/**< Start indices of update pairs of elements for IC/ILU factorization. */
+	GIuint		*ilu_pairs;						/**< Index pairs of updates for IC/ILU factorization. */
+	GILevelSchedule	*ilu_schedule;				/**< Level schedule of IC/ILU preconditioner for parallel application. */
+	struct _GIMultigrid	*amg;					/**< Algebraic multigrid hierarchy (used by preconditioner). */
+	GIfloat		*fvalues;						/**< Single precision copy of values (mixed precision). */
+	GIfloat		*filu;							/**< Single precision copy of IC/ILU factors (mixed precision). */
+	GIdouble	fscale;							/**< Power of two the single precision copies are scaled with. */
 } GISparseMatrixCSR;
 
 /** \internal
@@ -148,6 +211,60 @@ typedef struct _GISparseMatrixBCSR2
 	GIuint		*ptr;							/**< Start indices of rows. */
 } GISparseMatrixBCSR2;
 
+/** \internal
+ *  \brief Sparse LDL^T factorization.
+ *  \details This structure represents the LDL^T factorization of a symmetric 
+ *  compressed matrix in nested dissection order, with L stored column-wise.
+ *  \ingroup numerics
+ */
+typedef struct _GISparseLDL
+{
+	GIuint		n;								/**< Number of rows/columns. */
+	GIuint		nnz;							/**< Number of non-zero elements of L below diagonal. */
+	GIuint		*perm;							/**< Old indices of permuted rows/columns. */
+	GIuint		*iperm;							/**< Permuted indices of old rows/columns. */
+	GIuint		*parent;						/**< Elimination tree. */
+	GIuint		*aptr;							/**< Start indices of rows of permuted lower triangle. */
+	GIuint		*aidx;							/**< Column indices of permuted lower triangle. */
+	GIuint		*amap;							/**< Indices of permuted lower triangle into matrix values. */
+	GIuint		*lptr;							/**< Start indices of columns of L. */
+	GIuint		*lidx;							/**< Row indices of L. */
+	GIdouble	*lvalues;						/**< Non-zero elements of L below diagonal. */
+	GIdouble	*diag;							/**< Diagonal matrix D. */
+} GISparseLDL;
+
+/** \internal
+ *  \brief Level of algebraic multigrid hierarchy.
+ *  \ingroup numerics
+ */
+typedef struct _GIMultigridLevel
+{
+	GISparseMatrixCSR	*A;						/**< Fully stored matrix of level. */
+	GISparseMatrixCSR	P;						/**< Prolongation from next coarser level. */
+	GISparseMatrixCSR	R;						/**< Restriction to next coarser level. */
+	GISparseMatrixCSR	AP;						/**< Product of matrix and prolongation. */
+	GIuint				*agg;					/**< Aggregates of unknowns. */
+	GIdouble			*inv_diag;				/**< Inverted diagonal of matrix. */
+	GIdouble			*b;						/**< Right hand side on level. */
+	GIdouble			*x;						/**< Solution on level. */
+	GIdouble			*r;						/**< Residual on level. */
+} GIMultigridLevel;
+
+/** \internal
+ *  \brief Algebraic multigrid hierarchy.
+ *  \details This structure represents a smoothed aggregation hierarchy 
+ *  with a direct solver on the coarsest level.
+ *  \ingroup numerics
+ */
+typedef struct _GIMultigrid
+{
+	GIuint				levels;					/**< Number of levels. */
+	GIMultigridLevel	*level;					/**< Levels from finest to coarsest. */
+	GISparseLDL			coarse;					/**< Factorization of coarsest matrix. */
+	GISparseMatrixCSR	lower;					/**< Lower triangle of coarsest matrix. */
+	GIuint				*map;					/**< Indices of elements of finest matrix into values. */
+} GIMultigrid;
+
 
 /*************************************************************************/
 /* Functions */
@@ -183,9 +300,17 @@ void GISparseMatrixLIL_ax(const GISparseMatrix *A, const GIdouble *x, GIdouble *
  *  \{
  */
 void GISparseMatrixCSR_construct(GISparseMatrixCSR *mat, const GISparseMatrixLIL *src);
+void GISparseMatrixCSR_construct_rows(GISparseMatrixCSR *mat, GIuint n, GIboolean symmetric, GIuint *sizes);
+void GISparseMatrixCSR_append(GISparseMatrixCSR *mat, GIuint *sizes, GIuint i, GIuint j, GIdouble value);
+void GISparseMatrixCSR_add(GISparseMatrixCSR *mat, GIuint *sizes, GIuint i, GIuint j, GIdouble value);
+void GISparseMatrixCSR_finish_rows(GISparseMatrixCSR *mat, const GIuint *sizes);
 void GISparseMatrixCSR_destruct(GISparseMatrixCSR *mat);
 void GISparseMatrixCSR_print(const GISparseMatrixCSR *mat, FILE *file);
 void GISparseMatrixCSR_ax(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
+void GISparseMatrixCSR_ax2(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
+void GISparseMatrixCSR_ax2f(const GISparseMatrix *A, const GIfloat *x, GIfloat *y);
+void GISparseMatrixCSR_prepare_parallel(GISparseMatrixCSR *mat, GIuint threads);
+void GISparseMatrixCSR_prepare_float(GISparseMatrixCSR *mat);
 /** \} */
 
 /** \name Block compressed matrix methods
@@ -197,6 +322,15 @@ void GISparseMatrixBCSR2_print(const GISparseMatrixBCSR2 *mat, FILE *file);
 void GISparseMatrixBCSR2_ax(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
 /** \} */
 
+/** \name Direct solver methods
+ *  \{
+ */
+void GISparseLDL_construct(GISparseLDL *ldl, const GISparseMatrixCSR *A);
+void GISparseLDL_destruct(GISparseLDL *ldl);
+GIboolean GISparseLDL_factorize(GISparseLDL *ldl, const GISparseMatrixCSR *A);
+void GISparseLDL_solve(const GISparseLDL *ldl, const GIdouble *b, GIdouble *x, GIuint columns);
+/** \} */
+
 /** \name Preconditioner preparation
  *  \{
  */
@@ -206,6 +340,7 @@ void GISparseMatrixLIL_prepare_ilu(GISparseMatrixLIL *mat);
 void GISparseMatrixCSR_prepare_jacobi(GISparseMatrixCSR *mat);
 void GISparseMatrixCSR_prepare_ssor(GISparseMatrixCSR *mat, GIdouble omega);
 void GISparseMatrixCSR_prepare_ilu(GISparseMatrixCSR *mat);
+void GISparseMatrixCSR_prepare_amg(GISparseMatrixCSR *mat);
 void GISparseMatrixBCSR2_prepare_jacobi(GISparseMatrixBCSR2 *mat);
 /** \} */
 
@@ -213,13 +348,21 @@ void GISparseMatrixBCSR2_prepare_jacobi(GISparseMatrixBCSR2 *mat);
  *  \{
  */
 void GISparseMatrix_pc_jacobi(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
+void GISparseMatrix_pc_jacobi2(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
 void GISparseMatrixLIL_pc_ssor(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
 void GISparseMatrixLIL_pc_ilu(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
 void GISparseMatrixCSR_pc_ssor(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
+void GISparseMatrixCSR_pc_ssor2(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
 void GISparseMatrixCSR_pc_ilu(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
+void GISparseMatrixCSR_pc_ilu2(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
+void GISparseMatrixCSR_pc_ilu2f(const GISparseMatrix *A, const GIfloat *x, GIfloat *y);
+void GISparseMatrixCSR_pc_jacobi2f(const GISparseMatrix *A, const GIfloat *x, GIfloat *y);
+void GISparseMatrixCSR_pc_amg(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
+void GISparseMatrixCSR_pc_amg2(const GISparseMatrix *A, const GIdouble *x, GIdouble *y);
 #define GISparseMatrixLIL_pc_jacobi		GISparseMatrix_pc_jacobi
 #define GISparseMatrixCSR_pc_jacobi		GISparseMatrix_pc_jacobi
 #define GISparseMatrixBCSR2_pc_jacobi	GISparseMatrix_pc_jacobi
+#define GISparseMatrixCSR_pc_jacobi2	GISparseMatrix_pc_jacobi2
 /** \} */
 
 /** \name Solvers
@@ -231,6 +374,22 @@ GIuint GISolver_bicgstab(const GISparseMatrix *A, const GIdouble *b, GIdouble *x
 	GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter);
 GIuint GISolver_gmres(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
 	GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter);
+GIuint GISolver_cg2(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
+	GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter, GIuint *iterations, 
+	const GISolverMonitor *monitor);
+GIuint GISolver_bicgstab2(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
+	GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter, GIuint *iterations, 
+	const GISolverMonitor *monitor);
+GIuint GISolver_gmres2(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
+	GImvfunc ax, GImvfunc pc, GIdouble eps, GIuint max_iter, GIuint *iterations, 
+	const GISolverMonitor *monitor);
+GIuint GISolver_cg2f(const GISparseMatrix *A, const GIfloat *b, GIfloat *x, 
+	GImvfuncf ax, GImvfuncf pc, GIdouble eps, GIuint max_iter, GIuint *iterations);
+GIuint GISolver_bicgstab2f(const GISparseMatrix *A, const GIfloat *b, GIfloat *x, 
+	GImvfuncf ax, GImvfuncf pc, GIdouble eps, GIuint max_iter, GIuint *iterations);
+GIboolean GISolver_refine2(const GISparseMatrix *A, const GIdouble *b, GIdouble *x, 
+	GIsolver2ffunc solver, GImvfunc ax, GImvfuncf axf, GImvfuncf pc, GIdouble eps, 
+	GIuint max_iter, GIuint *iterations, const GISolverMonitor *monitor);
 /** \} */
 
 /** \name Matrix methods
@@ -42,6 +42,11 @@
 
 #define GI_HALF_SQRT_3				0.8660254037844386
 
+/** \internal
+ *  \brief Minimum number of rows for parallel assembly of linear systems.
+ */
+#define GI_PARALLEL_ASSEMBLY_MIN_ROWS	4096
+
 
 /** \internal
  *  \brief Param rescue structure.
@@ -71,6 +76,24 @@ typedef struct _GILocalInfo
 	GIdouble	angle;								/**< Surface angle. */
 } GILocalInfo;
 
+/** \internal
+ *  \brief Data for computing rows of linear system.
+ */
+typedef struct _GIAssemblyData
+{
+	GIParameterizer		*parameterizer;		/**< Parameterizer to use. */
+	GIPatch				*patch;				/**< Patch to which system belongs. */
+	GIenum				type;				/**< Mapping type of system. */
+	GISparseMatrixCSR	*A;					/**< Matrix of coefficients. */
+	GISparseMatrixCSR	*B;					/**< Coefficients of right hand side or NULL. */
+	GIuint				*sizes;				/**< Current row sizes of A. */
+	GIuint				*bsizes;			/**< Current row sizes of B. */
+	GIdouble			*bU;				/**< Right hand side for U coordinate. */
+	GIdouble			*bV;				/**< Right hand side for V coordinate. */
+	GIParam				**params;			/**< Interior params by ID (parallel only). */
+	GIuint				tasks;				/**< Number of row blocks (parallel only). */
+} GIAssemblyData;
+
 
 /** \internal
  *  \brief Compare path pointers for qsort.
@@ -83,6 +106,21 @@ static int compare(const void *a, const void *b)
 	return ((GICutPath*)b)->glength - ((GICutPath*)a)->glength;
 }
 
+/** \internal
+ *  \brief Discard measurements of solver configurations.
+ *  \param par parameterizer to reset tuning of
+ *  \ingroup parameterization
+ */
+static void reset_tuning(GIParameterizer *par)
+{
+	GIuint i, j;
+
+	memset(par->tuning, 0, sizeof(par->tuning));
+	for(i=0; i<2; ++i)
+		for(j=0; j<GI_TUNING_SIZES; ++j)
+			par->tuning[i][j].choice = -1;
+}
+
 /** Set boolean configuration parameter of parameterization.
  *  \param pname state to set
  *  \param param value to set
@@ -95,6 +133,14 @@ void GIAPIENTRY giParameterizerParameterb(GIenum pname, GIboolean param)
 	/* select state and set value */
 	switch(pname)
 	{
+	case GI_WARM_START:
+		pPar->warm_start = param;
+		break;
+	case GI_AUTOTUNE_SOLVER:
+		if(param && !pPar->autotune)
+			reset_tuning(pPar);
+		pPar->autotune = param;
+		break;
 	default:
 		GIContext_error(pPar->context, GI_INVALID_ENUM);
 	}
@@ -163,6 +209,31 @@ void GIAPIENTRY giParameterizerParameteri(GIenum pname, GIint param)
 		else
 			GIContext_error(pPar->context, GI_INVALID_ENUM);
 		break;
+	case GI_SYMMETRIC_SOLVER:
+		if(param == GI_SOLVER_CG || param == GI_SOLVER_LDLT)
+			pPar->symmetric_solver = param;
+		else
+			GIContext_error(pPar->context, GI_INVALID_ENUM);
+		break;
+	case GI_PRECONDITIONER:
+		if(param == GI_PRECONDITIONER_ILU || param == GI_PRECONDITIONER_AMG || 
+			param == GI_PRECONDITIONER_JACOBI || param == GI_PRECONDITIONER_SSOR)
+			pPar->preconditioner = param;
+		else
+			GIContext_error(pPar->context, GI_INVALID_ENUM);
+		break;
+	case GI_PARAM_ORDERING:
+		if(param == GI_NONE || param == GI_ORDERING_RCM)
+			pPar->param_ordering = param;
+		else
+			GIContext_error(pPar->context, GI_INVALID_ENUM);
+		break;
+	case GI_SOLVER_PRECISION:
+		if(param == GI_DOUBLE || param == GI_FLOAT)
+			pPar->solver_precision = param;
+		else
+			GIContext_error(pPar->context, GI_INVALID_ENUM);
+		break;
 	case GI_PARAM_SOURCE_ATTRIB:
 		if(param < GI_ATTRIB_COUNT)
 			pPar->source_attrib = param;
@@ -216,6 +287,15 @@ void GIAPIENTRY giParameterizerParameterf(GIenum pname, GIfloat param)
 }
 
 /** Set callback function for parameterization.
+ *  GI_PARAM_STARTED and GI_PARAM_FINISHED are called at the start and end of 
+ *  giParameterize(). GI_PARAM_CHANGED is called with the changed patch active 
+ *  and can reject the change by returning GI_FALSE. When patches are 
+ *  parameterized one after the other, it is called after every iteration of 
+ *  the stretch minimizing parameterizers and once more for every finished 
+ *  patch. When all patches of a mesh with several patches are parameterized 
+ *  concurrently (GI_MULTITHREADING enabled with more than one thread and 
+ *  parameterizer other than GI_GIM), it is only called once for every patch 
+ *  after all of them are done, in patch order and from the calling thread.
  *  \param which callback to set
  *  \param fn function to use
  *  \param data custom user data
@@ -237,6 +317,31 @@ void GIAPIENTRY giParameterizerCallback(GIenum which, GIparamcb fn, GIvoid *data
 	pPar->cdata[which-GI_CALLBACK_BASE] = data;
 }
 
+/** Set callback for monitoring convergence of linear solvers.
+ *  The callback is called after every iteration of an iterative solver (or 
+ *  every refinement step with single precision solvers) and once after a 
+ *  direct solution. It gets the ID of the patch, the iteration and the 
+ *  relative residuals of the U and V systems. When patches are parameterized 
+ *  concurrently, it may be called from multiple threads at once. 
+ *  CG, BiCGStab and the refinement steps report the unpreconditioned residual 
+ *  ||b-Ax||/||b||, whereas GMRES reports the one of the left-preconditioned 
+ *  system ||P(b-Ax)||/||Pb||, which it gets without additional work. 
+ *  Independent of the callback, ||b-Ax||/||b|| is computed after every solve 
+ *  and the larger of the U and V residuals is stored as GI_SOLVER_RESIDUAL of 
+ *  the patch, so it means the same for all solvers.
+ *  \param fn callback function or NULL to disable
+ *  \param data user data to pass to callback
+ *  \ingroup parameterization
+ */
+void GIAPIENTRY giParameterizerResidualCallback(GIresidualcb fn, GIvoid *data)
+{
+	GIParameterizer *pPar = &(GIContext_current()->parameterizer);
+
+	/* set callback data */
+	pPar->residual_cb = fn;
+	pPar->residual_data = data;
+}
+
 /** Parameterize current mesh.
  *  This function computes parameter coordinates for the current bound mesh.
  *  \ingroup parameterization
@@ -331,11 +436,21 @@ void GIAPIENTRY giParameterize()
 	/* process patches */
 	memset(pMesh->stretch, 0, GI_STRETCH_COUNT*sizeof(GIdouble));
 	pMesh->param_metric = 0;
+#if OPENGI_NUM_THREADS > 1
+	if(pPar->context->use_threads && g_ThreadPool.num_workers && !bActive && 
+		pMesh->patch_count > 1 && pPar->parameterizer != GI_GIM)
+	{
+		/* parameterize patches concurrently */
+		GIParameterizer_parallel(pPar, pMesh);
+	}
+	else
+#endif
 	do
 	{
 		GIDebug(printf("parameterizing patch %d\n", pPatch->id));
 		pMesh->active_patch = pPatch;
 		memset(pPatch->stretch, 0, GI_STRETCH_COUNT*sizeof(GIdouble));
+		memset(&pPatch->solver_stats, 0, sizeof(GISolverStats));
 		pPatch->param_metric = 0;
 
 		/* former parameterization external -> search corners */
@@ -356,38 +471,7 @@ void GIAPIENTRY giParameterize()
 			bSuccess = GI_FALSE;
 		}
 		else if(pPatch->pcount > pPatch->hcount)
-		{
-			/* parameterize interior */
-			switch(pPar->parameterizer)
-			{
-				case GI_TUTTE_BARYCENTRIC:
-				case GI_SHAPE_PRESERVING:
-				case GI_DISCRETE_HARMONIC:
-				case GI_MEAN_VALUE:
-				case GI_DISCRETE_AUTHALIC:
-				case GI_INTRINSIC:
-					{
-						GILinearSystem system;
-						GILinearSystem_construct(&system, pPar, pPatch, 
-							pPar->parameterizer, GI_FALSE, GI_FALSE);
-						bSuccess = GILinearSystem_solve(&system);
-						GILinearSystem_unknowns_to_params(&system);
-						GILinearSystem_destruct(&system);
-					}
-					break;
-				case GI_STRETCH_MINIMIZING:
-					bSuccess = GIParameterizer_stretch_minimizing(pPar, pPatch);
-					break;
-				case GI_GIM:
-					if(pMesh->patch_count > 1)
-					{
-						GIContext_error(pPar->context, GI_INVALID_OPERATION);
-						bSuccess = GI_FALSE;
-					}
-					else
-						bSuccess = GIParameterizer_gim(pPar, pPatch);
-			}
-		}
+			bSuccess = GIParameterizer_interior(pPar, pPatch);
 		else
 		{
 			if(!pPatch->parameterized)
@@ -456,10 +540,186 @@ void GIParameterizer_construct(GIParameterizer *par, GIContext *context)
 	par->source_attrib = 0;
 	par->sampling_res = 33;
 	par->solver = GI_SOLVER_BICGSTAB;
+	par->symmetric_solver = GI_SOLVER_CG;
+	par->preconditioner = GI_PRECONDITIONER_ILU;
+	par->param_ordering = GI_NONE;
+	par->solver_precision = GI_DOUBLE;
+	par->warm_start = GI_FALSE;
+	par->autotune = GI_FALSE;
+	reset_tuning(par);
+	par->parallel = GI_FALSE;
 	memset(par->callback, 0, GI_CALLBACK_COUNT*sizeof(GIparamcb));
 	memset(par->cdata, 0, GI_CALLBACK_COUNT*sizeof(GIvoid*));
+	par->residual_cb = NULL;
+	par->residual_data = NULL;
 }
 
+/** \internal
+ *  \brief Parameterize interior of patch with already parameterized border.
+ *  \param par parameterizer to use
+ *  \param patch patch to parameterize
+ *  \retval GI_TRUE if parameterized successfully
+ *  \retval GI_FALSE on error or abort
+ *  \ingroup parameterization
+ */
+GIboolean GIParameterizer_interior(GIParameterizer *par, GIPatch *patch)
+{
+	GIboolean bSuccess = GI_FALSE;
+
+	/* reduce bandwidth of linear systems */
+	if(par->param_ordering == GI_ORDERING_RCM)
+		GIPatch_reorder_params(patch);
+
+	/* parameterize interior */
+	switch(par->parameterizer)
+	{
+		case GI_TUTTE_BARYCENTRIC:
+		case GI_SHAPE_PRESERVING:
+		case GI_DISCRETE_HARMONIC:
+		case GI_MEAN_VALUE:
+		case GI_DISCRETE_AUTHALIC:
+		case GI_INTRINSIC:
+			{
+				GILinearSystem system;
+				GILinearSystem_construct(&system, par, patch, 
+					par->parameterizer, GI_FALSE, GI_FALSE);
+				bSuccess = GILinearSystem_solve(&system);
+				GILinearSystem_unknowns_to_params(&system);
+				GILinearSystem_destruct(&system);
+			}
+			break;
+		case GI_STRETCH_MINIMIZING:
+			bSuccess = GIParameterizer_stretch_minimizing(par, patch);
+			break;
+		case GI_GIM:
+			if(patch->mesh->patch_count > 1)
+				GIContext_error(par->context, GI_INVALID_OPERATION);
+			else
+				bSuccess = GIParameterizer_gim(par, patch);
+	}
+	return bSuccess;
+}
+
+#if OPENGI_NUM_THREADS > 1
+
+/** \internal
+ *  \brief Compare patches by number of interior params (descending).
+ *  \param a address of first patch pointer
+ *  \param b address of second patch pointer
+ *  \return difference of patch sizes
+ *  \ingroup parameterization
+ */
+static int compare_patch_size(const void *a, const void *b)
+{
+	const GIPatch *pPatch1 = *(const GIPatch**)a, *pPatch2 = *(const GIPatch**)b;
+	GIuint uiSize1 = pPatch1->pcount - pPatch1->hcount;
+	GIuint uiSize2 = pPatch2->pcount - pPatch2->hcount;
+	if(uiSize1 != uiSize2)
+		return (uiSize1 < uiSize2) ? 1 : -1;
+	return (pPatch1->id < pPatch2->id) ? -1 : (pPatch1->id > pPatch2->id);
+}
+
+/** \internal
+ *  \brief Parameterize all patches of mesh concurrently.
+ *  \details The borders are parameterized sequentially, as this may split 
+ *  edges shared with neighbouring patches. The interiors are then distributed 
+ *  among the pool threads, biggest patches first. Change callbacks are issued 
+ *  afterwards in patch order, so observers see the same sequence as in 
+ *  sequential mode.
+ *  \param par parameterizer to use
+ *  \param mesh mesh to parameterize
+ *  \ingroup parameterization
+ */
+void GIParameterizer_parallel(GIParameterizer *par, GIMesh *mesh)
+{
+	GIPatchQueue queue;
+	GIPatch *pPatch = mesh->patches;
+
+	/* parameterize boundaries and collect patches with interior */
+	queue.parameterizer = par;
+	queue.patches = (GIPatch**)GI_MALLOC_ARRAY(mesh->patch_count, sizeof(GIPatch*));
+	queue.success = (GIboolean*)GI_MALLOC_ARRAY(mesh->patch_count, sizeof(GIboolean));
+	queue.count = 0;
+	do
+	{
+		GIDebug(printf("parameterizing patch border %d\n", pPatch->id));
+		mesh->active_patch = pPatch;
+		memset(pPatch->stretch, 0, GI_STRETCH_COUNT*sizeof(GIdouble));
+		memset(&pPatch->solver_stats, 0, sizeof(GISolverStats));
+		pPatch->param_metric = 0;
+		if(pPatch->resolution == UINT_MAX)
+		{
+			memset(pPatch->corners, 0, 4*sizeof(GIParam*));
+			GIPatch_find_corners(pPatch);
+		}
+		if(mesh->resolution != par->sampling_res)
+			pPatch->resolution = 0;
+		queue.success[pPatch->id] = GIParameterizer_arc_length_square(par, pPatch);
+
+		/* queued patches keep their state for warm starts and are counted afterwards */
+		if(queue.success[pPatch->id] && pPatch->pcount > pPatch->hcount)
+			queue.patches[queue.count++] = pPatch;
+		else if(!pPatch->parameterized)
+		{
+			/* count as parameterized (reverted afterwards on failure) */
+			pPatch->parameterized = GI_TRUE;
+			++mesh->param_patches;
+		}
+		pPatch = pPatch->next;
+	}while(pPatch != mesh->patches);
+
+	/* biggest patches first for better load balance */
+	qsort(queue.patches, queue.count, sizeof(GIPatch*), compare_patch_size);
+
+	/* distribute interiors among pool threads */
+	par->parallel = GI_TRUE;
+	GIThreadPool_run(&g_ThreadPool, GIParameterizer_patch_task, &queue, queue.count);
+	par->parallel = GI_FALSE;
+
+	/* notify of changes in patch order */
+	do
+	{
+		mesh->active_patch = pPatch;
+		if(!pPatch->parameterized)
+		{
+			pPatch->parameterized = GI_TRUE;
+			++mesh->param_patches;
+		}
+		if(!queue.success[pPatch->id] || (par->callback[GI_PARAM_CHANGED-GI_CALLBACK_BASE] && 
+			!par->callback[GI_PARAM_CHANGED-GI_CALLBACK_BASE](
+			par->cdata[GI_PARAM_CHANGED-GI_CALLBACK_BASE])))
+		{
+			--mesh->param_patches;
+			pPatch->parameterized = GI_FALSE;
+			memset(pPatch->stretch, 0, GI_STRETCH_COUNT*sizeof(GIdouble));
+			pPatch->param_metric = 0;
+		}
+		pPatch = pPatch->next;
+	}while(pPatch != mesh->patches);
+
+	/* clean up */
+	GI_FREE_ARRAY(queue.patches);
+	GI_FREE_ARRAY(queue.success);
+}
+
+/** \internal
+ *  \brief Task function for parameterizing queued patch.
+ *  \param arg patch queue
+ *  \param index index of patch in queue
+ *  \ingroup parameterization
+ */
+void GIParameterizer_patch_task(GIvoid *arg, GIuint index)
+{
+	/* parameterize interior */
+	GIPatchQueue *pQueue = (GIPatchQueue*)arg;
+	GIPatch *pPatch = pQueue->patches[index];
+	GIDebug(printf("parameterizing patch %d\n", pPatch->id));
+	pQueue->success[pPatch->id] = 
+		GIParameterizer_interior(pQueue->parameterizer, pPatch);
+}
+
+#endif
+
 /** \internal
  *  \brief Parameterize border on unit circle with proportionally sampled points.
  *  \param par parameterizer to use
@@ -743,9 +1003,7 @@ GIboolean GIParameterizer_stretch_minimizing(GIParameterizer *par,
 											 GIPatch *patch)
 {
 	GILinearSystem system;
-	GISparseMatrixCSR *A;
-	GISparseMatrixLIL *B;
-	GIVectorElement *pElement;
+	GISparseMatrixCSR *A, *B;
 	GIParam **pBorderParams;
 	GIdouble dSum;
 	GIuint i, j, ii, ij, N, uiMetric = par->stretch_metric;
@@ -782,7 +1040,7 @@ GIboolean GIParameterizer_stretch_minimizing(GIParameterizer *par,
 	do
 	{
 		/* notify of changes */
-		if(!bSuccess || (par->callback[GI_PARAM_CHANGED-GI_CALLBACK_BASE] && 
+		if(!bSuccess || (!par->parallel && par->callback[GI_PARAM_CHANGED-GI_CALLBACK_BASE] && 
 			!par->callback[GI_PARAM_CHANGED-GI_CALLBACK_BASE](
 			par->cdata[GI_PARAM_CHANGED-GI_CALLBACK_BASE])))
 		{
@@ -826,13 +1084,13 @@ GIboolean GIParameterizer_stretch_minimizing(GIParameterizer *par,
 				A->values[ij] /= pPowStretches[A->idx[ij]];
 				dSum -= A->values[ij];
 			}
-			for(j=0,pElement=B->rows[i].elements; j<B->rows[i].size; ++j,++pElement)
+			for(j=B->ptr[i]; j<B->ptr[i+1]; ++j)
 			{
-				pElement->value /= pPowStretches[pElement->index];
-				dSum += pElement->value;
-				pParam = pBorderParams[pElement->index-uiPCount];
-				system.bU[i] += pElement->value * pParam->params[0];
-				system.bV[i] += pElement->value * pParam->params[1];
+				B->values[j] /= pPowStretches[B->idx[j]];
+				dSum += B->values[j];
+				pParam = pBorderParams[B->idx[j]-uiPCount];
+				system.bU[i] += B->values[j] * pParam->params[0];
+				system.bV[i] += B->values[j] * pParam->params[1];
 			}
 			A->values[ii] = dSum;
 		}
@@ -918,7 +1176,7 @@ GIboolean GIParameterizer_stretch_minimizing2(GIParameterizer *par,
 	do
 	{
 		/* notify of changes */
-		if(!bSuccess || (par->callback[GI_PARAM_CHANGED-GI_CALLBACK_BASE] && 
+		if(!bSuccess || (!par->parallel && par->callback[GI_PARAM_CHANGED-GI_CALLBACK_BASE] && 
 			!par->callback[GI_PARAM_CHANGED-GI_CALLBACK_BASE](
 			par->cdata[GI_PARAM_CHANGED-GI_CALLBACK_BASE])))
 		{
@@ -1177,13 +1435,13 @@ GIboolean GIParameterizer_gim(GIParameterizer *par, GIPatch *patch)
 	GIuint uiOldHStack, uiOldPStack, uiOldPCount, uiOldHCount, uiOldCutSplits;
 	GIuint uiMetric = par->stretch_metric;
 	GIboolean bSuccess;
-	GIHeap qFringe;
+	GIIndexedHeap qFringe;
 	GIHash hPathInfos;
 	GIHash hParamSaves;
 	GIuint uiSide;
 
 	/* create datastructures */
-	GIHeap_construct(&qFringe, pMesh->ecount, lessd, -DBL_MAX, GI_TRUE);
+	GIIndexedHeap_construct(&qFringe, pMesh->vcount, lessd);
 	GIHash_construct(&hParamSaves, patch->pcount, 0.0f, sizeof(GIParam*), 
 		hash_pointer, compare_pointer, copy_pointer);
 	GIHash_construct(&hPathInfos, patch->pcount, 0.0f, sizeof(GIuint), 
@@ -1251,7 +1509,7 @@ GIboolean GIParameterizer_gim(GIParameterizer *par, GIPatch *patch)
 
 		/* find shortest path (Dijkstra) */
 		GIDebug(printf("dijkstra\n"));
-		GIHeap_clear(&qFringe);
+		GIIndexedHeap_clear(&qFringe);
 		GIHash_clear(&hPathInfos, sizeof(GIPathInfo));
 		GIHash_insert(&hPathInfos, &pVStart->id, 
 			GI_CALLOC_SINGLE(sizeof(GIPathInfo)));
@@ -1272,11 +1530,11 @@ GIboolean GIParameterizer_gim(GIParameterizer *par, GIPatch *patch)
 							(GIPathInfo*)GI_MALLOC_SINGLE(sizeof(GIPathInfo)));
 					pInfo->source = pHalfEdge;
 					pInfo->distance = dDist;
-					GIHeap_enqueue(&qFringe, pVOther, dDist);
+					GIIndexedHeap_enqueue(&qFringe, pVOther->id, pVOther, dDist);
 				}
 				pHalfEdge = pHalfEdge->twin->next;
 			}while(pHalfEdge != pVertex->hedge);
-			pVertex = GIHeap_dequeue(&qFringe, &dOldDist);
+			pVertex = GIIndexedHeap_dequeue(&qFringe, &dOldDist);
 		}
 		pVEnd = pVertex;
 		++pVEnd->cut_degree;
@@ -1315,8 +1573,8 @@ GIboolean GIParameterizer_gim(GIParameterizer *par, GIPatch *patch)
 		dOldSideLength = patch->side_lengths[uiSide];
 
 		/* create new paths and connect to existing cut */
-		pNewPath = (GICutPath*)GI_MALLOC_PERSISTENT(sizeof(GICutPath));
-		pNewPath2 = (GICutPath*)GI_MALLOC_PERSISTENT(sizeof(GICutPath));
+		pNewPath = (GICutPath*)GI_MALLOC_ARENA(&patch->mesh->cut_arena, sizeof(GICutPath));
+		pNewPath2 = (GICutPath*)GI_MALLOC_ARENA(&patch->mesh->cut_arena, sizeof(GICutPath));
 		GI_LIST_INSERT(patch->paths, pPath->next, pNewPath2);
 		GI_LIST_INSERT(patch->paths, pNewPath2, pNewPath);
 		pNewPath->id = patch->path_count++;
@@ -1328,7 +1586,7 @@ GIboolean GIParameterizer_gim(GIParameterizer *par, GIPatch *patch)
 		pNewPath->twin = pNewPath2;
 		pNewPath2->twin = pNewPath;
 		pNewPath2->pstart = pVStart->hedge->pstart;
-		pNewPath->pstart = pPNew = (GIParam*)GI_MALLOC_PERSISTENT(sizeof(GIParam));
+		pNewPath->pstart = pPNew = (GIParam*)GI_MALLOC_ARENA(&patch->mesh->cut_arena, sizeof(GIParam));
 		GI_LIST_ADD(patch->params, pPNew);
 		pPNew->id = patch->pcount++;
 		GI_VEC2_COPY(pPNew->params, pPSplit->params);
@@ -1353,7 +1611,7 @@ GIboolean GIParameterizer_gim(GIParameterizer *par, GIPatch *patch)
 			pParam->cut_hedge = pHSource;
 			pHalfEdge = pHSource;
 			pHSource = ((GIPathInfo*)GIHash_find(&hPathInfos, &pVertex->id))->source;
-			pPNew = (GIParam*)GI_MALLOC_PERSISTENT(sizeof(GIParam));
+			pPNew = (GIParam*)GI_MALLOC_ARENA(&patch->mesh->cut_arena, sizeof(GIParam));
 			GI_LIST_ADD(patch->params, pPNew);
 			pPNew->id = patch->pcount++;
 			GI_VEC2_COPY(pPNew->params, pParam->params);
@@ -1380,6 +1638,8 @@ GIboolean GIParameterizer_gim(GIParameterizer *par, GIPatch *patch)
 		GIDebug(printf("stretch minimization\n"));
 		GIPatch_prevent_singularities(patch);
 		GIPatch_renumerate_params(patch);
+		if(par->param_ordering == GI_ORDERING_RCM)
+			GIPatch_reorder_params(patch);
 		pMesh->cut_splits = pMesh->split_hedges.size;
 		patch->resolution = 0;
 		bSuccess = (GIParameterizer_arc_length_square(par, patch) && 
@@ -1409,7 +1669,7 @@ GIboolean GIParameterizer_gim(GIParameterizer *par, GIPatch *patch)
 			pHalfEdge->pstart = pParam;
 			pHalfEdge = pHalfEdge->prev->twin;
 		}
-		GI_LIST_DELETE_PERSISTENT(patch->params, pPNew, sizeof(GIParam));
+		GI_LIST_DELETE_ARENA(patch->params, &patch->mesh->cut_arena, pPNew, sizeof(GIParam));
 		pHalfEdge = pParam->cut_hedge;
 	}
 	--pVEnd->cut_degree;
@@ -1422,8 +1682,8 @@ GIboolean GIParameterizer_gim(GIParameterizer *par, GIPatch *patch)
 		memcpy(patch->corners, pOldCorners, 4*sizeof(GIParam*));
 
 	/* delete paths and reverse path split */
-	GI_LIST_DELETE_PERSISTENT(patch->paths, pNewPath, sizeof(GICutPath));
-	GI_LIST_DELETE_PERSISTENT(patch->paths, pNewPath2, sizeof(GICutPath));
+	GI_LIST_DELETE_ARENA(patch->paths, &patch->mesh->cut_arena, pNewPath, sizeof(GICutPath));
+	GI_LIST_DELETE_ARENA(patch->paths, &patch->mesh->cut_arena, pNewPath2, sizeof(GICutPath));
 	patch->path_count -= 2;
 	--patch->groups;
 	GIPatch_revert_splits(patch, patch->split_paths.size-uiOldPStack);
@@ -1447,14 +1707,237 @@ GIboolean GIParameterizer_gim(GIParameterizer *par, GIPatch *patch)
 	patch->max_param_stretch = dOldMax;
 
 	/* clean up */
-	GIHeap_destruct(&qFringe);
+	GIIndexedHeap_destruct(&qFringe);
 	GIHash_destruct(&hParamSaves, sizeof(GIParamSave));
 	GIHash_destruct(&hPathInfos, sizeof(GIPathInfo));
 	return bSuccess;
 }
 
+/** \internal
+ *  \brief Compute coefficients of row of linear system.
+ *  \details Only the row of the param and its right hand sides are written, 
+ *  so rows can be computed concurrently.
+ *  \param data assembly data
+ *  \param pParam interior param of row
+ *  \ingroup parameterization
+ */
+static void assemble_row(const GIAssemblyData *data, GIParam *pParam)
+{
+	GISparseMatrixCSR *A = data->A, *B = data->B;
+	GIuint *pSizes = data->sizes, *pBSizes = data->bsizes;
+	GIdouble *bU = data->bU, *bV = data->bV;
+	GIPatch *patch = data->patch;
+	GIVertex *pVertex = pParam->vertex;
+	GIHalfEdge *pHalfEdge, *pEnd, *pPrev, *pNext;
+	GIdouble v0[3], v1[3], v2[3], v3[3], v4[3];
+	GIdouble *vec;
+	GIdouble dCos, dTan1, dTan2, dCot1, dCot2, dInvR, dCoord, dSum = 0.0;
+	GIdouble dLambda = data->parameterizer->conformal_weight;
+	GIdouble dMu = data->parameterizer->authalic_weight;
+	GIuint i = pParam->id, j, N = A->n;
+
+	/* compute coefficients of row */
+	bU[i] = bV[i] = 0.0;
+	switch(data->type)
+	{
+	case GI_TUTTE_BARYCENTRIC:
+		pHalfEdge = pEnd = pVertex->hedge->twin;
+		do
+		{
+			/* compute weight Wij = 1 and set coefficients */
+			dSum += 1.0;
+			j = pHalfEdge->pstart->id;
+			if(j < N)
+				GISparseMatrixCSR_append(A, pSizes, i, j, -1.0);
+			else
+			{
+				vec = pHalfEdge->pstart->params;
+				if(B)
+					GISparseMatrixCSR_append(B, pBSizes, i, j, 1.0);
+				bU[i] += vec[0];
+				bV[i] += vec[1];
+			}
+			pHalfEdge = pHalfEdge->next->twin;
+		}while(pHalfEdge != pEnd);
+		break;
+	case GI_DISCRETE_HARMONIC:
+		pHalfEdge = pEnd = pVertex->hedge->twin;
+		pPrev = pHalfEdge->twin->prev;
+		do
+		{
+			/* compute weights Wij = cot(Yij) + cot(Yji) */
+			pNext = pHalfEdge->next->twin;
+			GI_VEC3_SUB(v0, pVertex->coords, pPrev->vstart->coords);
+			GI_VEC3_SUB(v1, pHalfEdge->vstart->coords, pPrev->vstart->coords);
+			GI_VEC3_SUB(v2, pVertex->coords, pNext->vstart->coords);
+			GI_VEC3_SUB(v3, pHalfEdge->vstart->coords, pNext->vstart->coords);
+			dCos = GI_VEC3_DOT(v0, v1) / (pPrev->edge->length*pPrev->prev->edge->length);
+			dCot1 = dCos / sqrt(1.0-dCos*dCos);
+			dCos = GI_VEC3_DOT(v2, v3) / (pNext->edge->length*pHalfEdge->prev->edge->length);
+			dCot2 = dCos / sqrt(1.0-dCos*dCos);
+			dCoord = dCot1 + dCot2;
+			dSum += dCoord;
+
+			/* set coefficients */
+			j = pHalfEdge->pstart->id;
+			if(j < N)
+				GISparseMatrixCSR_append(A, pSizes, i, j, -dCoord);
+			else
+			{
+				vec = pHalfEdge->pstart->params;
+				if(B)
+					GISparseMatrixCSR_append(B, pBSizes, i, j, dCoord);
+				bU[i] += dCoord * vec[0];
+				bV[i] += dCoord * vec[1];
+			}
+			pPrev = pHalfEdge;
+			pHalfEdge = pNext;
+		}while(pHalfEdge != pEnd);
+		break;
+	case GI_MEAN_VALUE:
+		pHalfEdge = pEnd = pVertex->hedge->twin;
+		pPrev = pHalfEdge->twin->prev;
+		do
+		{
+			/* compute weights Wij = (tan(Aij/2) + tan(Bji/2)) / Rij */
+			pNext = pHalfEdge->next->twin;
+			GI_VEC3_SUB(v1, pPrev->vstart->coords, pVertex->coords);
+			GI_VEC3_SUB(v0, pHalfEdge->vstart->coords, pVertex->coords);
+			GI_VEC3_SUB(v2, pNext->vstart->coords, pVertex->coords);
+			dCos = GI_VEC3_DOT(v0, v1) / 
+				(pHalfEdge->edge->length*pPrev->edge->length);
+			dTan1 = sqrt((1.0-dCos)/(1.0+dCos));
+			dCos = GI_VEC3_DOT(v0, v2) / 
+				(pHalfEdge->edge->length*pNext->edge->length);
+			dTan2 = sqrt((1.0-dCos)/(1.0+dCos));
+			dCoord = (dTan1+dTan2) * 
+				(patch->mesh->mean_edge/pHalfEdge->edge->length);
+			dSum += dCoord;
+
+			/* set coefficients */
+			j = pHalfEdge->pstart->id;
+			if(j < N)
+				GISparseMatrixCSR_append(A, pSizes, i, j, -dCoord);
+			else
+			{
+				vec = pHalfEdge->pstart->params;
+				if(B)
+					GISparseMatrixCSR_append(B, pBSizes, i, j, dCoord);
+				bU[i] += dCoord * vec[0];
+				bV[i] += dCoord * vec[1];
+			}
+			pPrev = pHalfEdge;
+			pHalfEdge = pNext;
+		}while(pHalfEdge != pEnd);
+		break;
+	case GI_DISCRETE_AUTHALIC:
+		pHalfEdge = pEnd = pVertex->hedge->twin;
+		pPrev = pHalfEdge->twin->prev;
+		do
+		{
+			/* compute weight Wij = (cot(Aji) + cot(Bij)) / Rij^2 */
+			pNext = pHalfEdge->next->twin;
+			GI_VEC3_SUB(v1, pPrev->vstart->coords, pHalfEdge->vstart->coords);
+			GI_VEC3_SUB(v0, pVertex->coords, pHalfEdge->vstart->coords);
+			GI_VEC3_SUB(v2, pNext->vstart->coords, pHalfEdge->vstart->coords);
+			dCos = GI_VEC3_DOT(v0, v1) / 
+				(pHalfEdge->edge->length*pPrev->prev->edge->length);
+			dCot1 = dCos / sqrt(1.0-dCos*dCos);
+			dCos = GI_VEC3_DOT(v0, v2) / 
+				(pHalfEdge->edge->length*pHalfEdge->prev->edge->length);
+			dCot2 = dCos / sqrt(1.0-dCos*dCos);
+			dInvR = patch->mesh->mean_edge / pHalfEdge->edge->length;
+			dCoord = (dCot1+dCot2) * dInvR * dInvR;
+			dSum += dCoord;
+
+			/* set coefficients */
+			j = pHalfEdge->pstart->id;
+			if(j < N)
+				GISparseMatrixCSR_append(A, pSizes, i, j, -dCoord);
+			else
+			{
+				vec = pHalfEdge->pstart->params;
+				if(B)
+					GISparseMatrixCSR_append(B, pBSizes, i, j, dCoord);
+				bU[i] += dCoord * vec[0];
+				bV[i] += dCoord * vec[1];
+			}
+			pPrev = pHalfEdge;
+			pHalfEdge = pNext;
+		}while(pHalfEdge != pEnd);
+		break;
+	case GI_INTRINSIC:
+		pHalfEdge = pEnd = pVertex->hedge->twin;
+		pPrev = pHalfEdge->twin->prev;
+		do
+		{
+			/* compute weights Wij = lambda*(cot(Yij) + cot(Yji)) + mu*((cot(Aji) + cot(Bij)) / Rij^2) */
+			pNext = pHalfEdge->next->twin;
+			GI_VEC3_SUB(v0, pVertex->coords, pPrev->vstart->coords);
+			GI_VEC3_SUB(v1, pHalfEdge->vstart->coords, pPrev->vstart->coords);
+			GI_VEC3_SUB(v2, pVertex->coords, pNext->vstart->coords);
+			GI_VEC3_SUB(v3, pHalfEdge->vstart->coords, pNext->vstart->coords);
+			GI_VEC3_SUB(v4, pVertex->coords, pHalfEdge->vstart->coords);
+			dCos = GI_VEC3_DOT(v0, v1) / (pPrev->edge->length*pPrev->prev->edge->length);
+			dCot1 = dCos / sqrt(1.0-dCos*dCos);
+			dCos = GI_VEC3_DOT(v2, v3) / (pNext->edge->length*pHalfEdge->prev->edge->length);
+			dCot2 = dCos / sqrt(1.0-dCos*dCos);
+			dCoord = dLambda * (dCot1+dCot2);
+			GI_VEC3_NEGATE(v1, v1);
+			GI_VEC3_NEGATE(v3, v3);
+			dCos = GI_VEC3_DOT(v4, v1) / 
+				(pHalfEdge->edge->length*pPrev->prev->edge->length);
+			dCot1 = dCos / sqrt(1.0-dCos*dCos);
+			dCos = GI_VEC3_DOT(v4, v3) / 
+				(pHalfEdge->edge->length*pHalfEdge->prev->edge->length);
+			dCot2 = dCos / sqrt(1.0-dCos*dCos);
+			dInvR = patch->mesh->mean_edge / pHalfEdge->edge->length;
+			dCoord += dMu * (dCot1+dCot2) * dInvR * dInvR;
+			dSum += dCoord;
+
+			/* set coefficients */
+			j = pHalfEdge->pstart->id;
+			if(j < N)
+				GISparseMatrixCSR_append(A, pSizes, i, j, -dCoord);
+			else
+			{
+				vec = pHalfEdge->pstart->params;
+				if(B)
+					GISparseMatrixCSR_append(B, pBSizes, i, j, dCoord);
+				bU[i] += dCoord * vec[0];
+				bV[i] += dCoord * vec[1];
+			}
+			pPrev = pHalfEdge;
+			pHalfEdge = pNext;
+		}while(pHalfEdge != pEnd);
+		break;
+	}
+	GISparseMatrixCSR_append(A, pSizes, i, i, dSum);
+}
+
+#if OPENGI_NUM_THREADS > 1
+
+/** \internal
+ *  \brief Task function for computing block of rows of linear system.
+ *  \param arg assembly data
+ *  \param index index of row block
+ *  \ingroup parameterization
+ */
+static void assemble_task(GIvoid *arg, GIuint index)
+{
+	const GIAssemblyData *pData = (const GIAssemblyData*)arg;
+	GIuint i, N = pData->A->n;
+	GIuint uiEnd = (GIuint)(((GIdouble)(index+1)/pData->tasks)*N);
+	for(i=(GIuint)(((GIdouble)index/pData->tasks)*N); i<uiEnd; ++i)
+		assemble_row(pData, pData->params[i]);
+}
+
+#endif
+
 /** \internal
  *  \brief Linear system constructor.
+ *  \details The matrices are assembled directly in compressed form, with 
+ *  the row sizes reserved according to the valences of the params.
  *  \param system system to construct
  *  \param par parameterizer to use
  *  \param patch patch to construct system for
@@ -1467,22 +1950,25 @@ void GILinearSystem_construct(GILinearSystem *system, GIParameterizer *par,
 							  GIPatch *patch, GIenum type, 
 							  GIboolean force_non_symmetric, GIboolean store_rhs)
 {
-	GISparseMatrixLIL A;
-	GISparseMatrixLIL *B = NULL;
+	GISparseMatrixCSR *A, *B = NULL;
 	GIdouble *bU, *bV;
 	GIuint N = patch->pcount - patch->hcount;
-	GIHalfEdge *pHalfEdge, *pEnd, *pPrev, *pNext, *pWork;
+	GIuint *pSizes, *pBSizes = NULL;
+	GIAssemblyData data;
+	GIboolean bSymmetric = (!force_non_symmetric && (type == GI_TUTTE_BARYCENTRIC || 
+		type == GI_DISCRETE_HARMONIC));
+	GIHalfEdge *pHalfEdge, *pEnd, *pPrev, *pWork;
 	GIVertex *pVertex;
 	GIParam *pParam;
-	GIdouble v0[3], v1[3], v2[3], v3[3], v4[3];
+	GIdouble v0[3], v1[3];
 	GIdouble *vec;
-	GIdouble dCos, dTan1, dTan2, dCot1, dCot2, dInvR, dCoord, dSum;
+	GIdouble dCoord, dSum, dTime = GITimer_seconds();
 	GIuint i, j, k;
 
 	/* create system */
 	system->parameterizer = par;
 	system->patch = patch;
-	system->A = (GISparseMatrixCSR*)GI_MALLOC_SINGLE(sizeof(GISparseMatrixCSR));
+	A = system->A = (GISparseMatrixCSR*)GI_MALLOC_SINGLE(sizeof(GISparseMatrixCSR));
 	bU = system->bU = (GIdouble*)GI_MALLOC_ALIGNED(
 		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
 	bV = system->bV = (GIdouble*)GI_MALLOC_ALIGNED(
@@ -1491,10 +1977,40 @@ void GILinearSystem_construct(GILinearSystem *system, GIParameterizer *par,
 		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
 	system->v = (GIdouble*)GI_CALLOC_ALIGNED(
 		GI_SSE_SIZE(N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	system->ldl = NULL;
+	system->warm = (par->warm_start && patch->parameterized);
+
+	/* reserve coefficients of interior and border neighbours 
+	   and start from previous parameterization if wanted */
+	pSizes = (GIuint*)GI_CALLOC_ARRAY(N, sizeof(GIuint));
+	if(store_rhs)
+		pBSizes = (GIuint*)GI_CALLOC_ARRAY(N, sizeof(GIuint));
+	GI_LIST_FOREACH(patch->params, pParam)
+		if(!pParam->cut_hedge)
+		{
+			i = pParam->id;
+			if(system->warm)
+			{
+				system->u[i] = pParam->params[0];
+				system->v[i] = pParam->params[1];
+			}
+			pSizes[i] = 1;
+			pHalfEdge = pEnd = pParam->vertex->hedge->twin;
+			do
+			{
+				if(pHalfEdge->pstart->id < N)
+					++pSizes[i];
+				else if(pBSizes)
+					++pBSizes[i];
+				pHalfEdge = pHalfEdge->next->twin;
+			}while(pHalfEdge != pEnd);
+		}
+	GI_LIST_NEXT(patch->params, pParam)
+	GISparseMatrixCSR_construct_rows(A, N, bSymmetric, pSizes);
 	if(store_rhs)
 	{
-		B = system->B = (GISparseMatrixLIL*)GI_MALLOC_SINGLE(sizeof(GISparseMatrixLIL));
-		GISparseMatrixLIL_construct(B, N, GI_FALSE);
+		B = system->B = (GISparseMatrixCSR*)GI_MALLOC_SINGLE(sizeof(GISparseMatrixCSR));
+		GISparseMatrixCSR_construct_rows(B, N, GI_FALSE, pBSizes);
 	}
 	else
 		system->B = NULL;
@@ -1503,33 +2019,38 @@ void GILinearSystem_construct(GILinearSystem *system, GIParameterizer *par,
 	switch(type)
 	{
 	case GI_TUTTE_BARYCENTRIC:
-		GISparseMatrixLIL_construct(&A, N, !force_non_symmetric);
+	case GI_DISCRETE_HARMONIC:
+	case GI_MEAN_VALUE:
+	case GI_DISCRETE_AUTHALIC:
+	case GI_INTRINSIC:
+		data.parameterizer = par;
+		data.patch = patch;
+		data.type = type;
+		data.A = A;
+		data.B = B;
+		data.sizes = pSizes;
+		data.bsizes = pBSizes;
+		data.bU = bU;
+		data.bV = bV;
+#if OPENGI_NUM_THREADS > 1
+		if(par->context->use_threads && g_ThreadPool.num_workers && 
+			N >= GI_PARALLEL_ASSEMBLY_MIN_ROWS)
+		{
+			/* compute blocks of rows in parallel */
+			data.params = (GIParam**)GI_MALLOC_ARRAY(N, sizeof(GIParam*));
+			GI_LIST_FOREACH(patch->params, pParam)
+				if(!pParam->cut_hedge)
+					data.params[pParam->id] = pParam;
+			GI_LIST_NEXT(patch->params, pParam)
+			data.tasks = 4 * g_ThreadPool.num_threads;
+			GIThreadPool_run(&g_ThreadPool, assemble_task, &data, data.tasks);
+			GI_FREE_ARRAY(data.params);
+			break;
+		}
+#endif
 		GI_LIST_FOREACH(patch->params, pParam)
 			if(!pParam->cut_hedge)
-			{
-				i = pParam->id;
-				bU[i] = bV[i] = 0.0;
-				dSum = 0.0;
-				pHalfEdge = pEnd = pParam->vertex->hedge->twin;
-				do
-				{
-					/* compute weight Wij = 1 and set coefficients */
-					dSum += 1.0;
-					j = pHalfEdge->pstart->id;
-					if(j < N)
-						GISparseMatrixLIL_append(&A, i, j, -1.0);
-					else
-					{
-						vec = pHalfEdge->pstart->params;
-						if(B)
-							GISparseMatrixLIL_append(B, i, j, 1.0);
-						bU[i] += vec[0];
-						bV[i] += vec[1];
-					}
-					pHalfEdge = pHalfEdge->next->twin;
-				}while(pHalfEdge != pEnd);
-				GISparseMatrixLIL_append(&A, i, i, dSum);
-			}
+				assemble_row(&data, pParam);
 		GI_LIST_NEXT(patch->params, pParam)
 		break;
 	case GI_SHAPE_PRESERVING:
@@ -1539,7 +2060,6 @@ void GILinearSystem_construct(GILinearSystem *system, GIParameterizer *par,
 		GIParam *pPk[3];
 		GIdouble *p0, *p1, *p2;
 		GIdouble dTheta, dDet, dMu[3], d1Sum;
-		GISparseMatrixLIL_construct(&A, N, GI_FALSE);
 		GIHash_construct(&hLocal, 16, 0.0f, sizeof(GIuint), 
 			hash_uint, compare_uint, copy_uint);
 		GI_LIST_FOREACH(patch->params, pParam)
@@ -1614,233 +2134,43 @@ void GILinearSystem_construct(GILinearSystem *system, GIParameterizer *par,
 						dSum += dCoord;
 						j = pPk[k]->id;
 						if(j < N)
-							GISparseMatrixLIL_add(&A, i, j, -dCoord);
+							GISparseMatrixCSR_add(A, pSizes, i, j, -dCoord);
 						else
 						{
 							vec = pPk[k]->params;
 							if(B)
-								GISparseMatrixLIL_add(B, i, j, dCoord);
+								GISparseMatrixCSR_add(B, pBSizes, i, j, dCoord);
 							bU[i] += dCoord * vec[0];
 							bV[i] += dCoord * vec[1];
 						}
 					}
 					pHalfEdge = pHalfEdge->twin->prev;
 				}while(pHalfEdge != pEnd);
-				GISparseMatrixLIL_append(&A, i, i, dSum);
+				GISparseMatrixCSR_append(A, pSizes, i, i, dSum);
 				GIHash_clear(&hLocal, sizeof(GILocalInfo));
 			}
 		GI_LIST_NEXT(patch->params, pParam)
 		GIHash_destruct(&hLocal, sizeof(GILocalInfo));
 		}
 		break;
-	case GI_DISCRETE_HARMONIC:
-		GISparseMatrixLIL_construct(&A, N, !force_non_symmetric);
-		GI_LIST_FOREACH(patch->params, pParam)
-			if(!pParam->cut_hedge)
-			{
-				i = pParam->id;
-				bU[i] = bV[i] = 0.0;
-				dSum = 0.0;
-				pVertex = pParam->vertex;
-				pHalfEdge = pEnd = pVertex->hedge->twin;
-				pPrev = pHalfEdge->twin->prev;
-				do
-				{
-					/* compute weights Wij = cot(Yij) + cot(Yji) */
-					pNext = pHalfEdge->next->twin;
-					GI_VEC3_SUB(v0, pVertex->coords, pPrev->vstart->coords);
-					GI_VEC3_SUB(v1, pHalfEdge->vstart->coords, pPrev->vstart->coords);
-					GI_VEC3_SUB(v2, pVertex->coords, pNext->vstart->coords);
-					GI_VEC3_SUB(v3, pHalfEdge->vstart->coords, pNext->vstart->coords);
-					dCos = GI_VEC3_DOT(v0, v1) / (pPrev->edge->length*pPrev->prev->edge->length);
-					dCot1 = dCos / sqrt(1.0-dCos*dCos);
-					dCos = GI_VEC3_DOT(v2, v3) / (pNext->edge->length*pHalfEdge->prev->edge->length);
-					dCot2 = dCos / sqrt(1.0-dCos*dCos);
-					dCoord = dCot1 + dCot2;
-					dSum += dCoord;
-
-					/* set coefficients */
-					j = pHalfEdge->pstart->id;
-					if(j < N)
-						GISparseMatrixLIL_append(&A, i, j, -dCoord);
-					else
-					{
-						vec = pHalfEdge->pstart->params;
-						if(B)
-							GISparseMatrixLIL_append(B, i, j, dCoord);
-						bU[i] += dCoord * vec[0];
-						bV[i] += dCoord * vec[1];
-					}
-					pPrev = pHalfEdge;
-					pHalfEdge = pNext;
-				}while(pHalfEdge != pEnd);
-				GISparseMatrixLIL_append(&A, i, i, dSum);
-			}
-		GI_LIST_NEXT(patch->params, pParam)
-		break;
-	case GI_MEAN_VALUE:
-		GISparseMatrixLIL_construct(&A, N, GI_FALSE);
-		GI_LIST_FOREACH(patch->params, pParam)
-			if(!pParam->cut_hedge)
-			{
-				i = pParam->id;
-				bU[i] = bV[i] = 0.0;
-				dSum = 0.0;
-				pVertex = pParam->vertex;
-				pHalfEdge = pEnd = pVertex->hedge->twin;
-				pPrev = pHalfEdge->twin->prev;
-				do
-				{
-					/* compute weights Wij = (tan(Aij/2) + tan(Bji/2)) / Rij */
-					pNext = pHalfEdge->next->twin;
-					GI_VEC3_SUB(v1, pPrev->vstart->coords, pVertex->coords);
-					GI_VEC3_SUB(v0, pHalfEdge->vstart->coords, pVertex->coords);
-					GI_VEC3_SUB(v2, pNext->vstart->coords, pVertex->coords);
-					dCos = GI_VEC3_DOT(v0, v1) / 
-						(pHalfEdge->edge->length*pPrev->edge->length);
-					dTan1 = sqrt((1.0-dCos)/(1.0+dCos));
-					dCos = GI_VEC3_DOT(v0, v2) / 
-						(pHalfEdge->edge->length*pNext->edge->length);
-					dTan2 = sqrt((1.0-dCos)/(1.0+dCos));
-					dCoord = (dTan1+dTan2) * 
-						(patch->mesh->mean_edge/pHalfEdge->edge->length);
-					dSum += dCoord;
-
-					/* set coefficients */
-					j = pHalfEdge->pstart->id;
-					if(j < N)
-						GISparseMatrixLIL_append(&A, i, j, -dCoord);
-					else
-					{
-						vec = pHalfEdge->pstart->params;
-						if(B)
-							GISparseMatrixLIL_append(B, i, j, dCoord);
-						bU[i] += dCoord * vec[0];
-						bV[i] += dCoord * vec[1];
-					}
-					pPrev = pHalfEdge;
-					pHalfEdge = pNext;
-				}while(pHalfEdge != pEnd);
-				GISparseMatrixLIL_append(&A, i, i, dSum);
-			}
-		GI_LIST_NEXT(patch->params, pParam)
-		break;
-	case GI_DISCRETE_AUTHALIC:
-		GISparseMatrixLIL_construct(&A, N, GI_FALSE);
-		GI_LIST_FOREACH(patch->params, pParam)
-			if(!pParam->cut_hedge)
-			{
-				i = pParam->id;
-				bU[i] = bV[i] = 0.0;
-				dSum = 0.0;
-				pVertex = pParam->vertex;
-				pHalfEdge = pEnd = pVertex->hedge->twin;
-				pPrev = pHalfEdge->twin->prev;
-				do
-				{
-					/* compute weight Wij = (cot(Aji) + cot(Bij)) / Rij^2 */
-					pNext = pHalfEdge->next->twin;
-					GI_VEC3_SUB(v1, pPrev->vstart->coords, pHalfEdge->vstart->coords);
-					GI_VEC3_SUB(v0, pVertex->coords, pHalfEdge->vstart->coords);
-					GI_VEC3_SUB(v2, pNext->vstart->coords, pHalfEdge->vstart->coords);
-					dCos = GI_VEC3_DOT(v0, v1) / 
-						(pHalfEdge->edge->length*pPrev->prev->edge->length);
-					dCot1 = dCos / sqrt(1.0-dCos*dCos);
-					dCos = GI_VEC3_DOT(v0, v2) / 
-						(pHalfEdge->edge->length*pHalfEdge->prev->edge->length);
-					dCot2 = dCos / sqrt(1.0-dCos*dCos);
-					dInvR = patch->mesh->mean_edge / pHalfEdge->edge->length;
-					dCoord = (dCot1+dCot2) * dInvR * dInvR;
-					dSum += dCoord;
-
-					/* set coefficients */
-					j = pHalfEdge->pstart->id;
-					if(j < N)
-						GISparseMatrixLIL_append(&A, i, j, -dCoord);
-					else
-					{
-						vec = pHalfEdge->pstart->params;
-						if(B)
-							GISparseMatrixLIL_append(B, i, j, dCoord);
-						bU[i] += dCoord * vec[0];
-						bV[i] += dCoord * vec[1];
-					}
-					pPrev = pHalfEdge;
-					pHalfEdge = pNext;
-				}while(pHalfEdge != pEnd);
-				GISparseMatrixLIL_append(&A, i, i, dSum);
-			}
-		GI_LIST_NEXT(patch->params, pParam)
-		break;
-	case GI_INTRINSIC:
-		{
-		GIdouble dLambda = par->conformal_weight;
-		GIdouble dMu = par->authalic_weight;
-		GISparseMatrixLIL_construct(&A, N, GI_FALSE);
-		GI_LIST_FOREACH(patch->params, pParam)
-			if(!pParam->cut_hedge)
-			{
-				i = pParam->id;
-				bU[i] = bV[i] = 0.0;
-				dSum = 0.0;
-				pVertex = pParam->vertex;
-				pHalfEdge = pEnd = pVertex->hedge->twin;
-				pPrev = pHalfEdge->twin->prev;
-				do
-				{
-					/* compute weights Wij = lambda*(cot(Yij) + cot(Yji)) + mu*((cot(Aji) + cot(Bij)) / Rij^2) */
-					pNext = pHalfEdge->next->twin;
-					GI_VEC3_SUB(v0, pVertex->coords, pPrev->vstart->coords);
-					GI_VEC3_SUB(v1, pHalfEdge->vstart->coords, pPrev->vstart->coords);
-					GI_VEC3_SUB(v2, pVertex->coords, pNext->vstart->coords);
-					GI_VEC3_SUB(v3, pHalfEdge->vstart->coords, pNext->vstart->coords);
-					GI_VEC3_SUB(v4, pVertex->coords, pHalfEdge->vstart->coords);
-					dCos = GI_VEC3_DOT(v0, v1) / (pPrev->edge->length*pPrev->prev->edge->length);
-					dCot1 = dCos / sqrt(1.0-dCos*dCos);
-					dCos = GI_VEC3_DOT(v2, v3) / (pNext->edge->length*pHalfEdge->prev->edge->length);
-					dCot2 = dCos / sqrt(1.0-dCos*dCos);
-					dCoord = dLambda * (dCot1+dCot2);
-					GI_VEC3_NEGATE(v1, v1);
-					GI_VEC3_NEGATE(v3, v3);
-					dCos = GI_VEC3_DOT(v4, v1) / 
-						(pHalfEdge->edge->length*pPrev->prev->edge->length);
-					dCot1 = dCos / sqrt(1.0-dCos*dCos);
-					dCos = GI_VEC3_DOT(v4, v3) / 
-						(pHalfEdge->edge->length*pHalfEdge->prev->edge->length);
-					dCot2 = dCos / sqrt(1.0-dCos*dCos);
-					dInvR = patch->mesh->mean_edge / pHalfEdge->edge->length;
-					dCoord += dMu * (dCot1+dCot2) * dInvR * dInvR;
-					dSum += dCoord;
-
-					/* set coefficients */
-					j = pHalfEdge->pstart->id;
-					if(j < N)
-						GISparseMatrixLIL_append(&A, i, j, -dCoord);
-					else
-					{
-						vec = pHalfEdge->pstart->params;
-						if(B)
-							GISparseMatrixLIL_append(B, i, j, dCoord);
-						bU[i] += dCoord * vec[0];
-						bV[i] += dCoord * vec[1];
-					}
-					pPrev = pHalfEdge;
-					pHalfEdge = pNext;
-				}while(pHalfEdge != pEnd);
-				GISparseMatrixLIL_append(&A, i, i, dSum);
-			}
-		GI_LIST_NEXT(patch->params, pParam)
-		}
-		break;
 	default:
-		GISparseMatrixLIL_construct(&A, N, GI_FALSE);
 		memset(bU, 0, N*sizeof(GIdouble));
 		memset(bV, 0, N*sizeof(GIdouble));
 	}
 
-	/* convert matrix */
-	GISparseMatrixCSR_construct(system->A, &A);
-	GISparseMatrixLIL_destruct(&A);
+	/* sort rows and remove unused space */
+	GISparseMatrixCSR_finish_rows(A, pSizes);
+	GI_FREE_ARRAY(pSizes);
+	if(B)
+	{
+		GISparseMatrixCSR_finish_rows(B, pBSizes);
+		GI_FREE_ARRAY(pBSizes);
+	}
+
+	/* record statistics */
+	patch->solver_stats.rows = N;
+	patch->solver_stats.nnz = A->nnz;
+	patch->solver_stats.times[GI_ASSEMBLY_TIME-GI_SOLVER_TIME_BASE] += GITimer_seconds() - dTime;
 }
 
 /** \internal
@@ -1858,8 +2188,13 @@ void GILinearSystem_destruct(GILinearSystem *system)
 	}
 	if(system->B)
 	{
-		GISparseMatrixLIL_destruct(system->B);
-		GI_FREE_SINGLE(system->B, sizeof(GISparseMatrixLIL));
+		GISparseMatrixCSR_destruct(system->B);
+		GI_FREE_SINGLE(system->B, sizeof(GISparseMatrixCSR));
+	}
+	if(system->ldl)
+	{
+		GISparseLDL_destruct(system->ldl);
+		GI_FREE_SINGLE(system->ldl, sizeof(GISparseLDL));
 	}
 	if(system->bU)
 		GI_FREE_ALIGNED(system->bU);
@@ -1891,7 +2226,9 @@ void GILinearSystem_unknowns_to_params(GILinearSystem *system)
 			pParam->params[1] = v[pParam->id];
 		}
 	GI_LIST_NEXT(pPHead, pParam)
-	if(!system->patch->parameterized)
+
+	/* concurrently parameterized patches are counted afterwards */
+	if(!system->patch->parameterized && !system->parameterizer->parallel)
 	{
 		++system->patch->mesh->param_patches;
 		system->patch->parameterized = GI_TRUE;
@@ -1901,70 +2238,446 @@ void GILinearSystem_unknowns_to_params(GILinearSystem *system)
 }
 
 /** \internal
- *  \brief Solve linear system.
+ *  \brief Solve prepared linear system iteratively.
  *  \param system system to solve
+ *  \param solver Krylov solver to use
+ *  \param pc preconditioner to use
+ *  \param solverf single precision Krylov solver for corrections or NULL to solve in double precision
+ *  \param pcf single precision preconditioner for corrections
+ *  \param b interleaved right hand sides
+ *  \param x interleaved initial guesses, overwritten with solutions
+ *  \param max_iter solver specific iteration limit
+ *  \param iterations address to store numbers of iterations at
  *  \retval GI_TRUE if solved successfully
  *  \retval GI_FALSE if system could not be solved
  *  \ingroup parameterization
  */
-GIboolean GILinearSystem_solve(GILinearSystem *system)
+static GIboolean solve_iterative(GILinearSystem *system, GIsolver2func solver, 
+								 GImvfunc pc, GIsolver2ffunc solverf, GImvfuncf pcf, 
+								 const GIdouble *b, GIdouble *x, GIuint max_iter, 
+								 GIuint *iterations, const GISolverMonitor *monitor)
 {
-	GISolverData dataU;
-	GIboolean bBICGSTAB = (system->parameterizer->solver == GI_SOLVER_BICGSTAB);
-	GIsolverfunc pfnUnsymmetric = (bBICGSTAB ? GISolver_bicgstab : GISolver_gmres);
-	GIuint uiMaxIter = ((system->A->symmetric || bBICGSTAB) ? 13 : 3) * sqrt(system->A->n);
-	GIuint uiIterU, uiIterV;
+	GIuint uiLimit = max_iter;
+
+	/* single precision corrections of double precision residuals */
+	if(solverf)
+		return GISolver_refine2((GISparseMatrix*)system->A, b, x, solverf, 
+			GISparseMatrixCSR_ax2, GISparseMatrixCSR_ax2f, pcf, 1e-6, max_iter, 
+			iterations, monitor);
+
+	/* GMRES limit is packed as restarts and restart length */
+	if(solver == GISolver_gmres2)
+		uiLimit = (max_iter>>8) * (max_iter&0xFF);
+	solver((GISparseMatrix*)system->A, b, x, GISparseMatrixCSR_ax2, 
+		pc, 1e-6, max_iter, iterations, monitor);
+	return (iterations[0] <= uiLimit && iterations[1] <= uiLimit);
+}
 
-	/* assemble configuration */
-	GISparseMatrixCSR_prepare_ilu(system->A);
-	dataU.solver_func = (system->A->symmetric ? GISolver_cg : pfnUnsymmetric);
-	dataU.A = (GISparseMatrix*)system->A;
-	dataU.b = system->bU;
-	dataU.x = system->u;
-	dataU.ax = GISparseMatrixCSR_ax;
-	dataU.pc = GISparseMatrixCSR_pc_ilu;
-	dataU.eps = 1e-6;
-	dataU.max_iter = (dataU.solver_func==GISolver_gmres ? ((uiMaxIter<<8)|25) : uiMaxIter);
+#ifdef OPENGI_DEBUG_OUTPUT
+/** \internal
+ *  \brief Print iterations of warm started solve against those of cold start.
+ *  \details The system is solved again from zero for comparison.
+ *  \param system solved system
+ *  \param solver Krylov solver used
+ *  \param pc preconditioner used
+ *  \param solverf single precision Krylov solver used for corrections or NULL
+ *  \param pcf single precision preconditioner used for corrections
+ *  \param b interleaved right hand sides
+ *  \param max_iter solver specific iteration limit
+ *  \param iterations numbers of iterations of warm started solve
+ *  \ingroup parameterization
+ */
+static void report_warm_start(GILinearSystem *system, GIsolver2func solver, 
+							  GImvfunc pc, GIsolver2ffunc solverf, GImvfuncf pcf, 
+							  const GIdouble *b, GIuint max_iter, 
+							  const GIuint *iterations)
+{
+	GIuint uiCold[2], N = system->A->n;
+	GIdouble *x0 = (GIdouble*)GI_CALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	solve_iterative(system, solver, pc, solverf, pcf, b, x0, max_iter, uiCold, NULL);
+	printf("warm start iterations: %u , %u (cold start: %u , %u)\n", 
+		iterations[0], iterations[1], uiCold[0], uiCold[1]);
+	GI_FREE_ALIGNED(x0);
+}
+#endif
 
-#if OPENGI_NUM_THREADS > 1
-	if(system->parameterizer->context->use_threads)
+/** \internal
+ *  \brief Pass residuals of linear system to residual callback.
+ *  \param arg linear system
+ *  \param iteration current iteration
+ *  \param residuals relative residuals of U and V systems
+ *  \ingroup parameterization
+ */
+static void report_residuals(GIvoid *arg, GIuint iteration, const GIdouble *residuals)
+{
+	GILinearSystem *system = (GILinearSystem*)arg;
+	GIParameterizer *par = system->parameterizer;
+	par->residual_cb(system->patch->id, iteration, residuals, par->residual_data);
+}
+
+/** \internal
+ *  \brief Compute relative residuals of solved linear system.
+ *  \param system solved system
+ *  \param b interleaved right hand sides
+ *  \param x interleaved solutions
+ *  \param residuals address to store residuals ||b-Ax||/||b|| of U and V systems at
+ *  \ingroup parameterization
+ */
+static void compute_residuals(GILinearSystem *system, const GIdouble *b, 
+							  const GIdouble *x, GIdouble *residuals)
+{
+	GIuint i, N = system->A->n;
+	GIdouble *r = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	GIdouble dNorm[2] = { 0.0, 0.0 };
+
+	GISparseMatrixCSR_ax2((GISparseMatrix*)system->A, x, r);
+	residuals[0] = residuals[1] = 0.0;
+	for(i=0; i<2*N; ++i)
 	{
-		/* start solver threads and wait for completion */
-		GIthread threadU = GIthread_create(GILinearSystem_solve_thread, &dataU);
-		uiIterV = dataU.solver_func((GISparseMatrix*)system->A, system->bV, system->v, 
-			dataU.ax, dataU.pc, dataU.eps, dataU.max_iter);
-		uiIterU = (GIuint)GIthread_join(threadU);
+		residuals[i&1] += (b[i]-r[i]) * (b[i]-r[i]);
+		dNorm[i&1] += b[i] * b[i];
 	}
+	for(i=0; i<2; ++i)
+		residuals[i] = sqrt((dNorm[i] > 0.0) ? (residuals[i]/dNorm[i]) : residuals[i]);
+	GI_FREE_ALIGNED(r);
+}
+
+/** \internal
+ *  \brief Candidate configurations for automatic selection of symmetric solvers.
+ *  \details Restart lengths are given as multiples of the size dependent base length.
+ */
+static const GISolverConfig g_SymmetricCandidates[GI_TUNING_CANDIDATES] = {
+	{ GI_SOLVER_CG, GI_PRECONDITIONER_ILU, 0 },
+	{ GI_SOLVER_CG, GI_PRECONDITIONER_AMG, 0 },
+	{ GI_SOLVER_CG, GI_PRECONDITIONER_SSOR, 0 },
+	{ GI_SOLVER_CG, GI_PRECONDITIONER_JACOBI, 0 },
+	{ GI_SOLVER_LDLT, GI_NONE, 0 } };
+
+/** \internal
+ *  \brief Candidate configurations for automatic selection of unsymmetric solvers.
+ *  \details Restart lengths are given as multiples of the size dependent base length.
+ */
+static const GISolverConfig g_UnsymmetricCandidates[GI_TUNING_CANDIDATES] = {
+	{ GI_SOLVER_BICGSTAB, GI_PRECONDITIONER_ILU, 0 },
+	{ GI_SOLVER_GMRES, GI_PRECONDITIONER_ILU, 1 },
+	{ GI_SOLVER_GMRES, GI_PRECONDITIONER_ILU, 2 },
+	{ GI_SOLVER_BICGSTAB, GI_PRECONDITIONER_SSOR, 0 },
+	{ GI_SOLVER_BICGSTAB, GI_PRECONDITIONER_JACOBI, 0 } };
+
+/** \internal
+ *  \brief Get solver configuration set by user.
+ *  \param par parameterizer to use
+ *  \param symmetric GI_TRUE for symmetric systems
+ *  \param config address to store configuration at
+ *  \ingroup parameterization
+ */
+static void default_config(const GIParameterizer *par, GIboolean symmetric, 
+						   GISolverConfig *config)
+{
+	/* multigrid only for symmetric systems */
+	config->solver = (symmetric ? par->symmetric_solver : par->solver);
+	config->preconditioner = par->preconditioner;
+	if(!symmetric && config->preconditioner == GI_PRECONDITIONER_AMG)
+		config->preconditioner = GI_PRECONDITIONER_ILU;
+	config->restart = 25;
+}
+
+/** \internal
+ *  \brief Select solver configuration for linear system automatically.
+ *  \details Systems are classified by symmetry and magnitude of their size. 
+ *  Each candidate of a class is tried for a few solves, after which the one 
+ *  with the lowest time per unknown is used for the class. The measurements 
+ *  are shared by all patches of the context.
+ *  \param system system to select configuration for
+ *  \param config address to store configuration at
+ *  \return index of selected candidate or -1 if still waiting for measurements
+ *  \ingroup parameterization
+ */
+static GIint select_config(GILinearSystem *system, GISolverConfig *config)
+{
+	GIParameterizer *par = system->parameterizer;
+	const GISolverConfig *pCandidates = (system->A->symmetric ? 
+		g_SymmetricCandidates : g_UnsymmetricCandidates);
+	GISolverTuning *pTuning;
+	GIuint i, uiSize, N = system->A->n;
+	GIint iCandidate = 0;
+
+	/* find class of system */
+	for(uiSize=0; (N>>uiSize) > 1 && uiSize < GI_TUNING_SIZES-1; ++uiSize) ;
+	pTuning = &par->tuning[system->A->symmetric ? 1 : 0][uiSize];
+
+#if OPENGI_NUM_THREADS > 1
+	GIMutex_lock(&par->context->mutex);
+#endif
+	if(pTuning->choice >= GI_TUNING_CANDIDATES)
+		iCandidate = -1;
+	else if(pTuning->choice >= 0)
+		iCandidate = pTuning->choice;
 	else
+	{
+		/* measure least tried candidate */
+		for(i=1; i<GI_TUNING_CANDIDATES; ++i)
+			if(pTuning->trials[i] < pTuning->trials[iCandidate])
+				iCandidate = i;
+		if(pTuning->trials[iCandidate] < GI_TUNING_TRIALS)
+			++pTuning->trials[iCandidate];
+		else
+		{
+			/* choose fastest candidate when all measurements finished */
+			for(i=0; i<GI_TUNING_CANDIDATES && 
+				pTuning->finished[i]>=GI_TUNING_TRIALS; ++i) ;
+			if(i == GI_TUNING_CANDIDATES)
+			{
+				for(i=1; i<GI_TUNING_CANDIDATES; ++i)
+					if(pTuning->time[i] < pTuning->time[iCandidate])
+						iCandidate = i;
+
+				/* keep user configuration if every candidate failed */
+				if(pTuning->time[iCandidate] == DBL_MAX)
+					iCandidate = GI_TUNING_CANDIDATES;
+				pTuning->choice = iCandidate;
+				GIDebug(printf("solver tuning: candidate %d for %s systems of size 2^%d\n", 
+					iCandidate, system->A->symmetric ? "symmetric" : "unsymmetric", uiSize));
+				if(iCandidate == GI_TUNING_CANDIDATES)
+					iCandidate = -1;
+			}
+			else
+				iCandidate = -1;
+		}
+	}
+#if OPENGI_NUM_THREADS > 1
+	GIMutex_unlock(&par->context->mutex);
 #endif
+
+	/* restart length grows with size */
+	if(iCandidate >= 0)
 	{
-		/* solve systems sequentially */
-		uiIterU = dataU.solver_func((GISparseMatrix*)system->A, system->bU, system->u, 
-			dataU.ax, dataU.pc, dataU.eps, dataU.max_iter);
-		uiIterV = dataU.solver_func((GISparseMatrix*)system->A, system->bV, system->v, 
-			dataU.ax, dataU.pc, dataU.eps, dataU.max_iter);
+		*config = pCandidates[iCandidate];
+		config->restart *= GI_CLAMP((GIuint)sqrt(N)>>2, 8, 32);
 	}
+	return iCandidate;
+}
 
-	/* check results */
-	GIDebug(printf("iterations: %d , %d (%d)\n", uiIterU, uiIterV, uiMaxIter));
-	if(uiIterU > dataU.max_iter || uiIterV > dataU.max_iter)
+/** \internal
+ *  \brief Record measured performance of automatically selected configuration.
+ *  \param system system solved with configuration
+ *  \param candidate index of candidate used
+ *  \param time seconds needed to solve or DBL_MAX on failure
+ *  \ingroup parameterization
+ */
+static void record_config(GILinearSystem *system, GIint candidate, GIdouble time)
+{
+	GIParameterizer *par = system->parameterizer;
+	GISolverTuning *pTuning;
+	GIuint uiSize, N = system->A->n;
+
+	for(uiSize=0; (N>>uiSize) > 1 && uiSize < GI_TUNING_SIZES-1; ++uiSize) ;
+	pTuning = &par->tuning[system->A->symmetric ? 1 : 0][uiSize];
+
+#if OPENGI_NUM_THREADS > 1
+	GIMutex_lock(&par->context->mutex);
+#endif
+	if(pTuning->choice < 0)
+		++pTuning->finished[candidate];
+	if(time == DBL_MAX)
 	{
-		GIContext_error(system->parameterizer->context, GI_NUMERICAL_ERROR);
-		return GI_FALSE;
+		/* never choose failing candidate again */
+		pTuning->time[candidate] = DBL_MAX;
+		if(pTuning->choice == candidate)
+			pTuning->choice = -1;
 	}
-	return GI_TRUE;
+	else if(pTuning->choice < 0 && pTuning->time[candidate] < DBL_MAX)
+		pTuning->time[candidate] += time / N;
+#if OPENGI_NUM_THREADS > 1
+	GIMutex_unlock(&par->context->mutex);
+#endif
+}
+
+/** \internal
+ *  \brief Solve linear system with given configuration.
+ *  \param system system to solve
+ *  \param config solver configuration to use
+ *  \param b interleaved right hand sides
+ *  \param x interleaved initial guesses, overwritten with solutions
+ *  \retval GI_TRUE if solved successfully
+ *  \retval GI_FALSE if system could not be solved
+ *  \ingroup parameterization
+ */
+static GIboolean solve_configured(GILinearSystem *system, const GISolverConfig *config, 
+								  const GIdouble *b, GIdouble *x)
+{
+	GIuint N = system->A->n;
+	GIsolver2func pfnSolver = GISolver_cg2;
+	GIsolver2ffunc pfnSolverf = GISolver_cg2f;
+	GImvfuncf pfnPreconditionerf = NULL;
+	GIuint uiMaxIter = ((config->solver != GI_SOLVER_GMRES) ? 13 : 3) * sqrt(N);
+	GIuint uiMaxIterArg = uiMaxIter;
+	GImvfunc pfnPreconditioner;
+	GISolverStats *pStats = &system->patch->solver_stats;
+	GISolverMonitor monitor;
+	GIuint uiIter[2];
+	GIdouble dTime;
+	GIboolean bSuccess;
+
+	monitor.report = report_residuals;
+	monitor.data = system;
+	dTime = GITimer_seconds();
+
+	if(config->solver == GI_SOLVER_LDLT)
+	{
+		/* analyze structure once and solve both systems directly */
+		if(!system->ldl)
+		{
+			system->ldl = (GISparseLDL*)GI_MALLOC_SINGLE(sizeof(GISparseLDL));
+			GISparseLDL_construct(system->ldl, system->A);
+		}
+		bSuccess = GISparseLDL_factorize(system->ldl, system->A);
+		pStats->times[GI_PRECONDITIONER_TIME-GI_SOLVER_TIME_BASE] += GITimer_seconds() - dTime;
+		dTime = GITimer_seconds();
+		if(bSuccess)
+			GISparseLDL_solve(system->ldl, b, x, 2);
+		pStats->times[GI_SOLVER_TIME-GI_SOLVER_TIME_BASE] += GITimer_seconds() - dTime;
+		GIDebug(printf("factor entries: %d (%d)\n", system->ldl->nnz, system->A->nnz));
+		return bSuccess;
+	}
+
+	/* assemble configuration */
+	if(config->solver == GI_SOLVER_BICGSTAB)
+	{
+		pfnSolver = GISolver_bicgstab2;
+		pfnSolverf = GISolver_bicgstab2f;
+	}
+	else if(config->solver == GI_SOLVER_GMRES)
+	{
+		pfnSolver = GISolver_gmres2;
+		pfnSolverf = NULL;
+		uiMaxIterArg = (uiMaxIter<<8) | config->restart;
+	}
+	switch(config->preconditioner)
+	{
+	case GI_PRECONDITIONER_AMG:
+		GISparseMatrixCSR_prepare_amg(system->A);
+		pfnPreconditioner = GISparseMatrixCSR_pc_amg2;
+		break;
+	case GI_PRECONDITIONER_SSOR:
+		GISparseMatrixCSR_prepare_ssor(system->A, 1.0);
+		pfnPreconditioner = GISparseMatrixCSR_pc_ssor2;
+		break;
+	case GI_PRECONDITIONER_JACOBI:
+		GISparseMatrixCSR_prepare_jacobi(system->A);
+		pfnPreconditioner = GISparseMatrixCSR_pc_jacobi2;
+		pfnPreconditionerf = GISparseMatrixCSR_pc_jacobi2f;
+		break;
+	default:
+		GISparseMatrixCSR_prepare_ilu(system->A);
+		pfnPreconditioner = GISparseMatrixCSR_pc_ilu2;
+		pfnPreconditionerf = GISparseMatrixCSR_pc_ilu2f;
+	}
+#if OPENGI_NUM_THREADS > 1
+	if(system->parameterizer->context->use_threads)
+		GISparseMatrixCSR_prepare_parallel(system->A, g_ThreadPool.num_threads);
+#endif
+
+	/* single precision needs single precision solver and preconditioner */
+	if(system->parameterizer->solver_precision != GI_FLOAT || !pfnPreconditionerf)
+		pfnSolverf = NULL;
+	if(pfnSolverf)
+		GISparseMatrixCSR_prepare_float(system->A);
+	pStats->times[GI_PRECONDITIONER_TIME-GI_SOLVER_TIME_BASE] += GITimer_seconds() - dTime;
+
+	/* solve both systems at once */
+	dTime = GITimer_seconds();
+	bSuccess = solve_iterative(system, pfnSolver, pfnPreconditioner, pfnSolverf, 
+		pfnPreconditionerf, b, x, uiMaxIterArg, uiIter, 
+		system->parameterizer->residual_cb ? &monitor : NULL);
+	pStats->times[GI_SOLVER_TIME-GI_SOLVER_TIME_BASE] += GITimer_seconds() - dTime;
+	pStats->iterations += GI_MAX(uiIter[0], uiIter[1]);
+	GIDebug(printf("iterations: %d , %d (%d)\n", uiIter[0], uiIter[1], uiMaxIter));
+	GIDebug(if(system->warm) report_warm_start(system, pfnSolver, 
+		pfnPreconditioner, pfnSolverf, pfnPreconditionerf, b, uiMaxIterArg, uiIter));
+	return bSuccess;
 }
 
 /** \internal
- *  \brief Thread execution function for solving linear system.
- *  \param arg thread parameters
- *  \return number of iterations for solving linear system
+ *  \brief Solve linear system.
+ *  \details If automatic solver selection is enabled and the selected 
+ *  configuration fails, the system is solved again with the configuration 
+ *  set by the user.
+ *  \param system system to solve
+ *  \retval GI_TRUE if solved successfully
+ *  \retval GI_FALSE if system could not be solved
  *  \ingroup parameterization
  */
-GIthreadret GITHREADENTRY GILinearSystem_solve_thread(GIvoid *arg)
+GIboolean GILinearSystem_solve(GILinearSystem *system)
 {
-	/* solve system */
-	GISolverData *pData = (GISolverData*)arg;
-	return (GIthreadret)pData->solver_func(pData->A, pData->b, 
-		pData->x, pData->ax, pData->pc, pData->eps, pData->max_iter);
+	GIParameterizer *par = system->parameterizer;
+	GIuint i, N = system->A->n;
+	GISolverConfig config, fallback;
+	const GISolverConfig *pUsed = &config;
+	GIint iCandidate = -1;
+	GIdouble *b, *x, dTime, dRes[2];
+	GIboolean bSuccess;
+
+	/* interleave U and V systems */
+	b = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	x = (GIdouble*)GI_MALLOC_ALIGNED(
+		GI_SSE_SIZE(2*N*sizeof(GIdouble)), GI_SSE_ALIGN_DOUBLE);
+	for(i=0; i<N; ++i)
+	{
+		b[2*i] = system->bU[i];
+		b[2*i+1] = system->bV[i];
+		x[2*i] = system->u[i];
+		x[2*i+1] = system->v[i];
+	}
+
+	/* select configuration */
+	default_config(par, system->A->symmetric, &config);
+	fallback = config;
+	if(par->autotune)
+		iCandidate = select_config(system, &config);
+
+	/* solve and measure selected configuration */
+	dTime = GITimer_seconds();
+	bSuccess = solve_configured(system, &config, b, x);
+	if(iCandidate >= 0)
+	{
+		record_config(system, iCandidate, bSuccess ? (GITimer_seconds()-dTime) : DBL_MAX);
+		if(!bSuccess && (config.solver != fallback.solver || 
+			config.preconditioner != fallback.preconditioner || 
+			config.restart != fallback.restart))
+		{
+			/* retry failed candidate with user configuration */
+			for(i=0; i<N; ++i)
+			{
+				x[2*i] = system->u[i];
+				x[2*i+1] = system->v[i];
+			}
+			bSuccess = solve_configured(system, &fallback, b, x);
+			pUsed = &fallback;
+		}
+	}
+
+	/* same residual for every solver, direct ones have no iterations to monitor */
+	compute_residuals(system, b, x, dRes);
+	system->patch->solver_stats.residual = GI_MAX(dRes[0], dRes[1]);
+	if(pUsed->solver == GI_SOLVER_LDLT && par->residual_cb)
+		report_residuals(system, 0, dRes);
+	for(i=0; i<N; ++i)
+	{
+		system->u[i] = x[2*i];
+		system->v[i] = x[2*i+1];
+	}
+	GI_FREE_ALIGNED(b);
+	GI_FREE_ALIGNED(x);
+
+	/* check results */
+	if(!bSuccess)
+	{
+		GIContext_error(system->parameterizer->context, GI_NUMERICAL_ERROR);
+		return GI_FALSE;
+	}
+	return GI_TRUE;
 }
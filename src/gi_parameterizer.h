@@ -46,10 +46,37 @@
 #define GI_CALLBACK_END			GI_PARAM_FINISHED
 #define GI_CALLBACK_COUNT		(GI_CALLBACK_END-GI_CALLBACK_BASE+1)
 
+#define GI_TUNING_CANDIDATES	5
+#define GI_TUNING_TRIALS		2
+#define GI_TUNING_SIZES			32
+
 
 /*************************************************************************/
 /* Structures */
 
+/** \internal
+ *  \brief Configuration of linear solver.
+ *  \ingroup parameterization
+ */
+typedef struct _GISolverConfig
+{
+	GIenum		solver;							/**< Solver to use. */
+	GIenum		preconditioner;					/**< Preconditioner for iterative solvers. */
+	GIuint		restart;						/**< Restart length for GMRES. */
+} GISolverConfig;
+
+/** \internal
+ *  \brief Measured performance of solver configurations for one class of systems.
+ *  \ingroup parameterization
+ */
+typedef struct _GISolverTuning
+{
+	GIuint		trials[GI_TUNING_CANDIDATES];	/**< Number of solves started with each candidate. */
+	GIuint		finished[GI_TUNING_CANDIDATES];	/**< Number of solves finished with each candidate. */
+	GIdouble	time[GI_TUNING_CANDIDATES];		/**< Accumulated seconds per unknown of each candidate. */
+	GIint		choice;							/**< Selected candidate, -1 while measuring, GI_TUNING_CANDIDATES if all failed. */
+} GISolverTuning;
+
 /** \internal
  *  \brief Parameterization configuration.
  *  \ingroup parameterization
@@ -67,8 +94,18 @@ typedef struct _GIParameterizer
 	GIuint				source_attrib;					/**< Attribute to use as parameter coordinates. */
 	GIuint				sampling_res;					/**< Desired minimal sampling resolution. */
 	GIenum				solver;							/**< Solver for unsymmetric systems. */
+	GIenum				symmetric_solver;				/**< Solver for symmetric systems. */
+	GIenum				preconditioner;					/**< Preconditioner for iterative solvers. */
+	GIenum				param_ordering;					/**< Ordering of interior params. */
+	GIenum				solver_precision;				/**< Precision of iterative solvers. */
+	GIboolean			warm_start;						/**< Initialize unknowns from previous parameterization. */
+	GIboolean			autotune;						/**< Select solvers by measured convergence. */
+	GISolverTuning		tuning[2][GI_TUNING_SIZES];		/**< Solver measurements by symmetry and magnitude of size. */
+	GIboolean			parallel;						/**< Patches currently parameterized concurrently. */
 	GIparamcb			callback[GI_CALLBACK_COUNT];	/**< Callback function. */
 	GIvoid				*cdata[GI_CALLBACK_COUNT];		/**< User data for callback function. */
+	GIresidualcb		residual_cb;					/**< Callback for solver residuals. */
+	GIvoid				*residual_data;					/**< User data for residual callback. */
 } GIParameterizer;
 
 /** \internal
@@ -80,28 +117,26 @@ typedef struct _GILinearSystem
 	GIParameterizer		*parameterizer;			/**< Parameterizer to use. */
 	GIPatch				*patch;					/**< Patch to which system belongs. */
 	GISparseMatrixCSR	*A;						/**< Matrix of coefficients. */
-	GISparseMatrixLIL	*B;						/**< Separately stored coefficients of right hand side. */
+	GISparseMatrixCSR	*B;						/**< Separately stored coefficients of right hand side. */
+	GISparseLDL			*ldl;					/**< Direct factorization of coefficients. */
 	GIdouble			*bU;					/**< Right hand side for U coordinate. */
 	GIdouble			*bV;					/**< Right hand side for V coordinate. */
 	GIdouble			*u;						/**< Unknown vector for U coordinate. */
 	GIdouble			*v;						/**< Unknown vector for V coordinate. */
+	GIboolean			warm;					/**< Unknowns initialized from previous parameterization. */
 } GILinearSystem;
 
 /** \internal
- *  \brief Parameters for solver thread.
+ *  \brief Work queue for concurrent patch parameterization.
  *  \ingroup parameterization
  */
-typedef struct _GISolverData
+typedef struct _GIPatchQueue
 {
-	GIsolverfunc			solver_func;			/**< Solving function. */
-	const GISparseMatrix	*A;						/**< System matrix. */
-	const GIdouble			*b;						/**< Right hand side vector. */
-	GIdouble				*x;						/**< Vector of unknowns. */
-	GImvfunc				ax;						/**< Matrix-vector-multiplication function. */
-	GImvfunc				pc;						/**< Prconditioning function. */
-	GIdouble				eps;					/**< Error threshold. */
-	GIuint					max_iter;				/**< Maximum number of iterations. */
-} GISolverData;
+	GIParameterizer			*parameterizer;			/**< Parameterizer to use. */
+	GIPatch					**patches;				/**< Patches to parameterize (biggest first). */
+	GIboolean				*success;				/**< Success flags indexed by patch ID. */
+	GIuint					count;					/**< Number of patches in queue. */
+} GIPatchQueue;
 
 
 /*************************************************************************/
@@ -116,6 +151,9 @@ GIboolean GIParameterizer_arc_length_square(GIParameterizer *par, GIPatch *patch
 GIboolean GIParameterizer_stretch_minimizing(GIParameterizer *par, GIPatch *patch);
 GIboolean GIParameterizer_stretch_minimizing2(GIParameterizer *par, GIPatch *patch);
 GIboolean GIParameterizer_gim(GIParameterizer *par, GIPatch *patch);
+GIboolean GIParameterizer_interior(GIParameterizer *par, GIPatch *patch);
+void GIParameterizer_parallel(GIParameterizer *par, GIMesh *mesh);
+void GIParameterizer_patch_task(GIvoid *arg, GIuint index);
 /** \} */
 
 /** \name Linear system methods
@@ -126,7 +164,6 @@ void GILinearSystem_construct(GILinearSystem *system, GIParameterizer *par,
 void GILinearSystem_destruct(GILinearSystem *system);
 void GILinearSystem_unknowns_to_params(GILinearSystem *system);
 GIboolean GILinearSystem_solve(GILinearSystem *system);
-GIthreadret GITHREADENTRY GILinearSystem_solve_thread(GIvoid *arg);
 /** \} */
 
 
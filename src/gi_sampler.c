@@ -493,32 +493,15 @@ void GISampler_sample_software(GISampler *sampler, GIPatch *patch)
 
         /* rasterize faces */
 #if OPENGI_NUM_THREADS > 1
-        if(sampler->context->use_threads)
+        if(sampler->context->use_threads && g_ThreadPool.num_workers)
         {
-            GIthread threads[OPENGI_NUM_THREADS-1];
-            GIuint uiFaces;
-            GIfloat *pTemp = GI_MALLOC_ALIGNED(GI_SSE_SIZE(
-                data.num_attribs*12*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
-
-            /* rasterize first face and create threads */
-            GISampler_rasterize_triangle(patch->faces, &data, pTemp);
-            data.next_face = patch->faces->next;
+            /* rasterize faces in pool threads */
+            data.next_face = patch->faces;
             data.end_face = patch->next->faces;
             GIMutex_construct(&data.mutex);
-            for(j=0; j<OPENGI_NUM_THREADS-1; ++j)
-                threads[j] = GIthread_create(GISampler_rasterize_thread, &data);
-
-            /* print number of rasterized faces */
-            uiFaces = (GIuint)GISampler_rasterize_thread(&data) + 1;
-            GIDebug(printf("rasterized triangles: %d", uiFaces));
-            for(j=0; j<OPENGI_NUM_THREADS-1; ++j)
-            {
-                uiFaces = (GIuint)GIthread_join(threads[j]);
-                GIDebug(printf(", %d", uiFaces));
-            }
-            GIDebug(printf("\n"));
+            GIThreadPool_run(&g_ThreadPool, GISampler_rasterize_task, 
+                &data, g_ThreadPool.num_threads);
             GIMutex_destruct(&data.mutex);
-            GI_FREE_ALIGNED(pTemp);
         }
         else
 #endif
@@ -1654,19 +1637,21 @@ void GISampler_rasterize_triangle(GIFace *face, GIRasterizerData *data,
 }
 
 /** \internal
- *  \brief Thread execution function for rasterizing triangles.
- *  \param arg thread parameters
- *  \return number of rasterized faces
+ *  \brief Task function for rasterizing triangles.
+ *  \details Faces are fetched one by one until none is left.
+ *  \param arg rasterizer parameters
+ *  \param index unused
  *  \ingroup sampling
  */
-GIthreadret GITHREADENTRY GISampler_rasterize_thread(void *arg)
+void GISampler_rasterize_task(void *arg, GIuint index)
 {
     GIRasterizerData *pData = (GIRasterizerData*)arg;
     GIFace *pFace;
     GIfloat *pTemp = GI_MALLOC_ALIGNED(GI_SSE_SIZE(
         pData->num_attribs*12*sizeof(GIfloat)), GI_SSE_ALIGN_FLOAT);
-    GIuint uiCount = 0;
+    GIDebug(GIuint uiCount = 0);
 
+    (void)index;
 #if OPENGI_NUM_THREADS > 1
     /* rasterize triangles */
     for(;;)
@@ -1684,12 +1669,12 @@ GIthreadret GITHREADENTRY GISampler_rasterize_thread(void *arg)
 
         /* sample face */
         GISampler_rasterize_triangle(pFace, pData, pTemp);
-        ++uiCount;
+        GIDebug(++uiCount);
     }
 #endif
 
+    GIDebug(printf("rasterized triangles: %d\n", uiCount));
     GI_FREE_ALIGNED(pTemp);
-    return (GIthreadret)uiCount;
 }
 
 /** \internal
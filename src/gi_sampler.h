@@ -150,7 +150,7 @@ void GISampler_sample_gl_fixed_function(GISampler *sampler,
 void GISampler_sample_gl_shader(GISampler *sampler, 
 	GIPatch *patch, GIGLManager *gl, GIuint attrib);
 void GISampler_rasterize_triangle(GIFace *face, GIRasterizerData *data, GIfloat *temp);
-GIthreadret GITHREADENTRY GISampler_rasterize_thread(void *arg);
+void GISampler_rasterize_task(void *arg, GIuint index);
 /** \} */
 
 /** \name Texture methods.
@@ -29,7 +29,13 @@
  *  \brief Implementation of types and functions for multithreading.
  */
 
+/* clock_gettime and its clocks are hidden by strict C standard modes */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+	#define _POSIX_C_SOURCE		200112L
+#endif
+
 #include "gi_thread.h"
+#include "gi_memory.h"
 #include "gi_math.h"
 
 #if OPENGI_NUM_THREADS > 1
@@ -39,9 +45,15 @@
 		#define GI_WAKE_ALL			1
 	#else
 		#include <errno.h>
+		#include <sched.h>
 		#include <sys/time.h>
 	#endif
 #endif
+#ifdef _WIN32
+	#include <Windows.h>
+#else
+	#include <time.h>
+#endif
 
 
 #if OPENGI_NUM_THREADS > 1
@@ -52,6 +64,18 @@
  */
 volatile GIuint g_uiActiveThreads = 1;
 
+/** \internal
+ *  \brief Library-wide thread pool.
+ *  \ingroup threads
+ */
+GIThreadPool g_ThreadPool = { 0 };
+
+/** \internal
+ *  \brief Worker the calling thread runs as or NULL if not a pool thread.
+ *  \ingroup threads
+ */
+static GI_THREAD_LOCAL GIWorker *t_pWorker = NULL;
+
 /** \internal
  *  \brief Create and execute new thread.
  *  \param fn thread execution function
@@ -96,6 +120,20 @@ GIthreadret GIthread_join(GIthread thread)
 	return retval;
 }
 
+/** \internal
+ *  \brief Give up remaining time slice.
+ *  \ingroup threads
+ */
+void GIthread_yield()
+{
+	/* yield processor */
+#ifdef _WIN32
+	SwitchToThread();
+#else
+	sched_yield();
+#endif
+}
+
 /** \internal
  *  \brief Mutex constructor.
  *  \param mutex mutex to construct
@@ -177,6 +215,40 @@ GIboolean GIMutex_trylock(GIMutex *mutex)
 #endif
 }
 
+/** \internal
+ *  \brief Thread key constructor.
+ *  \details The key is never destroyed. The destructor is called on exit 
+ *  of every thread that set a non-NULL value, with this value.
+ *  \param key key to construct
+ *  \param fn destructor of thread values
+ *  \ingroup threads
+ */
+void GIThreadKey_construct(GIThreadKey *key, GIkeydestructor fn)
+{
+	/* create key */
+#ifdef _WIN32
+	*key = FlsAlloc(fn);
+#else
+	pthread_key_create(key, fn);
+#endif
+}
+
+/** \internal
+ *  \brief Set value of calling thread.
+ *  \param key key to set value of
+ *  \param value new value
+ *  \ingroup threads
+ */
+void GIThreadKey_set(GIThreadKey *key, GIvoid *value)
+{
+	/* set thread-specific value */
+#ifdef _WIN32
+	FlsSetValue(*key, value);
+#else
+	pthread_setspecific(*key, value);
+#endif
+}
+
 /** \internal
  *  \brief Condition variable constructor.
  *  \param cond condition variable to construct
@@ -365,4 +437,392 @@ void GIBarrier_enter(GIBarrier *barrier)
 #endif
 }
 
+/** \internal
+ *  \brief Task group constructor.
+ *  \param group task group to construct
+ *  \ingroup threads
+ */
+void GITaskGroup_construct(GITaskGroup *group)
+{
+	/* construct empty group */
+	group->pending = 0;
+	GIMutex_construct(&group->mutex);
+	GICondVar_construct(&group->cond_var);
+}
+
+/** \internal
+ *  \brief Task group destructor.
+ *  \param group task group to destruct
+ *  \ingroup threads
+ */
+void GITaskGroup_destruct(GITaskGroup *group)
+{
+	/* clean up */
+	GIMutex_destruct(&group->mutex);
+	GICondVar_destruct(&group->cond_var);
+}
+
+/** \internal
+ *  \brief Thread pool constructor.
+ *  \param pool thread pool to construct
+ *  \param num_threads number of threads including the calling thread
+ *  \ingroup threads
+ */
+void GIThreadPool_construct(GIThreadPool *pool, GIuint num_threads)
+{
+	GIuint i;
+
+	/* initialize state */
+	pool->num_threads = num_threads ? num_threads : 1;
+	pool->num_workers = pool->num_threads - 1;
+	pool->next_worker = 0;
+	pool->queued = 0;
+	pool->shutdown = GI_FALSE;
+	GIMutex_construct(&pool->mutex);
+	GICondVar_construct(&pool->cond_var);
+	pool->workers = NULL;
+	if(!pool->num_workers)
+		return;
+
+	/* create workers */
+	pool->workers = (GIWorker*)GI_CALLOC_ARRAY(pool->num_workers, sizeof(GIWorker));
+	for(i=0; i<pool->num_workers; ++i)
+	{
+		pool->workers[i].pool = pool;
+		GIMutex_construct(&pool->workers[i].mutex);
+	}
+	for(i=0; i<pool->num_workers; ++i)
+	{
+		pool->workers[i].thread = GIthread_create(GIThreadPool_worker, pool->workers+i);
+	}
+}
+
+/** \internal
+ *  \brief Thread pool destructor.
+ *  \details All submitted tasks have to be finished.
+ *  \param pool thread pool to destruct
+ *  \ingroup threads
+ */
+void GIThreadPool_destruct(GIThreadPool *pool)
+{
+	GIuint i;
+
+	/* stop workers */
+	GIMutex_lock(&pool->mutex);
+	pool->shutdown = GI_TRUE;
+	GICondVar_wake_all(&pool->cond_var);
+	GIMutex_unlock(&pool->mutex);
+	for(i=0; i<pool->num_workers; ++i)
+		GIthread_join(pool->workers[i].thread);
+
+	/* clean up */
+	for(i=0; i<pool->num_workers; ++i)
+	{
+		GIMutex_destruct(&pool->workers[i].mutex);
+		if(pool->workers[i].tasks)
+			GI_FREE_ARRAY(pool->workers[i].tasks);
+	}
+	if(pool->workers)
+		GI_FREE_ARRAY(pool->workers);
+	GIMutex_destruct(&pool->mutex);
+	GICondVar_destruct(&pool->cond_var);
+	memset(pool, 0, sizeof(GIThreadPool));
+}
+
+/** \internal
+ *  \brief Submit task to thread pool.
+ *  \details Pool threads push to their own queue, other threads 
+ *  distribute their tasks among the workers. Without workers 
+ *  the task is executed immediately.
+ *  \param pool thread pool to use
+ *  \param group group to add task to
+ *  \param fn task function
+ *  \param arg argument to task function
+ *  \param index index passed to task function
+ *  \ingroup threads
+ */
+void GIThreadPool_submit(GIThreadPool *pool, GITaskGroup *group, 
+						 GItaskfunc fn, GIvoid *arg, GIuint index)
+{
+	GIWorker *pWorker = t_pWorker;
+	GITask *pTask;
+
+	/* execute directly if no workers */
+	if(!pool->num_workers)
+	{
+		fn(arg, index);
+		return;
+	}
+	GIMutex_lock(&group->mutex);
+	++group->pending;
+	GIMutex_unlock(&group->mutex);
+
+	/* select queue */
+	GIMutex_lock(&pool->mutex);
+	if(!pWorker || pWorker->pool != pool)
+	{
+		pWorker = pool->workers + pool->next_worker;
+		pool->next_worker = (pool->next_worker+1) % pool->num_workers;
+	}
+	GIMutex_unlock(&pool->mutex);
+
+	/* push to back of queue (grow ring buffer if full) */
+	GIMutex_lock(&pWorker->mutex);
+	if(pWorker->size == pWorker->capacity)
+	{
+		GIuint uiCapacity = pWorker->capacity ? (pWorker->capacity<<1) : 16;
+		GITask *pTasks = (GITask*)GI_MALLOC_ARRAY(uiCapacity, sizeof(GITask));
+		GIuint i;
+		for(i=0; i<pWorker->size; ++i)
+			pTasks[i] = pWorker->tasks[(pWorker->head+i)%pWorker->capacity];
+		if(pWorker->tasks)
+			GI_FREE_ARRAY(pWorker->tasks);
+		pWorker->tasks = pTasks;
+		pWorker->capacity = uiCapacity;
+		pWorker->head = 0;
+	}
+	pTask = pWorker->tasks + ((pWorker->head+pWorker->size)%pWorker->capacity);
+	pTask->fn = fn;
+	pTask->arg = arg;
+	pTask->index = index;
+	pTask->group = group;
+	++pWorker->size;
+	GIMutex_unlock(&pWorker->mutex);
+
+	/* wake up a sleeping worker */
+	GIMutex_lock(&pool->mutex);
+	++pool->queued;
+	GICondVar_wake_one(&pool->cond_var);
+	GIMutex_unlock(&pool->mutex);
+}
+
+/** \internal
+ *  \brief Wait for all tasks of group to finish.
+ *  \details The calling thread executes queued tasks while waiting.
+ *  \param pool thread pool tasks were submitted to
+ *  \param group group to wait for
+ *  \ingroup threads
+ */
+void GIThreadPool_wait(GIThreadPool *pool, GITaskGroup *group)
+{
+	GITask task;
+	GIboolean bDone;
+
+	for(;;)
+	{
+		/* finished? */
+		GIMutex_lock(&group->mutex);
+		bDone = !group->pending;
+		GIMutex_unlock(&group->mutex);
+		if(bDone)
+			break;
+
+		/* help out or sleep till last task finished */
+		if(GIThreadPool_take(pool, &task))
+			GIThreadPool_execute(pool, &task);
+		else
+		{
+			GIMutex_lock(&group->mutex);
+			if(group->pending)
+				GICondVar_wait(&group->cond_var, &group->mutex);
+			GIMutex_unlock(&group->mutex);
+		}
+	}
+}
+
+/** \internal
+ *  \brief Execute function for range of indices in parallel and wait for completion.
+ *  \details Tasks with lower indices tend to be started first.
+ *  \param pool thread pool to use
+ *  \param fn task function
+ *  \param arg argument to task function
+ *  \param count number of tasks (indices passed are 0 to count-1)
+ *  \ingroup threads
+ */
+void GIThreadPool_run(GIThreadPool *pool, GItaskfunc fn, GIvoid *arg, GIuint count)
+{
+	GITaskGroup group;
+	GIuint i;
+
+	/* sequential execution if nothing to distribute */
+	if(!pool->num_workers || count < 2)
+	{
+		for(i=0; i<count; ++i)
+			fn(arg, i);
+		return;
+	}
+
+	/* submit in reverse order, as queues are processed LIFO by their owners */
+	GITaskGroup_construct(&group);
+	for(i=count; i>0; --i)
+		GIThreadPool_submit(pool, &group, fn, arg, i-1);
+	GIThreadPool_wait(pool, &group);
+	GITaskGroup_destruct(&group);
+}
+
+/** \internal
+ *  \brief Take task from own queue or steal one from other queues.
+ *  \param pool thread pool to take task from
+ *  \param task address to store task at
+ *  \retval GI_TRUE if task found
+ *  \retval GI_FALSE if all queues empty
+ *  \ingroup threads
+ */
+GIboolean GIThreadPool_take(GIThreadPool *pool, GITask *task)
+{
+	GIWorker *pWorker = t_pWorker;
+	GIuint i, uiStart = 0;
+	GIboolean bFound = GI_FALSE;
+
+	/* own queue first (back) */
+	if(pWorker && pWorker->pool == pool)
+	{
+		uiStart = pWorker - pool->workers;
+		GIMutex_lock(&pWorker->mutex);
+		if(pWorker->size)
+		{
+			--pWorker->size;
+			*task = pWorker->tasks[(pWorker->head+pWorker->size)%pWorker->capacity];
+			bFound = GI_TRUE;
+		}
+		GIMutex_unlock(&pWorker->mutex);
+	}
+
+	/* steal from other queues (front) */
+	for(i=1; !bFound && i<=pool->num_workers; ++i)
+	{
+		pWorker = pool->workers + ((uiStart+i)%pool->num_workers);
+		GIMutex_lock(&pWorker->mutex);
+		if(pWorker->size)
+		{
+			*task = pWorker->tasks[pWorker->head];
+			pWorker->head = (pWorker->head+1) % pWorker->capacity;
+			--pWorker->size;
+			bFound = GI_TRUE;
+		}
+		GIMutex_unlock(&pWorker->mutex);
+	}
+	if(bFound)
+	{
+		GIMutex_lock(&pool->mutex);
+		--pool->queued;
+		GIMutex_unlock(&pool->mutex);
+	}
+	return bFound;
+}
+
+/** \internal
+ *  \brief Execute task and notify its group.
+ *  \param pool thread pool task was taken from
+ *  \param task task to execute
+ *  \ingroup threads
+ */
+void GIThreadPool_execute(GIThreadPool *pool, GITask *task)
+{
+	GITaskGroup *pGroup = task->group;
+
+	/* execute task */
+	task->fn(task->arg, task->index);
+
+	/* last task of group? (group may be gone after unlock) */
+	GIMutex_lock(&pGroup->mutex);
+	if(!--pGroup->pending)
+		GICondVar_wake_all(&pGroup->cond_var);
+	GIMutex_unlock(&pGroup->mutex);
+}
+
+/** \internal
+ *  \brief Thread execution function of pool workers.
+ *  \param arg worker to run as
+ *  \return 0
+ *  \ingroup threads
+ */
+GIthreadret GITHREADENTRY GIThreadPool_worker(GIvoid *arg)
+{
+	GIWorker *pWorker = (GIWorker*)arg;
+	GIThreadPool *pPool = pWorker->pool;
+	GITask task;
+	GIboolean bExit;
+
+	/* process tasks till shutdown */
+	t_pWorker = pWorker;
+	for(;;)
+	{
+		if(GIThreadPool_take(pPool, &task))
+		{
+			GIThreadPool_execute(pPool, &task);
+			continue;
+		}
+		GIMutex_lock(&pPool->mutex);
+		while(!pPool->queued && !pPool->shutdown)
+			GICondVar_wait(&pPool->cond_var, &pPool->mutex);
+		bExit = pPool->shutdown && !pPool->queued;
+		GIMutex_unlock(&pPool->mutex);
+		if(bExit)
+			break;
+	}
+	t_pWorker = NULL;
+	GIMemory_release_caches();
+	return 0;
+}
+
 #endif	/* OPENGI_NUM_THREADS > 1 */
+
+/** \internal
+ *  \brief Start one-time initialization.
+ *  \details Exactly one caller gets GI_TRUE and has to call GIOnce_end 
+ *  after initializing. Concurrent callers wait till initialization is done.
+ *  \param once initialization flag
+ *  \retval GI_TRUE if caller has to initialize
+ *  \retval GI_FALSE if already initialized
+ *  \ingroup threads
+ */
+GIboolean GIOnce_begin(GIOnce *once)
+{
+#if OPENGI_NUM_THREADS > 1
+	/* first thread initializes, others wait */
+	if(GI_ATOMIC_LOAD_ACQUIRE(once) == 2)
+		return GI_FALSE;
+	if(GI_ATOMIC_CAS(once, 0, 1))
+		return GI_TRUE;
+	while(GI_ATOMIC_LOAD_ACQUIRE(once) != 2)
+		GIthread_yield();
+	return GI_FALSE;
+#else
+	return !*once;
+#endif
+}
+
+/** \internal
+ *  \brief Finish one-time initialization.
+ *  \param once initialization flag
+ *  \ingroup threads
+ */
+void GIOnce_end(GIOnce *once)
+{
+	/* publish initialized state */
+#if OPENGI_NUM_THREADS > 1
+	GI_ATOMIC_STORE_RELEASE(once, 2);
+#else
+	*once = 2;
+#endif
+}
+
+/** \internal
+ *  \brief Get time of monotonic clock for measuring durations.
+ *  \return time in seconds since unspecified starting point
+ *  \ingroup threads
+ */
+GIdouble GITimer_seconds()
+{
+#ifdef _WIN32
+	LARGE_INTEGER count, freq;
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&freq);
+	return (GIdouble)count.QuadPart / (GIdouble)freq.QuadPart;
+#else
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + 1e-9*time.tv_nsec;
+#endif
+}
@@ -67,10 +67,36 @@
 	typedef GIuint GIthreadret;
 #endif
 
+#if OPENGI_NUM_THREADS > 1 && defined(_MSC_VER)
+	#define GI_THREAD_LOCAL			__declspec(thread)
+#elif OPENGI_NUM_THREADS > 1
+	#define GI_THREAD_LOCAL			__thread
+#else
+	#define GI_THREAD_LOCAL
+#endif
+
+#if OPENGI_NUM_THREADS > 1 && defined(_WIN32)
+	#define GI_ATOMIC_CAS(p,o,n)	(InterlockedCompareExchange((volatile LONG*)(p), n, o) == (LONG)(o))
+	#define GI_ATOMIC_LOAD_ACQUIRE(p)		((GIuint)InterlockedCompareExchange((volatile LONG*)(p), 0, 0))
+	#define GI_ATOMIC_STORE_RELEASE(p,v)	InterlockedExchange((volatile LONG*)(p), v)
+#elif OPENGI_NUM_THREADS > 1
+	#define GI_ATOMIC_CAS(p,o,n)	__sync_bool_compare_and_swap(p, o, n)
+	#define GI_ATOMIC_LOAD_ACQUIRE(p)		__atomic_load_n(p, __ATOMIC_ACQUIRE)
+	#define GI_ATOMIC_STORE_RELEASE(p,v)	__atomic_store_n(p, v, __ATOMIC_RELEASE)
+#endif
+
+#define GI_ONCE_INIT				0
+
 
 /*************************************************************************/
 /* Typedefs */
 
+/** \internal
+ *  \brief Flag for one-time initialization.
+ *  \ingroup threads
+ */
+typedef volatile GIuint GIOnce;
+
 #if OPENGI_NUM_THREADS > 1
 
 /** \internal
@@ -120,6 +146,16 @@ typedef struct _GIBarrier
 	GICondVar	cond_var;					/**< Broadcast to signal completeness. */
 } GIBarrier;
 
+/** \internal
+ *  \brief Key of thread-specific values.
+ *  \ingroup threads
+ */
+#ifdef _WIN32
+	typedef DWORD			GIThreadKey;
+#else
+	typedef pthread_key_t	GIThreadKey;
+#endif
+
 /** \internal
  *  \brief Thread function return type.
  *  \ingroup threads
@@ -136,8 +172,82 @@ typedef struct _GIBarrier
  */
 typedef GIthreadret (GITHREADENTRY *GIthreadfunc)(void*);
 
+/** \internal
+ *  \brief Destructor of thread-specific values.
+ *  \ingroup threads
+ */
+typedef void (GITHREADENTRY *GIkeydestructor)(void*);
+
+/** \internal
+ *  \brief Task execution function.
+ *  \ingroup threads
+ */
+typedef void (*GItaskfunc)(GIvoid*, GIuint);
+
+
+/*************************************************************************/
+/* Structures */
+
+/** \internal
+ *  \brief Task for thread pool.
+ *  \ingroup threads
+ */
+typedef struct _GITask
+{
+	GItaskfunc			fn;					/**< Task function. */
+	GIvoid				*arg;				/**< Argument to task function. */
+	GIuint				index;				/**< Index passed to task function. */
+	struct _GITaskGroup	*group;				/**< Group this task belongs to. */
+} GITask;
+
+/** \internal
+ *  \brief Group of tasks to wait for.
+ *  \ingroup threads
+ */
+typedef struct _GITaskGroup
+{
+	GIuint		pending;					/**< Number of unfinished tasks. */
+	GIMutex		mutex;						/**< Mutex for pending counter. */
+	GICondVar	cond_var;					/**< Signals completion of last task. */
+} GITaskGroup;
+
+/** \internal
+ *  \brief Worker thread of thread pool.
+ *  \details Every worker owns a double ended task queue. It executes its own 
+ *  tasks in LIFO order and steals from the front of other queues when idle.
+ *  \ingroup threads
+ */
+typedef struct _GIWorker
+{
+	struct _GIThreadPool	*pool;			/**< Pool this worker belongs to. */
+	GIthread				thread;			/**< Thread handle. */
+	GITask					*tasks;			/**< Ring buffer of queued tasks. */
+	GIuint					capacity;		/**< Size of ring buffer. */
+	GIuint					head;			/**< Index of front task. */
+	GIuint					size;			/**< Number of queued tasks. */
+	GIMutex					mutex;			/**< Mutex for task queue. */
+} GIWorker;
+
+/** \internal
+ *  \brief Persistent work-stealing thread pool.
+ *  \ingroup threads
+ */
+typedef struct _GIThreadPool
+{
+	GIuint		num_threads;				/**< Number of threads including calling thread. */
+	GIuint		num_workers;				/**< Number of worker threads. */
+	GIWorker	*workers;					/**< Worker threads. */
+	GIuint		next_worker;				/**< Worker for next external submission. */
+	GIuint		queued;						/**< Number of queued tasks. */
+	GIboolean	shutdown;					/**< Workers should exit. */
+	GIMutex		mutex;						/**< Mutex for pool state. */
+	GICondVar	cond_var;					/**< Signals new tasks. */
+} GIThreadPool;
+
 extern volatile GIuint g_uiActiveThreads;
 
+extern GIThreadPool g_ThreadPool;
+
 
 /*************************************************************************/
 /* Functions */
@@ -147,6 +257,7 @@ extern volatile GIuint g_uiActiveThreads;
  */
 GIthread GIthread_create(GIthreadfunc fn, GIvoid* arg);
 GIthreadret GIthread_join(GIthread thread);
+void GIthread_yield();
 /** \} */
 
 /** \name Mutex methods
@@ -159,6 +270,13 @@ void GIMutex_unlock(GIMutex *mutex);
 GIboolean GIMutex_trylock(GIMutex *mutex);
 /** \} */
 
+/** \name Thread key methods
+ *  \{
+ */
+void GIThreadKey_construct(GIThreadKey *key, GIkeydestructor fn);
+void GIThreadKey_set(GIThreadKey *key, GIvoid *value);
+/** \} */
+
 /** \name Condition variable methods
  *  \{
  */
@@ -178,7 +296,41 @@ void GIBarrier_destruct(GIBarrier *barrier);
 void GIBarrier_enter(GIBarrier *barrier);
 /** \} */
 
+/** \name Task group methods
+ *  \{
+ */
+void GITaskGroup_construct(GITaskGroup *group);
+void GITaskGroup_destruct(GITaskGroup *group);
+/** \} */
+
+/** \name Thread pool methods
+ *  \{
+ */
+void GIThreadPool_construct(GIThreadPool *pool, GIuint num_threads);
+void GIThreadPool_destruct(GIThreadPool *pool);
+void GIThreadPool_submit(GIThreadPool *pool, GITaskGroup *group, 
+	GItaskfunc fn, GIvoid *arg, GIuint index);
+void GIThreadPool_wait(GIThreadPool *pool, GITaskGroup *group);
+void GIThreadPool_run(GIThreadPool *pool, GItaskfunc fn, GIvoid *arg, GIuint count);
+GIboolean GIThreadPool_take(GIThreadPool *pool, GITask *task);
+void GIThreadPool_execute(GIThreadPool *pool, GITask *task);
+GIthreadret GITHREADENTRY GIThreadPool_worker(GIvoid *arg);
+/** \} */
+
 #endif	/* OPENGI_NUM_THREADS > 1 */
 
+/** \name One-time initialization methods
+ *  \{
+ */
+GIboolean GIOnce_begin(GIOnce *once);
+void GIOnce_end(GIOnce *once);
+/** \} */
+
+/** \name Timer methods
+ *  \{
+ */
+GIdouble GITimer_seconds();
+/** \} */
+
 
 #endif